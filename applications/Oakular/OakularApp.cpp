@@ -15,6 +15,7 @@
 #include <imgui_stdlib.h>
 #include <yaml-cpp/yaml.h>
 
+#include <algorithm>
 #include <iostream>
 
 // ----------------------------------------------------------------------------
@@ -50,6 +51,15 @@ OakularApp::OakularApp(size_t const p_width, size_t const p_height)
 // ----------------------------------------------------------------------------
 void OakularApp::onDrawMainPanel()
 {
+    // Close the timings of the previous frame
+    m_hud.newFrame();
+    if (m_server)
+    {
+        Server::Statistics const& traffic = m_server->statistics();
+        m_hud.setTraffic(
+            {traffic.bytes, traffic.messages, traffic.status_updates});
+    }
+
     // Handle keyboard shortcuts
     handleKeyboardShortcuts();
 
@@ -76,6 +86,11 @@ void OakularApp::onDrawMainPanel()
     showBlackboardPanel();
     showFileDialogs();
     showQuitConfirmationPopup();
+
+    if (m_show_performance_hud)
+    {
+        m_hud.draw(&m_show_performance_hud);
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -148,7 +163,11 @@ void OakularApp::showVisualizerPanel()
     if (!m_server)
         return;
 
-    m_server->update();
+    {
+        PerformanceHUD::ScopedTimer timer(m_hud,
+                                          PerformanceHUD::Stage::Network);
+        m_server->update();
+    }
 
     if (!m_server->isConnected())
     {
@@ -172,6 +191,15 @@ void OakularApp::showVisualizerPanel()
                       << " nodes in DFS order" << std::endl;
         }
 
+        // Apply the structure patches before the states of their nodes
+        if (m_server->hasStructurePatches())
+        {
+            for (auto const& patch : m_server->takeStructurePatches())
+            {
+                applyStructurePatch(patch);
+            }
+        }
+
         // Update node states if we have new data
         if (m_server->hasStateUpdate())
         {
@@ -183,6 +211,56 @@ void OakularApp::showVisualizerPanel()
             m_server->clearStateUpdate();
         }
 
+        // Show the evaluation order chosen by unordered composites
+        if (m_server->hasOrderUpdate())
+        {
+            for (auto const& [parent_id, order] : m_server->getChildOrders())
+            {
+                for (size_t rank = 0; rank < order.size(); ++rank)
+                {
+                    if (Node* child = findNode(order[rank]))
+                    {
+                        child->evaluation_rank = int(rank);
+                    }
+                }
+            }
+            m_server->clearOrderUpdate();
+        }
+
+        // Show the heat overlay of the sampling profiler
+        if (m_server->hasHeatUpdate())
+        {
+            auto const& heat = m_server->getNodeHeat();
+            for (auto& [node_id, node] : m_nodes)
+            {
+                auto it = heat.find(node_id);
+                node.heat_total = (it != heat.end()) ? it->second.first : 0;
+                node.heat_self = (it != heat.end()) ? it->second.second : 0;
+            }
+            m_server->clearHeatUpdate();
+        }
+
+        // Show the distribution of the statuses across the instances of the
+        // tree: nodes take the color of the status of most instances
+        if (m_server->hasDistributionUpdate())
+        {
+            auto const& distribution = m_server->getNodeDistribution();
+            for (auto& [node_id, node] : m_nodes)
+            {
+                auto it = distribution.find(node_id);
+                node.distribution = (it != distribution.end())
+                                        ? it->second
+                                        : std::array<uint32_t, 4>{};
+                auto dominant = std::max_element(node.distribution.begin(),
+                                                 node.distribution.end());
+                node.runtime_status =
+                    (*dominant > 0u)
+                        ? int(dominant - node.distribution.begin())
+                        : 0;
+            }
+            m_server->clearDistributionUpdate();
+        }
+
         // Show connection status
         ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f),
                            "Connected - Visualizing tree (%zu nodes)",
@@ -1073,6 +1151,7 @@ void OakularApp::showBlackboardPanel()
     if (!m_show_blackboard_panel || !m_blackboard)
         return;
 
+    PerformanceHUD::ScopedTimer timer(m_hud, PerformanceHUD::Stage::Blackboard);
     ImGui::SetNextWindowSize(ImVec2(350, 500), ImGuiCond_FirstUseEver);
     if (!ImGui::Begin("Blackboard", &m_show_blackboard_panel))
     {
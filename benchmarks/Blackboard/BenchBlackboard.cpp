@@ -0,0 +1,169 @@
+/**
+ * @file BenchBlackboard.cpp
+ * @brief Micro-benchmarks of blackboard writes: read-modify-write through
+ * get/set versus in-place modify/emplace on large containers.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Blackboard.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Blackboard.hpp"
+
+#include <map>
+#include <vector>
+
+namespace {
+
+using Samples = std::vector<double>;
+using Table = std::map<int, double>;
+
+// ----------------------------------------------------------------------------
+//! \brief Blackboard holding a vector of p_size samples.
+// ----------------------------------------------------------------------------
+bt::Blackboard makeSamples(size_t p_size)
+{
+    bt::Blackboard bb;
+    bb.emplace<Samples>("samples", p_size, 1.0);
+    return bb;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Blackboard holding a map of p_size entries.
+// ----------------------------------------------------------------------------
+bt::Blackboard makeTable(size_t p_size)
+{
+    bt::Blackboard bb;
+    Table& table = bb.emplace<Table>("table");
+    for (size_t i = 0; i < p_size; ++i)
+    {
+        table[int(i)] = 0.0;
+    }
+    return bb;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Updating one element of a large vector
+// ============================================================================
+
+static void BM_UpdateVector_GetSet(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeSamples(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        Samples samples = *bb.get<Samples>("samples");
+        samples[0] += 1.0;
+        bb.set("samples", std::move(samples));
+    }
+}
+BENCHMARK(BM_UpdateVector_GetSet)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_UpdateVector_Modify(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeSamples(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        bb.modify<Samples>("samples",
+                           [](Samples& p_samples) { p_samples[0] += 1.0; });
+    }
+}
+BENCHMARK(BM_UpdateVector_Modify)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// ============================================================================
+// Growing a vector one sample per iteration (cleared when full)
+// ============================================================================
+
+static void BM_GrowVector_GetSet(benchmark::State& p_state)
+{
+    size_t const capacity = size_t(p_state.range(0));
+    bt::Blackboard bb;
+    bb.set("samples", Samples());
+    for (auto _ : p_state)
+    {
+        Samples samples = *bb.get<Samples>("samples");
+        if (samples.size() == capacity)
+        {
+            samples.clear();
+        }
+        samples.push_back(1.0);
+        bb.set("samples", std::move(samples));
+    }
+}
+BENCHMARK(BM_GrowVector_GetSet)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_GrowVector_Modify(benchmark::State& p_state)
+{
+    size_t const capacity = size_t(p_state.range(0));
+    bt::Blackboard bb;
+    bb.emplace<Samples>("samples");
+    for (auto _ : p_state)
+    {
+        bb.modify<Samples>("samples", [capacity](Samples& p_samples) {
+            if (p_samples.size() == capacity)
+            {
+                p_samples.clear(); // Keeps the capacity
+            }
+            p_samples.push_back(1.0);
+        });
+    }
+}
+BENCHMARK(BM_GrowVector_Modify)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// ============================================================================
+// Updating one entry of a large map
+// ============================================================================
+
+static void BM_UpdateMap_GetSet(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeTable(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        Table table = *bb.get<Table>("table");
+        table[0] += 1.0;
+        bb.set("table", std::move(table));
+    }
+}
+BENCHMARK(BM_UpdateMap_GetSet)->RangeMultiplier(16)->Range(16, 1 << 12);
+
+static void BM_UpdateMap_Modify(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeTable(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        bb.modify<Table>("table", [](Table& p_table) { p_table[0] += 1.0; });
+    }
+}
+BENCHMARK(BM_UpdateMap_Modify)->RangeMultiplier(16)->Range(16, 1 << 12);
+
+// ============================================================================
+// Replacing a whole vector: set() reuses the capacity of the stored value
+// ============================================================================
+
+static void BM_ReplaceVector_Set(benchmark::State& p_state)
+{
+    size_t const size = size_t(p_state.range(0));
+    Samples const source(size, 2.0);
+    bt::Blackboard bb = makeSamples(size);
+    for (auto _ : p_state)
+    {
+        bb.set("samples", source);
+    }
+}
+BENCHMARK(BM_ReplaceVector_Set)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+static void BM_ReplaceVector_Emplace(benchmark::State& p_state)
+{
+    size_t const size = size_t(p_state.range(0));
+    Samples const source(size, 2.0);
+    bt::Blackboard bb = makeSamples(size);
+    for (auto _ : p_state)
+    {
+        bb.emplace<Samples>("samples", source);
+    }
+}
+BENCHMARK(BM_ReplaceVector_Emplace)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -0,0 +1,86 @@
+/**
+ * @file BenchBlackboardKey.cpp
+ * @brief Micro-benchmarks of lookup-heavy leaves: reading and writing
+ * blackboard entries by string literal versus by key handle, through a chain
+ * of child blackboards.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Key.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Blackboard.hpp"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Chain of p_depth blackboards, the entries read by the leaf being
+//! stored in the root, the written one in the last child (the blackboard of
+//! the leaf).
+// ----------------------------------------------------------------------------
+bt::Blackboard::Ptr makeChain(size_t p_depth)
+{
+    auto root = std::make_shared<bt::Blackboard>();
+    root->set("target_position_x", 1.0);
+    root->set("target_position_y", 2.0);
+    root->set("obstacle_distance", 3.0);
+    root->set("maximum_speed_limit", 4.0);
+
+    bt::Blackboard::Ptr bb = root;
+    for (size_t i = 1; i < p_depth; ++i)
+    {
+        bb = bb->createChild();
+    }
+    bb->set("commanded_velocity", 0.0);
+    return bb;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Leaf reading four inputs and writing one output, keys given as literals
+// (names longer than the small string buffer, as in real trees)
+// ============================================================================
+
+static void BM_LeafLookups_Literal(benchmark::State& p_state)
+{
+    bt::Blackboard::Ptr bb = makeChain(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        double x = *bb->get<double>("target_position_x");
+        double y = *bb->get<double>("target_position_y");
+        double d = *bb->get<double>("obstacle_distance");
+        double v = *bb->get<double>("maximum_speed_limit");
+        bb->set("commanded_velocity", v * d / (x + y));
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * 5);
+}
+BENCHMARK(BM_LeafLookups_Literal)->DenseRange(1, 4);
+
+// ============================================================================
+// Same leaf, keys given as typed handles created once
+// ============================================================================
+
+static void BM_LeafLookups_Handle(benchmark::State& p_state)
+{
+    static bt::Key<double> const target_x("target_position_x");
+    static bt::Key<double> const target_y("target_position_y");
+    static bt::Key<double> const distance("obstacle_distance");
+    static bt::Key<double> const speed("maximum_speed_limit");
+    static bt::Key<double> const velocity("commanded_velocity");
+
+    bt::Blackboard::Ptr bb = makeChain(size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        double x = *bb->get(target_x);
+        double y = *bb->get(target_y);
+        double d = *bb->get(distance);
+        double v = *bb->get(speed);
+        bb->set(velocity, v * d / (x + y));
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * 5);
+}
+BENCHMARK(BM_LeafLookups_Handle)->DenseRange(1, 4);
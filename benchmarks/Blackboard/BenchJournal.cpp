@@ -0,0 +1,94 @@
+/**
+ * @file BenchJournal.cpp
+ * @brief Micro-benchmarks of blackboard replication: full YAML dumps versus
+ * the change journal.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Journal.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Journal.hpp"
+#include "BlackThorn/Blackboard/Serializer.hpp"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Blackboard holding p_size integer entries.
+// ----------------------------------------------------------------------------
+bt::Blackboard::Ptr makeBlackboard(size_t p_size)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+    for (size_t i = 0; i < p_size; ++i)
+    {
+        bb->set("key" + std::to_string(i), int(i));
+    }
+    return bb;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// One write per tick, replicated by a full dump
+// ============================================================================
+
+static void BM_Replicate_Dump(benchmark::State& p_state)
+{
+    auto bb = makeBlackboard(size_t(p_state.range(0)));
+    int i = 0;
+    for (auto _ : p_state)
+    {
+        bb->set("key0", ++i);
+        std::string text = YAML::Dump(bt::BlackboardSerializer::dump(*bb));
+        benchmark::DoNotOptimize(text);
+    }
+}
+BENCHMARK(BM_Replicate_Dump)->RangeMultiplier(8)->Range(8, 512);
+
+// ============================================================================
+// One write per tick, replicated by the journal
+// ============================================================================
+
+static void BM_Replicate_Journal(benchmark::State& p_state)
+{
+    auto bb = makeBlackboard(size_t(p_state.range(0)));
+    bt::BlackboardJournal journal(bb);
+    journal.consume(journal.pending());
+    int i = 0;
+    for (auto _ : p_state)
+    {
+        bb->set("key0", ++i);
+        benchmark::DoNotOptimize(journal.data().data());
+        journal.consume(journal.pending());
+    }
+}
+BENCHMARK(BM_Replicate_Journal)->RangeMultiplier(8)->Range(8, 512);
+
+// ============================================================================
+// Cost of the standby replaying a record
+// ============================================================================
+
+static void BM_Replay(benchmark::State& p_state)
+{
+    auto primary = std::make_shared<bt::Blackboard>();
+    bt::BlackboardJournal journal(primary);
+    primary->set("key0", 1);
+    journal.consume(journal.pending());
+    primary->set("key0", 2);
+    std::string record = journal.data();
+
+    // Replay the same record: patch the sequence to keep it consecutive
+    auto standby = std::make_shared<bt::Blackboard>();
+    bt::BlackboardReplica replica(standby);
+    uint64_t sequence = 2u;
+    for (auto _ : p_state)
+    {
+        std::memcpy(&record[sizeof(uint32_t)], &sequence, sizeof(sequence));
+        ++sequence;
+        replica.feed(record.data(), record.size());
+    }
+}
+BENCHMARK(BM_Replay);
@@ -0,0 +1,142 @@
+/**
+ * @file BenchMappedData.cpp
+ * @brief Micro-benchmarks of bulk blackboard data: loading and reading an
+ * array of doubles declared inline in YAML versus stored in a binary file
+ * mapped in memory.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/MappedData.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Serializer.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+//! \brief Number of doubles of the array.
+constexpr size_t COUNT = 100000u;
+
+// ----------------------------------------------------------------------------
+//! \brief Binary file of COUNT doubles in the temporary directory.
+// ----------------------------------------------------------------------------
+std::filesystem::path const& binaryFile()
+{
+    static std::filesystem::path const path = []
+    {
+        auto file = std::filesystem::temp_directory_path() /
+                    "blackthorn_bench_mapped.bin";
+        std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+        for (size_t i = 0u; i < COUNT; ++i)
+        {
+            double const value = double(i) * 0.5;
+            stream.write(reinterpret_cast<char const*>(&value),
+                         sizeof(value));
+        }
+        return file;
+    }();
+    return path;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief YAML blackboard holding the COUNT doubles inline.
+// ----------------------------------------------------------------------------
+YAML::Node inlineDocument()
+{
+    std::string text = "values: [";
+    for (size_t i = 0u; i < COUNT; ++i)
+    {
+        text += std::to_string(double(i) * 0.5) + ", ";
+    }
+    text += "0.0]";
+    return YAML::Load(text);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief YAML blackboard referring to the binary file of the COUNT doubles.
+// ----------------------------------------------------------------------------
+YAML::Node mappedDocument()
+{
+    return YAML::Load("values: !mmap {file: " + binaryFile().string() +
+                      ", type: double}");
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Loading the blackboard
+// ============================================================================
+
+static void BM_LoadBulk_Inline(benchmark::State& p_state)
+{
+    YAML::Node const document = inlineDocument();
+    for (auto _ : p_state)
+    {
+        bt::Blackboard bb;
+        bt::BlackboardSerializer::load(bb, document);
+        benchmark::DoNotOptimize(bb.lookup("values"));
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(COUNT));
+}
+BENCHMARK(BM_LoadBulk_Inline)->Unit(benchmark::kMillisecond);
+
+static void BM_LoadBulk_Mapped(benchmark::State& p_state)
+{
+    YAML::Node const document = mappedDocument();
+    // Keep the file mapped, as another tree of the process would
+    bt::Blackboard first;
+    bt::BlackboardSerializer::load(first, document);
+    for (auto _ : p_state)
+    {
+        bt::Blackboard bb;
+        bt::BlackboardSerializer::load(bb, document);
+        benchmark::DoNotOptimize(bb.lookup("values"));
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(COUNT));
+}
+BENCHMARK(BM_LoadBulk_Mapped)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Reading the values from a node: get<T>() then sum
+// ============================================================================
+
+static void BM_SumBulk_Vector(benchmark::State& p_state)
+{
+    bt::Blackboard bb;
+    bt::BlackboardSerializer::load(bb, inlineDocument());
+    for (auto _ : p_state)
+    {
+        auto values = bb.get<std::vector<double>>("values");
+        double sum = 0.0;
+        for (double value : *values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(COUNT));
+}
+BENCHMARK(BM_SumBulk_Vector);
+
+static void BM_SumBulk_Mapped(benchmark::State& p_state)
+{
+    bt::Blackboard bb;
+    bt::BlackboardSerializer::load(bb, mappedDocument());
+    for (auto _ : p_state)
+    {
+        auto values = bb.get<bt::MappedArray<double>>("values");
+        double sum = 0.0;
+        for (double value : *values)
+        {
+            sum += value;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(COUNT));
+}
+BENCHMARK(BM_SumBulk_Mapped);
@@ -0,0 +1,150 @@
+/**
+ * @file BenchRecord.cpp
+ * @brief Micro-benchmarks of structured blackboard values: reading a nested
+ * field and processing all the numeric fields, stored as nested
+ * std::unordered_map<std::string, std::any> versus as a record typed by a
+ * schema.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Record.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Serializer.hpp"
+
+namespace {
+
+using Map = std::unordered_map<std::string, std::any>;
+
+//! \brief Number of joints of the robot.
+constexpr size_t JOINTS = 16u;
+
+// ----------------------------------------------------------------------------
+//! \brief YAML blackboard of a robot with a pose and JOINTS joint angles,
+//! tagged with the schema Robot.
+// ----------------------------------------------------------------------------
+YAML::Node makeDocument()
+{
+    std::string text = "robot: !Robot\n  name: R2\n  battery: 80\n"
+                       "  pose: {x: 1.0, y: 2.0, theta: 0.5}\n  joints:\n";
+    for (size_t i = 0u; i < JOINTS; ++i)
+    {
+        text += "    j" + std::to_string(i) + ": " + std::to_string(i) + ".5\n";
+    }
+    return YAML::Load(text);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Schemas Pose, Joints and Robot matching makeDocument().
+// ----------------------------------------------------------------------------
+bt::RecordSchemas makeSchemas()
+{
+    bt::RecordSchema pose("Pose");
+    pose.add("x", bt::FieldType::Double);
+    pose.add("y", bt::FieldType::Double);
+    pose.add("theta", bt::FieldType::Double);
+    bt::RecordSchema joints("Joints");
+    for (size_t i = 0u; i < JOINTS; ++i)
+    {
+        joints.add("j" + std::to_string(i), bt::FieldType::Double);
+    }
+    bt::RecordSchema robot("Robot");
+    robot.add("name", bt::FieldType::String);
+    robot.add("battery", bt::FieldType::Int);
+    robot.add("pose", pose);
+    robot.add("joints", joints);
+
+    bt::RecordSchemas schemas;
+    schemas.add(std::make_shared<bt::RecordSchema const>(std::move(robot)));
+    return schemas;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Blackboard holding the robot, as a record if p_schemas is given,
+//! else as nested maps.
+// ----------------------------------------------------------------------------
+bt::Blackboard makeBlackboard(bt::RecordSchemas const* p_schemas)
+{
+    bt::Blackboard bb;
+    bt::BlackboardSerializer::load(bb, makeDocument(), nullptr, p_schemas);
+    return bb;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Reading robot.pose.x
+// ============================================================================
+
+static void BM_ReadNestedField_Map(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeBlackboard(nullptr);
+    for (auto _ : p_state)
+    {
+        auto const* robot = std::any_cast<Map>(bb.lookup("robot"));
+        auto const& pose = std::any_cast<Map const&>(robot->at("pose"));
+        benchmark::DoNotOptimize(std::any_cast<double>(pose.at("x")));
+    }
+}
+BENCHMARK(BM_ReadNestedField_Map);
+
+static void BM_ReadNestedField_Record(benchmark::State& p_state)
+{
+    bt::RecordSchemas schemas = makeSchemas();
+    bt::Blackboard bb = makeBlackboard(&schemas);
+    static bt::BlackboardKey const key("robot");
+    auto const x = *schemas.find("Robot")->field<double>("pose.x");
+    for (auto _ : p_state)
+    {
+        auto const* robot = std::any_cast<bt::Record>(bb.lookup(key));
+        benchmark::DoNotOptimize(robot->get(x));
+    }
+}
+BENCHMARK(BM_ReadNestedField_Record);
+
+// ============================================================================
+// Sum of the joint angles
+// ============================================================================
+
+static void BM_SumJoints_Map(benchmark::State& p_state)
+{
+    bt::Blackboard bb = makeBlackboard(nullptr);
+    for (auto _ : p_state)
+    {
+        auto const* robot = std::any_cast<Map>(bb.lookup("robot"));
+        auto const& joints = std::any_cast<Map const&>(robot->at("joints"));
+        double sum = 0.0;
+        for (auto const& [name, angle] : joints)
+        {
+            sum += std::any_cast<double>(angle);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(JOINTS));
+}
+BENCHMARK(BM_SumJoints_Map);
+
+static void BM_SumJoints_Record(benchmark::State& p_state)
+{
+    bt::RecordSchemas schemas = makeSchemas();
+    bt::Blackboard bb = makeBlackboard(&schemas);
+    static bt::BlackboardKey const key("robot");
+    size_t const first =
+        schemas.find("Robot")->find("joints.j0")->offset / sizeof(double);
+    for (auto _ : p_state)
+    {
+        auto const* robot = std::any_cast<bt::Record>(bb.lookup(key));
+        double const* angles = robot->reals() + first;
+        double sum = 0.0;
+        for (size_t i = 0u; i < JOINTS; ++i)
+        {
+            sum += angles[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * int64_t(JOINTS));
+}
+BENCHMARK(BM_SumJoints_Record);
@@ -0,0 +1,93 @@
+/**
+ * @file BenchSerializer.cpp
+ * @brief Micro-benchmarks of the loading of large YAML blackboards: type
+ * inference of string, integer, real and boolean scalars.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Serializer.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Blackboard/Serializer.hpp"
+
+#include <functional>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief YAML map of p_count entries "key<i>: <value of i>", parsed once
+//! outside of the measured loop (from text: inserting in a YAML::Node map is
+//! linear).
+// ----------------------------------------------------------------------------
+YAML::Node makeDocument(size_t p_count,
+                        std::function<std::string(size_t)> const& p_value)
+{
+    std::string text;
+    for (size_t i = 0u; i < p_count; ++i)
+    {
+        text += "key" + std::to_string(i) + ": " + p_value(i) + "\n";
+    }
+    return YAML::Load(text);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Measure the loading of the document into an empty blackboard.
+// ----------------------------------------------------------------------------
+void load(benchmark::State& p_state, YAML::Node const& p_document)
+{
+    for (auto _ : p_state)
+    {
+        bt::Blackboard bb;
+        bt::BlackboardSerializer::load(bb, p_document);
+        benchmark::DoNotOptimize(bb);
+    }
+    p_state.SetItemsProcessed(p_state.iterations() *
+                              int64_t(p_document.size()));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Blackboard of strings (the worst case of the type inference: every integer,
+// real and boolean conversion is tried and refused)
+// ============================================================================
+
+static void BM_LoadStrings(benchmark::State& p_state)
+{
+    load(p_state,
+         makeDocument(size_t(p_state.range(0)),
+                      [](size_t i) { return "wp_" + std::to_string(i); }));
+}
+BENCHMARK(BM_LoadStrings)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Blackboard of integers, reals and booleans
+// ============================================================================
+
+static void BM_LoadNumbers(benchmark::State& p_state)
+{
+    load(p_state,
+         makeDocument(size_t(p_state.range(0)),
+                      [](size_t i)
+                      {
+                          switch (i % 3u)
+                          {
+                              case 0u:
+                                  return std::to_string(i);
+                              case 1u:
+                                  return std::to_string(i) + ".5";
+                              default:
+                                  return std::string(i % 2u ? "true" : "no");
+                          }
+                      }));
+}
+BENCHMARK(BM_LoadNumbers)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,124 @@
+/**
+ * @file BenchSubTreeLibrary.cpp
+ * @brief Macro-benchmark of the startup of many trees sharing a library of
+ * subtrees: copied in the 'SubTrees' section of each tree, or included from
+ * a library file parsed once.
+ *
+ * Corresponds to src/BlackThorn/Builder/Builder.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+//! \brief Number of subtrees of the shared library.
+constexpr size_t LIBRARY_SIZE = 150u;
+
+// ----------------------------------------------------------------------------
+//! \brief 'SubTrees' section of p_size subtrees of a few nodes each.
+// ----------------------------------------------------------------------------
+std::string makeLibrary(size_t p_size)
+{
+    std::string yaml = "SubTrees:\n";
+    for (size_t i = 0; i < p_size; ++i)
+    {
+        yaml += "  Skill" + std::to_string(i) +
+                ":\n"
+                "    Sequence:\n"
+                "      children:\n"
+                "        - Success: {}\n"
+                "        - Inverter:\n"
+                "            child:\n"
+                "              - Failure: {}\n"
+                "        - Success: {}\n";
+    }
+    return yaml;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tree using three subtrees of the library.
+// ----------------------------------------------------------------------------
+std::string makeTree()
+{
+    return "BehaviorTree:\n"
+           "  Sequence:\n"
+           "    children:\n"
+           "      - SubTree:\n"
+           "          reference: Skill0\n"
+           "      - SubTree:\n"
+           "          reference: Skill75\n"
+           "      - SubTree:\n"
+           "          reference: Skill149\n";
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Build p_state.range(0) trees per iteration, from files holding
+//! their own copy of the library or including the shared library file.
+// ----------------------------------------------------------------------------
+void startup(benchmark::State& p_state, bool p_include)
+{
+    auto directory =
+        std::filesystem::temp_directory_path() / "blackthorn_library_bench";
+    std::filesystem::create_directories(directory);
+    auto library = directory / "library.yaml";
+    auto tree = directory / (p_include ? "included.yaml" : "inline.yaml");
+    std::ofstream(library) << makeLibrary(LIBRARY_SIZE);
+    if (p_include)
+    {
+        std::ofstream(tree) << "include: library.yaml\n" << makeTree();
+    }
+    else
+    {
+        std::ofstream(tree) << makeTree() << makeLibrary(LIBRARY_SIZE);
+    }
+
+    bt::NodeFactory factory;
+    bt::Builder::clearLibraryCache();
+    for (auto _ : p_state)
+    {
+        for (int64_t i = 0; i < p_state.range(0); ++i)
+        {
+            auto result = bt::Builder::fromFile(factory, tree.string());
+            if (!result)
+            {
+                p_state.SkipWithError(result.getError().c_str());
+                return;
+            }
+            benchmark::DoNotOptimize(result);
+        }
+    }
+    p_state.counters["trees/s"] = benchmark::Counter(
+        double(p_state.iterations() * p_state.range(0)),
+        benchmark::Counter::kIsRate);
+    std::filesystem::remove_all(directory);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Each tree carries its own copy of the library
+// ============================================================================
+
+static void BM_StartupInlineSubTrees(benchmark::State& p_state)
+{
+    startup(p_state, false);
+}
+BENCHMARK(BM_StartupInlineSubTrees)->Arg(40)->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Each tree includes the library, parsed once
+// ============================================================================
+
+static void BM_StartupIncludedSubTrees(benchmark::State& p_state)
+{
+    startup(p_state, true);
+}
+BENCHMARK(BM_StartupIncludedSubTrees)->Arg(40)->Unit(benchmark::kMillisecond);
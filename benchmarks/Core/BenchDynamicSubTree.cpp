@@ -0,0 +1,95 @@
+/**
+ * @file BenchDynamicSubTree.cpp
+ * @brief Micro-benchmarks of the DynamicSubTree: ticking its content, and
+ * ticking it while another thread keeps building and posting new contents.
+ *
+ * Corresponds to src/BlackThorn/Core/Tree.hpp and
+ * src/BlackThorn/Builder/FragmentBuilder.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Plan of p_leaves trivial leaves under a sequence.
+// ----------------------------------------------------------------------------
+std::string makePlan(size_t p_leaves)
+{
+    std::string yaml = "BehaviorTree:\n  Sequence:\n    children:\n";
+    for (size_t i = 0; i < p_leaves; ++i)
+    {
+        yaml += "      - Success: {}\n";
+    }
+    return yaml;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tick a tree holding a DynamicSubTree, optionally while another
+//! thread keeps posting new plans.
+// ----------------------------------------------------------------------------
+void tick(benchmark::State& p_state, bool p_swapping)
+{
+    bt::NodeFactory factory;
+    bt::FragmentBuilder fragments(factory, 0u);
+    std::string const plan = makePlan(size_t(p_state.range(0)));
+
+    bt::Tree tree;
+    tree.setBlackboard(std::make_shared<bt::Blackboard>());
+    auto& dynamic = tree.createRoot<bt::DynamicSubTree>(
+        fragments.instantiate(plan, tree.blackboard()).moveValue());
+    dynamic.setBlackboard(tree.blackboard());
+
+    std::atomic<bool> stop{false};
+    std::thread planner;
+    if (p_swapping)
+    {
+        planner = std::thread([&]() {
+            while (!stop.load())
+            {
+                (void)fragments.build(dynamic, plan).get();
+            }
+        });
+    }
+
+    for (auto _ : p_state)
+    {
+        benchmark::DoNotOptimize(tree.tick());
+    }
+    p_state.counters["swaps"] = double(dynamic.swaps());
+    stop = true;
+    if (planner.joinable())
+    {
+        planner.join();
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Ticking a stable content
+// ============================================================================
+
+static void BM_DynamicSubTreeStable(benchmark::State& p_state)
+{
+    tick(p_state, false);
+}
+BENCHMARK(BM_DynamicSubTreeStable)->RangeMultiplier(8)->Range(8, 512);
+
+// ============================================================================
+// Ticking while new contents are built and posted by another thread
+// ============================================================================
+
+static void BM_DynamicSubTreeSwapping(benchmark::State& p_state)
+{
+    tick(p_state, true);
+}
+BENCHMARK(BM_DynamicSubTreeSwapping)->RangeMultiplier(8)->Range(8, 512);
@@ -0,0 +1,95 @@
+/**
+ * @file BenchFork.cpp
+ * @brief Micro-benchmarks of Tree::fork(): cost of cloning the nodes and of
+ * the copy-on-write blackboard with a large value.
+ *
+ * Corresponds to src/BlackThorn/Core/Tree.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <vector>
+
+namespace {
+
+using Samples = std::vector<double>;
+
+// ----------------------------------------------------------------------------
+//! \brief Tree of p_leaves SetBlackboard leaves under a sequence, sharing a
+//! blackboard holding a vector of p_samples samples. The tree is ticked once
+//! so that the last leaf is RUNNING behind a Wait.
+// ----------------------------------------------------------------------------
+bt::Tree makeTree(size_t p_leaves, size_t p_samples)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->emplace<Samples>("samples", p_samples, 1.0);
+
+    bt::Tree tree;
+    tree.setBlackboard(bb);
+    auto& seq = tree.createRoot<bt::Sequence>();
+    for (size_t i = 0; i < p_leaves; ++i)
+    {
+        seq.addChild(bt::Node::create<bt::SetBlackboard>(
+            "key" + std::to_string(i), "${key0} + 1", bb));
+    }
+    seq.addChild(bt::Node::create<bt::Wait>(1000));
+    bb->set("key0", 0);
+    (void)tree.tick();
+    return tree;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Forking a running tree
+// ============================================================================
+
+static void BM_Fork(benchmark::State& p_state)
+{
+    bt::Tree tree = makeTree(size_t(p_state.range(0)), 1 << 16);
+    for (auto _ : p_state)
+    {
+        auto fork = tree.fork();
+        benchmark::DoNotOptimize(fork);
+    }
+}
+BENCHMARK(BM_Fork)->RangeMultiplier(4)->Range(4, 256);
+
+// ============================================================================
+// Forking, then writing the large value (copied once by the fork)
+// ============================================================================
+
+static void BM_ForkAndModify(benchmark::State& p_state)
+{
+    bt::Tree tree = makeTree(16, size_t(p_state.range(0)));
+    for (auto _ : p_state)
+    {
+        auto fork = tree.fork();
+        fork->blackboard()->modify<Samples>(
+            "samples", [](Samples& p_samples) { p_samples[0] += 1.0; });
+        benchmark::DoNotOptimize(fork);
+    }
+}
+BENCHMARK(BM_ForkAndModify)->RangeMultiplier(16)->Range(16, 1 << 16);
+
+// ============================================================================
+// Forking, then running the fork to completion with a simulated clock
+// ============================================================================
+
+static void BM_ForkRollout(benchmark::State& p_state)
+{
+    bt::Tree tree = makeTree(size_t(p_state.range(0)), 16);
+    for (auto _ : p_state)
+    {
+        auto clock = std::make_shared<bt::ManualClock>();
+        auto fork = tree.fork(clock);
+        clock->advance(std::chrono::seconds(1));
+        benchmark::DoNotOptimize(fork->tick());
+    }
+}
+BENCHMARK(BM_ForkRollout)->RangeMultiplier(4)->Range(4, 256);
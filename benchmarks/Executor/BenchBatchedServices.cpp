@@ -0,0 +1,127 @@
+/**
+ * @file BenchBatchedServices.cpp
+ * @brief Macro-benchmark of a service called by the action leaves of many
+ * agent trees: throughput of one call per request versus one call per batch
+ * of the requests of a tick. The service has a fixed cost per call (request
+ * setup, round trip) and a smaller cost per request.
+ *
+ * Corresponds to src/BlackThorn/Executor/BatchedServices.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <chrono>
+
+namespace {
+
+//! \brief Fixed cost of a call of the service.
+constexpr auto CALL_COST = std::chrono::microseconds(5);
+//! \brief Cost of each request of a call.
+constexpr auto REQUEST_COST = std::chrono::nanoseconds(200);
+
+// ----------------------------------------------------------------------------
+//! \brief Keep the calling thread busy for p_duration.
+// ----------------------------------------------------------------------------
+void busy(std::chrono::nanoseconds p_duration)
+{
+    auto const end = std::chrono::steady_clock::now() + p_duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Service doubling integer requests.
+// ----------------------------------------------------------------------------
+void service(bt::BatchedServices::Requests const& p_requests,
+             bt::BatchedServices::Responses& p_responses)
+{
+    busy(CALL_COST + REQUEST_COST * p_requests.size());
+    for (size_t i = 0u; i < p_requests.size(); ++i)
+    {
+        p_responses[i] = 2 * std::any_cast<int>(p_requests[i]);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Agent tree calling the service with its blackboard entry "x".
+// ----------------------------------------------------------------------------
+struct Agent
+{
+    Agent(bt::BatchedServices::Ptr const& p_services, int p_x)
+        : blackboard(std::make_shared<bt::Blackboard>())
+    {
+        blackboard->set("x", p_x);
+        auto leaf = bt::Node::create<bt::BatchedServiceCall>(
+            p_services, "service", "x", "y");
+        leaf->setBlackboard(blackboard);
+        tree.setRoot(std::move(leaf));
+        tree.setBlackboard(blackboard);
+    }
+
+    bt::Blackboard::Ptr blackboard;
+    bt::Tree tree;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Tick p_state.range(0) agents until each one got one response per
+//! iteration, the service serving at most p_batch requests per call.
+// ----------------------------------------------------------------------------
+void run(benchmark::State& p_state, size_t p_batch)
+{
+    auto const count = size_t(p_state.range(0));
+    bt::Executor executor;
+    bt::BatchedServices::Limits limits;
+    limits.maxBatch = p_batch;
+    executor.services()->add("service", service, limits);
+
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (size_t i = 0u; i < count; ++i)
+    {
+        agents.push_back(
+            std::make_unique<Agent>(executor.services(), int(i)));
+        executor.add(agents.back()->tree);
+    }
+
+    for (auto _ : p_state)
+    {
+        // Unbatched calls complete in the tick sending them, batched calls
+        // at the next tick
+        while (executor.tick()[0] == bt::Status::RUNNING)
+        {
+        }
+    }
+
+    auto stats = executor.services()->statistics("service");
+    p_state.SetItemsProcessed(int64_t(stats.requests));
+    p_state.counters["batch"] = stats.averageBatch();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// One call per request versus one call per tick
+// ============================================================================
+
+static void BM_ServiceCalls_Unbatched(benchmark::State& p_state)
+{
+    run(p_state, 1u);
+}
+BENCHMARK(BM_ServiceCalls_Unbatched)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_ServiceCalls_Batched(benchmark::State& p_state)
+{
+    run(p_state, 0u);
+}
+BENCHMARK(BM_ServiceCalls_Batched)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::kMillisecond);
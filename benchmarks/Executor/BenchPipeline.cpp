@@ -0,0 +1,131 @@
+/**
+ * @file BenchPipeline.cpp
+ * @brief Macro-benchmark of the sense-think-act Pipeline: throughput and
+ * end-to-end latency of sequential (depth 1) versus overlapped (depth 3)
+ * stages, each stage lasting the same duration. Sensing and acting wait for
+ * I/O (sleep), thinking keeps the CPU busy.
+ *
+ * Corresponds to src/BlackThorn/Executor/Pipeline.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Keep the calling thread busy for p_duration.
+// ----------------------------------------------------------------------------
+void busy(std::chrono::microseconds p_duration)
+{
+    auto const end = std::chrono::steady_clock::now() + p_duration;
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Leaf standing for the decision making of the tree.
+// ----------------------------------------------------------------------------
+class Think final: public bt::Action
+{
+public:
+
+    explicit Think(std::chrono::microseconds p_duration)
+        : m_duration(p_duration)
+    {
+    }
+
+    [[nodiscard]] bt::Status onRunning() override
+    {
+        busy(m_duration);
+        return bt::Status::SUCCESS;
+    }
+
+    [[nodiscard]] bt::Node::Ptr clone() const override
+    {
+        return std::make_unique<Think>(*this);
+    }
+
+private:
+
+    std::chrono::microseconds m_duration;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Run p_state.range(0) pipelined ticks per iteration, each stage
+//! lasting p_state.range(1) microseconds.
+// ----------------------------------------------------------------------------
+void run(benchmark::State& p_state, size_t p_depth)
+{
+    auto const ticks = uint64_t(p_state.range(0));
+    auto const stage = std::chrono::microseconds(p_state.range(1));
+
+    bt::Tree tree;
+    tree.setBlackboard(std::make_shared<bt::Blackboard>());
+    (void)tree.createRoot<Think>(stage);
+
+    bt::Pipeline::Config config;
+    config.depth = p_depth;
+    bt::Pipeline pipeline(
+        tree,
+        [&](bt::Blackboard& p_inputs) {
+            std::this_thread::sleep_for(stage);
+            p_inputs.set("pose", 1.0);
+        },
+        [&](bt::Blackboard const&, bt::Status) {
+            std::this_thread::sleep_for(stage);
+        },
+        config);
+
+    bt::Pipeline::Duration latency = bt::Pipeline::Duration::zero();
+    bt::Pipeline::Duration worst = bt::Pipeline::Duration::zero();
+    for (auto _ : p_state)
+    {
+        pipeline.start(ticks);
+        pipeline.wait();
+        latency += pipeline.statistics().meanLatency();
+        worst = std::max(worst, pipeline.statistics().maxLatency);
+    }
+    p_state.SetItemsProcessed(int64_t(p_state.iterations() * ticks));
+    p_state.counters["latency_us"] =
+        double(latency.count()) / double(p_state.iterations()) / 1e3;
+    p_state.counters["max_latency_us"] = double(worst.count()) / 1e3;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Sequential stages: lowest latency
+// ============================================================================
+
+static void BM_PipelineDepth1(benchmark::State& p_state)
+{
+    run(p_state, 1u);
+}
+BENCHMARK(BM_PipelineDepth1)
+    ->Args({200, 50})
+    ->Args({200, 200})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// ============================================================================
+// Overlapped stages: highest throughput
+// ============================================================================
+
+static void BM_PipelineDepth3(benchmark::State& p_state)
+{
+    run(p_state, 3u);
+}
+BENCHMARK(BM_PipelineDepth3)
+    ->Args({200, 50})
+    ->Args({200, 200})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,123 @@
+/**
+ * @file BenchSharding.cpp
+ * @brief Macro-benchmark of the live migration of a running agent between
+ * worker processes: pause of the agent (export on its worker, transfer,
+ * import on the other worker) versus the size of its blackboard, compared
+ * with the same export and import between two workers of this process.
+ *
+ * Corresponds to src/BlackThorn/Executor/Sharding.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <chrono>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Agent waiting in a repeater, with p_entries blackboard entries.
+// ----------------------------------------------------------------------------
+std::string agentDocument(size_t p_entries)
+{
+    std::string document = "Blackboard:\n";
+    for (size_t i = 0u; i < p_entries; ++i)
+    {
+        document += "  entry_" + std::to_string(i) + ": " +
+                    std::to_string(i) + "\n";
+    }
+    document += R"(BehaviorTree:
+  Sequence:
+    children:
+      - SetBlackboard:
+          key: entry_0
+          value: ${entry_0} + 1
+      - Repeat:
+          times: 1000
+          child:
+            - Wait:
+                milliseconds: 1000
+)";
+    return document;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Migration between two worker processes
+// ============================================================================
+
+static void BM_Migration_Processes(benchmark::State& p_state)
+{
+    bt::NodeFactory factory;
+    bt::Shards shards;
+    if (!shards.spawnLocal(factory) || !shards.spawnLocal(factory) ||
+        !shards.add("agent", agentDocument(size_t(p_state.range(0)))) ||
+        !shards.tick())
+    {
+        p_state.SkipWithError("Cannot start the workers");
+        return;
+    }
+
+    for (auto _ : p_state)
+    {
+        auto worker = 1u - *shards.location("agent");
+        if (!shards.migrate("agent", worker))
+        {
+            p_state.SkipWithError("Migration failed");
+            return;
+        }
+    }
+
+    auto const& statistics = shards.statistics();
+    p_state.counters["pause_us"] =
+        double(statistics.averagePause().count()) / 1000.0;
+    p_state.counters["max_pause_us"] =
+        double(statistics.max_pause.count()) / 1000.0;
+    p_state.counters["bytes"] =
+        double(statistics.bytes) / double(statistics.migrations);
+}
+BENCHMARK(BM_Migration_Processes)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// ============================================================================
+// Same export and import without leaving this process
+// ============================================================================
+
+static void BM_Migration_InProcess(benchmark::State& p_state)
+{
+    bt::NodeFactory factory;
+    bt::ShardWorker workers[2] = {bt::ShardWorker(factory),
+                                  bt::ShardWorker(factory)};
+    if (!workers[0].spawn("agent", agentDocument(size_t(p_state.range(0)))))
+    {
+        p_state.SkipWithError("Cannot spawn the agent");
+        return;
+    }
+    (void)workers[0].tick();
+
+    size_t source = 0u;
+    for (auto _ : p_state)
+    {
+        auto snapshot = workers[source].exportAgent("agent");
+        if (!snapshot || !workers[1u - source].importAgent(
+                             snapshot.getValue()))
+        {
+            p_state.SkipWithError("Migration failed");
+            return;
+        }
+        source = 1u - source;
+    }
+}
+BENCHMARK(BM_Migration_InProcess)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
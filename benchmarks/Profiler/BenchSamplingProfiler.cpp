@@ -0,0 +1,86 @@
+/**
+ * @file BenchSamplingProfiler.cpp
+ * @brief Micro-benchmarks of the overhead of the sampling profiler on
+ * Tree::tick(): untracked tree, tracked tree, tracked and sampled at 1 kHz.
+ *
+ * Corresponds to src/BlackThorn/Profiler/SamplingProfiler.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Tree of p_leaves trivial actions under a sequence: the worst case
+//! for the profiler since each node does almost nothing but being ticked.
+// ----------------------------------------------------------------------------
+void buildTree(bt::Tree& p_tree, size_t p_leaves)
+{
+    auto& seq = p_tree.createRoot<bt::Sequence>();
+    for (size_t i = 0; i < p_leaves; ++i)
+    {
+        seq.addChild(bt::Node::create<bt::SugarAction>(
+            []() { return bt::Status::SUCCESS; }));
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tick the tree, optionally attached to a profiler.
+// ----------------------------------------------------------------------------
+void tick(benchmark::State& p_state, bool p_attach, bool p_sample)
+{
+    bt::Tree tree;
+    buildTree(tree, size_t(p_state.range(0)));
+    bt::SamplingProfiler profiler(std::chrono::milliseconds(1));
+    if (p_attach)
+    {
+        profiler.attach(tree);
+    }
+    if (p_sample)
+    {
+        profiler.start();
+    }
+
+    for (auto _ : p_state)
+    {
+        benchmark::DoNotOptimize(tree.tick());
+    }
+    p_state.SetItemsProcessed(p_state.iterations() * p_state.range(0));
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Ticking without profiler
+// ============================================================================
+
+static void BM_TickUntracked(benchmark::State& p_state)
+{
+    tick(p_state, false, false);
+}
+BENCHMARK(BM_TickUntracked)->RangeMultiplier(8)->Range(8, 512);
+
+// ============================================================================
+// Ticking with the tick marker, without sampling
+// ============================================================================
+
+static void BM_TickTracked(benchmark::State& p_state)
+{
+    tick(p_state, true, false);
+}
+BENCHMARK(BM_TickTracked)->RangeMultiplier(8)->Range(8, 512);
+
+// ============================================================================
+// Ticking while the profiler samples at 1 kHz
+// ============================================================================
+
+static void BM_TickSampled(benchmark::State& p_state)
+{
+    tick(p_state, true, true);
+}
+BENCHMARK(BM_TickSampled)->RangeMultiplier(8)->Range(8, 512);
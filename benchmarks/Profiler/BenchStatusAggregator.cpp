@@ -0,0 +1,120 @@
+/**
+ * @file BenchStatusAggregator.cpp
+ * @brief Micro-benchmarks of the status aggregator: cost of a report whether
+ * the statuses changed or not, and cost of reading the distribution sent to
+ * Oakular, for crowds of instances of the same tree.
+ *
+ * Corresponds to src/BlackThorn/Profiler/StatusAggregator.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+//! \brief Number of leaves of the tree of each instance.
+constexpr size_t LEAVES = 32u;
+
+// ----------------------------------------------------------------------------
+//! \brief Instance of a tree of LEAVES actions under a sequence, the last one
+//! returning the status chosen by the benchmark.
+// ----------------------------------------------------------------------------
+struct Agent
+{
+    Agent()
+    {
+        auto& seq = tree.createRoot<bt::Sequence>();
+        seq.setId(1u);
+        for (size_t i = 0u; i < LEAVES; ++i)
+        {
+            auto action = bt::Node::create<bt::SugarAction>(
+                [this, last = (i + 1u == LEAVES)]()
+                { return last ? status : bt::Status::SUCCESS; });
+            action->setId(uint32_t(i + 2u));
+            seq.addChild(std::move(action));
+        }
+    }
+
+    bt::Tree tree;
+    bt::Status status = bt::Status::RUNNING;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Report the given number of ticked instances.
+// ----------------------------------------------------------------------------
+void reportAll(bt::StatusAggregator& p_aggregator, std::vector<Agent>& p_agents)
+{
+    for (size_t i = 0u; i < p_agents.size(); ++i)
+    {
+        (void)p_agents[i].tree.tick();
+        p_aggregator.report(uint32_t(i), p_agents[i].tree);
+    }
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// Report of an instance whose statuses did not change
+// ============================================================================
+
+static void BM_ReportUnchanged(benchmark::State& p_state)
+{
+    std::vector<Agent> agents(size_t(p_state.range(0)));
+    bt::StatusAggregator aggregator;
+    reportAll(aggregator, agents);
+
+    size_t i = 0u;
+    for (auto _ : p_state)
+    {
+        aggregator.report(uint32_t(i), agents[i].tree);
+        i = (i + 1u) % agents.size();
+    }
+    p_state.SetItemsProcessed(p_state.iterations());
+}
+BENCHMARK(BM_ReportUnchanged)->RangeMultiplier(8)->Range(8, 4096);
+
+// ============================================================================
+// Report of an instance whose last leaf alternates SUCCESS and FAILURE
+// ============================================================================
+
+static void BM_ReportChanged(benchmark::State& p_state)
+{
+    std::vector<Agent> agents(size_t(p_state.range(0)));
+    bt::StatusAggregator aggregator;
+    reportAll(aggregator, agents);
+
+    size_t i = 0u;
+    for (auto _ : p_state)
+    {
+        Agent& agent = agents[i];
+        agent.status = (agent.status == bt::Status::SUCCESS)
+                           ? bt::Status::FAILURE
+                           : bt::Status::SUCCESS;
+        (void)agent.tree.tick();
+        aggregator.report(uint32_t(i), agent.tree);
+        i = (i + 1u) % agents.size();
+    }
+    p_state.SetItemsProcessed(p_state.iterations());
+}
+BENCHMARK(BM_ReportChanged)->RangeMultiplier(8)->Range(8, 4096);
+
+// ============================================================================
+// Distribution read at display rate, whatever the number of instances
+// ============================================================================
+
+static void BM_Distribution(benchmark::State& p_state)
+{
+    std::vector<Agent> agents(size_t(p_state.range(0)));
+    bt::StatusAggregator aggregator;
+    reportAll(aggregator, agents);
+
+    for (auto _ : p_state)
+    {
+        benchmark::DoNotOptimize(aggregator.distribution());
+    }
+}
+BENCHMARK(BM_Distribution)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,12 @@
+/**
+ * @file main.cpp
+ * @brief Main entry point for micro-benchmarks - Runs all registered
+ * benchmarks. Use --benchmark_filter=<regex> to select some of them.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+BENCHMARK_MAIN();
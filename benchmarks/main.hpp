@@ -0,0 +1,13 @@
+/**
+ * @file main.hpp
+ * @brief Main header for micro-benchmarks - Includes the Google Benchmark
+ * framework.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+// Google Benchmark framework
+#include <benchmark/benchmark.h>
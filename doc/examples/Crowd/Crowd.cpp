@@ -0,0 +1,456 @@
+/**
+ * @file Crowd.cpp
+ * @brief Crowd of agents ticked at scale, doubling as a macro benchmark.
+ *
+ * This example demonstrates:
+ * - Building an agent tree once from YAML, then instantiating it for each
+ *   agent with Tree::fork() (copy-on-write blackboards)
+ * - Sharing a per-frame computation (the enemy position) between all agents
+ * - Simulated time with a ManualClock driving the temporal nodes
+ * - Ticking the agents on several threads
+ *
+ * It reports the agents ticked per second, the tail latency of an agent tick
+ * and of a frame, and the memory per agent. Optionally, the first agent is
+ * streamed to Oakular.
+ *
+ * Usage: Example-Crowd [agents=10000] [frames=200] [threads=1] [--visualize]
+ */
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace bt::examples {
+
+//! \brief Simulated duration of a frame.
+static constexpr double FRAME_SECONDS = 0.05;
+
+//! \brief Position of the roaming enemy, shared by all the agents.
+struct Point
+{
+    double x = 0.0;
+    double y = 0.0;
+};
+
+// ****************************************************************************
+//! \brief Walk toward the current waypoint (a square around home). RUNNING
+//! until the waypoint is reached. Each step makes the agent more tired.
+// ****************************************************************************
+class MoveToWaypoint final: public Action
+{
+public:
+
+    [[nodiscard]] Status onRunning() override
+    {
+        static constexpr std::array<Point, 4> square = {
+            Point{-5.0, -5.0}, Point{5.0, -5.0}, Point{5.0, 5.0},
+            Point{-5.0, 5.0}};
+
+        Blackboard& bb = *m_blackboard;
+        Point const& offset = square[size_t(bb.getOrDefault<int>("waypoint")) %
+                                     square.size()];
+        double target_x = bb.getOrDefault<double>("home_x") + offset.x;
+        double target_y = bb.getOrDefault<double>("home_y") + offset.y;
+        double x = bb.getOrDefault<double>("x");
+        double y = bb.getOrDefault<double>("y");
+        double step = getInput<double>("speed").value_or(1.0) * FRAME_SECONDS;
+
+        bb.modify<int>("fatigue", [](int& p_fatigue) { ++p_fatigue; });
+        double dx = target_x - x;
+        double dy = target_y - y;
+        double distance = std::hypot(dx, dy);
+        if (distance <= step)
+        {
+            bb.set("x", target_x);
+            bb.set("y", target_y);
+            return Status::SUCCESS;
+        }
+        bb.set("x", x + dx * step / distance);
+        bb.set("y", y + dy * step / distance);
+        return Status::RUNNING;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<MoveToWaypoint>(*this);
+    }
+};
+
+// ****************************************************************************
+//! \brief Succeed when the fatigue reaches the threshold.
+// ****************************************************************************
+class IsTired final: public Action
+{
+public:
+
+    [[nodiscard]] Status onRunning() override
+    {
+        int threshold = getInput<int>("threshold").value_or(100);
+        return (m_blackboard->getOrDefault<int>("fatigue") >= threshold)
+                   ? Status::SUCCESS
+                   : Status::FAILURE;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<IsTired>(*this);
+    }
+};
+
+// ****************************************************************************
+//! \brief Succeed when the enemy is within the radius.
+// ****************************************************************************
+class IsEnemyNear final: public Action
+{
+public:
+
+    [[nodiscard]] Status onRunning() override
+    {
+        auto enemy = m_blackboard->get<Point>("enemy");
+        if (!enemy)
+        {
+            return Status::FAILURE;
+        }
+        double radius = getInput<double>("radius").value_or(1.0);
+        double dx = enemy->x - m_blackboard->getOrDefault<double>("x");
+        double dy = enemy->y - m_blackboard->getOrDefault<double>("y");
+        return (dx * dx + dy * dy <= radius * radius) ? Status::SUCCESS
+                                                      : Status::FAILURE;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<IsEnemyNear>(*this);
+    }
+};
+
+// ****************************************************************************
+//! \brief Shoot at the enemy.
+// ****************************************************************************
+class Shoot final: public Action
+{
+public:
+
+    [[nodiscard]] Status onRunning() override
+    {
+        m_blackboard->modify<int>("shots", [](int& p_shots) { ++p_shots; });
+        return Status::SUCCESS;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<Shoot>(*this);
+    }
+};
+
+// ****************************************************************************
+//! \brief Latency histogram with 8 buckets per power of two (12% precision),
+//! cheap enough to record every agent tick.
+// ****************************************************************************
+class LatencyHistogram
+{
+public:
+
+    void record(uint64_t p_ns)
+    {
+        ++m_buckets[bucket(p_ns)];
+        ++m_count;
+        m_max = std::max(m_max, p_ns);
+    }
+
+    void merge(LatencyHistogram const& p_other)
+    {
+        for (size_t i = 0u; i < BUCKETS; ++i)
+        {
+            m_buckets[i] += p_other.m_buckets[i];
+        }
+        m_count += p_other.m_count;
+        m_max = std::max(m_max, p_other.m_max);
+    }
+
+    //! \brief Upper bound of the latency below which p_ratio of the samples
+    //! are.
+    [[nodiscard]] uint64_t percentile(double p_ratio) const
+    {
+        auto rank = uint64_t(std::ceil(p_ratio * double(m_count)));
+        uint64_t seen = 0u;
+        for (size_t i = 0u; i < BUCKETS; ++i)
+        {
+            seen += m_buckets[i];
+            if ((seen >= rank) && (m_buckets[i] > 0u))
+            {
+                return std::min(upperBound(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    [[nodiscard]] uint64_t max() const
+    {
+        return m_max;
+    }
+
+private:
+
+    static constexpr size_t SUB_BITS = 3u;
+    static constexpr size_t BUCKETS = 64u << SUB_BITS;
+
+    static size_t bucket(uint64_t p_ns)
+    {
+        if (p_ns < (1u << SUB_BITS))
+        {
+            return size_t(p_ns);
+        }
+        auto exponent = size_t(63 - __builtin_clzll(p_ns));
+        size_t mantissa = size_t(p_ns >> (exponent - SUB_BITS)) &
+                          ((1u << SUB_BITS) - 1u);
+        return ((exponent - SUB_BITS + 1u) << SUB_BITS) + mantissa;
+    }
+
+    static uint64_t upperBound(size_t p_bucket)
+    {
+        if (p_bucket < (1u << SUB_BITS))
+        {
+            return p_bucket;
+        }
+        size_t exponent = (p_bucket >> SUB_BITS) + SUB_BITS - 1u;
+        uint64_t mantissa = p_bucket & ((1u << SUB_BITS) - 1u);
+        return ((mantissa + 1u + (1u << SUB_BITS)) << (exponent - SUB_BITS)) -
+               1u;
+    }
+
+    std::array<uint64_t, BUCKETS> m_buckets{};
+    uint64_t m_count = 0u;
+    uint64_t m_max = 0u;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Resident memory of the process in bytes (0 when unknown).
+// ----------------------------------------------------------------------------
+static size_t residentMemory()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0u;
+    size_t resident = 0u;
+    if (!(statm >> pages >> resident))
+    {
+        return 0u;
+    }
+    return resident * size_t(sysconf(_SC_PAGESIZE));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tick the agents [p_begin, p_end) once, recording their latencies.
+// ----------------------------------------------------------------------------
+static void tickAgents(std::vector<Tree::Ptr> const& p_agents,
+                       size_t p_begin,
+                       size_t p_end,
+                       LatencyHistogram& p_latencies)
+{
+    using Clock = std::chrono::steady_clock;
+    for (size_t i = p_begin; i < p_end; ++i)
+    {
+        auto start = Clock::now();
+        (void)p_agents[i]->tick();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now() - start);
+        p_latencies.record(uint64_t(ns.count()));
+    }
+}
+
+} // namespace bt::examples
+
+int main(int argc, char* argv[])
+{
+    using namespace bt;
+    using namespace bt::examples;
+    using Clock = std::chrono::steady_clock;
+
+    // Command line
+    size_t agents = 10000u;
+    size_t frames = 200u;
+    size_t threads = 1u;
+    bool visualize = false;
+    std::vector<size_t*> positional = {&agents, &frames, &threads};
+    size_t position = 0u;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--visualize") == 0)
+        {
+            visualize = true;
+        }
+        else if (position < positional.size())
+        {
+            *positional[position++] =
+                size_t(std::strtoul(argv[i], nullptr, 10));
+        }
+    }
+    agents = std::max<size_t>(agents, 1u);
+    threads = std::max<size_t>(threads, 1u);
+
+    // Simulated time and the enemy roaming on a circle, located once per
+    // frame for the whole crowd
+    auto clock = std::make_shared<ManualClock>();
+    auto shared = std::make_shared<SharedComputations>();
+    std::atomic<size_t> frame{0u};
+    shared->add("enemy", [&frame]() {
+        double angle = double(frame.load()) * FRAME_SECONDS * 0.2;
+        return Blackboard::Value(Point{50.0 + 40.0 * std::cos(angle),
+                                       50.0 + 40.0 * std::sin(angle)});
+    });
+
+    // Build the agent tree once
+    auto start = Clock::now();
+    NodeFactory factory;
+    factory.registerNode<MoveToWaypoint>("MoveToWaypoint");
+    factory.registerNode<IsTired>("IsTired");
+    factory.registerNode<IsEnemyNear>("IsEnemyNear");
+    factory.registerNode<Shoot>("Shoot");
+    factory.setSharedComputations(shared);
+
+    auto yamlPath = "doc/examples/Crowd/Crowd.yaml";
+    auto result = Builder::fromFile(factory, yamlPath);
+    if (!result)
+    {
+        std::cerr << "Failed to build tree: " << result.getError() << std::endl;
+        return EXIT_FAILURE;
+    }
+    auto prototype = result.moveValue();
+    prototype->setClock(clock);
+    auto build_time = Clock::now() - start;
+
+    // Instantiate the agents, scattered on a 100 x 100 map
+    size_t memory_before = residentMemory();
+    start = Clock::now();
+    std::mt19937 random(42);
+    std::uniform_real_distribution<double> coordinate(0.0, 100.0);
+    std::uniform_int_distribution<int> fatigue(0, 149);
+    std::vector<Tree::Ptr> crowd;
+    crowd.reserve(agents);
+    for (size_t i = 0u; i < agents; ++i)
+    {
+        auto agent = prototype->fork();
+        if (!agent)
+        {
+            std::cerr << "Failed to fork the agent tree" << std::endl;
+            return EXIT_FAILURE;
+        }
+        Blackboard& bb = *agent->blackboard();
+        double x = coordinate(random);
+        double y = coordinate(random);
+        bb.set("home_x", x);
+        bb.set("home_y", y);
+        bb.set("x", x);
+        bb.set("y", y);
+        bb.set("fatigue", fatigue(random));
+        crowd.push_back(std::move(agent));
+    }
+    auto spawn_time = Clock::now() - start;
+    size_t memory_after = residentMemory();
+
+    // Stream the first agent to Oakular
+    if (visualize)
+    {
+        auto visualizer = std::make_shared<VisualizerClient>();
+        if (visualizer->connect("localhost", 8888))
+        {
+            crowd.front()->setVisualizerClient(visualizer);
+            std::cout << "=== Streaming agent #0 to localhost:8888 ==="
+                      << std::endl;
+        }
+        else
+        {
+            std::cout << "=== Visualizer not available ===" << std::endl;
+        }
+    }
+
+    // Simulation: each frame locates the enemy once, ticks all the agents
+    // then advances the simulated time
+    std::vector<LatencyHistogram> latencies(threads);
+    LatencyHistogram frame_latencies;
+    start = Clock::now();
+    for (size_t f = 0u; f < frames; ++f)
+    {
+        auto frame_start = Clock::now();
+        frame = f;
+        shared->nextTick();
+
+        size_t chunk = (agents + threads - 1u) / threads;
+        std::vector<std::thread> workers;
+        for (size_t t = 1u; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                tickAgents(crowd,
+                           std::min(agents, t * chunk),
+                           std::min(agents, (t + 1u) * chunk),
+                           latencies[t]);
+            });
+        }
+        tickAgents(crowd, 0u, std::min(agents, chunk), latencies[0]);
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        clock->advance(std::chrono::milliseconds(int(FRAME_SECONDS * 1000)));
+        frame_latencies.record(uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - frame_start)
+                .count()));
+    }
+    std::chrono::duration<double> run_time = Clock::now() - start;
+
+    // Report
+    LatencyHistogram tick_latencies;
+    for (auto const& histogram : latencies)
+    {
+        tick_latencies.merge(histogram);
+    }
+    size_t waypoints = 0u;
+    size_t shots = 0u;
+    for (auto const& agent : crowd)
+    {
+        waypoints += size_t(agent->blackboard()->getOrDefault<int>("waypoint"));
+        shots += size_t(agent->blackboard()->getOrDefault<int>("shots"));
+    }
+    auto ms = [](auto p_duration) {
+        return std::chrono::duration<double, std::milli>(p_duration).count();
+    };
+    double ticks = double(agents) * double(frames);
+
+    std::cout << "Crowd: " << agents << " agents, " << frames << " frames, "
+              << threads << " thread(s)\n"
+              << "  build:       " << ms(build_time) << " ms (YAML), "
+              << ms(spawn_time) << " ms (fork of the agents)\n"
+              << "  memory:      "
+              << (memory_after - memory_before) / agents
+              << " bytes per agent (resident)\n"
+              << "  throughput:  " << size_t(ticks / run_time.count())
+              << " agents ticked per second\n"
+              << "  agent tick:  p50 " << tick_latencies.percentile(0.5)
+              << " ns, p99 " << tick_latencies.percentile(0.99)
+              << " ns, p99.9 " << tick_latencies.percentile(0.999)
+              << " ns, max " << tick_latencies.max() << " ns\n"
+              << "  frame:       p50 "
+              << double(frame_latencies.percentile(0.5)) / 1e6 << " ms, p99 "
+              << double(frame_latencies.percentile(0.99)) / 1e6 << " ms, max "
+              << double(frame_latencies.max()) / 1e6 << " ms\n"
+              << "  simulation:  " << waypoints << " waypoints reached, "
+              << shots << " shots fired, enemy located "
+              << shared->statistics("enemy").misses << " times for the crowd"
+              << std::endl;
+
+    return EXIT_SUCCESS;
+}
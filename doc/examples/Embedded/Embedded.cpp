@@ -0,0 +1,177 @@
+/**
+ * @file Embedded.cpp
+ * @brief Example of the embedded profile: a robot mission tree built with
+ * -fno-exceptions -fno-rtti, checking that ticking does not allocate, and
+ * reporting the memory footprint.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Embedded.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// ----------------------------------------------------------------------------
+// Heap accounting: count the allocations made through operator new
+// ----------------------------------------------------------------------------
+static size_t g_allocations = 0;
+static size_t g_bytes = 0;
+
+void* operator new(std::size_t p_size)
+{
+    ++g_allocations;
+    g_bytes += p_size;
+    if (void* ptr = std::malloc(p_size ? p_size : 1u))
+    {
+        return ptr;
+    }
+    std::abort(); // No exceptions: out of memory is fatal
+}
+
+void operator delete(void* p_ptr) noexcept
+{
+    std::free(p_ptr);
+}
+
+void operator delete(void* p_ptr, std::size_t) noexcept
+{
+    std::free(p_ptr);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Count the nodes of a tree without RTTI.
+// ----------------------------------------------------------------------------
+static size_t countNodes(bt::Node& p_node)
+{
+    size_t count = 1u;
+    for (size_t i = 0u; i < p_node.childrenCount(); ++i)
+    {
+        count += countNodes(*p_node.childAt(i));
+    }
+    return count;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Attach the blackboard to all the nodes (their ports read it).
+// ----------------------------------------------------------------------------
+static void setBlackboard(bt::Node& p_node, bt::Blackboard::Ptr const& p_bb)
+{
+    p_node.setBlackboard(p_bb);
+    for (size_t i = 0u; i < p_node.childrenCount(); ++i)
+    {
+        setBlackboard(*p_node.childAt(i), p_bb);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Build the mission: check the battery, avoid obstacles, drive while
+//! counting the laps, then wait.
+// ----------------------------------------------------------------------------
+static void buildMission(bt::Tree& p_tree, bt::Blackboard::Ptr const& p_bb)
+{
+    auto mission = bt::Node::create<bt::Sequence>();
+
+    mission->addChild(bt::Node::create<bt::Condition>(
+        [p_bb]() { return p_bb->getOrDefault<int>("battery") > 20; }, p_bb));
+
+    auto avoid = bt::Node::create<bt::Selector>();
+    auto clear = bt::Node::create<bt::Inverter>();
+    clear->setChild(bt::Node::create<bt::Condition>(
+        [p_bb]() { return p_bb->getOrDefault<bool>("obstacle"); }, p_bb));
+    avoid->addChild(std::move(clear));
+    avoid->addChild(bt::Node::create<bt::SugarAction>([p_bb]() {
+        p_bb->set("obstacle", false);
+        return bt::Status::SUCCESS;
+    }));
+    mission->addChild(std::move(avoid));
+
+    auto drive = bt::Node::create<bt::Parallel>(2, 1);
+    auto laps = bt::Node::create<bt::Repeater>(3);
+    laps->setChild(bt::Node::create<bt::SetBlackboard>(
+        "laps", "${laps} + 1", p_bb));
+    drive->addChild(std::move(laps));
+    auto timeout = bt::Node::create<bt::Timeout>(500);
+    timeout->setChild(bt::Node::create<bt::SugarAction>([p_bb]() {
+        p_bb->modify<int>("battery", [](int& p_battery) { --p_battery; });
+        return bt::Status::SUCCESS;
+    }));
+    drive->addChild(std::move(timeout));
+    mission->addChild(std::move(drive));
+
+    mission->addChild(bt::Node::create<bt::Wait>(50));
+
+    setBlackboard(*mission, p_bb);
+    p_tree.setRoot(std::move(mission));
+    p_tree.setBlackboard(p_bb);
+}
+
+int main()
+{
+    constexpr size_t TICKS = 10000u;
+
+    // Initialization: everything is allocated here
+    size_t const allocations_before = g_allocations;
+    size_t const bytes_before = g_bytes;
+
+    auto clock = std::make_shared<bt::ManualClock>();
+    auto blackboard = std::make_shared<bt::Blackboard>();
+    blackboard->set("battery", 100000);
+    blackboard->set("obstacle", false);
+    blackboard->set("laps", 0);
+
+    bt::Tree tree;
+    buildMission(tree, blackboard);
+    tree.setClock(clock);
+
+    size_t const init_allocations = g_allocations - allocations_before;
+    size_t const init_bytes = g_bytes - bytes_before;
+
+    // Execution: must not touch the heap
+    size_t const tick_allocations = g_allocations;
+    size_t const tick_bytes = g_bytes;
+    size_t successes = 0u;
+    for (size_t i = 0u; i < TICKS; ++i)
+    {
+        if (i % 100u == 0u)
+        {
+            blackboard->set("obstacle", true);
+        }
+        if (tree.tick() == bt::Status::SUCCESS)
+        {
+            ++successes;
+        }
+        clock->advance(std::chrono::milliseconds(10));
+    }
+    size_t const loop_allocations = g_allocations - tick_allocations;
+    size_t const loop_bytes = g_bytes - tick_bytes;
+
+    std::printf("BlackThorn embedded profile footprint\n");
+    std::printf("  nodes:             %zu\n", countNodes(tree.getRoot()));
+    std::printf("  heap at init:      %zu bytes in %zu allocations\n",
+                init_bytes,
+                init_allocations);
+    std::printf("  heap while ticking: %zu bytes in %zu allocations"
+                " (%zu ticks, %zu missions)\n",
+                loop_bytes,
+                loop_allocations,
+                TICKS,
+                successes);
+    std::printf("  sizeof(Node):      %zu\n", sizeof(bt::Node));
+    std::printf("  sizeof(Sequence):  %zu\n", sizeof(bt::Sequence));
+    std::printf("  sizeof(Condition): %zu\n", sizeof(bt::Condition));
+    std::printf("  sizeof(Tree):      %zu\n", sizeof(bt::Tree));
+    std::printf("  sizeof(Blackboard): %zu\n", sizeof(bt::Blackboard));
+    std::printf("  laps: %d, battery: %d\n",
+                blackboard->getOrDefault<int>("laps"),
+                blackboard->getOrDefault<int>("battery"));
+
+    if (loop_allocations != 0u)
+    {
+        std::printf("FAILED: the tick allocated memory\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
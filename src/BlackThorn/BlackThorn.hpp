@@ -18,7 +18,11 @@
 
 // Blackboard
 #include "BlackThorn/Blackboard/Blackboard.hpp"
+#include "BlackThorn/Blackboard/Journal.hpp"
+#include "BlackThorn/Blackboard/Key.hpp"
+#include "BlackThorn/Blackboard/MappedData.hpp"
 #include "BlackThorn/Blackboard/Ports.hpp"
+#include "BlackThorn/Blackboard/Record.hpp"
 #include "BlackThorn/Blackboard/Resolver.hpp"
 #include "BlackThorn/Blackboard/Serializer.hpp"
 
@@ -26,6 +30,14 @@
 #include "BlackThorn/Builder/Builder.hpp"
 #include "BlackThorn/Builder/Exporter.hpp"
 #include "BlackThorn/Builder/Factory.hpp"
+#include "BlackThorn/Builder/FragmentBuilder.hpp"
+
+// Executor
+#include "BlackThorn/Executor/BatchedServices.hpp"
+#include "BlackThorn/Executor/Executor.hpp"
+#include "BlackThorn/Executor/Pipeline.hpp"
+#include "BlackThorn/Executor/SharedComputations.hpp"
+#include "BlackThorn/Executor/Sharding.hpp"
 
 // Composite nodes
 #include "BlackThorn/Nodes/Composites/Parallels.hpp"
@@ -40,9 +52,16 @@
 // Leaf nodes
 #include "BlackThorn/Nodes/Leaves/Action.hpp"
 #include "BlackThorn/Nodes/Leaves/Basic.hpp"
+#include "BlackThorn/Nodes/Leaves/BatchedServiceCall.hpp"
 #include "BlackThorn/Nodes/Leaves/Condition.hpp"
+#include "BlackThorn/Nodes/Leaves/IO.hpp"
 #include "BlackThorn/Nodes/Leaves/SetBlackboard.hpp"
+#include "BlackThorn/Nodes/Leaves/SharedComputation.hpp"
 #include "BlackThorn/Nodes/Leaves/Wait.hpp"
 
+// Profiler
+#include "BlackThorn/Profiler/SamplingProfiler.hpp"
+#include "BlackThorn/Profiler/StatusAggregator.hpp"
+
 // Network
 #include "BlackThorn/Network/VisualizerClient.hpp"
\ No newline at end of file
@@ -8,19 +8,30 @@
 
 #pragma once
 
+#include "BlackThorn/Blackboard/Key.hpp"
+#include "BlackThorn/Blackboard/Record.hpp"
+#include "BlackThorn/Common/Tracing.hpp"
+
 #include <any>
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace bt {
 
-// Forward declaration for friend class
+// Forward declaration for friend classes
 class BlackboardSerializer;
+class BlackboardReplica;
 
 // ****************************************************************************
 //! \brief Class representing a blackboard.
@@ -34,6 +45,20 @@ class BlackboardSerializer;
 //! - Hierarchical structure: child blackboards can access parent data.
 //! - Automatic parent lookup when a key is not found locally.
 //! - Support for creating child blackboards with createChild().
+//! - Each entry carries a version incremented on each write, letting
+//!   observers detect changes without comparing values.
+//! - Large values (containers) can be updated in place with modify<T>() and
+//!   constructed in place with emplace<T>().
+//! - Copy-on-write: copies made by fork() (or the copy constructor) share the
+//!   table of entries and the values until one side writes. A write first
+//!   detaches the table (entries only, values stay shared), then duplicates
+//!   the written value if it is still shared. Forking is therefore O(1) and
+//!   a fork only pays for the entries it modifies.
+//! - Writes can be observed by a listener (see setListener()), used by the
+//!   BlackboardJournal to replicate the blackboard to a standby process.
+//! - Keys can be given as strings or as handles (BlackboardKey, Key<T>)
+//!   whose hash is computed once: the hash of a key is never recomputed
+//!   while walking up the parents, and lookups do not allocate.
 //!
 //! Usage example:
 //! \code
@@ -46,30 +71,208 @@ class BlackboardSerializer;
 class Blackboard final: public std::enable_shared_from_this<Blackboard>
 {
     friend class BlackboardSerializer;
+    friend class BlackboardReplica;
 
 public:
 
     using Key = std::string;
     using Value = std::any;
     using Ptr = std::shared_ptr<Blackboard>;
+    using Version = uint64_t;
+    //! \brief Forked blackboards indexed by their original (see fork()).
+    using Forks = std::unordered_map<Blackboard const*, Ptr>;
+    //! \brief Called after each local write with the key, the new version of
+    //! the entry and its new value (nullptr when the key is removed).
+    using Listener = std::function<void(Key const&, Version, Value const*)>;
 
     // ------------------------------------------------------------------------
     //! \brief Constructor.
     //! \param[in] p_parent The parent blackboard.
     // ------------------------------------------------------------------------
-    explicit Blackboard(Blackboard::Ptr p_parent = nullptr) : m_parent(p_parent)
+    explicit Blackboard(Blackboard::Ptr p_parent = nullptr)
+        : m_data(std::make_shared<Entries>()), m_parent(p_parent)
     {
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Copy-on-write copy: entries are shared with p_other until one
+    //! of the two blackboards writes. The parent is shared, not copied. The
+    //! listener is not copied: writes to the copy are not observed.
+    // ------------------------------------------------------------------------
+    Blackboard(Blackboard const& p_other)
+        : std::enable_shared_from_this<Blackboard>(p_other),
+          m_data(p_other.m_data),
+          m_parent(p_other.m_parent),
+          m_portRemapping(p_other.m_portRemapping)
+    {
+    }
+
+    Blackboard& operator=(Blackboard const& p_other)
+    {
+        m_data = p_other.m_data;
+        m_parent = p_other.m_parent;
+        m_portRemapping = p_other.m_portRemapping;
+        return *this;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Observe the writes of the local entries (set, setRaw, emplace,
+    //! modify, share, remove). Writes done through a parent are observed by
+    //! the listener of the parent.
+    //! \details For emplace(), the listener sees the value just constructed,
+    //!          not the later changes made through the returned reference.
+    //! \param[in] p_listener The listener, or nullptr to stop observing.
+    // ------------------------------------------------------------------------
+    void setListener(Listener p_listener)
+    {
+        m_listener = std::move(p_listener);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Copy-on-write copy of this blackboard and of its parents.
+    //! \details Writes to the fork (or to one of its forked parents) are not
+    //!          seen by the original, and the other way around.
+    //! \return The forked blackboard.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Ptr fork() const
+    {
+        Forks forks;
+        return fork(forks);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Copy-on-write copy of this blackboard and of its parents,
+    //! reusing the blackboards already forked in p_forks. Used to fork
+    //! several blackboards sharing parents (e.g. the subtrees of a tree).
+    //! \param[in,out] p_forks The forked blackboards indexed by original.
+    //! \return The forked blackboard.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Ptr fork(Forks& p_forks) const
+    {
+        if (auto it = p_forks.find(this); it != p_forks.end())
+        {
+            return it->second;
+        }
+
+        auto copy = std::make_shared<Blackboard>(*this);
+        if (m_parent)
+        {
+            copy->m_parent = m_parent->fork(p_forks);
+        }
+        p_forks[this] = copy;
+        return copy;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Set a value with generic type.
+    //! \details When the key already holds a value of the same type, the value
+    //!          is assigned in place: no std::any is rebuilt and containers
+    //!          such as std::string reuse their storage (no allocation when the
+    //!          capacity is enough).
     //! \param[in] key The key to set the value.
     //! \param[in] value The value to set.
     // ------------------------------------------------------------------------
     template <typename T>
-    void set(const Key& p_key, T&& p_value)
+    void set(KeyView p_key, T&& p_value)
+    {
+        using Type = std::decay_t<T>;
+
+        auto slot = writableSlot(p_key);
+        Entry& entry = slot->second;
+        entry.version++;
+        Value& value = writable(entry, false);
+        if constexpr (std::is_assignable_v<Type&, T&&> &&
+                      !std::is_same_v<Type, Value>)
+        {
+            if (auto* current = std::any_cast<Type>(&value))
+            {
+                *current = std::forward<T>(p_value);
+                notify(slot->first.name(), entry);
+                return;
+            }
+        }
+        value = std::forward<T>(p_value);
+        notify(slot->first.name(), entry);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set a value through a typed key, converted to the type of the
+    //! key so that get(p_key) finds it (e.g. a literal 1 set to a Key<double>
+    //! is stored as a double).
+    //! \param[in] p_key The typed key to set the value.
+    //! \param[in] p_value The value to set.
+    // ------------------------------------------------------------------------
+    template <typename T, typename U>
+    void set(bt::Key<T> const& p_key, U&& p_value)
+    {
+        if constexpr (std::is_same_v<std::decay_t<U>, T>)
+        {
+            set(KeyView(p_key), std::forward<U>(p_value));
+        }
+        else
+        {
+            set(KeyView(p_key), T(std::forward<U>(p_value)));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Construct a value in place, replacing the current one.
+    //! \details Avoids the temporary and the move of set(): the value is
+    //!          built directly inside the entry from the given arguments.
+    //! \param[in] p_key The key to set the value.
+    //! \param[in] p_args The arguments forwarded to the constructor of T.
+    //! \return A reference to the constructed value, valid until the key is
+    //!         set with another type or removed.
+    // ------------------------------------------------------------------------
+    template <typename T, typename... Args>
+    T& emplace(KeyView p_key, Args&&... p_args)
     {
-        m_data[p_key] = std::forward<T>(p_value);
+        auto slot = writableSlot(p_key);
+        Entry& entry = slot->second;
+        entry.version++;
+        T& value =
+            writable(entry, false).emplace<T>(std::forward<Args>(p_args)...);
+        notify(slot->first.name(), entry);
+        return value;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Update a stored value in place (read-modify-write without copy).
+    //! \details The function receives a reference to the stored value, so
+    //!          containers keep and reuse their capacity. The entry is
+    //!          searched like get<T>(): locally first, then in the parent
+    //!          when not found or on type mismatch. The version of the entry
+    //!          is incremented once, whatever the function does.
+    //! \param[in] p_key The key of the value to update.
+    //! \param[in] p_function Callable taking a T&.
+    //! \return False if no entry of type T was found (the function is not
+    //!         called).
+    // ------------------------------------------------------------------------
+    template <typename T, typename Function>
+    bool modify(KeyView p_key, Function&& p_function)
+    {
+        if (auto it = find(p_key); it != m_data->end())
+        {
+            if (std::any_cast<T>(it->second.value.get()) != nullptr)
+            {
+                // The search above did not detach a shared table
+                auto slot = writableSlot(p_key);
+                Entry& entry = slot->second;
+                entry.version++;
+                std::forward<Function>(p_function)(
+                    *std::any_cast<T>(&writable(entry, true)));
+                notify(slot->first.name(), entry);
+                return true;
+            }
+        }
+
+        if (m_parent)
+        {
+            return m_parent->modify<T>(p_key,
+                                       std::forward<Function>(p_function));
+        }
+
+        return false;
     }
 
     // ------------------------------------------------------------------------
@@ -77,9 +280,34 @@ public:
     //! \param[in] p_key The key to set the value.
     //! \param[in] p_value The std::any value to set.
     // ------------------------------------------------------------------------
-    void setRaw(const Key& p_key, Value const& p_value)
+    void setRaw(KeyView p_key, Value p_value)
+    {
+        auto slot = writableSlot(p_key);
+        Entry& entry = slot->second;
+        entry.version++;
+        writable(entry, false) = std::move(p_value);
+        notify(slot->first.name(), entry);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Store a value shared with other owners without copying it.
+    //! \details The value is treated like a value shared with a fork: it is
+    //!          never modified through this blackboard but copied on the
+    //!          first write of the key. The version is not incremented when
+    //!          the key already shares this very value.
+    //! \param[in] p_key The key to set the value.
+    //! \param[in] p_value The shared value (not null).
+    // ------------------------------------------------------------------------
+    void share(KeyView p_key, std::shared_ptr<Value> p_value)
     {
-        m_data[p_key] = p_value;
+        auto slot = writableSlot(p_key);
+        Entry& entry = slot->second;
+        if (entry.value != p_value)
+        {
+            entry.version++;
+            entry.value = std::move(p_value);
+            notify(slot->first.name(), entry);
+        }
     }
 
     // ------------------------------------------------------------------------
@@ -90,11 +318,11 @@ public:
     //! \param[in] p_key The key to get the value.
     //! \return The stored std::any if present, std::nullopt otherwise.
     // ------------------------------------------------------------------------
-    [[nodiscard]] std::optional<Value> raw(const Key& p_key) const
+    [[nodiscard]] std::optional<Value> raw(KeyView p_key) const
     {
-        if (auto it = m_data.find(p_key); it != m_data.end())
+        if (auto it = find(p_key); it != m_data->end())
         {
-            return it->second;
+            return *it->second.value;
         }
 
         if (m_parent)
@@ -105,6 +333,50 @@ public:
         return std::nullopt;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Get a pointer to the raw stored value without copying it.
+    //! \details Same search strategy than raw(). The pointer is invalidated
+    //!          when the key is written or removed.
+    //! \param[in] p_key The key to get the value.
+    //! \return The stored std::any if present, nullptr otherwise.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Value const* lookup(KeyView p_key) const
+    {
+        if (auto it = find(p_key); it != m_data->end())
+        {
+            return it->second.value.get();
+        }
+
+        if (m_parent)
+        {
+            return m_parent->lookup(p_key);
+        }
+
+        return nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the version of an entry, incremented on each write (set,
+    //!        setRaw, emplace, modify).
+    //! \details Searches locally first, then in the parent blackboard.
+    //! \param[in] p_key The key of the entry.
+    //! \return The version of the entry, 0 if the key does not exist.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Version version(KeyView p_key) const
+    {
+        if (auto it = find(p_key); it != m_data->end())
+        {
+            return it->second.version;
+        }
+
+        if (m_parent)
+        {
+            return m_parent->version(p_key);
+        }
+
+        return 0u;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Get a value with automatic type conversion.
     //! \details Searches locally first. If the key is found but the type does
@@ -115,18 +387,14 @@ public:
     //!         otherwise.
     // ------------------------------------------------------------------------
     template <typename T>
-    [[nodiscard]] std::optional<T> get(const Key& p_key) const
+    [[nodiscard]] std::optional<T> get(KeyView p_key) const
     {
-        // Search locally first
-        if (auto it = m_data.find(p_key); it != m_data.end())
+        // Search locally first (type mismatch: fall through to parent)
+        if (auto it = find(p_key); it != m_data->end())
         {
-            try
+            if (auto* value = std::any_cast<T>(it->second.value.get()))
             {
-                return std::any_cast<T>(it->second);
-            }
-            catch (const std::bad_any_cast&)
-            {
-                // Type mismatch, fall through to parent
+                return *value;
             }
         }
 
@@ -151,7 +419,7 @@ public:
     //! \return The converted value if found, otherwise the default value.
     // ------------------------------------------------------------------------
     template <typename T>
-    [[nodiscard]] T getOrDefault(const Key& p_key, T p_default = T()) const
+    [[nodiscard]] T getOrDefault(KeyView p_key, T p_default = T()) const
     {
         if (auto value = get<T>(p_key))
         {
@@ -160,14 +428,26 @@ public:
         return p_default;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Get a value through a typed key.
+    //! \param[in] p_key The typed key to get the value.
+    //! \return The value if found with the type of the key, std::nullopt
+    //!         otherwise.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    [[nodiscard]] std::optional<T> get(bt::Key<T> const& p_key) const
+    {
+        return get<T>(KeyView(p_key));
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Check if a key exists.
     //! \param[in] p_key The key to check.
     //! \return True if the key exists, false otherwise.
     // ------------------------------------------------------------------------
-    [[nodiscard]] bool has(const Key& p_key) const
+    [[nodiscard]] bool has(KeyView p_key) const
     {
-        if (m_data.find(p_key) != m_data.end())
+        if (find(p_key) != m_data->end())
             return true;
         if (m_parent)
             return m_parent->has(p_key);
@@ -178,9 +458,46 @@ public:
     //! \brief Remove a key.
     //! \param[in] p_key The key to remove.
     // ------------------------------------------------------------------------
-    void remove(const Key& p_key)
+    void remove(KeyView p_key)
     {
-        m_data.erase(p_key);
+        Entries& entries = writableEntries();
+        if (auto it = entries.find(EntryKey::probe(p_key));
+            it != entries.end())
+        {
+            Version version = it->second.version + 1u;
+            auto removed = entries.extract(it);
+            if (m_listener)
+            {
+                m_listener(removed.key().name(), version, nullptr);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Move the local entries of p_source into this blackboard, then
+    //! empty p_source. Values are shared, not copied (see share()): this
+    //! hands over a batch of values written on another thread, e.g. the
+    //! inputs of a tick (see Pipeline). The listener of p_source is not
+    //! informed.
+    //! \param[in,out] p_source The blackboard to empty.
+    // ------------------------------------------------------------------------
+    void absorb(Blackboard& p_source)
+    {
+        for (auto const& [key, entry] : *p_source.m_data)
+        {
+            if (entry.value)
+            {
+                share(KeyView(key.name(), key.hash()), entry.value);
+            }
+        }
+        if (p_source.m_data.use_count() > 1)
+        {
+            p_source.m_data = std::make_shared<Entries>();
+        }
+        else
+        {
+            p_source.m_data->clear();
+        }
     }
 
     // ------------------------------------------------------------------------
@@ -216,12 +533,12 @@ public:
         oss << "=== " << p_title << " ===" << std::endl;
 
         // Show local data with values
-        for (const auto& [key, value] : m_data)
+        for (const auto& [key, entry] : *m_data)
         {
-            oss << "  " << key << " = " << anyToString(value);
+            oss << "  " << key.name() << " = " << anyToString(*entry.value);
 
             // Show remapping info if this key is remapped
-            auto it = m_portRemapping.find(key);
+            auto it = m_portRemapping.find(key.name());
             if (it != m_portRemapping.end())
             {
                 oss << "  [remapped to port of parent tree: " << it->second
@@ -233,7 +550,7 @@ public:
         // Show remapped ports that don't have local values yet
         for (const auto& [localKey, parentKey] : m_portRemapping)
         {
-            if (m_data.find(localKey) == m_data.end())
+            if (find(localKey) == m_data->end())
             {
                 oss << "  [" << localKey
                     << "] remapped to port of parent tree [" << parentKey << "]"
@@ -245,9 +562,10 @@ public:
         if (p_showParent && m_parent)
         {
             oss << "  --- Parent Blackboard ---" << std::endl;
-            for (const auto& [key, value] : m_parent->m_data)
+            for (const auto& [key, entry] : *m_parent->m_data)
             {
-                oss << "    " << key << " = " << anyToString(value)
+                oss << "    " << key.name() << " = "
+                    << anyToString(*entry.value)
                     << std::endl;
             }
         }
@@ -262,10 +580,10 @@ public:
     [[nodiscard]] std::vector<Key> keys() const
     {
         std::vector<Key> result;
-        result.reserve(m_data.size());
-        for (const auto& [key, _] : m_data)
+        result.reserve(m_data->size());
+        for (const auto& [key, _] : *m_data)
         {
-            result.push_back(key);
+            result.push_back(key.name());
         }
         return result;
     }
@@ -290,14 +608,176 @@ private:
             return (*v ? "true" : "false") + std::string(" (bool)");
         if (auto* v = std::any_cast<size_t>(&p_value))
             return std::to_string(*v) + " (size_t)";
+        if (auto* v = std::any_cast<Record>(&p_value))
+            return "{...} (" + v->schema().name() + ")";
 
         // Fallback to type name
+#if defined(__cpp_rtti)
         return std::string("(") + p_value.type().name() + ")";
+#else
+        return "(?)";
+#endif
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Stored value and its version. The value may be shared with
+    //! forked blackboards.
+    // ------------------------------------------------------------------------
+    struct Entry
+    {
+        std::shared_ptr<Value> value;
+        Version version = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Key of the table of entries: its name and precomputed hash.
+    //! Stored keys own their name; the probes built to search the table view
+    //! the name of the caller, so that searching neither allocates nor
+    //! hashes (std::unordered_map has no heterogeneous lookup in C++17).
+    // ------------------------------------------------------------------------
+    class EntryKey
+    {
+    public:
+
+        //! \brief Stored key, owning a copy of the name.
+        explicit EntryKey(KeyView p_key)
+            : m_storage(p_key.name()), m_name(m_storage), m_hash(p_key.hash())
+        {
+        }
+
+        EntryKey(EntryKey const& p_other)
+            : m_storage(p_other.m_storage),
+              m_name(p_other.m_owner ? std::string_view(m_storage)
+                                     : p_other.m_name),
+              m_hash(p_other.m_hash),
+              m_owner(p_other.m_owner)
+        {
+        }
+
+        EntryKey& operator=(EntryKey const&) = delete;
+
+        //! \brief Key viewing the name of p_key, only valid during a search.
+        static EntryKey probe(KeyView p_key)
+        {
+            return EntryKey(p_key, false);
+        }
+
+        //! \brief Name of a stored key.
+        std::string const& name() const
+        {
+            return m_storage;
+        }
+
+        size_t hash() const
+        {
+            return m_hash;
+        }
+
+        bool operator==(EntryKey const& p_other) const
+        {
+            return (m_hash == p_other.m_hash) && (m_name == p_other.m_name);
+        }
+
+    private:
+
+        EntryKey(KeyView p_key, bool p_owner)
+            : m_name(p_key.name()), m_hash(p_key.hash()), m_owner(p_owner)
+        {
+        }
+
+        std::string m_storage;
+        std::string_view m_name;
+        size_t m_hash;
+        bool m_owner = true;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Hash of the table of entries: the precomputed one.
+    // ------------------------------------------------------------------------
+    struct EntryHash
+    {
+        size_t operator()(EntryKey const& p_key) const
+        {
+            return p_key.hash();
+        }
+    };
+
+    using Entries = std::unordered_map<EntryKey, Entry, EntryHash>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Search a local entry.
+    // ------------------------------------------------------------------------
+    Entries::const_iterator find(KeyView p_key) const
+    {
+        return m_data->find(EntryKey::probe(p_key));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the table of entries for writing: copy it first when it is
+    //! shared with a fork (values are not copied).
+    // ------------------------------------------------------------------------
+    Entries& writableEntries()
+    {
+        if (m_data.use_count() > 1)
+        {
+            m_data = std::make_shared<Entries>(*m_data);
+        }
+        return *m_data;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the local entry of a key for writing, created if missing.
+    // ------------------------------------------------------------------------
+    Entries::iterator writableSlot(KeyView p_key)
+    {
+        Entries& entries = writableEntries();
+        auto it = entries.find(EntryKey::probe(p_key));
+        if (it == entries.end())
+        {
+            it = entries
+                     .emplace(std::piecewise_construct,
+                              std::forward_as_tuple(p_key),
+                              std::forward_as_tuple())
+                     .first;
+        }
+        return it;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Inform the listener of the write of an entry.
+    // ------------------------------------------------------------------------
+    void notify(Key const& p_key, Entry const& p_entry) const
+    {
+        BT_TRACE(blackboard__write, this, p_key.c_str(), p_entry.version);
+        if (m_listener)
+        {
+            m_listener(p_key, p_entry.version, p_entry.value.get());
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the value of an entry for writing: allocate it when missing
+    //! or, when shared with a fork, copy it (p_keep) or replace it with an
+    //! empty value (the caller overwrites it).
+    // ------------------------------------------------------------------------
+    static Value& writable(Entry& p_entry, bool p_keep)
+    {
+        if (p_entry.value == nullptr)
+        {
+            p_entry.value = std::make_shared<Value>();
+        }
+        else if (p_entry.value.use_count() > 1)
+        {
+            p_entry.value = p_keep ? std::make_shared<Value>(*p_entry.value)
+                                   : std::make_shared<Value>();
+        }
+        return *p_entry.value;
     }
 
-    std::unordered_map<Key, Value> m_data;
+    std::shared_ptr<Entries> m_data;
     std::shared_ptr<Blackboard> m_parent;
     std::unordered_map<std::string, std::string> m_portRemapping;
+    Listener m_listener;
 };
 
 } // namespace bt
@@ -0,0 +1,474 @@
+/**
+ * @file Journal.hpp
+ * @brief Change journal replicating a blackboard to a standby process.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Blackboard/Blackboard.hpp"
+#include "BlackThorn/Common/Encoding.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Binary encoding of the journal records.
+//!
+//! A record is: [u32 size of the rest][u64 sequence][u64 version]
+//! [i64 steady time of the write in ns][u16 key size][key][value], in the
+//! native byte order (primary and standby run on the same host). Values are
+//! encoded as described in encoding.
+// ****************************************************************************
+namespace journal {
+
+// ----------------------------------------------------------------------------
+//! \brief Current steady time in nanoseconds, shared by the processes of the
+//! host (CLOCK_MONOTONIC).
+// ----------------------------------------------------------------------------
+inline int64_t now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Append a record.
+//! \param[in] p_value The value, or nullptr when the key was removed.
+//! \return False if the key is too long or the type of the value has no
+//!         encoding: the buffer is then left unchanged.
+// ----------------------------------------------------------------------------
+inline bool putRecord(std::string& p_buffer,
+                      uint64_t p_sequence,
+                      Blackboard::Key const& p_key,
+                      Blackboard::Version p_version,
+                      Blackboard::Value const* p_value)
+{
+    if (p_key.size() > UINT16_MAX)
+    {
+        return false;
+    }
+
+    size_t const start = p_buffer.size();
+    encoding::put(p_buffer, uint32_t(0)); // Patched below
+    encoding::put(p_buffer, p_sequence);
+    encoding::put(p_buffer, uint64_t(p_version));
+    encoding::put(p_buffer, now());
+    encoding::put(p_buffer, uint16_t(p_key.size()));
+    p_buffer.append(p_key);
+
+    bool encoded = true;
+    if (p_value == nullptr)
+    {
+        encoding::put(p_buffer, encoding::Tag::Removed);
+    }
+    else
+    {
+        encoded = encoding::putValue(p_buffer, *p_value);
+    }
+
+    if (!encoded)
+    {
+        p_buffer.resize(start);
+        return false;
+    }
+
+    uint32_t size = uint32_t(p_buffer.size() - start - sizeof(uint32_t));
+    std::memcpy(&p_buffer[start], &size, sizeof(size));
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Append the local entries of a blackboard as consecutive records,
+//! replayed by a new BlackboardReplica, e.g. to move the blackboard to
+//! another process in one message.
+//! \return False if the type of a value has no encoding.
+// ----------------------------------------------------------------------------
+inline bool putSnapshot(std::string& p_buffer, Blackboard const& p_blackboard)
+{
+    uint64_t sequence = 0u;
+    for (auto const& key : p_blackboard.keys())
+    {
+        if (!putRecord(p_buffer, ++sequence, key, p_blackboard.version(key),
+                       p_blackboard.lookup(key)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace journal
+
+// ****************************************************************************
+//! \brief Append-only journal of the writes of a blackboard, to replicate it
+//! continuously to a hot-standby process (see BlackboardReplica).
+//!
+//! Each write (set, setRaw, emplace, modify, share, remove) appends a
+//! (key, version, typed binary value) record as it happens. The encoded
+//! records are shipped by the application, either with flush() on a
+//! non-blocking local socket or pipe, or by copying data() to shared memory
+//! then calling consume(). Compared to dumping the whole blackboard with
+//! BlackboardSerializer, only the changed entries are encoded, without YAML.
+//!
+//! Supported value types are those of BlackboardSerializer (bool, int,
+//! double, std::string, std::vector<double>, std::vector<std::any>, string
+//! maps of std::any) plus float and size_t. Writes of other types are not
+//! journaled and are counted by unsupported().
+//!
+//! The journal starts with a snapshot of the blackboard, so that the standby
+//! starts from the same state. Once in sync, a switchover needs no reload:
+//! the standby blackboard is already up to date, versions included.
+//!
+//! Usage example:
+//! \code
+//!   // Primary
+//!   bt::BlackboardJournal journal(tree->blackboard());
+//!   while (running) {
+//!       tree->tick();
+//!       journal.flush(socket);
+//!   }
+//!   // Standby
+//!   bt::BlackboardReplica replica(standby_blackboard);
+//!   reactor->add(socket, EPOLLIN, [&](uint32_t) { replica.receive(socket); });
+//! \endcode
+// ****************************************************************************
+class BlackboardJournal
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor - observes the writes of the blackboard (replacing
+    //! its listener) and journals a snapshot of its local entries.
+    //! \param[in] p_blackboard The blackboard to replicate.
+    // ------------------------------------------------------------------------
+    explicit BlackboardJournal(Blackboard::Ptr p_blackboard)
+        : m_blackboard(std::move(p_blackboard))
+    {
+        m_blackboard->setListener([this](Blackboard::Key const& p_key,
+                                         Blackboard::Version p_version,
+                                         Blackboard::Value const* p_value) {
+            append(p_key, p_version, p_value);
+        });
+        snapshot();
+    }
+
+    // Disable copy/move: the listener references this instance
+    BlackboardJournal(BlackboardJournal const&) = delete;
+    BlackboardJournal& operator=(BlackboardJournal const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - stops observing the blackboard.
+    // ------------------------------------------------------------------------
+    ~BlackboardJournal()
+    {
+        m_blackboard->setListener(nullptr);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Journal all the local entries, e.g. for a standby connecting
+    //! after the start of the primary.
+    // ------------------------------------------------------------------------
+    void snapshot()
+    {
+        for (auto const& key : m_blackboard->keys())
+        {
+            append(key, m_blackboard->version(key), m_blackboard->lookup(key));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the encoded records not yet shipped.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& data() const
+    {
+        return m_buffer;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of bytes not yet shipped.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t pending() const
+    {
+        return m_buffer.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Drop the first bytes of data(), once shipped.
+    //! \param[in] p_size The number of shipped bytes.
+    // ------------------------------------------------------------------------
+    void consume(size_t p_size)
+    {
+        m_buffer.erase(0u, std::min(p_size, m_buffer.size()));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Write the pending records to a file descriptor (local socket,
+    //! pipe). On a non-blocking descriptor, the bytes not accepted stay
+    //! pending for the next call.
+    //! \param[in] p_fd The file descriptor.
+    //! \return False on a write error other than EAGAIN/EINTR.
+    // ------------------------------------------------------------------------
+    bool flush(int p_fd)
+    {
+        size_t written = 0u;
+        while (written < m_buffer.size())
+        {
+            ssize_t n = ::write(p_fd, m_buffer.data() + written,
+                                m_buffer.size() - written);
+            if (n > 0)
+            {
+                written += size_t(n);
+            }
+            else if ((n < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            else
+            {
+                consume(written);
+                return (n < 0) && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+        }
+        consume(written);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the sequence number of the last record (0 if none).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] uint64_t sequence() const
+    {
+        return m_sequence;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of writes not journaled because the type of
+    //! their value has no binary encoding.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t unsupported() const
+    {
+        return m_unsupported;
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Encode a record at the end of the buffer.
+    // ------------------------------------------------------------------------
+    void append(Blackboard::Key const& p_key,
+                Blackboard::Version p_version,
+                Blackboard::Value const* p_value)
+    {
+        if (!journal::putRecord(
+                m_buffer, m_sequence + 1u, p_key, p_version, p_value))
+        {
+            ++m_unsupported;
+            return;
+        }
+        ++m_sequence;
+    }
+
+private:
+
+    Blackboard::Ptr m_blackboard;
+    std::string m_buffer;
+    uint64_t m_sequence = 0u;
+    size_t m_unsupported = 0u;
+};
+
+// ****************************************************************************
+//! \brief Standby side of the replication: replays the records of a
+//! BlackboardJournal into its own blackboard.
+//!
+//! Entries get the value and the version they have on the primary. Records
+//! can be fed in chunks of any size (partial records are kept until
+//! complete). The replication lag of a record is the time between the write
+//! on the primary and its replay.
+// ****************************************************************************
+class BlackboardReplica
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Replication statistics.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of replayed records.
+        size_t records = 0u;
+        //! \brief Number of received bytes.
+        size_t bytes = 0u;
+        //! \brief Lag of the last replayed record.
+        std::chrono::nanoseconds lag{0};
+        //! \brief Largest lag since the last resetStatistics().
+        std::chrono::nanoseconds max_lag{0};
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_blackboard The standby blackboard.
+    // ------------------------------------------------------------------------
+    explicit BlackboardReplica(Blackboard::Ptr p_blackboard)
+        : m_blackboard(std::move(p_blackboard))
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Replay the complete records of the received bytes.
+    //! \param[in] p_data The received bytes.
+    //! \param[in] p_size The number of received bytes.
+    //! \return False if a record is corrupted or a record is missing (the
+    //!         sequence numbers are not consecutive): the standby is out of
+    //!         sync and needs a new snapshot.
+    // ------------------------------------------------------------------------
+    bool feed(char const* p_data, size_t p_size)
+    {
+        m_statistics.bytes += p_size;
+        m_pending.append(p_data, p_size);
+
+        size_t offset = 0u;
+        bool ok = true;
+        while (ok && (m_pending.size() - offset >= sizeof(uint32_t)))
+        {
+            uint32_t size;
+            std::memcpy(&size, m_pending.data() + offset, sizeof(size));
+            if (m_pending.size() - offset - sizeof(uint32_t) < size)
+            {
+                break; // Partial record
+            }
+            offset += sizeof(uint32_t);
+            ok = replay(m_pending.data() + offset, size);
+            offset += size;
+        }
+        m_pending.erase(0u, offset);
+        return ok;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read the available bytes of a file descriptor (local socket,
+    //! pipe) and replay them. Typically called by a Reactor handler.
+    //! \param[in] p_fd The non-blocking file descriptor.
+    //! \return False on a read error, on end of file (the primary is gone:
+    //!         time to switch over) or if feed() failed.
+    // ------------------------------------------------------------------------
+    bool receive(int p_fd)
+    {
+        char buffer[4096];
+        while (true)
+        {
+            ssize_t n = ::read(p_fd, buffer, sizeof(buffer));
+            if (n > 0)
+            {
+                if (!feed(buffer, size_t(n)))
+                    return false;
+            }
+            else if ((n < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            else
+            {
+                return (n < 0) && (errno == EAGAIN || errno == EWOULDBLOCK);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the sequence number of the last replayed record.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] uint64_t sequence() const
+    {
+        return m_sequence;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the replication statistics.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics const& statistics() const
+    {
+        return m_statistics;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Reset the replication statistics.
+    // ------------------------------------------------------------------------
+    void resetStatistics()
+    {
+        m_statistics = Statistics();
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Replay one record (without its size field).
+    // ------------------------------------------------------------------------
+    bool replay(char const* p_data, size_t p_size)
+    {
+        encoding::Reader reader(p_data, p_size);
+        uint64_t sequence;
+        uint64_t version;
+        int64_t time;
+        uint16_t key_size;
+        std::string key;
+        std::any value;
+        bool removed;
+        if (!reader.get(sequence) || !reader.get(version) ||
+            !reader.get(time) || !reader.get(key_size) ||
+            !reader.getString(key, key_size) ||
+            !reader.getValue(value, removed) || !reader.atEnd())
+        {
+            return false;
+        }
+
+        // The first record may follow a snapshot asked by a late standby
+        if ((m_sequence != 0u) && (sequence != m_sequence + 1u))
+        {
+            return false;
+        }
+        m_sequence = sequence;
+
+        // Write directly: versions are the ones of the primary and the
+        // listener of the standby blackboard is not called
+        if (removed)
+        {
+            m_blackboard->writableEntries().erase(
+                Blackboard::EntryKey::probe(key));
+        }
+        else
+        {
+            Blackboard::Entry& entry =
+                m_blackboard->writableSlot(key)->second;
+            entry.version = version;
+            Blackboard::writable(entry, false) = std::move(value);
+        }
+
+        m_statistics.records++;
+        m_statistics.lag = std::chrono::nanoseconds(journal::now() - time);
+        m_statistics.max_lag = std::max(m_statistics.max_lag,
+                                        m_statistics.lag);
+        return true;
+    }
+
+private:
+
+    Blackboard::Ptr m_blackboard;
+    //! \brief Received bytes of the incomplete record.
+    std::string m_pending;
+    uint64_t m_sequence = 0u;
+    Statistics m_statistics;
+};
+
+} // namespace bt
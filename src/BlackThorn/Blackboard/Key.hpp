@@ -0,0 +1,147 @@
+/**
+ * @file Key.hpp
+ * @brief Blackboard keys with a precomputed hash.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Handle of a blackboard entry: the name of the key and its hash,
+//! computed once at construction.
+//!
+//! Lookups done with a handle neither allocate nor hash the name, whatever
+//! the depth of the chain of parent blackboards. Create the handles once
+//! (e.g. as members of a node or as static constants) and reuse them at each
+//! tick. Calls made with strings keep working: they hash the name once per
+//! call instead of once per blackboard of the chain.
+//!
+//! Usage example:
+//! \code
+//!   static const bt::BlackboardKey health("health");
+//!   bb->set(health, 100);
+//!   auto value = bb->get<int>(health);
+//! \endcode
+// ****************************************************************************
+class BlackboardKey
+{
+public:
+
+    explicit BlackboardKey(std::string p_name)
+        : m_name(std::move(p_name)), m_hash(hashOf(m_name))
+    {
+    }
+
+    explicit BlackboardKey(char const* p_name)
+        : BlackboardKey(std::string(p_name))
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the name of the key.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] inline std::string const& name() const
+    {
+        return m_name;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the precomputed hash of the name.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] inline size_t hash() const
+    {
+        return m_hash;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Hash function of the names of the blackboard keys.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static size_t hashOf(std::string_view p_name)
+    {
+        return std::hash<std::string_view>{}(p_name);
+    }
+
+private:
+
+    std::string m_name;
+    size_t m_hash;
+};
+
+// ****************************************************************************
+//! \brief Handle of a blackboard entry carrying the type of its value, so
+//! that Blackboard::get() and Node::getInput() need no template argument.
+//!
+//! Usage example:
+//! \code
+//!   static const bt::Key<int> health("health");
+//!   bb->set(health, 100);
+//!   std::optional<int> value = bb->get(health);
+//! \endcode
+// ****************************************************************************
+template <typename T>
+class Key final: public BlackboardKey
+{
+public:
+
+    using Type = T;
+    using BlackboardKey::BlackboardKey;
+};
+
+// ****************************************************************************
+//! \brief Non-owning view of a key name and of its hash, taken by the
+//! Blackboard methods. Implicitly built from a handle (no hashing) or from a
+//! string (hashed once). Only meant as a parameter: it must not outlive the
+//! name it views.
+// ****************************************************************************
+class KeyView
+{
+public:
+
+    KeyView(BlackboardKey const& p_key)
+        : m_name(p_key.name()), m_hash(p_key.hash())
+    {
+    }
+
+    KeyView(std::string const& p_name)
+        : m_name(p_name), m_hash(BlackboardKey::hashOf(p_name))
+    {
+    }
+
+    KeyView(std::string_view p_name)
+        : m_name(p_name), m_hash(BlackboardKey::hashOf(p_name))
+    {
+    }
+
+    KeyView(char const* p_name) : KeyView(std::string_view(p_name)) {}
+
+    KeyView(std::string_view p_name, size_t p_hash)
+        : m_name(p_name), m_hash(p_hash)
+    {
+    }
+
+    [[nodiscard]] inline std::string_view name() const
+    {
+        return m_name;
+    }
+
+    [[nodiscard]] inline size_t hash() const
+    {
+        return m_hash;
+    }
+
+private:
+
+    std::string_view m_name;
+    size_t m_hash;
+};
+
+} // namespace bt
@@ -0,0 +1,123 @@
+/**
+ * @file MappedData.cpp
+ * @brief Implementation of the read-only file mappings shared by the
+ * blackboards of the process.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Blackboard/MappedData.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bt {
+
+// ----------------------------------------------------------------------------
+//! \brief Mapping of the process and identity of the file mapped, to detect
+//! a file replaced since it was mapped.
+// ----------------------------------------------------------------------------
+struct MappedEntry
+{
+    std::weak_ptr<MappedFile const> file;
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    struct timespec mtime;
+
+    bool isSame(struct stat const& p_stat) const
+    {
+        return (device == p_stat.st_dev) && (inode == p_stat.st_ino) &&
+               (size == p_stat.st_size) &&
+               (mtime.tv_sec == p_stat.st_mtim.tv_sec) &&
+               (mtime.tv_nsec == p_stat.st_mtim.tv_nsec);
+    }
+};
+
+// ----------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+    }
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<MappedFile::Ptr> MappedFile::open(std::string const& p_path)
+{
+    static std::mutex mutex;
+    static std::unordered_map<std::string, MappedEntry> mappings;
+
+    std::error_code error;
+    std::string const path = std::filesystem::canonical(p_path, error).string();
+    if (error)
+    {
+        return robotik::Return<Ptr>::error("Cannot find mapped file '" +
+                                           p_path + "'");
+    }
+
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat status;
+    if ((fd < 0) || (::fstat(fd, &status) != 0))
+    {
+        std::string const reason = std::strerror(errno);
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return robotik::Return<Ptr>::error("Cannot open mapped file '" +
+                                           path + "': " + reason);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = mappings.find(path);
+    if ((it != mappings.end()) && it->second.isSame(status))
+    {
+        if (Ptr file = it->second.file.lock())
+        {
+            ::close(fd);
+            return robotik::Return<Ptr>::success(std::move(file));
+        }
+    }
+
+    size_t const size = size_t(status.st_size);
+    void* data = nullptr;
+    if (size > 0u)
+    {
+        data = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    std::string const reason = std::strerror(errno);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return robotik::Return<Ptr>::error("Cannot map file '" + path +
+                                           "': " + reason);
+    }
+
+    // Forget the mappings released since the last call
+    for (auto entry = mappings.begin(); entry != mappings.end();)
+    {
+        entry = entry->second.file.expired() ? mappings.erase(entry)
+                                             : std::next(entry);
+    }
+
+    Ptr file(new MappedFile(path, data, size));
+    mappings[path] = MappedEntry{file,
+                                 status.st_dev,
+                                 status.st_ino,
+                                 status.st_size,
+                                 status.st_mtim};
+    return robotik::Return<Ptr>::success(std::move(file));
+}
+
+} // namespace bt
@@ -0,0 +1,236 @@
+/**
+ * @file MappedData.hpp
+ * @brief Read-only bulk data stored in binary files mapped in memory and
+ * referenced by blackboard entries.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Common/Return.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Binary file mapped read-only in memory, unmapped when its last
+//! owner is destroyed.
+//!
+//! A file is mapped once per process: opening it again while it is mapped
+//! returns the same mapping. Since the pages are shared read-only mappings
+//! of the file, the processes mapping it share the same physical memory
+//! (the page cache). Mapped files must not be modified in place: replace
+//! them by renaming a new file over them, the next open() maps the new one.
+// ****************************************************************************
+class MappedFile
+{
+public:
+
+    using Ptr = std::shared_ptr<MappedFile const>;
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    ~MappedFile();
+
+    // ------------------------------------------------------------------------
+    //! \brief Map a file, or get the mapping of this process if it is
+    //! already mapped and unchanged.
+    //! \param[in] p_path Path of the file.
+    //! \return The mapping or an error message.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static robotik::Return<Ptr> open(std::string const& p_path);
+
+    // ------------------------------------------------------------------------
+    //! \brief Canonical path of the file.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& path() const
+    {
+        return m_path;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief First byte of the file (page aligned), nullptr if empty.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] unsigned char const* data() const
+    {
+        return static_cast<unsigned char const*>(m_data);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Size of the file in bytes.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+
+    MappedFile(std::string p_path, void* p_data, size_t p_size)
+        : m_path(std::move(p_path)), m_data(p_data), m_size(p_size)
+    {
+    }
+
+    std::string m_path;
+    void* m_data;
+    size_t m_size;
+};
+
+// ****************************************************************************
+//! \brief Blackboard value giving typed access to an array of T stored in a
+//! mapped file, without copying it. Copying the value copies the view, not
+//! the data, which stays mapped as long as a view refers to it.
+//!
+//! Declared in the Blackboard section of the YAML documents with:
+//! \code
+//!   occupancy: !mmap { file: grid.bin, type: uint8 }
+//!   waypoints: !mmap { file: path.bin, type: double, offset: 64, count: 3000 }
+//! \endcode
+//! and read by the nodes with:
+//! \code
+//!   auto grid = getInput<bt::MappedArray<uint8_t>>("occupancy");
+//!   for (uint8_t cell : *grid) { ... }
+//! \endcode
+// ****************************************************************************
+template <typename T>
+class MappedArray
+{
+public:
+
+    static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                  "MappedArray needs a numeric type");
+
+    using value_type = T;
+    using const_iterator = T const*;
+
+    //! \brief Number of elements meaning "up to the end of the file".
+    static constexpr size_t all = std::numeric_limits<size_t>::max();
+
+    MappedArray() = default;
+
+    // ------------------------------------------------------------------------
+    //! \brief View p_count elements of a mapped file from p_offset.
+    //! \param[in] p_file The mapped file.
+    //! \param[in] p_offset Offset in bytes, multiple of alignof(T).
+    //! \param[in] p_count Number of elements, or all to view up to the end of
+    //!            the file (whose remaining size must then be a multiple of
+    //!            sizeof(T)).
+    //! \return The view, or an error message if out of the file.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static robotik::Return<MappedArray>
+    view(MappedFile::Ptr p_file, size_t p_offset = 0u, size_t p_count = all)
+    {
+        std::string const where = " of '" + p_file->path() + "'";
+        if ((p_offset > p_file->size()) || ((p_offset % alignof(T)) != 0u))
+        {
+            return robotik::Return<MappedArray>::error(
+                "Offset " + std::to_string(p_offset) + where +
+                " is out of the file or misaligned");
+        }
+        size_t const remaining = p_file->size() - p_offset;
+        if (p_count == all)
+        {
+            if ((remaining % sizeof(T)) != 0u)
+            {
+                return robotik::Return<MappedArray>::error(
+                    "Size" + where + " is not a multiple of the element size");
+            }
+            p_count = remaining / sizeof(T);
+        }
+        else if (p_count > remaining / sizeof(T))
+        {
+            return robotik::Return<MappedArray>::error(
+                std::to_string(p_count) + " elements exceed the size" + where);
+        }
+
+        MappedArray array;
+        array.m_data =
+            reinterpret_cast<T const*>(p_file->data() + p_offset);
+        array.m_size = p_count;
+        array.m_offset = p_offset;
+        array.m_file = std::move(p_file);
+        return robotik::Return<MappedArray>::success(std::move(array));
+    }
+
+    [[nodiscard]] T const* data() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_size == 0u;
+    }
+
+    [[nodiscard]] T const& operator[](size_t p_index) const
+    {
+        return m_data[p_index];
+    }
+
+    [[nodiscard]] const_iterator begin() const
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] const_iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Mapped file, nullptr for a default constructed view.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] MappedFile::Ptr const& file() const
+    {
+        return m_file;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Offset in bytes of the first element in the file.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t offset() const
+    {
+        return m_offset;
+    }
+
+private:
+
+    MappedFile::Ptr m_file;
+    T const* m_data = nullptr;
+    size_t m_size = 0u;
+    size_t m_offset = 0u;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Call p_function(T{}, name) for each element type of the mapped
+//! arrays declared in YAML (the name being the one of the 'type' field),
+//! until it returns true.
+//! \return True if p_function returned true.
+// ----------------------------------------------------------------------------
+template <typename Function>
+bool forEachMappedType(Function&& p_function)
+{
+    return p_function(int8_t{}, "int8") || p_function(uint8_t{}, "uint8") ||
+           p_function(int16_t{}, "int16") ||
+           p_function(uint16_t{}, "uint16") ||
+           p_function(int32_t{}, "int32") ||
+           p_function(uint32_t{}, "uint32") ||
+           p_function(int64_t{}, "int64") ||
+           p_function(uint64_t{}, "uint64") || p_function(float{}, "float") ||
+           p_function(double{}, "double");
+}
+
+} // namespace bt
@@ -10,11 +10,23 @@
 
 #include <optional>
 #include <string>
-#include <typeindex>
 #include <unordered_map>
 
 namespace bt {
 
+// ****************************************************************************
+//! \brief RTTI-free type identifier: the address of a variable instantiated
+//! once per type.
+// ****************************************************************************
+using TypeId = void const*;
+
+template <typename T>
+[[nodiscard]] TypeId typeId()
+{
+    static char const id = 0;
+    return &id;
+}
+
 // ****************************************************************************
 //! \brief Enum representing the direction of a Blackboard port.
 //! Directions are similar to C++ function parameters.
@@ -95,7 +107,7 @@ public:
     void addInput(const std::string& p_name,
                   std::optional<T> p_default_value = std::nullopt)
     {
-        m_inputs[p_name] = PortInfo{typeid(T), p_default_value.has_value()};
+        m_inputs[p_name] = PortInfo{typeId<T>(), p_default_value.has_value()};
     }
 
     // ------------------------------------------------------------------------
@@ -105,7 +117,7 @@ public:
     template <typename T>
     void addOutput(const std::string& p_name)
     {
-        m_outputs[p_name] = PortInfo{typeid(T), false};
+        m_outputs[p_name] = PortInfo{typeId<T>(), false};
     }
 
     // ------------------------------------------------------------------------
@@ -139,12 +151,12 @@ private:
     struct PortInfo
     {
         //! \brief The type of the port (e.g. int, double, std::string, etc.)
-        std::type_index type;
+        TypeId type;
         //! \brief True if the port has a default value, false otherwise.
         bool has_default;
 
-        PortInfo() : type(typeid(void)), has_default(false) {}
-        PortInfo(std::type_index t, bool d) : type(t), has_default(d) {}
+        PortInfo() : type(typeId<void>()), has_default(false) {}
+        PortInfo(TypeId t, bool d) : type(t), has_default(d) {}
     };
 
     //! \brief The input ports.
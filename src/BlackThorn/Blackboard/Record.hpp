@@ -0,0 +1,495 @@
+/**
+ * @file Record.hpp
+ * @brief Structured blackboard values typed by a schema: fields stored in a
+ * contiguous buffer at offsets resolved once.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace bt {
+
+// ----------------------------------------------------------------------------
+//! \brief Type of a field of a record.
+// ----------------------------------------------------------------------------
+enum class FieldType
+{
+    Double,
+    Int,
+    Bool,
+    String,
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Field type of the C++ types that records can store.
+// ----------------------------------------------------------------------------
+template <typename T>
+struct FieldTypeOf;
+
+template <>
+struct FieldTypeOf<double>
+{
+    static constexpr FieldType value = FieldType::Double;
+};
+
+template <>
+struct FieldTypeOf<int>
+{
+    static constexpr FieldType value = FieldType::Int;
+};
+
+template <>
+struct FieldTypeOf<bool>
+{
+    static constexpr FieldType value = FieldType::Bool;
+};
+
+template <>
+struct FieldTypeOf<std::string>
+{
+    static constexpr FieldType value = FieldType::String;
+};
+
+class RecordSchema;
+class Record;
+
+// ****************************************************************************
+//! \brief Handle of a field of a record, resolved once from its path by
+//! RecordSchema::field(): reading or writing the field through the handle is
+//! a copy at a fixed offset, without lookup nor type check.
+// ****************************************************************************
+template <typename T>
+class RecordField
+{
+public:
+
+    using Type = T;
+
+private:
+
+    friend class RecordSchema;
+    friend class Record;
+
+    RecordField(RecordSchema const* p_schema, size_t p_offset)
+        : m_schema(p_schema), m_offset(p_offset)
+    {
+    }
+
+    //! \brief Schema of the records the handle applies to.
+    RecordSchema const* m_schema;
+    //! \brief Offset in bytes of the numeric field, or index of the string.
+    size_t m_offset;
+};
+
+// ****************************************************************************
+//! \brief Record type: named and typed fields, nested records being
+//! flattened into their parent (the field "x" of the nested record "pose" is
+//! the field "pose.x").
+//!
+//! The fields are laid out by type in a single buffer: the reals first, as
+//! a contiguous array of doubles (see Record::reals()), then the integers,
+//! then the booleans. Strings are stored aside. Schemas are shared by their
+//! records: they must not be modified once records are created.
+//!
+//! Usage example:
+//! \code
+//!   bt::RecordSchema pose("Pose");
+//!   pose.add("x", bt::FieldType::Double);
+//!   pose.add("y", bt::FieldType::Double);
+//!   bt::RecordSchema robot("Robot");
+//!   robot.add("battery", bt::FieldType::Int);
+//!   robot.add("pose", pose);
+//!   auto schema = std::make_shared<bt::RecordSchema const>(robot);
+//!   auto x = *schema->field<double>("pose.x");
+//! \endcode
+// ****************************************************************************
+class RecordSchema
+{
+public:
+
+    using Ptr = std::shared_ptr<RecordSchema const>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Field of the schema.
+    // ------------------------------------------------------------------------
+    struct Field
+    {
+        //! \brief Dotted path of the field, e.g. "pose.x".
+        std::string path;
+        FieldType type;
+        //! \brief Offset in bytes of the numeric field, or index of the string.
+        size_t offset;
+    };
+
+    explicit RecordSchema(std::string p_name) : m_name(std::move(p_name)) {}
+
+    // ------------------------------------------------------------------------
+    //! \brief Add a field.
+    //! \param[in] p_name Name of the field (not empty, without dot).
+    //! \param[in] p_type Type of the field.
+    //! \return False if the name is invalid or already used.
+    // ------------------------------------------------------------------------
+    bool add(std::string const& p_name, FieldType p_type)
+    {
+        if (!isName(p_name) || conflicts(p_name))
+        {
+            return false;
+        }
+        m_fields.push_back({p_name, p_type, 0u});
+        layout();
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add a nested record, whose fields are flattened as
+    //! "<p_name>.<field>".
+    //! \param[in] p_name Name of the field (not empty, without dot).
+    //! \param[in] p_nested Schema of the nested record.
+    //! \return False if the name is invalid or already used.
+    // ------------------------------------------------------------------------
+    bool add(std::string const& p_name, RecordSchema const& p_nested)
+    {
+        if (!isName(p_name) || conflicts(p_name))
+        {
+            return false;
+        }
+        for (auto const& field : p_nested.m_fields)
+        {
+            m_fields.push_back({p_name + "." + field.path, field.type, 0u});
+        }
+        layout();
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Find a field from its path.
+    //! \return The field or nullptr if the schema has no such field.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Field const* find(std::string_view p_path) const
+    {
+        for (auto const& field : m_fields)
+        {
+            if (field.path == p_path)
+            {
+                return &field;
+            }
+        }
+        return nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Resolve the handle of a field, to be done once (e.g. when the
+    //! tree is built) and reused at each tick.
+    //! \param[in] p_path Dotted path of the field.
+    //! \return The handle or std::nullopt if the schema has no such field of
+    //! type T.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    [[nodiscard]] std::optional<RecordField<T>>
+    field(std::string_view p_path) const
+    {
+        Field const* field = find(p_path);
+        if ((field == nullptr) || (field->type != FieldTypeOf<T>::value))
+        {
+            return std::nullopt;
+        }
+        return RecordField<T>(this, field->offset);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Name of the record type.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& name() const
+    {
+        return m_name;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Fields in their order of declaration.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<Field> const& fields() const
+    {
+        return m_fields;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Size in bytes of the numeric fields.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t bytes() const
+    {
+        return m_bytes;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Number of real fields, stored first.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t reals() const
+    {
+        return m_reals;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Number of string fields.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t strings() const
+    {
+        return m_strings;
+    }
+
+private:
+
+    static bool isName(std::string const& p_name)
+    {
+        return !p_name.empty() && (p_name.find('.') == std::string::npos);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Return true if p_name is a field or the prefix of fields.
+    // ------------------------------------------------------------------------
+    bool conflicts(std::string const& p_name) const
+    {
+        for (auto const& field : m_fields)
+        {
+            if ((field.path.compare(0u, p_name.size(), p_name) == 0) &&
+                ((field.path.size() == p_name.size()) ||
+                 (field.path[p_name.size()] == '.')))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Compute the offsets: reals, then integers, then booleans, so
+    //! that no padding is needed.
+    // ------------------------------------------------------------------------
+    void layout()
+    {
+        m_bytes = 0u;
+        m_reals = 0u;
+        m_strings = 0u;
+        for (FieldType type : {FieldType::Double, FieldType::Int,
+                               FieldType::Bool, FieldType::String})
+        {
+            for (auto& field : m_fields)
+            {
+                if (field.type != type)
+                {
+                    continue;
+                }
+                switch (type)
+                {
+                    case FieldType::Double:
+                        field.offset = m_bytes;
+                        m_bytes += sizeof(double);
+                        ++m_reals;
+                        break;
+                    case FieldType::Int:
+                        field.offset = m_bytes;
+                        m_bytes += sizeof(int);
+                        break;
+                    case FieldType::Bool:
+                        field.offset = m_bytes;
+                        m_bytes += sizeof(bool);
+                        break;
+                    case FieldType::String:
+                        field.offset = m_strings++;
+                        break;
+                }
+            }
+        }
+    }
+
+    std::string m_name;
+    std::vector<Field> m_fields;
+    size_t m_bytes = 0u;
+    size_t m_reals = 0u;
+    size_t m_strings = 0u;
+};
+
+// ****************************************************************************
+//! \brief Structured value of a blackboard entry, typed by its schema.
+//!
+//! Reading a nested value stored as a record costs one blackboard lookup and
+//! a copy at an offset resolved once, instead of a lookup and an any_cast
+//! per level of nested maps. Fields are zero (or empty) until written.
+//!
+//! Usage example:
+//! \code
+//!   static auto const x = *schema->field<double>("pose.x");
+//!   auto const* robot = std::any_cast<bt::Record>(bb->lookup("robot"));
+//!   double value = robot->get(x);
+//!   bb->modify<bt::Record>("robot", [](bt::Record& r) { r.set(x, 2.0); });
+//! \endcode
+// ****************************************************************************
+class Record
+{
+public:
+
+    explicit Record(RecordSchema::Ptr p_schema)
+        : m_schema(std::move(p_schema)),
+          m_numbers((m_schema->bytes() + sizeof(double) - 1u) / sizeof(double),
+                    0.0),
+          m_strings(m_schema->strings())
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Schema of the record.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] RecordSchema const& schema() const
+    {
+        return *m_schema;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read a numeric field through its handle, which must have been
+    //! resolved from the schema of this record.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    [[nodiscard]] T get(RecordField<T> const& p_field) const
+    {
+        T value;
+        std::memcpy(&value, bytes() + p_field.m_offset, sizeof(T));
+        return value;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read a string field through its handle.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const&
+    get(RecordField<std::string> const& p_field) const
+    {
+        return m_strings[p_field.m_offset];
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Write a numeric field through its handle.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    void set(RecordField<T> const& p_field, T const& p_value)
+    {
+        std::memcpy(bytes() + p_field.m_offset, &p_value, sizeof(T));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Write a string field through its handle.
+    // ------------------------------------------------------------------------
+    void set(RecordField<std::string> const& p_field, std::string p_value)
+    {
+        m_strings[p_field.m_offset] = std::move(p_value);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read a field from its path (resolved at each call).
+    //! \return The value or std::nullopt if there is no such field of type T.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    [[nodiscard]] std::optional<T> get(std::string_view p_path) const
+    {
+        if (auto field = m_schema->field<T>(p_path))
+        {
+            return get(*field);
+        }
+        return std::nullopt;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Write a field from its path (resolved at each call).
+    //! \return False if there is no such field of type T.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    bool set(std::string_view p_path, T p_value)
+    {
+        if (auto field = m_schema->field<T>(p_path))
+        {
+            set(*field, std::move(p_value));
+            return true;
+        }
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Contiguous array of the schema().reals() real fields, for
+    //! vectorized processing.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] double const* reals() const
+    {
+        return m_numbers.data();
+    }
+
+    [[nodiscard]] double* reals()
+    {
+        return m_numbers.data();
+    }
+
+private:
+
+    unsigned char const* bytes() const
+    {
+        return reinterpret_cast<unsigned char const*>(m_numbers.data());
+    }
+
+    unsigned char* bytes()
+    {
+        return reinterpret_cast<unsigned char*>(m_numbers.data());
+    }
+
+    RecordSchema::Ptr m_schema;
+    //! \brief Numeric fields, stored in doubles for their alignment.
+    std::vector<double> m_numbers;
+    std::vector<std::string> m_strings;
+};
+
+// ****************************************************************************
+//! \brief Registry of the record schemas, by name. Schemas are declared in
+//! the 'Schemas' section of the YAML documents, or registered from C++ and
+//! given to NodeFactory::setRecordSchemas().
+// ****************************************************************************
+class RecordSchemas
+{
+public:
+
+    using Ptr = std::shared_ptr<RecordSchemas>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Register a schema (replacing any with the same name).
+    // ------------------------------------------------------------------------
+    void add(RecordSchema::Ptr p_schema)
+    {
+        std::string name = p_schema->name();
+        m_schemas[std::move(name)] = std::move(p_schema);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Find a schema from its name.
+    //! \return The schema or nullptr if unknown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] RecordSchema::Ptr find(std::string const& p_name) const
+    {
+        auto it = m_schemas.find(p_name);
+        return (it != m_schemas.end()) ? it->second : nullptr;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return m_schemas.empty();
+    }
+
+private:
+
+    std::unordered_map<std::string, RecordSchema::Ptr> m_schemas;
+};
+
+} // namespace bt
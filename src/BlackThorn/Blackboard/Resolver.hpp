@@ -9,10 +9,11 @@
 #pragma once
 
 #include "BlackThorn/Blackboard/Blackboard.hpp"
+#include "BlackThorn/Common/Literal.hpp"
 
 #include <optional>
-#include <regex>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 namespace bt {
@@ -27,6 +28,28 @@ class VariableResolver
 {
 public:
 
+    // ------------------------------------------------------------------------
+    //! \brief Check if an expression is a reference ${key}.
+    //! \param[in] p_expr The expression.
+    //! \param[out] p_key The referenced key (a view of p_expr), when true.
+    //! \return True if the whole expression is a reference to a non empty key.
+    // ------------------------------------------------------------------------
+    static bool isReference(std::string_view p_expr, std::string_view& p_key)
+    {
+        if ((p_expr.size() < 4u) || (p_expr.compare(0u, 2u, "${") != 0) ||
+            (p_expr.back() != '}'))
+        {
+            return false;
+        }
+        std::string_view key = p_expr.substr(2u, p_expr.size() - 3u);
+        if (key.find('}') != std::string_view::npos)
+        {
+            return false;
+        }
+        p_key = key;
+        return true;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Resolve a variable.
     //! \param[in] p_str The string to resolve.
@@ -35,31 +58,37 @@ public:
     // ------------------------------------------------------------------------
     static std::string resolve(const std::string& p_str, const Blackboard& p_bb)
     {
-        std::regex pattern(R"(\$\{([^}]+)\})");
         std::string result = p_str;
-        std::smatch match;
 
-        auto search_start = result.cbegin();
-        while (std::regex_search(search_start, result.cend(), match, pattern))
+        std::string::size_type search_start = 0u;
+        while (true)
         {
-            std::string key = match[1].str();
+            auto const pos = result.find("${", search_start);
+            if (pos == std::string::npos)
+            {
+                break;
+            }
+            auto const end = result.find('}', pos + 2u);
+            if (end == std::string::npos)
+            {
+                break;
+            }
+            if (end == pos + 2u) // Empty key
+            {
+                search_start = end + 1u;
+                continue;
+            }
 
+            std::string_view key =
+                std::string_view(result).substr(pos + 2u, end - pos - 2u);
             if (auto value = p_bb.get<std::string>(key))
             {
-                const auto offset = static_cast<std::string::size_type>(
-                    std::distance(result.cbegin(), search_start));
-                const auto pos = offset + static_cast<std::string::size_type>(
-                                              match.position(0));
-                const auto len =
-                    static_cast<std::string::size_type>(match.length(0));
-                result.replace(pos, len, *value);
-                const std::string::size_type new_index = pos + value->length();
-                search_start =
-                    result.cbegin() + static_cast<std::ptrdiff_t>(new_index);
+                result.replace(pos, end - pos + 1u, *value);
+                search_start = pos + value->length();
             }
             else
             {
-                search_start = match.suffix().first;
+                search_start = end + 1u;
             }
         }
 
@@ -77,12 +106,9 @@ public:
                                          const Blackboard& p_bb)
     {
         // If it is a reference ${key}
-        std::regex pattern(R"(\$\{([^}]+)\})");
-        std::smatch match;
-
-        if (std::regex_match(p_expr, match, pattern))
+        std::string_view key;
+        if (isReference(p_expr, key))
         {
-            std::string key = match[1].str();
             return p_bb.get<T>(key);
         }
 
@@ -93,9 +119,11 @@ public:
 private:
 
     // ------------------------------------------------------------------------
-    //! \brief Parse a literal value.
+    //! \brief Parse a literal value with the grammar of literal::parseInt(),
+    //! literal::parseDouble() and literal::parseBool() (plus "1" and "0" for
+    //! booleans). The whole text must match: " 12" or "12px" are not integers.
     //! \param[in] p_str The string to parse.
-    //! \return The parsed value.
+    //! \return The parsed value, or std::nullopt if malformed.
     // ------------------------------------------------------------------------
     template <typename T>
     static std::optional<T> parseLiteral(const std::string& p_str)
@@ -104,34 +132,29 @@ private:
         {
             return p_str;
         }
-        else if constexpr (std::is_same_v<T, int>)
+        else if constexpr (std::is_same_v<T, bool>)
         {
-            try
-            {
-                return std::stoi(p_str);
-            }
-            catch (...)
-            {
-                return std::nullopt;
-            }
+            bool value = false;
+            if (literal::parseBool(p_str, value))
+                return value;
+            if (p_str == "1")
+                return true;
+            if (p_str == "0")
+                return false;
+            return std::nullopt;
         }
-        else if constexpr (std::is_same_v<T, double>)
+        else if constexpr (std::is_integral_v<T>)
         {
-            try
-            {
-                return std::stod(p_str);
-            }
-            catch (...)
-            {
-                return std::nullopt;
-            }
+            T value = 0;
+            if (literal::parseInt(p_str, value))
+                return value;
+            return std::nullopt;
         }
-        else if constexpr (std::is_same_v<T, bool>)
+        else if constexpr (std::is_floating_point_v<T>)
         {
-            if (p_str == "true" || p_str == "1")
-                return true;
-            if (p_str == "false" || p_str == "0")
-                return false;
+            double value = 0.0;
+            if (literal::parseDouble(p_str, value))
+                return T(value);
             return std::nullopt;
         }
         return std::nullopt;
@@ -9,8 +9,13 @@
 #pragma once
 
 #include "BlackThorn/Blackboard/Blackboard.hpp"
+#include "BlackThorn/Blackboard/MappedData.hpp"
+#include "BlackThorn/Blackboard/Record.hpp"
+#include "BlackThorn/Blackboard/Resolver.hpp"
+#include "BlackThorn/Common/Literal.hpp"
 
-#include <regex>
+#include <filesystem>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <yaml-cpp/yaml.h>
@@ -28,33 +33,78 @@ namespace bt {
 //! - Load the blackboard content from a YAML node.
 //! - Store the blackboard content into a YAML node.
 //! - Resolve ${var} references in the blackboard content.
+//! - Infer the type of the scalars (int, double, bool, else string) with the
+//!   exception-free literal parser shared with VariableResolver and
+//!   SetBlackboard (see literal::classify()).
+//! - Store the maps tagged with the name of a record schema ("!Robot") as
+//!   Record values instead of nested std::unordered_map<std::string,
+//!   std::any>.
+//! - Store the maps tagged "!mmap" as MappedArray views of binary files
+//!   mapped in memory, instead of loading bulk data from YAML.
 // ****************************************************************************
 class BlackboardSerializer
 {
 public:
 
+    // ------------------------------------------------------------------------
+    //! \brief What the values of a YAML document may refer to.
+    // ------------------------------------------------------------------------
+    struct Context
+    {
+        //! \brief Scope used to resolve ${var} references, if any.
+        Blackboard const* scope = nullptr;
+        //! \brief Schemas of the tagged maps, if any.
+        RecordSchemas const* schemas = nullptr;
+        //! \brief Directory of the relative paths of the !mmap files (the
+        //! working directory if empty).
+        std::filesystem::path directory;
+    };
+
     // ------------------------------------------------------------------------
     //! \brief Populate a blackboard from a YAML node.
     //! \param[in,out] p_target Blackboard to populate.
     //! \param[in] p_node YAML map containing key/value pairs.
     //! \param[in] p_reference Optional scope used to resolve ${var} references.
+    //! \param[in] p_schemas Optional schemas of the tagged maps.
+    //! \throw YAML::Exception if a tagged map does not match its schema or if
+    //! a !mmap file cannot be mapped.
+    // ------------------------------------------------------------------------
+    static void load(Blackboard& p_target,
+                     YAML::Node const& p_node,
+                     Blackboard const* p_reference = nullptr,
+                     RecordSchemas const* p_schemas = nullptr)
+    {
+        load(p_target, p_node, Context{p_reference, p_schemas, {}});
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Populate a blackboard from a YAML node.
+    //! \param[in,out] p_target Blackboard to populate.
+    //! \param[in] p_node YAML map containing key/value pairs.
+    //! \param[in] p_context What the values may refer to. Without scope, the
+    //!            references are resolved in p_target.
+    //! \throw YAML::Exception if a tagged map does not match its schema or if
+    //! a !mmap file cannot be mapped.
     // ------------------------------------------------------------------------
     static void load(Blackboard& p_target,
                      YAML::Node const& p_node,
-                     Blackboard const* p_reference = nullptr)
+                     Context const& p_context)
     {
         if (!p_node || !p_node.IsMap())
         {
             return;
         }
 
-        Blackboard const* scope =
-            p_reference != nullptr ? p_reference : &p_target;
+        Context context = p_context;
+        if (context.scope == nullptr)
+        {
+            context.scope = &p_target;
+        }
 
         for (auto const& entry : p_node)
         {
-            auto key = entry.first.as<std::string>();
-            p_target.m_data[key] = toAny(entry.second, scope);
+            p_target.setRaw(entry.first.Scalar(),
+                            toAny(entry.second, context));
         }
     }
 
@@ -66,73 +116,60 @@ public:
     [[nodiscard]] static YAML::Node dump(Blackboard const& p_source)
     {
         YAML::Node node(YAML::NodeType::Map);
-        for (auto const& [key, value] : p_source.m_data)
+        for (auto const& [key, entry] : *p_source.m_data)
         {
-            node[key] = toYaml(value);
+            node[key.name()] = toYaml(*entry.value);
         }
         return node;
     }
 
 private:
 
-    static bool isReference(std::string const& p_literal, std::string& p_key)
+    static std::any toAny(YAML::Node const& p_node, Context const& p_context)
     {
-        static std::regex pattern(R"(\$\{([^}]+)\})");
-        std::smatch match;
-        if (std::regex_match(p_literal, match, pattern))
+        if (!p_node)
         {
-            p_key = match[1].str();
-            return true;
+            return {};
         }
-        return false;
-    }
 
-    static std::any toAny(YAML::Node const& p_node, Blackboard const* p_scope)
-    {
-        if (!p_node)
+        if (p_node.Tag() == "!mmap")
         {
-            return {};
+            return toMappedArray(p_node, p_context.directory);
+        }
+        if ((p_context.schemas != nullptr) && (p_node.Tag().size() > 1u) &&
+            (p_node.Tag()[0] == '!'))
+        {
+            if (auto schema = p_context.schemas->find(p_node.Tag().substr(1u)))
+            {
+                return toRecord(p_node, schema);
+            }
         }
 
         if (p_node.IsScalar())
         {
-            std::string literal = p_node.Scalar();
-            std::string key;
-            if (p_scope != nullptr && isReference(literal, key))
+            std::string const& literal = p_node.Scalar();
+            std::string_view key;
+            if (p_context.scope != nullptr &&
+                VariableResolver::isReference(literal, key))
             {
-                if (auto value = p_scope->raw(key))
+                if (auto value = p_context.scope->raw(key))
                 {
                     return *value;
                 }
             }
 
-            try
-            {
-                int i = p_node.as<int>();
-                return i;
-            }
-            catch (...)
-            {
-            }
-
-            try
+            literal::Scalar const scalar = literal::classify(literal);
+            switch (scalar.type)
             {
-                double d = p_node.as<double>();
-                return d;
+                case literal::Scalar::Type::Int:
+                    return scalar.integer;
+                case literal::Scalar::Type::Double:
+                    return scalar.real;
+                case literal::Scalar::Type::Bool:
+                    return scalar.boolean;
+                case literal::Scalar::Type::String:
+                    break;
             }
-            catch (...)
-            {
-            }
-
-            try
-            {
-                bool b = p_node.as<bool>();
-                return b;
-            }
-            catch (...)
-            {
-            }
-
             return literal;
         }
 
@@ -147,7 +184,7 @@ private:
 
             for (auto const& element : p_node)
             {
-                auto entry = toAny(element, p_scope);
+                auto entry = toAny(element, p_context);
 
                 if (entry.type() == typeid(int))
                 {
@@ -180,7 +217,7 @@ private:
             for (auto const& element : p_node)
             {
                 map.emplace(element.first.as<std::string>(),
-                            toAny(element.second, p_scope));
+                            toAny(element.second, p_context));
             }
             return map;
         }
@@ -188,6 +225,222 @@ private:
         return {};
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Convert a YAML map tagged !mmap to a MappedArray of the element
+    //! type given by its 'type' field.
+    //! \throw YAML::Exception if the map is malformed or the file cannot be
+    //! mapped.
+    // ------------------------------------------------------------------------
+    static std::any toMappedArray(YAML::Node const& p_node,
+                                  std::filesystem::path const& p_directory)
+    {
+        auto fail = [&p_node](std::string const& p_message)
+        { throw YAML::Exception(p_node.Mark(), "!mmap: " + p_message); };
+
+        if (!p_node.IsMap() || !p_node["file"] || !p_node["type"])
+        {
+            fail("expecting a map with the 'file' and 'type' fields");
+        }
+        size_t offset = 0u;
+        size_t count = MappedArray<uint8_t>::all;
+        if ((p_node["offset"] &&
+             !literal::parseInt(p_node["offset"].Scalar(), offset)) ||
+            (p_node["count"] &&
+             !literal::parseInt(p_node["count"].Scalar(), count)))
+        {
+            fail("'offset' and 'count' must be non-negative integers");
+        }
+
+        std::filesystem::path path(p_node["file"].Scalar());
+        if (path.is_relative() && !p_directory.empty())
+        {
+            path = p_directory / path;
+        }
+        auto file = MappedFile::open(path.string());
+        if (!file)
+        {
+            fail(file.getError());
+        }
+
+        std::string const& type = p_node["type"].Scalar();
+        std::any value;
+        bool const known = forEachMappedType(
+            [&](auto p_element, char const* p_name)
+            {
+                if (type != p_name)
+                {
+                    return false;
+                }
+                using T = decltype(p_element);
+                auto array =
+                    MappedArray<T>::view(file.getValue(), offset, count);
+                if (!array)
+                {
+                    fail(array.getError());
+                }
+                value = array.moveValue();
+                return true;
+            });
+        if (!known)
+        {
+            fail("unknown element type '" + type + "'");
+        }
+        return value;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Convert a MappedArray to a YAML map tagged !mmap.
+    //! \return True if p_value is a MappedArray.
+    // ------------------------------------------------------------------------
+    static bool mappedToYaml(std::any const& p_value, YAML::Node& p_node)
+    {
+        return forEachMappedType(
+            [&](auto p_element, char const* p_name)
+            {
+                using T = decltype(p_element);
+                auto const* array = std::any_cast<MappedArray<T>>(&p_value);
+                if ((array == nullptr) || !array->file())
+                {
+                    return false;
+                }
+                p_node = YAML::Node(YAML::NodeType::Map);
+                p_node.SetTag("!mmap");
+                p_node["file"] = array->file()->path();
+                p_node["type"] = p_name;
+                p_node["offset"] = array->offset();
+                p_node["count"] = array->size();
+                return true;
+            });
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Convert a YAML map tagged with the name of a schema to a record.
+    //! \throw YAML::Exception if the map does not match the schema.
+    // ------------------------------------------------------------------------
+    static Record toRecord(YAML::Node const& p_node,
+                           RecordSchema::Ptr const& p_schema)
+    {
+        if (!p_node.IsMap())
+        {
+            throw YAML::Exception(p_node.Mark(),
+                                  "record '" + p_schema->name() +
+                                      "' must be a map");
+        }
+        Record record(p_schema);
+        fill(record, p_node, std::string());
+        return record;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Write the fields of a YAML map (nested maps being nested
+    //! records) into a record.
+    // ------------------------------------------------------------------------
+    static void fill(Record& p_record,
+                     YAML::Node const& p_node,
+                     std::string const& p_prefix)
+    {
+        for (auto const& element : p_node)
+        {
+            std::string path = p_prefix + element.first.Scalar();
+            YAML::Node const& value = element.second;
+            if (value.IsMap())
+            {
+                fill(p_record, value, path + ".");
+                continue;
+            }
+
+            auto const* field = p_record.schema().find(path);
+            if ((field == nullptr) || !value.IsScalar())
+            {
+                throw YAML::Exception(value.Mark(),
+                                      "no field '" + path + "' in record '" +
+                                          p_record.schema().name() + "'");
+            }
+            if (!setField(p_record, *field, value.Scalar()))
+            {
+                throw YAML::Exception(value.Mark(),
+                                      "bad value for the field '" + path +
+                                          "' of record '" +
+                                          p_record.schema().name() + "'");
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Parse the text of a field with the literal grammar of its type.
+    //! \return False if malformed.
+    // ------------------------------------------------------------------------
+    static bool setField(Record& p_record,
+                         RecordSchema::Field const& p_field,
+                         std::string const& p_text)
+    {
+        switch (p_field.type)
+        {
+            case FieldType::Double:
+            {
+                double value = 0.0;
+                return literal::parseDouble(p_text, value) &&
+                       p_record.set(p_field.path, value);
+            }
+            case FieldType::Int:
+            {
+                int value = 0;
+                return literal::parseInt(p_text, value) &&
+                       p_record.set(p_field.path, value);
+            }
+            case FieldType::Bool:
+            {
+                bool value = false;
+                return literal::parseBool(p_text, value) &&
+                       p_record.set(p_field.path, value);
+            }
+            case FieldType::String:
+                return p_record.set(p_field.path, p_text);
+        }
+        return false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Convert a record to a YAML map tagged with its schema name, its
+    //! nested records being nested maps.
+    // ------------------------------------------------------------------------
+    static YAML::Node toYaml(Record const& p_record)
+    {
+        YAML::Node node(YAML::NodeType::Map);
+        node.SetTag("!" + p_record.schema().name());
+        for (auto const& field : p_record.schema().fields())
+        {
+            // Walk down the nested maps of the dotted path
+            YAML::Node parent = node;
+            std::string_view path = field.path;
+            for (size_t dot = path.find('.'); dot != std::string_view::npos;
+                 dot = path.find('.'))
+            {
+                YAML::Node child = parent[std::string(path.substr(0u, dot))];
+                parent.reset(child);
+                path.remove_prefix(dot + 1u);
+            }
+
+            std::string const key(path);
+            switch (field.type)
+            {
+                case FieldType::Double:
+                    parent[key] = *p_record.get<double>(field.path);
+                    break;
+                case FieldType::Int:
+                    parent[key] = *p_record.get<int>(field.path);
+                    break;
+                case FieldType::Bool:
+                    parent[key] = *p_record.get<bool>(field.path);
+                    break;
+                case FieldType::String:
+                    parent[key] = *p_record.get<std::string>(field.path);
+                    break;
+            }
+        }
+        return node;
+    }
+
     static YAML::Node toYaml(std::any const& p_value)
     {
         if (!p_value.has_value())
@@ -231,6 +484,14 @@ private:
             }
             return node;
         }
+        if (auto const* record = std::any_cast<Record>(&p_value))
+        {
+            return toYaml(*record);
+        }
+        if (YAML::Node node; mappedToYaml(p_value, node))
+        {
+            return node;
+        }
         if (p_value.type() == typeid(std::unordered_map<std::string, std::any>))
         {
             YAML::Node node(YAML::NodeType::Map);
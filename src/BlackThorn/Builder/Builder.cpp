@@ -9,29 +9,99 @@
 
 #include "BlackThorn/Builder/Builder.hpp"
 #include "BlackThorn/BlackThorn.hpp"
+#include "BlackThorn/Common/Literal.hpp"
 
+#include <algorithm>
+#include <filesystem>
 #include <functional>
+#include <mutex>
 #include <unordered_map>
 #include <yaml-cpp/yaml.h>
 
 namespace bt {
 
 // ****************************************************************************
-//! \brief Context structure for parsing, containing factory and blackboard
+//! \brief Reusable subtree definitions of a YAML document: its own 'SubTrees'
+//! section and the libraries of its 'include' section. Libraries are shared,
+//! and only read once loaded.
 // ****************************************************************************
 struct SubTreeRegistry
 {
+    // ------------------------------------------------------------------------
+    //! \brief Find the definition of a subtree: local definitions first, then
+    //! the included libraries in their order of inclusion.
+    //! \return The definition or nullptr if unknown.
+    // ------------------------------------------------------------------------
+    YAML::Node const* find(std::string const& p_name) const
+    {
+        auto it = definitions.find(p_name);
+        if (it != definitions.end())
+        {
+            return &it->second;
+        }
+        for (auto const& library : includes)
+        {
+            if (auto definition = library->find(p_name); definition)
+            {
+                return definition;
+            }
+        }
+        return nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Return true if no subtree can be found.
+    // ------------------------------------------------------------------------
+    bool empty() const
+    {
+        return definitions.empty() && includes.empty();
+    }
+
     std::unordered_map<std::string, YAML::Node> definitions;
+    std::vector<std::shared_ptr<SubTreeRegistry const>> includes;
 };
 
+// ****************************************************************************
+//! \brief Context structure for parsing, containing factory and blackboard
+// ****************************************************************************
+
 struct ParsingContext
 {
     NodeFactory const& factory;
     Blackboard::Ptr blackboard;
     SubTreeRegistry const* subtrees = nullptr;
+    BlackboardSerializer::Context const* document = nullptr;
     mutable uint32_t next_id = 1; // Auto-increment ID counter
 };
 
+// ----------------------------------------------------------------------------
+//! \brief Convert a YAML scalar field to an integer or a boolean with the
+//! literal grammar shared with the blackboard loader (see Literal.hpp),
+//! instead of the stream based YAML::Node::as().
+//! \throw YAML::TypedBadConversion<T> if the field is malformed, reported like
+//! the other errors of the YAML document.
+// ----------------------------------------------------------------------------
+template <typename T>
+static T scalarAs(YAML::Node const& p_node)
+{
+    T value{};
+    if (p_node.IsScalar())
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if (literal::parseBool(p_node.Scalar(), value))
+            {
+                return value;
+            }
+        }
+        else if (literal::parseInt(p_node.Scalar(), value))
+        {
+            return value;
+        }
+    }
+    throw YAML::TypedBadConversion<T>(p_node.Mark());
+}
+
 // ----------------------------------------------------------------------------
 //! \brief Assign ID to a node from YAML _id field or auto-generate
 // ----------------------------------------------------------------------------
@@ -41,11 +111,12 @@ static void assignNodeId(Node& p_node,
 {
     if (p_content["_id"])
     {
-        p_node.setId(p_content["_id"].as<uint32_t>());
+        uint32_t const id = scalarAs<uint32_t>(p_content["_id"]);
+        p_node.setId(id);
         // Update counter to avoid collisions with auto-generated IDs
-        if (p_content["_id"].as<uint32_t>() >= p_context.next_id)
+        if (id >= p_context.next_id)
         {
-            p_context.next_id = p_content["_id"].as<uint32_t>() + 1;
+            p_context.next_id = id + 1;
         }
     }
     else
@@ -68,13 +139,21 @@ parseYAMLNodeInternal(ParsingContext const& p_context,
 // ----------------------------------------------------------------------------
 static std::string getNodeName(YAML::Node const& p_content)
 {
-    return p_content["name"] ? p_content["name"].as<std::string>()
-                             : p_content.begin()->first.as<std::string>();
+    if (p_content["name"])
+    {
+        return p_content["name"].as<std::string>();
+    }
+    // Empty content (e.g. "Success: {}") has no key to fall back on
+    return (p_content.IsMap() && (p_content.size() > 0u))
+               ? p_content.begin()->first.as<std::string>()
+               : std::string();
 }
 
 // ----------------------------------------------------------------------------
 //! \brief Extract port remapping from YAML parameters section.
 //! Converts YAML parameters to a map of port name -> blackboard key.
+//! Structured parameters (maps, sequences, records) are not remapped: the
+//! port reads the entry of the same name, set by loadLiteralParameters().
 // ----------------------------------------------------------------------------
 static std::unordered_map<std::string, std::string>
 extractPortRemapping(YAML::Node const& p_parameters)
@@ -84,6 +163,10 @@ extractPortRemapping(YAML::Node const& p_parameters)
     {
         for (auto const& param : p_parameters)
         {
+            if (!param.second.IsScalar())
+            {
+                continue;
+            }
             remapping[param.first.as<std::string>()] =
                 param.second.as<std::string>();
         }
@@ -95,16 +178,16 @@ extractPortRemapping(YAML::Node const& p_parameters)
 //! \brief Load only literal parameters into blackboard.
 //! Skips ${...} references which are only used for port remapping.
 // ----------------------------------------------------------------------------
-static void loadLiteralParameters(Blackboard& p_bb,
-                                  YAML::Node const& p_parameters)
+static void
+loadLiteralParameters(Blackboard& p_bb,
+                      YAML::Node const& p_parameters,
+                      BlackboardSerializer::Context const* p_document)
 {
     if (!p_parameters || !p_parameters.IsMap())
     {
         return;
     }
 
-    std::regex refPattern(R"(\$\{([^}]+)\})");
-
     for (auto const& param : p_parameters)
     {
         auto const& valueNode = param.second;
@@ -112,8 +195,8 @@ static void loadLiteralParameters(Blackboard& p_bb,
         // Skip ${...} references - they're for port remapping only
         if (valueNode.IsScalar())
         {
-            std::string value = valueNode.as<std::string>();
-            if (std::regex_match(value, refPattern))
+            std::string_view key;
+            if (VariableResolver::isReference(valueNode.Scalar(), key))
             {
                 continue; // Skip reference
             }
@@ -123,7 +206,10 @@ static void loadLiteralParameters(Blackboard& p_bb,
         std::string key = param.first.as<std::string>();
         YAML::Node single;
         single[key] = valueNode;
-        BlackboardSerializer::load(p_bb, single, &p_bb);
+        BlackboardSerializer::Context context =
+            p_document ? *p_document : BlackboardSerializer::Context();
+        context.scope = &p_bb;
+        BlackboardSerializer::load(p_bb, single, context);
     }
 }
 
@@ -171,14 +257,221 @@ parseChildren(ParsingContext const& p_context,
         std::move(children));
 }
 
+// ----------------------------------------------------------------------------
+//! \brief File read to build a library, with its modification time when read.
+// ----------------------------------------------------------------------------
+struct LibraryFile
+{
+    std::string path;
+    std::filesystem::file_time_type mtime;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Library loaded from a file.
+// ----------------------------------------------------------------------------
+struct LibraryEntry
+{
+    std::shared_ptr<SubTreeRegistry const> registry;
+    //! \brief The library file and the files it includes, directly or not.
+    std::vector<LibraryFile> files;
+};
+
+static robotik::Return<SubTreeRegistry>
+buildSubTreeRegistry(YAML::Node const& p_root,
+                     std::filesystem::path const& p_directory,
+                     std::vector<std::string>& p_stack,
+                     std::vector<LibraryFile>& p_files);
+
+// ****************************************************************************
+//! \brief Process-wide cache of the subtree libraries, indexed by canonical
+//! path. Files are parsed outside the lock, so that nested includes and
+//! concurrent builds of other libraries do not wait for each other: when two
+//! threads load the same file at the same time, both parse it and the last
+//! one wins, which is harmless since the results are the same.
+// ****************************************************************************
+class SubTreeLibrary
+{
+public:
+
+    static SubTreeLibrary& instance()
+    {
+        static SubTreeLibrary library;
+        return library;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the library of the given file, parsed again if the file or
+    //! one of its includes changed since it was cached.
+    //! \param[in,out] p_stack Libraries being loaded, to detect cycles.
+    // ------------------------------------------------------------------------
+    robotik::Return<LibraryEntry> load(std::filesystem::path const& p_path,
+                                       std::vector<std::string>& p_stack)
+    {
+        std::error_code error;
+        auto const path = std::filesystem::canonical(p_path, error);
+        if (error)
+        {
+            return robotik::Return<LibraryEntry>::error(
+                "Cannot find subtree library '" + p_path.string() + "'");
+        }
+
+        std::string const key = path.string();
+        if (std::find(p_stack.begin(), p_stack.end(), key) != p_stack.end())
+        {
+            return robotik::Return<LibraryEntry>::error(
+                "Circular include of subtree library '" + key + "'");
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_entries.find(key);
+            if ((it != m_entries.end()) && isUpToDate(it->second))
+            {
+                ++m_statistics.hits;
+                return robotik::Return<LibraryEntry>::success(it->second);
+            }
+        }
+
+        // Read the modification time first: a change made while parsing is
+        // seen by the next load.
+        std::vector<LibraryFile> files{
+            {key, std::filesystem::last_write_time(path, error)}};
+        YAML::Node root = YAML::LoadFile(key);
+        p_stack.push_back(key);
+        auto registry =
+            buildSubTreeRegistry(root, path.parent_path(), p_stack, files);
+        p_stack.pop_back();
+        if (!registry)
+        {
+            return robotik::Return<LibraryEntry>::error(
+                "In subtree library '" + key + "': " + registry.getError());
+        }
+
+        LibraryEntry entry{
+            std::make_shared<SubTreeRegistry const>(registry.moveValue()),
+            std::move(files)};
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries[key] = entry;
+        ++m_statistics.loads;
+        return robotik::Return<LibraryEntry>::success(std::move(entry));
+    }
+
+    Builder::LibraryStatistics statistics()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Builder::LibraryStatistics statistics = m_statistics;
+        statistics.files = m_entries.size();
+        return statistics;
+    }
+
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Return true if none of the files of the entry changed.
+    // ------------------------------------------------------------------------
+    static bool isUpToDate(LibraryEntry const& p_entry)
+    {
+        for (auto const& file : p_entry.files)
+        {
+            std::error_code error;
+            auto mtime = std::filesystem::last_write_time(file.path, error);
+            if (error || (mtime != file.mtime))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, LibraryEntry> m_entries;
+    Builder::LibraryStatistics m_statistics;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Get the paths of the 'include' section: a path or a list of paths.
+// ----------------------------------------------------------------------------
+static robotik::Return<std::vector<std::string>>
+getIncludes(YAML::Node const& p_root)
+{
+    std::vector<std::string> paths;
+    YAML::Node const includes = p_root["include"];
+    if (!includes)
+    {
+        return robotik::Return<std::vector<std::string>>::success(
+            std::move(paths));
+    }
+
+    if (includes.IsScalar())
+    {
+        paths.push_back(includes.as<std::string>());
+    }
+    else if (includes.IsSequence())
+    {
+        for (auto const& include : includes)
+        {
+            if (!include.IsScalar())
+            {
+                return robotik::Return<std::vector<std::string>>::error(
+                    "'include' entries must be file paths");
+            }
+            paths.push_back(include.as<std::string>());
+        }
+    }
+    else
+    {
+        return robotik::Return<std::vector<std::string>>::error(
+            "'include' section must be a file path or a list of file paths");
+    }
+
+    return robotik::Return<std::vector<std::string>>::success(
+        std::move(paths));
+}
+
 // ----------------------------------------------------------------------------
 //! \brief Build the registry of reusable subtrees if provided in YAML input.
+//! \param[in] p_directory Directory of the relative include paths.
+//! \param[in,out] p_stack Libraries being loaded, to detect cycles.
+//! \param[in,out] p_files Receives the files of the included libraries.
 // ----------------------------------------------------------------------------
 static robotik::Return<SubTreeRegistry>
-buildSubTreeRegistry(YAML::Node const& p_root)
+buildSubTreeRegistry(YAML::Node const& p_root,
+                     std::filesystem::path const& p_directory,
+                     std::vector<std::string>& p_stack,
+                     std::vector<LibraryFile>& p_files)
 {
     SubTreeRegistry registry;
 
+    auto includes = getIncludes(p_root);
+    if (!includes)
+    {
+        return robotik::Return<SubTreeRegistry>::error(includes.getError());
+    }
+    for (auto const& include : includes.getValue())
+    {
+        std::filesystem::path path(include);
+        if (path.is_relative())
+        {
+            path = p_directory / path;
+        }
+        auto library = SubTreeLibrary::instance().load(path, p_stack);
+        if (!library)
+        {
+            return robotik::Return<SubTreeRegistry>::error(library.getError());
+        }
+        auto entry = library.moveValue();
+        registry.includes.push_back(std::move(entry.registry));
+        p_files.insert(p_files.end(), entry.files.begin(), entry.files.end());
+    }
+
     if (!p_root["SubTrees"])
     {
         return robotik::Return<SubTreeRegistry>::success(std::move(registry));
@@ -199,6 +492,122 @@ buildSubTreeRegistry(YAML::Node const& p_root)
     return robotik::Return<SubTreeRegistry>::success(std::move(registry));
 }
 
+// ----------------------------------------------------------------------------
+//! \brief Build the registry of reusable subtrees of a tree document.
+//! \param[in] p_directory Directory of the relative include paths.
+// ----------------------------------------------------------------------------
+static robotik::Return<SubTreeRegistry>
+buildSubTreeRegistry(YAML::Node const& p_root,
+                     std::filesystem::path const& p_directory)
+{
+    std::vector<std::string> stack;
+    std::vector<LibraryFile> files;
+    return buildSubTreeRegistry(p_root, p_directory, stack, files);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Build the record schemas of a tree document: the ones registered in
+//! the factory, then the ones of its 'Schemas' section, in their order of
+//! declaration (a schema can nest the previous ones).
+//! \return The schemas, or nullptr if there is none.
+// ----------------------------------------------------------------------------
+static robotik::Return<RecordSchemas::Ptr>
+buildRecordSchemas(NodeFactory const& p_factory, YAML::Node const& p_root)
+{
+    YAML::Node const section = p_root["Schemas"];
+    if (!section)
+    {
+        return robotik::Return<RecordSchemas::Ptr>::success(
+            p_factory.recordSchemas());
+    }
+    if (!section.IsMap())
+    {
+        return robotik::Return<RecordSchemas::Ptr>::error(
+            "'Schemas' section must be a map of name -> fields");
+    }
+
+    auto schemas = p_factory.recordSchemas()
+                       ? std::make_shared<RecordSchemas>(
+                             *p_factory.recordSchemas())
+                       : std::make_shared<RecordSchemas>();
+    for (auto const& entry : section)
+    {
+        std::string const& name = entry.first.Scalar();
+        if (!entry.second.IsMap())
+        {
+            return robotik::Return<RecordSchemas::Ptr>::error(
+                "Schema '" + name + "' must be a map of field -> type");
+        }
+
+        RecordSchema schema(name);
+        for (auto const& field : entry.second)
+        {
+            std::string const& field_name = field.first.Scalar();
+            std::string const& type = field.second.Scalar();
+            bool added = false;
+            if (type == "double")
+            {
+                added = schema.add(field_name, FieldType::Double);
+            }
+            else if (type == "int")
+            {
+                added = schema.add(field_name, FieldType::Int);
+            }
+            else if (type == "bool")
+            {
+                added = schema.add(field_name, FieldType::Bool);
+            }
+            else if (type == "string")
+            {
+                added = schema.add(field_name, FieldType::String);
+            }
+            else if (auto nested = schemas->find(type))
+            {
+                added = schema.add(field_name, *nested);
+            }
+            else
+            {
+                return robotik::Return<RecordSchemas::Ptr>::error(
+                    "Schema '" + name + "': unknown type '" + type +
+                    "' of field '" + field_name + "'");
+            }
+            if (!added)
+            {
+                return robotik::Return<RecordSchemas::Ptr>::error(
+                    "Schema '" + name + "': invalid or duplicate field '" +
+                    field_name + "'");
+            }
+        }
+        schemas->add(std::make_shared<RecordSchema const>(std::move(schema)));
+    }
+
+    return robotik::Return<RecordSchemas::Ptr>::success(std::move(schemas));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Enable the adaptive child ordering of a Sequence or Selector when
+//! the YAML content has "unordered: true".
+// ----------------------------------------------------------------------------
+template <class T>
+static void parseChildOrdering(T& p_node, YAML::Node const& p_content)
+{
+    if (!p_content["unordered"] || !scalarAs<bool>(p_content["unordered"]))
+    {
+        return;
+    }
+
+    ChildOrdering::Config config;
+    if (p_content["deterministic"])
+    {
+        config.deterministic = scalarAs<bool>(p_content["deterministic"]);
+    }
+    if (p_content["reorder_period"])
+    {
+        config.reorder_period = scalarAs<size_t>(p_content["reorder_period"]);
+    }
+    p_node.setUnordered(config);
+}
+
 // ----------------------------------------------------------------------------
 //! \brief Static creator functions for each node type
 // ----------------------------------------------------------------------------
@@ -208,6 +617,7 @@ createSequence(ParsingContext const& p_context, YAML::Node const& p_content)
     auto node = Node::create<Sequence>();
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
+    parseChildOrdering(*node, p_content);
     auto children = parseChildren(p_context, p_content, "children");
     if (!children)
         return robotik::Return<Node::Ptr>::error(children.getError());
@@ -227,6 +637,7 @@ createSelector(ParsingContext const& p_context, YAML::Node const& p_content)
     auto node = Node::create<Selector>();
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
+    parseChildOrdering(*node, p_content);
     auto children = parseChildren(p_context, p_content, "children");
     if (!children)
         return robotik::Return<Node::Ptr>::error(children.getError());
@@ -258,28 +669,38 @@ createParallel(ParsingContext const& p_context, YAML::Node const& p_content)
             "Missing policies or thresholds");
     }
 
+    // Race semantics: halt the children still running once decided
+    bool halt_on_decision = p_content["halt_on_decision"]
+                                ? scalarAs<bool>(p_content["halt_on_decision"])
+                                : false;
+
     Node::Ptr par;
     if (has_policies)
     {
         bool success_on_all = p_content["success_on_all"]
-                                  ? p_content["success_on_all"].as<bool>()
+                                  ? scalarAs<bool>(p_content["success_on_all"])
                                   : true;
         bool fail_on_all = p_content["fail_on_all"]
-                               ? p_content["fail_on_all"].as<bool>()
+                               ? scalarAs<bool>(p_content["fail_on_all"])
                                : true;
-        par = Node::create<ParallelAll>(success_on_all, fail_on_all);
+        auto all = Node::create<ParallelAll>(success_on_all, fail_on_all);
+        all->setHaltOnDecision(halt_on_decision);
+        par = std::move(all);
     }
     else
     {
         size_t success_threshold =
             p_content["success_threshold"]
-                ? p_content["success_threshold"].as<size_t>()
+                ? scalarAs<size_t>(p_content["success_threshold"])
                 : 1;
         size_t failure_threshold =
             p_content["failure_threshold"]
-                ? p_content["failure_threshold"].as<size_t>()
+                ? scalarAs<size_t>(p_content["failure_threshold"])
                 : 1;
-        par = Node::create<Parallel>(success_threshold, failure_threshold);
+        auto some =
+            Node::create<Parallel>(success_threshold, failure_threshold);
+        some->setHaltOnDecision(halt_on_decision);
+        par = std::move(some);
     }
 
     par->name = getNodeName(p_content);
@@ -324,7 +745,8 @@ createInverter(ParsingContext const& p_context, YAML::Node const& p_content)
 static robotik::Return<Node::Ptr>
 createRepeater(ParsingContext const& p_context, YAML::Node const& p_content)
 {
-    size_t times = p_content["times"] ? p_content["times"].as<size_t>() : 0;
+    size_t times =
+        p_content["times"] ? scalarAs<size_t>(p_content["times"]) : 0;
     auto node = Node::create<Repeater>(times);
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
@@ -358,7 +780,7 @@ createRepeatUntilSuccess(ParsingContext const& p_context,
                          YAML::Node const& p_content)
 {
     size_t attempts =
-        p_content["attempts"] ? p_content["attempts"].as<size_t>() : 0;
+        p_content["attempts"] ? scalarAs<size_t>(p_content["attempts"]) : 0;
     auto node = Node::create<UntilSuccess>(attempts);
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
@@ -382,7 +804,7 @@ createRepeatUntilFailure(ParsingContext const& p_context,
                          YAML::Node const& p_content)
 {
     size_t attempts =
-        p_content["attempts"] ? p_content["attempts"].as<size_t>() : 0;
+        p_content["attempts"] ? scalarAs<size_t>(p_content["attempts"]) : 0;
     auto node = Node::create<UntilFailure>(attempts);
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
@@ -471,7 +893,9 @@ static robotik::Return<Node::Ptr> createAction(ParsingContext const& p_context,
     {
         // Load only literal parameters into blackboard (not ${...} references)
         // References are only used for port remapping, not stored in BB
-        loadLiteralParameters(*p_context.blackboard, p_content["parameters"]);
+        loadLiteralParameters(*p_context.blackboard,
+                              p_content["parameters"],
+                              p_context.document);
 
         // Configure port remapping for all parameters
         node->setPortRemapping(extractPortRemapping(p_content["parameters"]));
@@ -531,18 +955,16 @@ static void applySubTreePortRemapping(
         return;
     }
 
-    std::regex pattern(R"(\$\{([^}]+)\})");
-
     for (auto const& param : p_parameters)
     {
         std::string childKey = param.first.as<std::string>();
         std::string value = param.second.as<std::string>();
 
-        std::smatch match;
-        if (std::regex_match(value, match, pattern))
+        std::string_view reference;
+        if (VariableResolver::isReference(value, reference))
         {
             // It's a reference ${parent_key}
-            std::string parentKey = match[1].str();
+            std::string parentKey(reference);
 
             // Try to get value from parent blackboard and copy to child
             if (auto raw = p_parentBB->raw(parentKey); raw)
@@ -575,7 +997,8 @@ static robotik::Return<Node::Ptr> createSubTree(ParsingContext const& p_context,
     if (!p_context.subtrees)
     {
         return robotik::Return<Node::Ptr>::error(
-            "SubTree node encountered but no 'SubTrees' section was provided");
+            "SubTree node encountered but no 'SubTrees' section nor 'include' "
+            "was provided");
     }
 
     if (!p_content["reference"])
@@ -585,8 +1008,8 @@ static robotik::Return<Node::Ptr> createSubTree(ParsingContext const& p_context,
     }
 
     auto reference = p_content["reference"].as<std::string>();
-    auto it = p_context.subtrees->definitions.find(reference);
-    if (it == p_context.subtrees->definitions.end())
+    auto definition = p_context.subtrees->find(reference);
+    if (!definition)
     {
         return robotik::Return<Node::Ptr>::error("Unknown subtree reference: " +
                                                  reference);
@@ -622,7 +1045,7 @@ static robotik::Return<Node::Ptr> createSubTree(ParsingContext const& p_context,
         nested.blackboard->setPortRemapping(allRemapping);
     }
 
-    auto subtreeRoot = parseYAMLNodeInternal(nested, it->second);
+    auto subtreeRoot = parseYAMLNodeInternal(nested, *definition);
     if (!subtreeRoot)
     {
         return robotik::Return<Node::Ptr>::error(
@@ -658,7 +1081,7 @@ static robotik::Return<Node::Ptr> createTimeout(ParsingContext const& p_context,
                                                 YAML::Node const& p_content)
 {
     size_t ms = p_content["milliseconds"]
-                    ? p_content["milliseconds"].as<size_t>()
+                    ? scalarAs<size_t>(p_content["milliseconds"])
                     : 1000;
     auto node = Node::create<Timeout>(ms);
     node->name = getNodeName(p_content);
@@ -692,7 +1115,7 @@ static robotik::Return<Node::Ptr> createDelay(ParsingContext const& p_context,
                                               YAML::Node const& p_content)
 {
     size_t ms = p_content["milliseconds"]
-                    ? p_content["milliseconds"].as<size_t>()
+                    ? scalarAs<size_t>(p_content["milliseconds"])
                     : 1000;
     auto node = Node::create<Delay>(ms);
     node->name = getNodeName(p_content);
@@ -716,7 +1139,7 @@ static robotik::Return<Node::Ptr>
 createCooldown(ParsingContext const& p_context, YAML::Node const& p_content)
 {
     size_t ms = p_content["milliseconds"]
-                    ? p_content["milliseconds"].as<size_t>()
+                    ? scalarAs<size_t>(p_content["milliseconds"])
                     : 1000;
     auto node = Node::create<Cooldown>(ms);
     node->name = getNodeName(p_content);
@@ -761,7 +1184,7 @@ static robotik::Return<Node::Ptr> createWait(ParsingContext const& p_context,
                                              YAML::Node const& p_content)
 {
     size_t ms = p_content["milliseconds"]
-                    ? p_content["milliseconds"].as<size_t>()
+                    ? scalarAs<size_t>(p_content["milliseconds"])
                     : 1000;
     auto node = Node::create<Wait>(ms);
     node->name = getNodeName(p_content);
@@ -787,9 +1210,127 @@ createSetBlackboard(ParsingContext const& p_context,
             "SetBlackboard node missing 'value' field");
     }
 
+    // The value type is given by the optional 'type' field, else a quoted
+    // scalar is a string and a plain scalar is inferred.
+    YAML::Node const& value_node = p_content["value"];
+    SetBlackboard::Type type =
+        (value_node.Tag() == "!") ? SetBlackboard::Type::String
+                                  : SetBlackboard::Type::Auto;
+    if (p_content["type"])
+    {
+        std::string type_name = p_content["type"].as<std::string>();
+        if (!SetBlackboard::parseType(type_name, type))
+        {
+            return robotik::Return<Node::Ptr>::error(
+                "SetBlackboard node has unknown type '" + type_name +
+                "' (expected auto, int, double, bool or string)");
+        }
+    }
+
     std::string key = p_content["key"].as<std::string>();
-    std::string value = p_content["value"].as<std::string>();
-    auto node = Node::create<SetBlackboard>(key, value, p_context.blackboard);
+    std::string value = value_node.as<std::string>();
+    auto node =
+        Node::create<SetBlackboard>(key, value, type, p_context.blackboard);
+    if (!node->isValid())
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "SetBlackboard node cannot parse value '" + value + "' as " +
+            SetBlackboard::toString(type));
+    }
+    node->name = getNodeName(p_content);
+    assignNodeId(*node, p_context, p_content);
+    return robotik::Return<Node::Ptr>::success(std::move(node));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Create a shared computation leaf node
+// ----------------------------------------------------------------------------
+static robotik::Return<Node::Ptr>
+createSharedComputation(ParsingContext const& p_context,
+                        YAML::Node const& p_content)
+{
+    if (!p_content["computation"])
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "SharedComputation node missing 'computation' field");
+    }
+
+    std::string computation = p_content["computation"].as<std::string>();
+    SharedComputations::Ptr const& computations =
+        p_context.factory.sharedComputations();
+    if (computations == nullptr)
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "SharedComputation node '" + computation +
+            "' needs NodeFactory::setSharedComputations()");
+    }
+    if (!computations->has(computation))
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "SharedComputation node references unknown computation '" +
+            computation + "'");
+    }
+
+    std::string key =
+        p_content["key"] ? p_content["key"].as<std::string>() : "";
+    auto node =
+        Node::create<SharedComputation>(computations, computation, key);
+    node->setBlackboard(p_context.blackboard);
+    node->name = getNodeName(p_content);
+    assignNodeId(*node, p_context, p_content);
+    return robotik::Return<Node::Ptr>::success(std::move(node));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Create a batched service call leaf node
+// ----------------------------------------------------------------------------
+static robotik::Return<Node::Ptr>
+createBatchedServiceCall(ParsingContext const& p_context,
+                         YAML::Node const& p_content)
+{
+    if (!p_content["service"])
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "BatchedServiceCall node missing 'service' field");
+    }
+
+    std::string service = p_content["service"].as<std::string>();
+    BatchedServices::Ptr const& services = p_context.factory.batchedServices();
+    if (services == nullptr)
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "BatchedServiceCall node '" + service +
+            "' needs NodeFactory::setBatchedServices()");
+    }
+    if (!services->has(service))
+    {
+        return robotik::Return<Node::Ptr>::error(
+            "BatchedServiceCall node references unknown service '" + service +
+            "'");
+    }
+
+    std::string request =
+        p_content["request"] ? p_content["request"].as<std::string>() : "";
+    std::string response =
+        p_content["response"] ? p_content["response"].as<std::string>() : "";
+    auto node = Node::create<BatchedServiceCall>(
+        services, service, request, response);
+    node->setBlackboard(p_context.blackboard);
+    node->name = getNodeName(p_content);
+    assignNodeId(*node, p_context, p_content);
+    return robotik::Return<Node::Ptr>::success(std::move(node));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Create a dynamic subtree node (without content, see
+//! FragmentBuilder)
+// ----------------------------------------------------------------------------
+static robotik::Return<Node::Ptr>
+createDynamicSubTree(ParsingContext const& p_context,
+                     YAML::Node const& p_content)
+{
+    auto node = Node::create<DynamicSubTree>();
+    node->setBlackboard(p_context.blackboard);
     node->name = getNodeName(p_content);
     assignNodeId(*node, p_context, p_content);
     return robotik::Return<Node::Ptr>::success(std::move(node));
@@ -821,16 +1362,40 @@ static NodeCreatorMap& getNodeCreators()
         {Failure::toString(), createFailure},
         {Wait::toString(), createWait},
         {SetBlackboard::toString(), createSetBlackboard},
+        {SharedComputation::toString(), createSharedComputation},
+        {BatchedServiceCall::toString(), createBatchedServiceCall},
         {SubTreeNode::toString(), createSubTree},
+        {DynamicSubTree::toString(), createDynamicSubTree},
     };
     return creators;
 }
 
+// ****************************************************************************
+//! \brief Fire the USDT probes builder__load__enter and builder__load__exit
+//! around the loading of a file, whatever the returned path.
+// ****************************************************************************
+struct LoadProbe
+{
+    explicit LoadProbe(std::string const& p_path) : path(p_path)
+    {
+        BT_TRACE(builder__load__enter, path.c_str());
+    }
+
+    ~LoadProbe()
+    {
+        BT_TRACE(builder__load__exit, path.c_str(), int(success));
+    }
+
+    std::string const& path;
+    bool success = false;
+};
+
 //-----------------------------------------------------------------------------
 robotik::Return<Tree::Ptr> Builder::fromFile(NodeFactory const& p_factory,
                                              std::string const& p_file_path,
                                              Blackboard::Ptr p_blackboard)
 {
+    LoadProbe probe(p_file_path);
     try
     {
         YAML::Node root = YAML::LoadFile(p_file_path);
@@ -843,23 +1408,38 @@ robotik::Return<Tree::Ptr> Builder::fromFile(NodeFactory const& p_factory,
         Blackboard::Ptr blackboard =
             p_blackboard ? p_blackboard : std::make_shared<Blackboard>();
 
+        auto schemasResult = buildRecordSchemas(p_factory, root);
+        if (!schemasResult)
+        {
+            return robotik::Return<Tree::Ptr>::error(schemasResult.getError());
+        }
+        RecordSchemas::Ptr schemas = schemasResult.moveValue();
+        BlackboardSerializer::Context const document{
+            blackboard.get(),
+            schemas.get(),
+            std::filesystem::path(p_file_path).parent_path()};
+
         if (root["Blackboard"])
         {
             BlackboardSerializer::load(
-                *blackboard, root["Blackboard"], blackboard.get());
+                *blackboard, root["Blackboard"], document);
         }
 
-        auto registryResult = buildSubTreeRegistry(root);
+        auto registryResult = buildSubTreeRegistry(
+            root, std::filesystem::path(p_file_path).parent_path());
         if (!registryResult)
         {
             return robotik::Return<Tree::Ptr>::error(registryResult.getError());
         }
         auto registry = registryResult.moveValue();
         SubTreeRegistry const* registryPtr =
-            registry.definitions.empty() ? nullptr : &registry;
+            registry.empty() ? nullptr : &registry;
 
-        auto nodeResult = parseYAMLNode(
-            p_factory, root["BehaviorTree"], blackboard, registryPtr);
+        auto nodeResult = parseYAMLNode(p_factory,
+                                        root["BehaviorTree"],
+                                        blackboard,
+                                        registryPtr,
+                                        &document);
         if (!nodeResult)
         {
             return robotik::Return<Tree::Ptr>::error(nodeResult.getError());
@@ -868,6 +1448,7 @@ robotik::Return<Tree::Ptr> Builder::fromFile(NodeFactory const& p_factory,
         Tree::Ptr tree = Tree::create();
         tree->setBlackboard(blackboard);
         tree->setRoot(nodeResult.moveValue());
+        probe.success = true;
         return robotik::Return<Tree::Ptr>::success(std::move(tree));
     }
     catch (const YAML::Exception& e)
@@ -899,23 +1480,38 @@ robotik::Return<Tree::Ptr> Builder::fromText(NodeFactory const& p_factory,
         Blackboard::Ptr blackboard =
             p_blackboard ? p_blackboard : std::make_shared<Blackboard>();
 
+        auto schemasResult = buildRecordSchemas(p_factory, root);
+        if (!schemasResult)
+        {
+            return robotik::Return<Tree::Ptr>::error(schemasResult.getError());
+        }
+        RecordSchemas::Ptr schemas = schemasResult.moveValue();
+        // Relative paths are relative to the working directory
+        BlackboardSerializer::Context const document{
+            blackboard.get(), schemas.get(), {}};
+
         if (root["Blackboard"])
         {
             BlackboardSerializer::load(
-                *blackboard, root["Blackboard"], blackboard.get());
+                *blackboard, root["Blackboard"], document);
         }
 
-        auto registryResult = buildSubTreeRegistry(root);
+        // Relative includes are relative to the working directory
+        auto registryResult =
+            buildSubTreeRegistry(root, std::filesystem::path());
         if (!registryResult)
         {
             return robotik::Return<Tree::Ptr>::error(registryResult.getError());
         }
         auto registry = registryResult.moveValue();
         SubTreeRegistry const* registryPtr =
-            registry.definitions.empty() ? nullptr : &registry;
+            registry.empty() ? nullptr : &registry;
 
-        auto nodeResult = parseYAMLNode(
-            p_factory, root["BehaviorTree"], blackboard, registryPtr);
+        auto nodeResult = parseYAMLNode(p_factory,
+                                        root["BehaviorTree"],
+                                        blackboard,
+                                        registryPtr,
+                                        &document);
         if (!nodeResult)
         {
             return robotik::Return<Tree::Ptr>::error(nodeResult.getError());
@@ -938,6 +1534,18 @@ robotik::Return<Tree::Ptr> Builder::fromText(NodeFactory const& p_factory,
     }
 }
 
+//-----------------------------------------------------------------------------
+Builder::LibraryStatistics Builder::libraryStatistics()
+{
+    return SubTreeLibrary::instance().statistics();
+}
+
+//-----------------------------------------------------------------------------
+void Builder::clearLibraryCache()
+{
+    SubTreeLibrary::instance().clear();
+}
+
 // ----------------------------------------------------------------------------
 //! \brief Internal helper to parse YAML node with context
 // ----------------------------------------------------------------------------
@@ -975,9 +1583,10 @@ robotik::Return<Node::Ptr>
 Builder::parseYAMLNode(NodeFactory const& p_factory,
                        YAML::Node const& p_node,
                        Blackboard::Ptr p_blackboard,
-                       SubTreeRegistry const* p_subtrees)
+                       SubTreeRegistry const* p_subtrees,
+                       BlackboardSerializer::Context const* p_document)
 {
-    ParsingContext context{p_factory, p_blackboard, p_subtrees};
+    ParsingContext context{p_factory, p_blackboard, p_subtrees, p_document};
     return parseYAMLNodeInternal(context, p_node);
 }
 
@@ -986,7 +1595,7 @@ Builder::parseYAMLNode(NodeFactory const& p_factory,
 robotik::Return<Node::Ptr> Builder::parseYAMLNode(NodeFactory const& p_factory,
                                                   YAML::Node const& p_node)
 {
-    return parseYAMLNode(p_factory, p_node, nullptr, nullptr);
+    return parseYAMLNode(p_factory, p_node, nullptr, nullptr, nullptr);
 }
 
 } // namespace bt
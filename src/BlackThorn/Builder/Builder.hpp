@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "BlackThorn/Blackboard/Serializer.hpp"
 #include "BlackThorn/Builder/Factory.hpp"
 #include "BlackThorn/Common/Return.hpp"
 #include "BlackThorn/Core/Tree.hpp"
@@ -34,11 +35,34 @@ struct SubTreeRegistry;
 //! - Support for custom nodes (it must access to your classes to create them).
 //! - Support for blackboard.
 //! - Support for subtrees.
+//! - Support for subtree libraries: YAML files listed by the `include:`
+//!   section, parsed once per process and shared by all the builds.
+//! - Support for record schemas: the `Schemas:` section, plus the ones set
+//!   with NodeFactory::setRecordSchemas(), type the blackboard maps tagged
+//!   with their name (see Record).
+//!
+//! The libraries are cached by canonical path in a process-wide registry
+//! which is immutable once loaded and safe to use from several threads. A
+//! library is parsed again when its modification time, or the one of a file
+//! it includes, changes.
 // ****************************************************************************
 class Builder
 {
 public:
 
+    // --------------------------------------------------------------------------
+    //! \brief Statistics of the subtree library cache.
+    // --------------------------------------------------------------------------
+    struct LibraryStatistics
+    {
+        //! \brief Number of library files currently cached.
+        size_t files = 0;
+        //! \brief Number of library files parsed (first loads and reloads).
+        size_t loads = 0;
+        //! \brief Number of includes served from the cache.
+        size_t hits = 0;
+    };
+
     // --------------------------------------------------------------------------
     //! \brief Create a behavior tree from a YAML file.
     //! \param[in] p_factory The factory to create custom nodes.
@@ -72,6 +96,17 @@ public:
     static robotik::Return<Node::Ptr>
     parseYAMLNode(NodeFactory const& p_factory, YAML::Node const& p_node);
 
+    // --------------------------------------------------------------------------
+    //! \brief Get the statistics of the process-wide subtree library cache.
+    // --------------------------------------------------------------------------
+    [[nodiscard]] static LibraryStatistics libraryStatistics();
+
+    // --------------------------------------------------------------------------
+    //! \brief Drop the cached subtree libraries. The trees already built are
+    //! not affected.
+    // --------------------------------------------------------------------------
+    static void clearLibraryCache();
+
 private:
 
     // --------------------------------------------------------------------------
@@ -79,13 +114,17 @@ private:
     //! \param[in] p_factory The factory to create custom nodes.
     //! \param[in] p_node The YAML node to parse.
     //! \param[in] p_blackboard Optional blackboard for parameter resolution.
+    //! \param[in] p_subtrees Optional reusable subtree definitions.
+    //! \param[in] p_document Optional record schemas and directory of the
+    //!            document, for the values of the parameters.
     //! \return Return object containing the node or an error message.
     // --------------------------------------------------------------------------
     static robotik::Return<Node::Ptr>
     parseYAMLNode(NodeFactory const& p_factory,
                   YAML::Node const& p_node,
                   Blackboard::Ptr p_blackboard,
-                  SubTreeRegistry const* p_subtrees);
+                  SubTreeRegistry const* p_subtrees,
+                  BlackboardSerializer::Context const* p_document);
 };
 
 } // namespace bt
\ No newline at end of file
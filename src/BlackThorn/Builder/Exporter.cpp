@@ -9,10 +9,13 @@
 #include "BlackThorn/Builder/Exporter.hpp"
 
 #include <fstream>
+#include <iomanip>
 #include <sstream>
 
 namespace bt {
 
+namespace {
+
 // ****************************************************************************
 //! \brief Visitor that exports a behavior tree to YAML format.
 // ****************************************************************************
@@ -72,10 +75,45 @@ public:
         indent_level--;
     }
 
+    void writeChildOrdering(ChildOrdering const& p_ordering)
+    {
+        if (!p_ordering.isEnabled())
+        {
+            return;
+        }
+        yaml << indent() << "unordered: true\n";
+        if (p_ordering.config().deterministic)
+        {
+            yaml << indent() << "deterministic: true\n";
+        }
+        yaml << indent()
+             << "reorder_period: " << p_ordering.config().reorder_period
+             << "\n";
+    }
+
+    // Quoted values are strings, else the type is inferred unless given
+    void writeSetBlackboardValue(SetBlackboard const& p_node)
+    {
+        SetBlackboard::Type type = p_node.getValueType();
+        if (type == SetBlackboard::Type::String)
+        {
+            yaml << indent() << "value: " << std::quoted(p_node.getValue())
+                 << "\n";
+            return;
+        }
+        yaml << indent() << "value: " << p_node.getValue() << "\n";
+        if (type != SetBlackboard::Type::Auto)
+        {
+            yaml << indent() << "type: " << SetBlackboard::toString(type)
+                 << "\n";
+        }
+    }
+
     // Composite nodes
     void visitSequence(Sequence const& p_node) override
     {
         writeNodeStart("Sequence", p_node);
+        writeChildOrdering(p_node.getOrdering());
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -121,6 +159,7 @@ public:
     void visitSelector(Selector const& p_node) override
     {
         writeNodeStart("Selector", p_node);
+        writeChildOrdering(p_node.getOrdering());
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -170,6 +209,10 @@ public:
              << "\n";
         yaml << indent() << "failure_threshold: " << p_node.getMinFail()
              << "\n";
+        if (p_node.getHaltOnDecision())
+        {
+            yaml << indent() << "halt_on_decision: true\n";
+        }
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -190,6 +233,10 @@ public:
         yaml << indent()
              << "fail_on_all: " << (p_node.getFailOnAll() ? "true" : "false")
              << "\n";
+        if (p_node.getHaltOnDecision())
+        {
+            yaml << indent() << "halt_on_decision: true\n";
+        }
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -373,6 +420,13 @@ public:
         writeNodeEnd();
     }
 
+    void visitDynamicSubTree(DynamicSubTree const& p_node) override
+    {
+        // The content is set at runtime: only the placeholder is exported
+        writeNodeStart("DynamicSubTree", p_node);
+        writeNodeEnd();
+    }
+
     void visitWait(Wait const& p_node) override
     {
         writeNodeStart("Wait", p_node);
@@ -385,7 +439,34 @@ public:
     {
         writeNodeStart("SetBlackboard", p_node);
         yaml << indent() << "key: " << p_node.getKey() << "\n";
-        yaml << indent() << "value: " << p_node.getValue() << "\n";
+        writeSetBlackboardValue(p_node);
+        writeNodeEnd();
+    }
+
+    void visitSharedComputation(SharedComputation const& p_node) override
+    {
+        writeNodeStart("SharedComputation", p_node);
+        yaml << indent() << "computation: " << p_node.getComputation()
+             << "\n";
+        if (p_node.getKey() != p_node.getComputation())
+        {
+            yaml << indent() << "key: " << p_node.getKey() << "\n";
+        }
+        writeNodeEnd();
+    }
+
+    void visitBatchedServiceCall(BatchedServiceCall const& p_node) override
+    {
+        writeNodeStart("BatchedServiceCall", p_node);
+        yaml << indent() << "service: " << p_node.getService() << "\n";
+        if (!p_node.getRequest().empty())
+        {
+            yaml << indent() << "request: " << p_node.getRequest() << "\n";
+        }
+        if (p_node.getResponse() != p_node.getService())
+        {
+            yaml << indent() << "response: " << p_node.getResponse() << "\n";
+        }
         writeNodeEnd();
     }
 
@@ -562,6 +643,10 @@ public:
     {
         visitLeaf("SubTree", p_node);
     }
+    void visitDynamicSubTree(DynamicSubTree const& p_node) override
+    {
+        visitLeaf("DynamicSubTree", p_node);
+    }
     void visitWait(Wait const& p_node) override
     {
         visitLeaf("Wait", p_node);
@@ -570,6 +655,14 @@ public:
     {
         visitLeaf("SetBlackboard", p_node);
     }
+    void visitSharedComputation(SharedComputation const& p_node) override
+    {
+        visitLeaf("SharedComputation", p_node);
+    }
+    void visitBatchedServiceCall(BatchedServiceCall const& p_node) override
+    {
+        visitLeaf("BatchedServiceCall", p_node);
+    }
 
     void visitTree(Tree const& tree) override
     {
@@ -589,6 +682,8 @@ public:
     }
 };
 
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 std::string Exporter::toYAML(Tree const& tree)
 {
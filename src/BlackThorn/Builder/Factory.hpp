@@ -8,7 +8,10 @@
 
 #pragma once
 
+#include "BlackThorn/Blackboard/Record.hpp"
 #include "BlackThorn/Core/Node.hpp"
+#include "BlackThorn/Executor/BatchedServices.hpp"
+#include "BlackThorn/Executor/SharedComputations.hpp"
 #include "BlackThorn/Nodes/Leaves/Action.hpp"
 #include "BlackThorn/Nodes/Leaves/Condition.hpp"
 
@@ -151,10 +154,75 @@ public:
         });
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Set the registry of the shared computations referenced by the
+    //! SharedComputation nodes of the trees built with this factory.
+    //! \param[in] p_computations The registry (usually the one of the
+    //!            Executor ticking the trees).
+    // ------------------------------------------------------------------------
+    void setSharedComputations(SharedComputations::Ptr p_computations)
+    {
+        m_computations = std::move(p_computations);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the registry of the shared computations.
+    //! \return The registry, or nullptr if none was set.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] SharedComputations::Ptr const& sharedComputations() const
+    {
+        return m_computations;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the registry of the batched services called by the
+    //! BatchedServiceCall nodes of the trees built with this factory.
+    //! \param[in] p_services The registry (usually the one of the Executor
+    //!            ticking the trees).
+    // ------------------------------------------------------------------------
+    void setBatchedServices(BatchedServices::Ptr p_services)
+    {
+        m_services = std::move(p_services);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the registry of the batched services.
+    //! \return The registry, or nullptr if none was set.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] BatchedServices::Ptr const& batchedServices() const
+    {
+        return m_services;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the record schemas known by the trees built with this
+    //! factory, in addition to the ones of their 'Schemas' section.
+    //! \param[in] p_schemas The schemas registered from C++.
+    // ------------------------------------------------------------------------
+    void setRecordSchemas(RecordSchemas::Ptr p_schemas)
+    {
+        m_schemas = std::move(p_schemas);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the record schemas registered from C++.
+    //! \return The schemas, or nullptr if none were set.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] RecordSchemas::Ptr const& recordSchemas() const
+    {
+        return m_schemas;
+    }
+
 private:
 
     //! \brief Map of node names to their creation functions
     std::unordered_map<std::string, NodeCreator> m_creators;
+    //! \brief Computations shared by the SharedComputation nodes
+    SharedComputations::Ptr m_computations;
+    //! \brief Services called by the BatchedServiceCall nodes
+    BatchedServices::Ptr m_services;
+    //! \brief Record schemas registered from C++
+    RecordSchemas::Ptr m_schemas;
 };
 
 } // namespace bt
@@ -0,0 +1,177 @@
+/**
+ * @file FragmentBuilder.cpp
+ * @brief Builds the content of DynamicSubTree nodes on a background thread.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Builder/FragmentBuilder.hpp"
+#include "BlackThorn/Builder/Builder.hpp"
+
+namespace bt {
+
+//-----------------------------------------------------------------------------
+FragmentBuilder::FragmentBuilder(NodeFactory const& p_factory,
+                                 size_t p_cache_capacity)
+    : m_factory(p_factory),
+      m_capacity(p_cache_capacity),
+      m_anchor(std::make_shared<Blackboard>())
+{
+    m_thread = std::thread([this] { run(); });
+}
+
+//-----------------------------------------------------------------------------
+FragmentBuilder::~FragmentBuilder()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_one();
+    m_thread.join();
+}
+
+//-----------------------------------------------------------------------------
+std::future<FragmentBuilder::Result>
+FragmentBuilder::build(DynamicSubTree& p_node, std::string p_yaml_text)
+{
+    Request request{p_node.mailbox(),       p_node.blackboard(),
+                    p_node.clock(),         p_node.tickMarker(),
+                    p_node.commandBuffer(), std::move(p_yaml_text),
+                    {}};
+    std::future<Result> result = request.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_requests.push_back(std::move(request));
+    }
+    m_wakeup.notify_one();
+    return result;
+}
+
+//-----------------------------------------------------------------------------
+robotik::Return<Tree::Ptr>
+FragmentBuilder::instantiate(std::string const& p_yaml_text,
+                             Blackboard::Ptr p_blackboard)
+{
+    bool hit = false;
+    return instantiate(p_yaml_text, p_blackboard, hit);
+}
+
+//-----------------------------------------------------------------------------
+robotik::Return<Tree::Ptr>
+FragmentBuilder::instantiate(std::string const& p_yaml_text,
+                             Blackboard::Ptr const& p_blackboard,
+                             bool& p_hit)
+{
+    // Fork the cached prototype, its blackboard being re-parented to
+    // p_blackboard instead of m_anchor
+    auto forkPrototype = [&](Tree const& p_prototype) {
+        Blackboard::Forks forks{{m_anchor.get(), p_blackboard}};
+        Tree::Ptr fragment = p_prototype.fork(forks);
+        return fragment ? robotik::Return<Tree::Ptr>::success(
+                              std::move(fragment))
+                        : robotik::Return<Tree::Ptr>::error(
+                              "Fragment holds a node that cannot be cloned");
+    };
+
+    std::shared_ptr<Tree const> prototype;
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        if (auto it = m_index.find(p_yaml_text); it != m_index.end())
+        {
+            m_fragments.splice(m_fragments.begin(), m_fragments, it->second);
+            prototype = it->second->prototype;
+            ++m_statistics.hits;
+        }
+        else
+        {
+            ++m_statistics.misses;
+        }
+    }
+    if (prototype)
+    {
+        p_hit = true;
+        return forkPrototype(*prototype);
+    }
+
+    // Without cache, build the fragment directly under p_blackboard
+    p_hit = false;
+    auto blackboard = std::make_shared<Blackboard>(
+        (m_capacity == 0u) ? p_blackboard : m_anchor);
+    auto result = Builder::fromText(m_factory, p_yaml_text, blackboard);
+    if (!result || (m_capacity == 0u))
+    {
+        return result;
+    }
+    prototype = result.moveValue();
+
+    {
+        std::lock_guard<std::mutex> lock(m_cache_mutex);
+        if (m_index.find(p_yaml_text) == m_index.end())
+        {
+            m_fragments.push_front({p_yaml_text, prototype});
+            m_index[p_yaml_text] = m_fragments.begin();
+            if (m_fragments.size() > m_capacity)
+            {
+                m_index.erase(m_fragments.back().yaml);
+                m_fragments.pop_back();
+            }
+        }
+    }
+    return forkPrototype(*prototype);
+}
+
+//-----------------------------------------------------------------------------
+FragmentBuilder::Statistics FragmentBuilder::statistics() const
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    return m_statistics;
+}
+
+//-----------------------------------------------------------------------------
+void FragmentBuilder::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_cache_mutex);
+    m_index.clear();
+    m_fragments.clear();
+}
+
+//-----------------------------------------------------------------------------
+void FragmentBuilder::run()
+{
+    while (true)
+    {
+        Request request;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(
+                lock, [this] { return m_stop || !m_requests.empty(); });
+            if (m_requests.empty())
+            {
+                return;
+            }
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        bool hit = false;
+        auto fragment = instantiate(request.yaml, request.blackboard, hit);
+        if (!fragment)
+        {
+            request.promise.set_value(Result::error(fragment.getError()));
+            continue;
+        }
+
+        // Done here so that the swap, on the ticking thread, only exchanges
+        // pointers
+        Tree::Ptr content = fragment.moveValue();
+        content->setClock(request.clock);
+        content->setTickMarker(request.marker);
+        content->setCommandBuffer(request.commands);
+        request.mailbox->post(std::move(content));
+        request.promise.set_value(Result::success(hit));
+    }
+}
+
+} // namespace bt
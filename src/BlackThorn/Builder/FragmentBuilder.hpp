@@ -0,0 +1,190 @@
+/**
+ * @file FragmentBuilder.hpp
+ * @brief Builds the content of DynamicSubTree nodes on a background thread.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Builder/Factory.hpp"
+#include "BlackThorn/Common/Return.hpp"
+#include "BlackThorn/Core/Tree.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Builds plan fragments (YAML texts with a BehaviorTree section, like
+//! Builder::fromText()) on a background thread and swaps them into
+//! DynamicSubTree nodes, without stopping the tree nor losing its state.
+//!
+//! The fragment blackboard is a child of the blackboard of the node: the
+//! fragment reads the keys of the tree and its own keys (Blackboard section
+//! of the fragment) stay local. Recently built fragments are cached by YAML
+//! text: a repeated plan is forked from the cache (copy-on-write blackboard)
+//! instead of being parsed and built again.
+//!
+//! The factory is used by the background thread: it must outlive the
+//! builder and must not be modified while requests are pending.
+//!
+//! Usage example:
+//! \code
+//!   bt::FragmentBuilder fragments(factory);
+//!   auto* plan = tree->findDynamicSubTree("Plan");
+//!   fragments.build(*plan, planner.nextPlanAsYaml());
+//!   while (running)
+//!       tree->tick(); // The plan is swapped in at the tick following its
+//!                     // build
+//! \endcode
+// ****************************************************************************
+class FragmentBuilder
+{
+public:
+
+    //! \brief Result of a build: true if the fragment came from the cache.
+    using Result = robotik::Return<bool>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Usage statistics of the cache.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of fragments forked from the cache.
+        size_t hits = 0;
+        //! \brief Number of fragments parsed and built.
+        size_t misses = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor - starts the background thread.
+    //! \param[in] p_factory The factory creating the custom nodes.
+    //! \param[in] p_cache_capacity Number of fragments kept in the cache (0
+    //!            disables the cache).
+    // ------------------------------------------------------------------------
+    explicit FragmentBuilder(NodeFactory const& p_factory,
+                             size_t p_cache_capacity = 16u);
+
+    // Disable copy/move: the thread references this instance
+    FragmentBuilder(FragmentBuilder const&) = delete;
+    FragmentBuilder& operator=(FragmentBuilder const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - builds the pending requests and joins the thread.
+    // ------------------------------------------------------------------------
+    ~FragmentBuilder();
+
+    // ------------------------------------------------------------------------
+    //! \brief Request the build of a fragment, posted to the node once built.
+    //! The node does not need to outlive the request. Must be called by the
+    //! thread ticking the node (it reads its blackboard, clock, tick marker
+    //! and command buffer).
+    //! \param[in] p_node The node receiving the fragment.
+    //! \param[in] p_yaml_text The YAML text of the fragment.
+    //! \return The result, ready once the fragment is posted (or failed to
+    //!         build, the node then keeps its content).
+    // ------------------------------------------------------------------------
+    std::future<Result> build(DynamicSubTree& p_node, std::string p_yaml_text);
+
+    // ------------------------------------------------------------------------
+    //! \brief Build a fragment on the calling thread, through the cache.
+    //! \param[in] p_yaml_text The YAML text of the fragment.
+    //! \param[in] p_blackboard The parent of the fragment blackboard (may be
+    //!            nullptr).
+    //! \return The fragment or an error message.
+    // ------------------------------------------------------------------------
+    robotik::Return<Tree::Ptr> instantiate(std::string const& p_yaml_text,
+                                           Blackboard::Ptr p_blackboard);
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the usage statistics of the cache.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics() const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Drop the cached fragments.
+    // ------------------------------------------------------------------------
+    void clearCache();
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Pending build request.
+    // ------------------------------------------------------------------------
+    struct Request
+    {
+        DynamicSubTree::Mailbox::Ptr mailbox;
+        Blackboard::Ptr blackboard;
+        Clock::Ptr clock;
+        Node::TickMarker* marker = nullptr;
+        CommandBuffer* commands = nullptr;
+        std::string yaml;
+        std::promise<Result> promise;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Cached fragment, never ticked, whose blackboard is a child of
+    //! m_anchor.
+    // ------------------------------------------------------------------------
+    struct Fragment
+    {
+        std::string yaml;
+        std::shared_ptr<Tree const> prototype;
+    };
+
+    using Fragments = std::list<Fragment>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Background thread loop: build the requests in order.
+    // ------------------------------------------------------------------------
+    void run();
+
+    // ------------------------------------------------------------------------
+    //! \brief Fork the fragment from the cache, or build it.
+    //! \param[out] p_hit Set to true when forked from the cache.
+    // ------------------------------------------------------------------------
+    robotik::Return<Tree::Ptr> instantiate(std::string const& p_yaml_text,
+                                           Blackboard::Ptr const& p_blackboard,
+                                           bool& p_hit);
+
+private:
+
+    //! \brief Factory creating the custom nodes.
+    NodeFactory const& m_factory;
+    //! \brief Maximum number of cached fragments.
+    size_t m_capacity;
+    //! \brief Parent of the blackboards of the cached fragments, replaced by
+    //! the blackboard of the node when forked.
+    Blackboard::Ptr m_anchor;
+
+    //! \brief Protects the cache and the statistics.
+    mutable std::mutex m_cache_mutex;
+    //! \brief Cached fragments, most recently used first.
+    Fragments m_fragments;
+    //! \brief Cached fragments indexed by YAML text.
+    std::unordered_map<std::string, Fragments::iterator> m_index;
+    //! \brief Usage statistics of the cache.
+    Statistics m_statistics;
+
+    //! \brief Protects the requests.
+    std::mutex m_mutex;
+    //! \brief Signals a new request or the stop.
+    std::condition_variable m_wakeup;
+    //! \brief Requests not built yet.
+    std::deque<Request> m_requests;
+    //! \brief Set by the destructor.
+    bool m_stop = false;
+    //! \brief Background thread building the requests.
+    std::thread m_thread;
+};
+
+} // namespace bt
@@ -0,0 +1,113 @@
+/**
+ * @file Clock.hpp
+ * @brief Injectable clock used by the time-based nodes.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Source of time of the time-based nodes (Wait, Timeout, Delay,
+//! Cooldown).
+//!
+//! Nodes without clock read std::chrono::steady_clock directly. Attaching a
+//! clock with Tree::setClock() lets a simulation drive the time of a tree,
+//! typically a forked tree (see Tree::fork()) rolled out faster than real
+//! time with a ManualClock.
+// ****************************************************************************
+class Clock
+{
+public:
+
+    using Ptr = std::shared_ptr<Clock>;
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor needed because of virtual methods.
+    // ------------------------------------------------------------------------
+    virtual ~Clock() = default;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the current time.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual TimePoint now() const = 0;
+};
+
+// ****************************************************************************
+//! \brief Real time clock (std::chrono::steady_clock).
+// ****************************************************************************
+class SteadyClock final: public Clock
+{
+public:
+
+    [[nodiscard]] TimePoint now() const override
+    {
+        return std::chrono::steady_clock::now();
+    }
+};
+
+// ****************************************************************************
+//! \brief Simulated clock whose time only moves when advanced.
+//! \details Starts at the current steady time by default, so that the timers
+//! already started by a forked tree keep consistent elapsed times.
+//!
+//! Usage:
+//! \code
+//!   auto clock = std::make_shared<bt::ManualClock>();
+//!   auto rollout = tree.fork(clock);
+//!   while (rollout->tick() == bt::Status::RUNNING)
+//!       clock->advance(std::chrono::milliseconds(100));
+//! \endcode
+// ****************************************************************************
+class ManualClock final: public Clock
+{
+public:
+
+    using Ptr = std::shared_ptr<ManualClock>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_start The initial time.
+    // ------------------------------------------------------------------------
+    explicit ManualClock(TimePoint p_start = std::chrono::steady_clock::now())
+        : m_now(p_start)
+    {
+    }
+
+    [[nodiscard]] TimePoint now() const override
+    {
+        return m_now;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Move the time forward.
+    //! \param[in] p_duration The elapsed time.
+    // ------------------------------------------------------------------------
+    void advance(Duration p_duration)
+    {
+        m_now += p_duration;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the current time.
+    //! \param[in] p_now The new time.
+    // ------------------------------------------------------------------------
+    void set(TimePoint p_now)
+    {
+        m_now = p_now;
+    }
+
+private:
+
+    TimePoint m_now;
+};
+
+} // namespace bt
@@ -0,0 +1,344 @@
+/**
+ * @file CommandBuffer.hpp
+ * @brief Per-tick buffer of the commands sent by the actions to actuators
+ * and middlewares, coalesced and flushed once at the end of the tick.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace bt {
+
+class Node;
+
+// ****************************************************************************
+//! \brief Buffer of the commands sent by the nodes during a tick.
+//!
+//! Instead of performing their I/O from onRunning() (one syscall or message
+//! per command, some of them superseded later in the same tick), actions
+//! push typed commands to named channels. Commands are:
+//! - coalesced: the last command pushed to a channel during the tick wins;
+//! - discarded when the node which pushed them is halted during the same
+//!   tick (the commands pushed by onHalt() itself are kept);
+//! - validated, then flushed once to the sink of their channel when the
+//!   outermost Tree::tick() returns, in the order of the first push to
+//!   each channel.
+//!
+//! Channels are declared before ticking. Pushing does not allocate once the
+//! channel has held a value of the same capacity. The buffer is not thread
+//! safe: it is used by the thread ticking the tree.
+//!
+//! Usage example:
+//! \code
+//!   bt::CommandBuffer commands;
+//!   commands.addChannel<double>("wheel_speed",
+//!       [&](double const& speed) { motors.write(speed); },
+//!       [](double const& speed) { return std::abs(speed) <= 2.0; });
+//!   tree.setCommandBuffer(&commands);
+//!
+//!   // In the onRunning() of an action
+//!   command("wheel_speed", 1.5);
+//! \endcode
+// ****************************************************************************
+class CommandBuffer
+{
+public:
+
+    //! \brief Performs the I/O of a command.
+    template <typename T>
+    using Sink = std::function<void(T const&)>;
+    //! \brief Checks a command before flushing it.
+    template <typename T>
+    using Validator = std::function<bool(T const&)>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Counters of the commands since the creation of the buffer.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of commands pushed.
+        uint64_t pushed = 0u;
+        //! \brief Number of commands replaced by a later command of the same
+        //! channel and tick.
+        uint64_t coalesced = 0u;
+        //! \brief Number of commands dropped because their node was halted.
+        uint64_t discarded = 0u;
+        //! \brief Number of commands refused: unknown channel, wrong type or
+        //! failed validation.
+        uint64_t rejected = 0u;
+        //! \brief Number of commands sent to the sinks.
+        uint64_t sent = 0u;
+        //! \brief Number of flushes sending at least one command.
+        uint64_t flushes = 0u;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Declare a channel.
+    //! \param[in] p_name The name of the channel.
+    //! \param[in] p_sink The function performing the I/O of the command.
+    //! \param[in] p_validator The function checking the command before it is
+    //!            flushed (nullptr: always valid).
+    //! \return False if the channel already exists.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    bool addChannel(std::string const& p_name,
+                    Sink<T> p_sink,
+                    Validator<T> p_validator = nullptr)
+    {
+        if (m_index.find(p_name) != m_index.end())
+        {
+            return false;
+        }
+        m_index[p_name] = m_channels.size();
+        m_channels.push_back(std::make_unique<Channel<T>>(
+            std::move(p_sink), std::move(p_validator)));
+        m_pending.reserve(m_channels.size());
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Push a command, replacing the command already pushed to the
+    //! channel during this tick.
+    //! \param[in] p_channel The name of the channel.
+    //! \param[in] p_value The command.
+    //! \param[in] p_issuer The node pushing the command (nullptr: the
+    //!            command is never discarded).
+    //! \return False if the channel does not exist or holds another type.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    bool push(std::string const& p_channel,
+              T&& p_value,
+              Node const* p_issuer = nullptr)
+    {
+        using Type = std::decay_t<T>;
+
+        ++m_statistics.pushed;
+        auto it = m_index.find(p_channel);
+        if ((it == m_index.end()) ||
+            (m_channels[it->second]->type != typeTag<Type>()))
+        {
+            ++m_statistics.rejected;
+            return false;
+        }
+
+        auto& channel = static_cast<Channel<Type>&>(*m_channels[it->second]);
+        if (channel.pending)
+        {
+            ++m_statistics.coalesced;
+        }
+        if (!channel.queued)
+        {
+            channel.queued = true;
+            m_pending.push_back(it->second);
+        }
+        channel.pending = true;
+        channel.issuer = p_issuer;
+        channel.value = std::forward<T>(p_value);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Drop the pending commands pushed by a node. Called by
+    //! Node::halt() before onHalt().
+    //! \param[in] p_issuer The node being halted.
+    // ------------------------------------------------------------------------
+    void discard(Node const& p_issuer)
+    {
+        for (size_t index : m_pending)
+        {
+            ChannelBase& channel = *m_channels[index];
+            if (channel.pending && (channel.issuer == &p_issuer))
+            {
+                channel.pending = false;
+                ++m_statistics.discarded;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Validate and send the pending commands to their sinks.
+    //! \return The number of commands sent.
+    // ------------------------------------------------------------------------
+    size_t flush()
+    {
+        size_t sent = 0u;
+        for (size_t index : m_pending)
+        {
+            ChannelBase& channel = *m_channels[index];
+            channel.queued = false;
+            if (!channel.pending)
+            {
+                continue;
+            }
+            channel.pending = false;
+            if (channel.send())
+            {
+                ++sent;
+            }
+            else
+            {
+                ++m_statistics.rejected;
+            }
+        }
+        m_pending.clear();
+        m_statistics.sent += sent;
+        m_statistics.flushes += (sent > 0u) ? 1u : 0u;
+        return sent;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Drop the pending commands without sending them.
+    // ------------------------------------------------------------------------
+    void clear()
+    {
+        for (size_t index : m_pending)
+        {
+            m_channels[index]->pending = false;
+            m_channels[index]->queued = false;
+        }
+        m_pending.clear();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Called when a tree starts its tick. Nested ticks (subtrees)
+    //! do not flush.
+    // ------------------------------------------------------------------------
+    void beginTick()
+    {
+        ++m_depth;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Called when a tree ends its tick: flushes the pending commands
+    //! at the end of the outermost tick.
+    // ------------------------------------------------------------------------
+    void endTick()
+    {
+        if ((m_depth > 0u) && (--m_depth == 0u))
+        {
+            flush();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a channel exists.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool hasChannel(std::string const& p_name) const
+    {
+        return m_index.find(p_name) != m_index.end();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of pending commands.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t pending() const
+    {
+        size_t count = 0u;
+        for (size_t index : m_pending)
+        {
+            count += m_channels[index]->pending ? 1u : 0u;
+        }
+        return count;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the counters of the commands.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics const& statistics() const
+    {
+        return m_statistics;
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief RTTI-free type identifier: the address of a variable per type.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    static void const* typeTag()
+    {
+        static char const tag = 0;
+        return &tag;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Channel without its type.
+    // ------------------------------------------------------------------------
+    struct ChannelBase
+    {
+        explicit ChannelBase(void const* p_type) : type(p_type) {}
+        virtual ~ChannelBase() = default;
+
+        //! \brief Validate and send the command.
+        //! \return False if the command is not valid.
+        virtual bool send() = 0;
+
+        //! \brief Type of the commands.
+        void const* type;
+        //! \brief Node which pushed the command.
+        Node const* issuer = nullptr;
+        //! \brief A command is waiting for the flush.
+        bool pending = false;
+        //! \brief The channel is listed in m_pending.
+        bool queued = false;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Channel of commands of type T. The last command is kept after
+    //! the flush so that the next one is assigned in place.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    struct Channel final: public ChannelBase
+    {
+        Channel(Sink<T> p_sink, Validator<T> p_validator)
+            : ChannelBase(typeTag<T>()),
+              sink(std::move(p_sink)),
+              validator(std::move(p_validator))
+        {
+        }
+
+        bool send() override
+        {
+            if (validator && !validator(*value))
+            {
+                return false;
+            }
+            if (sink)
+            {
+                sink(*value);
+            }
+            return true;
+        }
+
+        Sink<T> sink;
+        Validator<T> validator;
+        std::optional<T> value;
+    };
+
+private:
+
+    //! \brief Declared channels.
+    std::vector<std::unique_ptr<ChannelBase>> m_channels;
+    //! \brief Channels indexed by name.
+    std::unordered_map<std::string, size_t> m_index;
+    //! \brief Channels having received a command during the tick, in the
+    //! order of their first command.
+    std::vector<size_t> m_pending;
+    //! \brief Number of nested ticks in progress.
+    size_t m_depth = 0u;
+    //! \brief Counters of the commands.
+    Statistics m_statistics;
+};
+
+} // namespace bt
@@ -0,0 +1,31 @@
+/**
+ * @file Config.hpp
+ * @brief Build profiles of the library.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+// ****************************************************************************
+//! \brief Embedded profile: the core of the library (Core/, Nodes/ except the
+//! I/O leaves, Blackboard.hpp, Ports.hpp, Resolver.hpp, Common/Clock.hpp,
+//! Common/CommandBuffer.hpp) for small targets built with -fno-exceptions
+//! -fno-rtti and a fixed memory budget. Include "BlackThorn/Embedded.hpp"
+//! instead of "BlackThorn.hpp".
+//!
+//! The profile is enabled by defining BT_EMBEDDED, or automatically when
+//! exceptions or RTTI are disabled. It removes the dependency of Tree::tick()
+//! on the visualizer client (SFML). The core code is always exception-free
+//! and RTTI-free: the embedded profile only drops what is not.
+//!
+//! Trees are allocated while they are built. Once built, ticking the built-in
+//! nodes does not allocate as long as the blackboard entries they write
+//! already exist with their final type, and strings fit in the small string
+//! buffer (see doc/examples/Embedded which checks it).
+// ****************************************************************************
+#if !defined(BT_EMBEDDED) &&                                                   \
+    (!defined(__cpp_exceptions) || !defined(__cpp_rtti))
+#    define BT_EMBEDDED 1
+#endif
@@ -0,0 +1,297 @@
+/**
+ * @file Encoding.hpp
+ * @brief Compact binary encoding of values, shared by the blackboard journal
+ * and the migration of trees between processes.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <any>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Binary encoding of values, in the native byte order (the peers run
+//! the same build). A value is a u8 tag followed by its payload. Strings,
+//! sequences and maps are prefixed by their u32 size.
+// ****************************************************************************
+namespace encoding {
+
+//! \brief Type of an encoded value.
+enum class Tag : uint8_t
+{
+    Removed = 0,  //!< The key was removed (no payload).
+    Empty = 1,    //!< std::any without value.
+    Bool = 2,     //!< u8.
+    Int = 3,      //!< int.
+    SizeT = 4,    //!< u64.
+    Float = 5,    //!< float.
+    Double = 6,   //!< double.
+    String = 7,   //!< u32 size + characters.
+    Doubles = 8,  //!< u32 size + doubles (std::vector<double>).
+    Array = 9,    //!< u32 size + values (std::vector<std::any>).
+    Map = 10,     //!< u32 size + (u32 size + key, value) pairs.
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Append a trivially copyable value.
+// ----------------------------------------------------------------------------
+template <typename T>
+void put(std::string& p_buffer, T p_value)
+{
+    p_buffer.append(reinterpret_cast<char const*>(&p_value), sizeof(T));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Append a size prefixed string.
+// ----------------------------------------------------------------------------
+inline void putString(std::string& p_buffer, std::string const& p_string)
+{
+    put(p_buffer, uint32_t(p_string.size()));
+    p_buffer.append(p_string);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Append a tagged value.
+//! \return False if the type of the value (or of one of its elements) has no
+//!         encoding: the buffer is then left partially written.
+// ----------------------------------------------------------------------------
+inline bool putValue(std::string& p_buffer, std::any const& p_value)
+{
+    using Array = std::vector<std::any>;
+    using Map = std::unordered_map<std::string, std::any>;
+
+    if (!p_value.has_value())
+    {
+        put(p_buffer, Tag::Empty);
+    }
+    else if (auto* b = std::any_cast<bool>(&p_value))
+    {
+        put(p_buffer, Tag::Bool);
+        put(p_buffer, uint8_t(*b));
+    }
+    else if (auto* i = std::any_cast<int>(&p_value))
+    {
+        put(p_buffer, Tag::Int);
+        put(p_buffer, *i);
+    }
+    else if (auto* z = std::any_cast<size_t>(&p_value))
+    {
+        put(p_buffer, Tag::SizeT);
+        put(p_buffer, uint64_t(*z));
+    }
+    else if (auto* f = std::any_cast<float>(&p_value))
+    {
+        put(p_buffer, Tag::Float);
+        put(p_buffer, *f);
+    }
+    else if (auto* d = std::any_cast<double>(&p_value))
+    {
+        put(p_buffer, Tag::Double);
+        put(p_buffer, *d);
+    }
+    else if (auto* s = std::any_cast<std::string>(&p_value))
+    {
+        put(p_buffer, Tag::String);
+        putString(p_buffer, *s);
+    }
+    else if (auto* v = std::any_cast<std::vector<double>>(&p_value))
+    {
+        put(p_buffer, Tag::Doubles);
+        put(p_buffer, uint32_t(v->size()));
+        p_buffer.append(reinterpret_cast<char const*>(v->data()),
+                        v->size() * sizeof(double));
+    }
+    else if (auto* a = std::any_cast<Array>(&p_value))
+    {
+        put(p_buffer, Tag::Array);
+        put(p_buffer, uint32_t(a->size()));
+        for (auto const& element : *a)
+        {
+            if (!putValue(p_buffer, element))
+                return false;
+        }
+    }
+    else if (auto* m = std::any_cast<Map>(&p_value))
+    {
+        put(p_buffer, Tag::Map);
+        put(p_buffer, uint32_t(m->size()));
+        for (auto const& [key, element] : *m)
+        {
+            putString(p_buffer, key);
+            if (!putValue(p_buffer, element))
+                return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// ****************************************************************************
+//! \brief Bounds-checked reader of an encoded record.
+// ****************************************************************************
+class Reader
+{
+public:
+
+    Reader(char const* p_data, size_t p_size)
+        : m_data(p_data), m_end(p_data + p_size)
+    {
+    }
+
+    template <typename T>
+    bool get(T& p_value)
+    {
+        if (size_t(m_end - m_data) < sizeof(T))
+            return false;
+        std::memcpy(&p_value, m_data, sizeof(T));
+        m_data += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string& p_string, size_t p_size)
+    {
+        if (size_t(m_end - m_data) < p_size)
+            return false;
+        p_string.assign(m_data, p_size);
+        m_data += p_size;
+        return true;
+    }
+
+    bool getString(std::string& p_string)
+    {
+        uint32_t size;
+        return get(size) && getString(p_string, size);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Decode a tagged value.
+    //! \param[out] p_value The decoded value.
+    //! \param[out] p_removed Set when the tag is Tag::Removed.
+    //! \return False on a truncated or unknown encoding.
+    // ------------------------------------------------------------------------
+    bool getValue(std::any& p_value, bool& p_removed)
+    {
+        Tag tag;
+        if (!get(tag))
+            return false;
+
+        p_removed = false;
+        switch (tag)
+        {
+            case Tag::Removed:
+                p_removed = true;
+                p_value.reset();
+                return true;
+            case Tag::Empty:
+                p_value.reset();
+                return true;
+            case Tag::Bool:
+                return getScalar<uint8_t, bool>(p_value);
+            case Tag::Int:
+                return getScalar<int, int>(p_value);
+            case Tag::SizeT:
+                return getScalar<uint64_t, size_t>(p_value);
+            case Tag::Float:
+                return getScalar<float, float>(p_value);
+            case Tag::Double:
+                return getScalar<double, double>(p_value);
+            case Tag::String:
+            {
+                std::string s;
+                if (!getString(s))
+                    return false;
+                p_value = std::move(s);
+                return true;
+            }
+            case Tag::Doubles:
+            {
+                uint32_t size;
+                if (!get(size) ||
+                    size_t(m_end - m_data) / sizeof(double) < size)
+                    return false;
+                std::vector<double> v(size);
+                std::memcpy(v.data(), m_data, size * sizeof(double));
+                m_data += size * sizeof(double);
+                p_value = std::move(v);
+                return true;
+            }
+            case Tag::Array:
+            {
+                uint32_t size;
+                if (!get(size))
+                    return false;
+                std::vector<std::any> a;
+                a.reserve(std::min<size_t>(size, size_t(m_end - m_data)));
+                bool removed;
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    std::any element;
+                    if (!getValue(element, removed) || removed)
+                        return false;
+                    a.push_back(std::move(element));
+                }
+                p_value = std::move(a);
+                return true;
+            }
+            case Tag::Map:
+            {
+                uint32_t size;
+                if (!get(size))
+                    return false;
+                std::unordered_map<std::string, std::any> m;
+                bool removed;
+                for (uint32_t i = 0; i < size; ++i)
+                {
+                    std::string key;
+                    std::any element;
+                    if (!getString(key) || !getValue(element, removed) ||
+                        removed)
+                        return false;
+                    m.emplace(std::move(key), std::move(element));
+                }
+                p_value = std::move(m);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool atEnd() const
+    {
+        return m_data == m_end;
+    }
+
+private:
+
+    template <typename Stored, typename T>
+    bool getScalar(std::any& p_value)
+    {
+        Stored stored;
+        if (!get(stored))
+            return false;
+        p_value = T(stored);
+        return true;
+    }
+
+private:
+
+    char const* m_data;
+    char const* m_end;
+};
+
+} // namespace encoding
+
+} // namespace bt
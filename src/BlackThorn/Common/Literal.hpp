@@ -0,0 +1,271 @@
+/**
+ * @file Literal.hpp
+ * @brief Exception-free, locale-independent parsing of scalar literals.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace bt {
+namespace literal {
+
+// ----------------------------------------------------------------------------
+//! \brief Parse the whole text as an integer.
+//! \details Grammar: [+-]?[0-9]+ (decimal, leading zeros allowed) or
+//!          0x[0-9a-fA-F]+ (hexadecimal). A minus sign is refused for
+//!          unsigned types. Values out of the range of T are refused.
+//! \param[in] p_text The text to parse (no surrounding spaces).
+//! \param[out] p_value The parsed value, when true is returned.
+//! \return True if the whole text is an integer fitting in T.
+// ----------------------------------------------------------------------------
+template <typename T>
+[[nodiscard]] bool parseInt(std::string_view p_text, T& p_value)
+{
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                  "parseInt needs an integer type");
+
+    char const* first = p_text.data();
+    char const* last = first + p_text.size();
+    int base = 10;
+    if ((p_text.size() > 2u) && (p_text[0] == '0') &&
+        ((p_text[1] == 'x') || (p_text[1] == 'X')))
+    {
+        first += 2;
+        base = 16;
+    }
+    else if ((first != last) && (*first == '+'))
+    {
+        ++first;
+    }
+
+    // from_chars accepts a minus sign but no plus sign: refuse "+-1", "0x-1"
+    if ((first == last) || ((*first == '-') && (first != p_text.data())))
+    {
+        return false;
+    }
+    T value = 0;
+    auto [ptr, ec] = std::from_chars(first, last, value, base);
+    if ((ec != std::errc()) || (ptr != last))
+    {
+        return false;
+    }
+    p_value = value;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Parse the whole text as a real.
+//! \details Grammar:
+//!          [+-]?([0-9]+(\.[0-9]*)?|\.[0-9]+)([eE][+-]?[0-9]+)? and the YAML
+//!          special values [+-]?.inf and .nan (lower, capitalized or upper
+//!          case). "inf", "nan" and hexadecimal floats are refused. Values
+//!          out of the range of double are refused.
+//! \param[in] p_text The text to parse (no surrounding spaces).
+//! \param[out] p_value The parsed value, when true is returned.
+//! \return True if the whole text is a real.
+// ----------------------------------------------------------------------------
+[[nodiscard]] inline bool parseDouble(std::string_view p_text, double& p_value)
+{
+    std::string_view text = p_text;
+    bool negative = false;
+    if (!text.empty() && ((text[0] == '+') || (text[0] == '-')))
+    {
+        negative = (text[0] == '-');
+        text.remove_prefix(1u);
+    }
+    if (text.empty())
+    {
+        return false;
+    }
+
+    // YAML special values
+    if (text[0] == '.' && text.size() == 4u)
+    {
+        if ((text == ".inf") || (text == ".Inf") || (text == ".INF"))
+        {
+            p_value = negative ? -std::numeric_limits<double>::infinity()
+                               : std::numeric_limits<double>::infinity();
+            return true;
+        }
+        // Not a number has no sign
+        if ((p_text == ".nan") || (p_text == ".NaN") || (p_text == ".NAN"))
+        {
+            p_value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+    }
+
+    // Validate the grammar: from_chars also accepts "inf", "nan", "1e"...
+    auto digits = [&text](size_t p_from)
+    {
+        size_t i = p_from;
+        while ((i < text.size()) && (text[i] >= '0') && (text[i] <= '9'))
+        {
+            ++i;
+        }
+        return i;
+    };
+    size_t i = digits(0u);
+    size_t const integral = i;
+    size_t fractional = 0u;
+    if ((i < text.size()) && (text[i] == '.'))
+    {
+        size_t const end = digits(i + 1u);
+        fractional = end - i - 1u;
+        i = end;
+    }
+    if ((integral == 0u) && (fractional == 0u))
+    {
+        return false;
+    }
+    if ((i < text.size()) && ((text[i] == 'e') || (text[i] == 'E')))
+    {
+        size_t exponent = i + 1u;
+        if ((exponent < text.size()) &&
+            ((text[exponent] == '+') || (text[exponent] == '-')))
+        {
+            ++exponent;
+        }
+        i = digits(exponent);
+        if (i == exponent)
+        {
+            return false;
+        }
+    }
+    if (i != text.size())
+    {
+        return false;
+    }
+
+    double value = 0.0;
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if ((ec != std::errc()) || (ptr != text.data() + text.size()))
+    {
+        return false;
+    }
+    p_value = negative ? -value : value;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Parse the whole text as a boolean.
+//! \details Grammar: the YAML 1.1 words true/false, yes/no, on/off, y/n in
+//!          lower, capitalized or upper case (e.g. "true", "True", "TRUE").
+//!          Digits are not booleans.
+//! \param[in] p_text The text to parse.
+//! \param[out] p_value The parsed value, when true is returned.
+//! \return True if the whole text is a boolean.
+// ----------------------------------------------------------------------------
+[[nodiscard]] inline bool parseBool(std::string_view p_text, bool& p_value)
+{
+    if (p_text.empty() || (p_text.size() > 5u))
+    {
+        return false;
+    }
+
+    // Lower case copy, refusing mixed cases such as "tRUE"
+    char lower[5];
+    bool all_upper = (p_text[0] >= 'A') && (p_text[0] <= 'Z');
+    bool rest_lower = true;
+    for (size_t i = 0u; i < p_text.size(); ++i)
+    {
+        char const c = p_text[i];
+        bool const is_upper = (c >= 'A') && (c <= 'Z');
+        if ((i > 0u) && is_upper)
+        {
+            rest_lower = false;
+        }
+        if ((i > 0u) && !is_upper)
+        {
+            all_upper = false;
+        }
+        lower[i] = is_upper ? char(c - 'A' + 'a') : c;
+    }
+    if (!rest_lower && !all_upper)
+    {
+        return false;
+    }
+
+    static constexpr std::array<std::string_view, 4u> yes = {
+        "true", "yes", "on", "y"};
+    static constexpr std::array<std::string_view, 4u> no = {
+        "false", "no", "off", "n"};
+    std::string_view const word(lower, p_text.size());
+    for (size_t i = 0u; i < yes.size(); ++i)
+    {
+        if ((word == yes[i]) || (word == no[i]))
+        {
+            p_value = (word == yes[i]);
+            return true;
+        }
+    }
+    return false;
+}
+
+// ****************************************************************************
+//! \brief Scalar literal classified by its text.
+// ****************************************************************************
+struct Scalar
+{
+    enum class Type
+    {
+        Int,    //!< parseInt<int>() accepted the text
+        Double, //!< parseDouble() accepted the text
+        Bool,   //!< parseBool() accepted the text
+        String, //!< anything else
+    };
+
+    Type type = Type::String;
+    int integer = 0;
+    double real = 0.0;
+    bool boolean = false;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Infer the type of a literal: int, else double, else bool, else
+//! string. Like YAML, an integer too large for int is a double.
+//! \details Texts starting with a letter other than the ones of the boolean
+//!          words are classified as strings without parsing.
+//! \param[in] p_text The text to classify.
+//! \return The type and the parsed value.
+// ----------------------------------------------------------------------------
+[[nodiscard]] inline Scalar classify(std::string_view p_text)
+{
+    Scalar scalar;
+    if (p_text.empty())
+    {
+        return scalar;
+    }
+
+    char const c = p_text[0];
+    if (((c >= '0') && (c <= '9')) || (c == '+') || (c == '-') || (c == '.'))
+    {
+        if (parseInt(p_text, scalar.integer))
+        {
+            scalar.type = Scalar::Type::Int;
+        }
+        else if (parseDouble(p_text, scalar.real))
+        {
+            scalar.type = Scalar::Type::Double;
+        }
+    }
+    else if (parseBool(p_text, scalar.boolean))
+    {
+        scalar.type = Scalar::Type::Bool;
+    }
+    return scalar;
+}
+
+} // namespace literal
+} // namespace bt
@@ -0,0 +1,216 @@
+/**
+ * @file Reactor.hpp
+ * @brief epoll based reactor waking I/O-bound leaves when their file
+ * descriptors are ready.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Reactor multiplexing the file descriptors of I/O-bound leaves
+//! (sockets, pipes, subprocesses) with epoll.
+//!
+//! Instead of blocking the tick, or spinning with non-blocking reads on each
+//! tick, a leaf registers its file descriptor with a handler and returns
+//! RUNNING. The reactor is drained (without blocking) at the beginning of
+//! Tree::tick(): handlers of ready file descriptors are called and usually
+//! just raise a flag that the leaf checks in its onRunning(). The application
+//! main loop can also sleep on wait() until at least one leaf has work to do.
+//!
+//! Usage:
+//! \code
+//!   auto reactor = std::make_shared<bt::Reactor>();
+//!   tree.setReactor(reactor);
+//!   auto& seq = tree.createRoot<bt::Sequence>();
+//!   seq.addChild<bt::ReadLine>(reactor, STDIN_FILENO);
+//!   while (tree.tick() == bt::Status::RUNNING) {
+//!       reactor->wait(std::chrono::milliseconds(100));
+//!   }
+//! \endcode
+// ****************************************************************************
+class Reactor
+{
+public:
+
+    using Ptr = std::shared_ptr<Reactor>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Handler called with the ready epoll events (EPOLLIN, EPOLLOUT,
+    //! EPOLLHUP, EPOLLERR ...) of a registered file descriptor.
+    // ------------------------------------------------------------------------
+    using Handler = std::function<void(uint32_t)>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor - creates the epoll instance.
+    // ------------------------------------------------------------------------
+    Reactor() : m_epoll(::epoll_create1(EPOLL_CLOEXEC)) {}
+
+    // Disable copy/move
+    Reactor(Reactor const&) = delete;
+    Reactor& operator=(Reactor const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - closes the epoll instance. Registered file
+    //! descriptors are not owned and are not closed.
+    // ------------------------------------------------------------------------
+    ~Reactor()
+    {
+        if (m_epoll >= 0)
+        {
+            ::close(m_epoll);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if the epoll instance has been created.
+    //! \return True if the reactor is usable.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const
+    {
+        return m_epoll >= 0;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the epoll file descriptor, to nest the reactor inside
+    //! another event loop (it becomes readable when a leaf has work to do).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] int fd() const
+    {
+        return m_epoll;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Register a file descriptor (or update its events and handler if
+    //! already registered).
+    //! \param[in] p_fd The file descriptor to watch.
+    //! \param[in] p_events The epoll events to watch (i.e. EPOLLIN, EPOLLOUT).
+    //! \param[in] p_handler The handler called when the fd is ready.
+    //! \return True on success, false if epoll_ctl failed.
+    // ------------------------------------------------------------------------
+    bool add(int p_fd, uint32_t p_events, Handler p_handler)
+    {
+        epoll_event event{};
+        event.events = p_events;
+        event.data.fd = p_fd;
+
+        bool registered = (m_handlers.count(p_fd) != 0u);
+        if (::epoll_ctl(m_epoll,
+                        registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD,
+                        p_fd,
+                        &event) != 0)
+        {
+            return false;
+        }
+
+        m_handlers[p_fd] = std::make_shared<Handler>(std::move(p_handler));
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Unregister a file descriptor. Safe to call from a handler and
+    //! for file descriptors not registered.
+    //! \param[in] p_fd The file descriptor to forget.
+    // ------------------------------------------------------------------------
+    void remove(int p_fd)
+    {
+        if (m_handlers.erase(p_fd) != 0u)
+        {
+            ::epoll_ctl(m_epoll, EPOLL_CTL_DEL, p_fd, nullptr);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a file descriptor is registered.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool contains(int p_fd) const
+    {
+        return m_handlers.count(p_fd) != 0u;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of registered file descriptors.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t size() const
+    {
+        return m_handlers.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Dispatch the ready file descriptors without blocking. Called by
+    //! Tree::tick() before ticking the root node.
+    //! \return The number of handlers called.
+    // ------------------------------------------------------------------------
+    size_t poll()
+    {
+        return dispatch(0);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Block until at least one file descriptor is ready or the
+    //! timeout expires, then dispatch the ready file descriptors.
+    //! \param[in] p_timeout Maximum duration to wait.
+    //! \return The number of handlers called.
+    // ------------------------------------------------------------------------
+    size_t wait(std::chrono::milliseconds p_timeout)
+    {
+        return dispatch(int(p_timeout.count()));
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Wait for events and call the handlers of ready fds.
+    // ------------------------------------------------------------------------
+    size_t dispatch(int p_timeout_ms)
+    {
+        if ((m_epoll < 0) || m_handlers.empty())
+        {
+            return 0u;
+        }
+
+        int count = ::epoll_wait(
+            m_epoll, m_events.data(), int(m_events.size()), p_timeout_ms);
+
+        size_t called = 0u;
+        for (int i = 0; i < count; ++i)
+        {
+            // The handler may unregister itself (or another fd): keep it
+            // alive and skip fds removed by a previous handler.
+            auto it = m_handlers.find(m_events[size_t(i)].data.fd);
+            if (it == m_handlers.end())
+            {
+                continue;
+            }
+            std::shared_ptr<Handler> handler = it->second;
+            (*handler)(m_events[size_t(i)].events);
+            ++called;
+        }
+        return called;
+    }
+
+private:
+
+    //! \brief The epoll instance.
+    int m_epoll;
+    //! \brief Handlers of registered file descriptors.
+    std::unordered_map<int, std::shared_ptr<Handler>> m_handlers;
+    //! \brief Buffer of ready events filled by epoll_wait.
+    std::array<epoll_event, 64> m_events{};
+};
+
+} // namespace bt
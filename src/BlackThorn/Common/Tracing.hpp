@@ -0,0 +1,34 @@
+/**
+ * @file Tracing.hpp
+ * @brief Optional USDT (SystemTap-style) static tracepoints for perf, bpftrace
+ * and SystemTap.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+// ****************************************************************************
+//! \brief BT_TRACE(probe, args...) places the USDT probe blackthorn:probe.
+//!
+//! Probes are compiled in when BT_USDT is defined (make USDT=1) and
+//! <sys/sdt.h> is available (package systemtap-sdt-dev on Debian). A probe is
+//! a single nop instruction and a note in the ELF file: nothing is executed
+//! until a tracer attaches to it. Arguments must be cheap to compute (ids,
+//! pointers, C strings) since they are evaluated even when no tracer is
+//! attached. Without BT_USDT, probes and their arguments vanish.
+//!
+//! Probes (see doc/tracing-guide.md and the bpftrace scripts in doc/tracing):
+//! - tree__tick__enter(tree), tree__tick__exit(tree, status)
+//! - node__tick__enter(node, id, type), node__tick__exit(node, id, status)
+//! - blackboard__write(blackboard, key, version)
+//! - builder__load__enter(path), builder__load__exit(path, success)
+//! - visualizer__send(bytes, success)
+// ****************************************************************************
+#if defined(BT_USDT)
+#    include <sys/sdt.h>
+#    define BT_TRACE(probe, ...) STAP_PROBEV(blackthorn, probe, __VA_ARGS__)
+#else
+#    define BT_TRACE(probe, ...) ((void)0)
+#endif
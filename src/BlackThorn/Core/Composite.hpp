@@ -23,6 +23,9 @@ class Composite: public Node
 {
 public:
 
+    Composite() = default;
+    Composite& operator=(Composite const&) = delete;
+
     // ------------------------------------------------------------------------
     //! \brief Initialize the composite node before running.
     //! \return Status::RUNNING to proceed with onRunning().
@@ -84,6 +87,16 @@ public:
         return m_children;
     }
 
+    [[nodiscard]] size_t childrenCount() const override
+    {
+        return m_children.size();
+    }
+
+    [[nodiscard]] Node* childAt(size_t p_index) override
+    {
+        return m_children[p_index].get();
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Check if the composite node is valid.
     //! \return True if the composite node is valid, false otherwise.
@@ -118,6 +131,7 @@ public:
     // ------------------------------------------------------------------------
     void halt() override
     {
+        discardCommands();
         for (auto const& child : m_children)
         {
             child->halt();
@@ -129,6 +143,92 @@ public:
         m_status = Status::INVALID;
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Deep copy constructor used by clone(): children are cloned and
+    //! the iterator of a RUNNING composite points to the same child.
+    //! A child that is not clonable is left null (see cloneAs()).
+    // ------------------------------------------------------------------------
+    Composite(Composite const& p_other) : Node(p_other)
+    {
+        m_children.reserve(p_other.m_children.size());
+        for (auto const& child : p_other.m_children)
+        {
+            m_children.emplace_back(child->clone());
+        }
+        m_iterator = m_children.begin();
+        if (p_other.m_status == Status::RUNNING)
+        {
+            m_iterator += std::distance(
+                p_other.m_children.begin(),
+                std::vector<Node::Ptr>::const_iterator(p_other.m_iterator));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the index of the current child of a RUNNING composite.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        uint32_t index = 0u;
+        if (m_status == Status::RUNNING)
+        {
+            index = uint32_t(std::distance(
+                m_children.begin(),
+                std::vector<Node::Ptr>::const_iterator(m_iterator)));
+        }
+        encoding::put(p_state, index);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the index of the current child.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        uint32_t index;
+        if (!p_state.get(index) || (index > m_children.size()))
+        {
+            return false;
+        }
+        m_iterator = m_children.begin() + index;
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Halt the children still RUNNING, e.g. once the outcome of the
+    //! composite no longer depends on them.
+    // ------------------------------------------------------------------------
+    void haltRunningChildren()
+    {
+        for (auto const& child : m_children)
+        {
+            if (child->status() == Status::RUNNING)
+            {
+                child->halt();
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Implement clone() for the composite T.
+    //! \return The copy, or nullptr if one of the children is not clonable.
+    // ------------------------------------------------------------------------
+    template <class T>
+    [[nodiscard]] static Node::Ptr cloneAs(T const& p_node)
+    {
+        auto copy = std::make_unique<T>(p_node);
+        for (auto const& child : copy->m_children)
+        {
+            if (child == nullptr)
+            {
+                return nullptr;
+            }
+        }
+        return copy;
+    }
+
 protected:
 
     //! \brief The children nodes of the composite node.
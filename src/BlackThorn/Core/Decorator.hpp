@@ -20,6 +20,9 @@ class Decorator: public Node
 {
 public:
 
+    Decorator() = default;
+    Decorator& operator=(Decorator const&) = delete;
+
     // ------------------------------------------------------------------------
     //! \brief Set the child node of the decorator.
     //! \param[in] child The child node to set.
@@ -72,6 +75,16 @@ public:
         return *(m_child.get());
     }
 
+    [[nodiscard]] size_t childrenCount() const override
+    {
+        return (m_child != nullptr) ? 1u : 0u;
+    }
+
+    [[nodiscard]] Node* childAt(size_t /* p_index */) override
+    {
+        return m_child.get();
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Check if the composite node is valid.
     //! \return True if the composite node is valid, false otherwise.
@@ -98,6 +111,7 @@ public:
     // ------------------------------------------------------------------------
     void halt() override
     {
+        discardCommands();
         if (m_child != nullptr)
         {
             m_child->halt();
@@ -109,6 +123,33 @@ public:
         m_status = Status::INVALID;
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Deep copy constructor used by clone(): the child is cloned.
+    //! A child that is not clonable is left null (see cloneAs()).
+    // ------------------------------------------------------------------------
+    Decorator(Decorator const& p_other)
+        : Node(p_other),
+          m_child(p_other.m_child ? p_other.m_child->clone() : nullptr)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Implement clone() for the decorator T.
+    //! \return The copy, or nullptr if the child is not clonable.
+    // ------------------------------------------------------------------------
+    template <class T>
+    [[nodiscard]] static Node::Ptr cloneAs(T const& p_node)
+    {
+        auto copy = std::make_unique<T>(p_node);
+        if ((p_node.m_child != nullptr) && (copy->m_child == nullptr))
+        {
+            return nullptr;
+        }
+        return copy;
+    }
+
 protected:
 
     Node::Ptr m_child = nullptr;
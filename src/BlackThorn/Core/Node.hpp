@@ -11,14 +11,18 @@
 #include "BlackThorn/Blackboard/Blackboard.hpp"
 #include "BlackThorn/Blackboard/Ports.hpp"
 #include "BlackThorn/Blackboard/Resolver.hpp"
+#include "BlackThorn/Common/Clock.hpp"
+#include "BlackThorn/Common/CommandBuffer.hpp"
+#include "BlackThorn/Common/Encoding.hpp"
+#include "BlackThorn/Common/Tracing.hpp"
 #include "BlackThorn/Core/Status.hpp"
 #include "BlackThorn/Visitors/Visitor.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <memory>
 #include <optional>
-#include <regex>
 #include <string>
 #include <unordered_map>
 
@@ -37,6 +41,10 @@ public:
 
     using Ptr = std::unique_ptr<Node>;
 
+    //! \brief Marker holding the node being ticked in a tree (nullptr when
+    //! the tree is not ticked), read by the SamplingProfiler.
+    using TickMarker = std::atomic<Node const*>;
+
     // ------------------------------------------------------------------------
     //! \brief Create a new node of type T.
     //! \param[in] args The arguments to pass to the constructor of T.
@@ -72,6 +80,15 @@ public:
     // ------------------------------------------------------------------------
     [[nodiscard]] Status tick()
     {
+        BT_TRACE(node__tick__enter, this, m_id, m_type.c_str());
+
+        Node const* caller = nullptr;
+        if (m_marker != nullptr)
+        {
+            caller = m_marker->load(std::memory_order_relaxed);
+            m_marker->store(this, std::memory_order_relaxed);
+        }
+
         if (m_status != Status::RUNNING)
         {
             m_status = onSetUp();
@@ -84,6 +101,13 @@ public:
                 onTearDown(m_status);
             }
         }
+
+        if (m_marker != nullptr)
+        {
+            m_marker->store(caller, std::memory_order_relaxed);
+        }
+
+        BT_TRACE(node__tick__exit, this, m_id, int(m_status));
         return m_status;
     }
 
@@ -117,10 +141,12 @@ public:
 
     // ------------------------------------------------------------------------
     //! \brief Halt the execution of the node. This will call onHalt() if the
-    //! node is currently running, then reset the node status.
+    //! node is currently running, then reset the node status. The commands
+    //! pushed by the node during the tick are discarded.
     // ------------------------------------------------------------------------
     virtual void halt()
     {
+        discardCommands();
         if (m_status == Status::RUNNING)
         {
             onHalt();
@@ -128,6 +154,44 @@ public:
         m_status = Status::INVALID;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Append the execution state of the node, without its children,
+    //! to a buffer. Prefer Tree::saveState() which saves the whole tree.
+    //! \details The type, the number of children and the status are saved,
+    //!          then the state specific to the node (see onSaveState()).
+    //! \param[in,out] p_state The buffer.
+    //! \return False if the node cannot be restored in its current state.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool saveState(std::string& p_state) const
+    {
+        encoding::putString(p_state, m_type);
+        encoding::put(p_state, uint32_t(childrenCount()));
+        encoding::put(p_state, m_status);
+        return onSaveState(p_state);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the execution state saved by saveState() on a node
+    //! built from the same description.
+    //! \param[in,out] p_state The reader of the buffer.
+    //! \return False if the state is truncated or was saved by a node of
+    //!         another type.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool loadState(encoding::Reader& p_state)
+    {
+        std::string type;
+        uint32_t children;
+        Status status;
+        if (!p_state.getString(type) || (type != m_type) ||
+            !p_state.get(children) || (children != childrenCount()) ||
+            !p_state.get(status) || (status > Status::FAILURE))
+        {
+            return false;
+        }
+        m_status = status;
+        return onLoadState(p_state);
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Method invoked by the method onSetUp() of the Tree class to be
     //! sure the whole tree is valid.
@@ -147,6 +211,46 @@ public:
     // ------------------------------------------------------------------------
     virtual void accept(BehaviorTreeVisitor& p_visitor) = 0;
 
+    // ------------------------------------------------------------------------
+    //! \brief Deep copy the node, its children and its execution state (a
+    //! RUNNING node stays RUNNING in the copy). Used by Tree::fork().
+    //! \details The copy shares the blackboard and the clock of the original.
+    //! Nodes holding resources that cannot be duplicated (file descriptors,
+    //! processes, user objects) are not clonable: by default nullptr is
+    //! returned. Custom actions can opt in with:
+    //! \code
+    //!   Node::Ptr clone() const override
+    //!   {
+    //!       return std::make_unique<MyAction>(*this);
+    //!   }
+    //! \endcode
+    //! \return The copy, or nullptr if the node or one of its descendants is
+    //! not clonable.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual Node::Ptr clone() const
+    {
+        return nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of children (0 for leaves). Together with
+    //! childAt(), lets the tree be traversed without RTTI.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual size_t childrenCount() const
+    {
+        return 0u;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get a child.
+    //! \param[in] p_index The index of the child, below childrenCount().
+    //! \return The child, or nullptr for leaves.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual Node* childAt(size_t /* p_index */)
+    {
+        return nullptr;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Get the blackboard for the node.
     //! \return The blackboard for the node.
@@ -176,6 +280,64 @@ public:
         m_port_remapping = p_remapping;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Set the clock read by the time-based nodes. Prefer
+    //! Tree::setClock() which sets the clock of all nodes of the tree.
+    //! \param[in] p_clock The clock, or nullptr for the steady clock.
+    // ------------------------------------------------------------------------
+    void setClock(Clock::Ptr const& p_clock)
+    {
+        m_clock = p_clock;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the clock of the node.
+    //! \return The clock, or nullptr when the steady clock is used.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] inline Clock::Ptr const& clock() const
+    {
+        return m_clock;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the marker updated when entering and leaving tick(). Prefer
+    //! Tree::setTickMarker() which sets the marker of all nodes of the tree.
+    //! \param[in] p_marker The marker, or nullptr to disable the tracking.
+    // ------------------------------------------------------------------------
+    void setTickMarker(TickMarker* p_marker)
+    {
+        m_marker = p_marker;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the marker updated when entering and leaving tick().
+    //! \return The marker, or nullptr when the node is not tracked.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] inline TickMarker* tickMarker() const
+    {
+        return m_marker;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the buffer receiving the commands of the node. Prefer
+    //! Tree::setCommandBuffer() which sets the buffer of all nodes of the
+    //! tree.
+    //! \param[in] p_commands The buffer, or nullptr to drop the commands.
+    // ------------------------------------------------------------------------
+    void setCommandBuffer(CommandBuffer* p_commands)
+    {
+        m_commands = p_commands;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the buffer receiving the commands of the node.
+    //! \return The buffer, or nullptr when the commands are dropped.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] inline CommandBuffer* commandBuffer() const
+    {
+        return m_commands;
+    }
+
 protected: // Port management
 
     // ------------------------------------------------------------------------
@@ -191,8 +353,9 @@ protected: // Port management
         {
             return std::nullopt;
         }
-        auto key = m_port_remapping.count(p_port) ? m_port_remapping.at(p_port)
-                                                  : p_port;
+        auto it = m_port_remapping.find(p_port);
+        std::string const& key =
+            (it != m_port_remapping.end()) ? it->second : p_port;
         return VariableResolver::resolveValue<T>(key, *m_blackboard);
     }
 
@@ -210,16 +373,15 @@ protected: // Port management
             return;
         }
 
-        std::string key = m_port_remapping.count(p_port)
-                              ? m_port_remapping.at(p_port)
-                              : p_port;
+        auto it = m_port_remapping.find(p_port);
+        std::string const& key =
+            (it != m_port_remapping.end()) ? it->second : p_port;
 
         // Extract the key from ${key} syntax
-        std::regex pattern(R"(\$\{([^}]+)\})");
-        std::smatch match;
-        if (std::regex_match(key, match, pattern))
+        std::string_view reference;
+        if (VariableResolver::isReference(key, reference))
         {
-            m_blackboard->set(match[1].str(), std::forward<T>(p_value));
+            m_blackboard->set(reference, std::forward<T>(p_value));
         }
         else
         {
@@ -227,6 +389,104 @@ protected: // Port management
         }
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Get an input from a typed port: the name of the key is the name
+    //! of the port and its type the type of the value.
+    //! \param[in] p_port The port to get the input from.
+    //! \return The input value, or std::nullopt if not found.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    std::optional<T> getInput(Key<T> const& p_port) const
+    {
+        return getInput<T>(p_port.name());
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set an output to a typed port, converting the value to the type
+    //! of the port.
+    //! \param[in] p_port The port to set the output to.
+    //! \param[in] p_value The value to set the output to.
+    // ------------------------------------------------------------------------
+    template <typename T, typename U>
+    void setOutput(Key<T> const& p_port, U&& p_value)
+    {
+        if constexpr (std::is_same_v<std::decay_t<U>, T>)
+        {
+            setOutput(p_port.name(), std::forward<U>(p_value));
+        }
+        else
+        {
+            setOutput(p_port.name(), T(std::forward<U>(p_value)));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the current time from the clock of the node.
+    //! \return The time of the attached clock, else the steady clock time.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Clock::TimePoint now() const
+    {
+        return m_clock ? m_clock->now() : std::chrono::steady_clock::now();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Append a time point as the nanoseconds elapsed since it, so
+    //! that it does not depend on the clock origin of the host.
+    // ------------------------------------------------------------------------
+    void saveTime(std::string& p_state, Clock::TimePoint p_time) const
+    {
+        encoding::put(p_state, int64_t(std::chrono::duration_cast<
+                                           std::chrono::nanoseconds>(
+                                           now() - p_time)
+                                           .count()));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read back a time point appended by saveTime().
+    //! \return False if the buffer is truncated.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool loadTime(encoding::Reader& p_state,
+                                Clock::TimePoint& p_time) const
+    {
+        int64_t elapsed;
+        if (!p_state.get(elapsed))
+        {
+            return false;
+        }
+        p_time = now() - std::chrono::duration_cast<Clock::Duration>(
+                             std::chrono::nanoseconds(elapsed));
+        return true;
+    }
+
+protected: // Commands
+
+    // ------------------------------------------------------------------------
+    //! \brief Push a command to the command buffer of the tree, flushed at
+    //! the end of the tick (see CommandBuffer).
+    //! \param[in] p_channel The name of the channel.
+    //! \param[in] p_value The command.
+    //! \return False if there is no buffer, or the channel does not exist or
+    //!         holds another type.
+    // ------------------------------------------------------------------------
+    template <typename T>
+    bool command(std::string const& p_channel, T&& p_value)
+    {
+        return (m_commands != nullptr) &&
+               m_commands->push(p_channel, std::forward<T>(p_value), this);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Discard the commands pushed by the node during the tick. Called
+    //! by halt() before onHalt().
+    // ------------------------------------------------------------------------
+    void discardCommands()
+    {
+        if (m_commands != nullptr)
+        {
+            m_commands->discard(*this);
+        }
+    }
+
 protected: // Lifecycle methods
 
     // ------------------------------------------------------------------------
@@ -273,6 +533,30 @@ protected: // Lifecycle methods
         // Default implementation does nothing
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Method invoked by saveState() to append the state specific to
+    //! the node (cursors, counters, timers).
+    //! \details By default nothing is saved: override for nodes holding
+    //! state between ticks. Time points are saved relative to now(), so that
+    //! the state can be restored on another host. Return false when the
+    //! state cannot be restored elsewhere (e.g. a pending I/O).
+    //! \return True if the node can be restored from the buffer.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual bool onSaveState(std::string& /* p_state */) const
+    {
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Method invoked by loadState() to read back the state appended
+    //! by onSaveState().
+    //! \return False if the state is truncated or invalid.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] virtual bool onLoadState(encoding::Reader& /* p_state */)
+    {
+        return true;
+    }
+
 public:
 
     //! \brief The name of the node.
@@ -308,6 +592,12 @@ protected:
     Blackboard::Ptr m_blackboard = nullptr;
     //! \brief The port remapping for this node (port name -> blackboard key).
     std::unordered_map<std::string, std::string> m_port_remapping;
+    //! \brief The clock of the time-based nodes (nullptr: steady clock).
+    Clock::Ptr m_clock = nullptr;
+    //! \brief The marker of the node being ticked (nullptr: not tracked).
+    TickMarker* m_marker = nullptr;
+    //! \brief The buffer of the commands (nullptr: commands dropped).
+    CommandBuffer* m_commands = nullptr;
 };
 
 } // namespace bt
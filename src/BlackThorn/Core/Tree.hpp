@@ -1,6 +1,7 @@
 /**
  * @file Tree.hpp
- * @brief Tree container, SubTreeHandle, and SubTreeNode classes.
+ * @brief Tree container, SubTreeHandle, SubTreeNode and DynamicSubTree
+ * classes.
  *
  * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
  * distributed under MIT License
@@ -8,10 +9,14 @@
 
 #pragma once
 
+#include "BlackThorn/Common/Clock.hpp"
+#include "BlackThorn/Common/Config.hpp"
+#include "BlackThorn/Common/Reactor.hpp"
 #include "BlackThorn/Core/Composite.hpp"
 #include "BlackThorn/Core/Decorator.hpp"
 #include "BlackThorn/Core/Node.hpp"
 
+#include <atomic>
 #include <cassert>
 #include <memory>
 
@@ -20,6 +25,7 @@ namespace bt {
 // Forward declarations
 class VisualizerClient;
 class SubTreeNode;
+class DynamicSubTree;
 
 // ****************************************************************************
 //! \brief Container for a behavior tree instance.
@@ -29,6 +35,9 @@ class SubTreeNode;
 // ****************************************************************************
 class Tree
 {
+    friend class SubTreeNode;
+    friend class DynamicSubTree;
+
 public:
 
     using Ptr = std::unique_ptr<Tree>;
@@ -197,6 +206,131 @@ public:
         return m_visualizer;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Attach the reactor used by the I/O-bound leaves of this tree.
+    //! When attached, the ready file descriptors are dispatched (without
+    //! blocking) at the beginning of each tick() call.
+    //! \param[in] p_reactor The reactor to attach.
+    // ------------------------------------------------------------------------
+    void setReactor(Reactor::Ptr p_reactor)
+    {
+        m_reactor = std::move(p_reactor);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the attached reactor.
+    //! \return The reactor, or nullptr if none attached.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Reactor::Ptr reactor() const
+    {
+        return m_reactor;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the clock read by the time-based nodes (Wait, Timeout,
+    //! Delay, Cooldown) of the tree and of its subtrees. Call it once the
+    //! tree is built.
+    //! \param[in] p_clock The clock, or nullptr for the steady clock.
+    // ------------------------------------------------------------------------
+    void setClock(Clock::Ptr p_clock);
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the clock of the tree.
+    //! \return The clock, or nullptr when the steady clock is used.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Clock::Ptr clock() const
+    {
+        return m_clock;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the marker in which the nodes of the tree and of its
+    //! subtrees store themselves while they are ticked (see SamplingProfiler).
+    //! Call it once the tree is built.
+    //! \param[in] p_marker The marker, or nullptr to disable the tracking.
+    // ------------------------------------------------------------------------
+    void setTickMarker(Node::TickMarker* p_marker);
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the marker of the node being ticked.
+    //! \return The marker, or nullptr when the nodes are not tracked.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Node::TickMarker* tickMarker() const
+    {
+        return m_tickMarker;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the buffer receiving the commands of the nodes of the tree
+    //! and of its subtrees, flushed when tick() returns (see CommandBuffer).
+    //! Call it once the tree is built. The buffer is not owned.
+    //! \param[in] p_commands The buffer, or nullptr to drop the commands.
+    // ------------------------------------------------------------------------
+    void setCommandBuffer(CommandBuffer* p_commands);
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the buffer receiving the commands of the nodes.
+    //! \return The buffer, or nullptr when the commands are dropped.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] CommandBuffer* commandBuffer() const
+    {
+        return m_commands;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Copy the tree in its current execution state, e.g. to roll out
+    //! "what if" simulations from the live tree.
+    //! \details Nodes are cloned with their state (see Node::clone()): a
+    //!          RUNNING branch keeps running in the fork. The blackboard
+    //!          chain (including the blackboards of subtrees) is forked with
+    //!          copy-on-write (see Blackboard::fork()), so forking costs the
+    //!          nodes only and large values are copied when written. The fork
+    //!          has no visualizer, no reactor and no command buffer (its
+    //!          commands are dropped).
+    //! \param[in] p_clock The clock of the fork (e.g. a ManualClock to run it
+    //!            faster than real time), or nullptr to keep the clock of
+    //!            this tree.
+    //! \return The fork, or nullptr if a node is not clonable.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Ptr fork(Clock::Ptr p_clock = nullptr) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Copy the tree in its current execution state, reusing the
+    //! blackboards already forked in p_forks.
+    //! \details Seeding p_forks with {original, replacement} makes the fork
+    //!          use the replacement instead of forking the original, e.g. to
+    //!          attach the fork to another parent blackboard.
+    //! \param[in,out] p_forks The forked blackboards indexed by original.
+    //! \param[in] p_clock The clock of the fork, or nullptr to keep the clock
+    //!            of this tree.
+    //! \return The fork, or nullptr if a node is not clonable.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Ptr fork(Blackboard::Forks& p_forks,
+                           Clock::Ptr p_clock = nullptr) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Append the execution state of the tree to a buffer, e.g. to
+    //! move a running tree to another process (see Shards).
+    //! \details The status of the tree, then the state of each node (status,
+    //!          current child, counters, elapsed time of the timers, see
+    //!          Node::saveState()) and of its subtrees are saved, in depth
+    //!          first order. Blackboards are not saved. The buffer can only
+    //!          be loaded by a tree built from the same description.
+    //! \param[in,out] p_state The buffer.
+    //! \return False if a node cannot be restored in its current state
+    //!         (e.g. a pending I/O): the buffer is then partially written.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool saveState(std::string& p_state) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the execution state saved by saveState(): the next
+    //! tick() resumes the tree where the saved tree stopped.
+    //! \param[in,out] p_state The reader of the buffer.
+    //! \return False if the state is truncated or does not match the nodes
+    //!         of this tree: the tree should then be reset.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool loadState(encoding::Reader& p_state);
+
     // ------------------------------------------------------------------------
     //! \brief Reset the tree state and recursively reset all nodes.
     // ------------------------------------------------------------------------
@@ -271,6 +405,13 @@ public:
     [[nodiscard]] SubTreeNode const*
     findSubTree(std::string const& p_name) const;
 
+    // ------------------------------------------------------------------------
+    //! \brief Find a DynamicSubTree by its name, also in the subtrees.
+    //! \param[in] p_name The name of the DynamicSubTree to find.
+    //! \return Pointer to the DynamicSubTree if found, nullptr otherwise.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] DynamicSubTree* findDynamicSubTree(std::string const& p_name);
+
 private:
 
     //! \brief The root node of the behavior tree.
@@ -281,10 +422,31 @@ private:
     Status m_status = Status::INVALID;
     //! \brief Optional visualizer client for real-time monitoring.
     std::shared_ptr<VisualizerClient> m_visualizer = nullptr;
+    //! \brief Optional reactor waking I/O-bound leaves.
+    Reactor::Ptr m_reactor = nullptr;
     //! \brief Output remapping for subtrees (child key -> parent key).
     std::unordered_map<std::string, std::string> m_outputRemapping;
     //! \brief Parent blackboard for output propagation (subtrees only).
     Blackboard::Ptr m_parentBlackboard = nullptr;
+    //! \brief Clock of the time-based nodes (nullptr: steady clock).
+    Clock::Ptr m_clock = nullptr;
+    //! \brief Marker of the node being ticked (nullptr: not tracked).
+    Node::TickMarker* m_tickMarker = nullptr;
+    //! \brief Buffer of the commands of the nodes (nullptr: dropped).
+    CommandBuffer* m_commands = nullptr;
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Clone the nodes, sharing the blackboards (see fork()).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Ptr clone() const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Replace the blackboards of the tree, of its nodes and of its
+    //! subtrees by their forks.
+    // ------------------------------------------------------------------------
+    void forkBlackboards(Blackboard::Forks& p_forks);
 };
 
 // ****************************************************************************
@@ -348,6 +510,23 @@ public:
                m_handle->tree().isValid();
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        if (m_handle == nullptr)
+        {
+            return nullptr;
+        }
+        Tree::Ptr tree = m_handle->tree().clone();
+        if (tree == nullptr)
+        {
+            return nullptr;
+        }
+        auto copy = std::make_unique<SubTreeNode>(*this);
+        copy->m_handle =
+            std::make_shared<SubTreeHandle>(m_handle->id(), std::move(tree));
+        return copy;
+    }
+
 protected:
 
     [[nodiscard]] Status onSetUp() override
@@ -423,11 +602,313 @@ private:
     SubTreeHandle::Ptr m_handle;
 };
 
+// ****************************************************************************
+//! \brief Node executing a Tree whose content can be replaced while the tree
+//! is running, e.g. by the plan fragments produced by a planner.
+//!
+//! The new content is built by any thread (see FragmentBuilder) and posted
+//! with replace(). The node swaps it in at its next tick, between two ticks
+//! of its content: the old content is halted if it was running and the new
+//! content starts from scratch. Checking for a new content costs one atomic
+//! load per tick, the swap itself exchanges pointers: the old content is
+//! destroyed by the thread posting the next content, not by the ticking
+//! thread. Without content, the node fails.
+//!
+//! The content inherits the clock and the tick marker of the node. Its
+//! blackboard is left as built: make it a child of the node blackboard to
+//! read the keys of the tree.
+// ****************************************************************************
+class DynamicSubTree final: public Node
+{
+public:
+
+    // ************************************************************************
+    //! \brief Lock-free mailbox shared by the node and the threads building
+    //! its content. It outlives the node while a content is being built.
+    // ************************************************************************
+    class Mailbox
+    {
+    public:
+
+        using Ptr = std::shared_ptr<Mailbox>;
+
+        Mailbox() = default;
+        Mailbox(Mailbox const&) = delete;
+        Mailbox& operator=(Mailbox const&) = delete;
+
+        ~Mailbox()
+        {
+            delete m_pending.load(std::memory_order_acquire);
+            delete m_retired.load(std::memory_order_acquire);
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Post the next content (any thread). A content posted but
+        //! not swapped in yet is replaced. Also destroys the content retired
+        //! by the last swap.
+        //! \param[in] p_content The next content.
+        // --------------------------------------------------------------------
+        void post(Tree::Ptr p_content)
+        {
+            Tree::Ptr retired(
+                m_retired.exchange(nullptr, std::memory_order_acq_rel));
+            Tree::Ptr replaced(m_pending.exchange(p_content.release(),
+                                                  std::memory_order_acq_rel));
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Check if a content is waiting to be swapped in.
+        // --------------------------------------------------------------------
+        [[nodiscard]] bool hasPending() const
+        {
+            return m_pending.load(std::memory_order_relaxed) != nullptr;
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Take the posted content (ticking thread).
+        //! \return The content, or nullptr if none was posted.
+        // --------------------------------------------------------------------
+        [[nodiscard]] Tree::Ptr take()
+        {
+            return Tree::Ptr(
+                m_pending.exchange(nullptr, std::memory_order_acq_rel));
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Hand the swapped out content over to the next post()
+        //! (ticking thread).
+        //! \param[in] p_content The swapped out content.
+        // --------------------------------------------------------------------
+        void retire(Tree::Ptr p_content)
+        {
+            Tree::Ptr older(m_retired.exchange(p_content.release(),
+                                               std::memory_order_acq_rel));
+        }
+
+    private:
+
+        //! \brief Content posted, not swapped in yet (owned).
+        std::atomic<Tree*> m_pending{nullptr};
+        //! \brief Content swapped out, not destroyed yet (owned).
+        std::atomic<Tree*> m_retired{nullptr};
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the string representation of the node type.
+    //! \return The string "DynamicSubTree".
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static constexpr char const* toString()
+    {
+        return "DynamicSubTree";
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_content The initial content, or nullptr.
+    // ------------------------------------------------------------------------
+    explicit DynamicSubTree(Tree::Ptr p_content = nullptr)
+        : m_mailbox(std::make_shared<Mailbox>()),
+          m_content(std::move(p_content))
+    {
+        m_type = toString();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Copy the node state, without the content and the posted content
+    //! (see clone()).
+    // ------------------------------------------------------------------------
+    DynamicSubTree(DynamicSubTree const& p_other)
+        : Node(p_other),
+          m_mailbox(std::make_shared<Mailbox>()),
+          m_swaps(p_other.m_swaps)
+    {
+    }
+
+    DynamicSubTree& operator=(DynamicSubTree const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Post the next content, swapped in at the next tick. Can be
+    //! called from any thread.
+    //! \param[in] p_content The next content.
+    // ------------------------------------------------------------------------
+    void replace(Tree::Ptr p_content)
+    {
+        m_mailbox->post(std::move(p_content));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the mailbox receiving the next content.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Mailbox::Ptr mailbox() const
+    {
+        return m_mailbox;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the current content (ticking thread).
+    //! \return The content, or nullptr if none was swapped in.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Tree* content()
+    {
+        return m_content.get();
+    }
+
+    [[nodiscard]] Tree const* content() const
+    {
+        return m_content.get();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of contents swapped in.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t swaps() const
+    {
+        return m_swaps;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief The node is valid without content (it fails until a content
+    //! is posted).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_content == nullptr) || m_content->isValid();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Clone the node and its current content. The posted content is
+    //! not cloned.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        auto copy = std::make_unique<DynamicSubTree>(*this);
+        if (m_content)
+        {
+            copy->m_content = m_content->clone();
+            if (copy->m_content == nullptr)
+            {
+                return nullptr;
+            }
+        }
+        return copy;
+    }
+
+    void accept(ConstBehaviorTreeVisitor& p_visitor) const override
+    {
+        p_visitor.visitDynamicSubTree(*this);
+    }
+
+    void accept(BehaviorTreeVisitor& p_visitor) override
+    {
+        p_visitor.visitDynamicSubTree(*this);
+    }
+
+protected:
+
+    [[nodiscard]] Status onSetUp() override
+    {
+        swapContent();
+        if (!m_content)
+        {
+            return Status::FAILURE;
+        }
+        m_content->reset();
+        return Status::RUNNING;
+    }
+
+    [[nodiscard]] Status onRunning() override
+    {
+        swapContent();
+        if (!m_content)
+        {
+            return Status::FAILURE;
+        }
+        return m_content->tick();
+    }
+
+    void onTearDown(Status) override
+    {
+        if (m_content)
+        {
+            m_content->reset();
+        }
+    }
+
+    void onHalt() override
+    {
+        if (m_content)
+        {
+            m_content->halt();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief A content swapped in at runtime is not part of the description
+    //! of the tree, so it cannot be rebuilt elsewhere. The initial content is
+    //! saved by Tree::saveState().
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string&) const override
+    {
+        return (m_swaps == 0u) && !m_mailbox->hasPending();
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Swap in the posted content, if any.
+    // ------------------------------------------------------------------------
+    void swapContent()
+    {
+        if (!m_mailbox->hasPending())
+        {
+            return;
+        }
+        Tree::Ptr next = m_mailbox->take();
+        if (!next)
+        {
+            return;
+        }
+
+        // Usually already done by the thread building the content
+        if (next->clock() != m_clock)
+        {
+            next->setClock(m_clock);
+        }
+        if (next->tickMarker() != m_marker)
+        {
+            next->setTickMarker(m_marker);
+        }
+        if (next->commandBuffer() != m_commands)
+        {
+            next->setCommandBuffer(m_commands);
+        }
+
+        if (m_content)
+        {
+            m_content->halt();
+        }
+        m_mailbox->retire(std::move(m_content));
+        m_content = std::move(next);
+        ++m_swaps;
+    }
+
+private:
+
+    //! \brief Mailbox receiving the next content.
+    Mailbox::Ptr m_mailbox;
+    //! \brief Current content (nullptr: none yet).
+    Tree::Ptr m_content;
+    //! \brief Number of contents swapped in.
+    size_t m_swaps = 0u;
+};
+
 } // namespace bt
 
 // Include VisualizerClient for Tree::tick() implementation
 // Must be outside namespace bt to avoid nested namespace issues.
-#include "BlackThorn/Network/VisualizerClient.hpp"
+#if !defined(BT_EMBEDDED)
+#    include "BlackThorn/Network/VisualizerClient.hpp"
+#endif
 
 namespace bt {
 
@@ -447,13 +928,31 @@ inline Status Tree::tick()
         return m_status;
     }
 
+    // Wake up the I/O-bound leaves whose file descriptors are ready
+    if (m_reactor)
+    {
+        m_reactor->poll();
+    }
+
+    BT_TRACE(tree__tick__enter, this);
+    if (m_commands)
+    {
+        m_commands->beginTick();
+    }
     m_status = m_root->tick();
+    if (m_commands)
+    {
+        m_commands->endTick();
+    }
+    BT_TRACE(tree__tick__exit, this, int(m_status));
 
+#if !defined(BT_EMBEDDED)
     // Send state changes to visualizer if connected
     if (m_visualizer && m_visualizer->isConnected())
     {
         m_visualizer->sendStateChanges(*this);
     }
+#endif
 
     return m_status;
 }
@@ -463,6 +962,45 @@ inline Status Tree::tick()
 // ----------------------------------------------------------------------------
 namespace detail {
 
+// ----------------------------------------------------------------------------
+// RTTI-free downcast to SubTreeNode (the class is final and its type is set
+// by its constructor)
+// ----------------------------------------------------------------------------
+inline SubTreeNode* asSubTree(Node* p_node)
+{
+    return (p_node->type() == SubTreeNode::toString())
+               ? static_cast<SubTreeNode*>(p_node)
+               : nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// RTTI-free downcast to DynamicSubTree
+// ----------------------------------------------------------------------------
+inline DynamicSubTree* asDynamicSubTree(Node* p_node)
+{
+    return (p_node->type() == DynamicSubTree::toString())
+               ? static_cast<DynamicSubTree*>(p_node)
+               : nullptr;
+}
+
+// ----------------------------------------------------------------------------
+// Tree executed by a SubTreeNode or by a DynamicSubTree (current content),
+// nullptr for the other nodes
+// ----------------------------------------------------------------------------
+inline Tree* innerTree(Node* p_node)
+{
+    if (auto* subtree = asSubTree(p_node))
+    {
+        auto handle = subtree->handle();
+        return handle ? &handle->tree() : nullptr;
+    }
+    if (auto* dynamic = asDynamicSubTree(p_node))
+    {
+        return dynamic->content();
+    }
+    return nullptr;
+}
+
 inline SubTreeNode* findSubTreeRecursive(Node* p_node,
                                          std::string const& p_name)
 {
@@ -472,7 +1010,7 @@ inline SubTreeNode* findSubTreeRecursive(Node* p_node,
     }
 
     // Check if this node is the SubTree we're looking for
-    if (auto* subtree = dynamic_cast<SubTreeNode*>(p_node))
+    if (auto* subtree = asSubTree(p_node))
     {
         if (subtree->name == p_name)
         {
@@ -486,38 +1024,254 @@ inline SubTreeNode* findSubTreeRecursive(Node* p_node,
         }
     }
 
-    // Check children of Composite nodes
-    if (auto* composite = dynamic_cast<Composite*>(p_node))
+    // Check children of Composite and Decorator nodes
+    for (size_t i = 0u; i < p_node->childrenCount(); ++i)
     {
-        for (auto const& child : composite->getChildren())
+        if (auto* found = findSubTreeRecursive(p_node->childAt(i), p_name))
         {
-            if (auto* found = findSubTreeRecursive(child.get(), p_name))
-            {
-                return found;
-            }
+            return found;
         }
     }
 
-    // Check child of Decorator nodes
-    if (auto* decorator = dynamic_cast<Decorator*>(p_node))
+    return nullptr;
+}
+
+inline DynamicSubTree* findDynamicSubTreeRecursive(Node* p_node,
+                                                   std::string const& p_name)
+{
+    if (!p_node)
     {
-        if (decorator->hasChild())
+        return nullptr;
+    }
+
+    if (auto* dynamic = asDynamicSubTree(p_node);
+        dynamic && (dynamic->name == p_name))
+    {
+        return dynamic;
+    }
+
+    // Search inside subtrees and dynamic contents, then the children
+    if (Tree* inner = innerTree(p_node); inner && inner->hasRoot())
+    {
+        if (auto* found =
+                findDynamicSubTreeRecursive(&inner->getRoot(), p_name))
         {
-            if (auto* found =
-                    findSubTreeRecursive(&decorator->getChild(), p_name))
-            {
-                return found;
-            }
+            return found;
+        }
+    }
+    for (size_t i = 0u; i < p_node->childrenCount(); ++i)
+    {
+        if (auto* found =
+                findDynamicSubTreeRecursive(p_node->childAt(i), p_name))
+        {
+            return found;
         }
     }
 
     return nullptr;
 }
 
+// ----------------------------------------------------------------------------
+// Helper to call a function on a node and its descendants, without entering
+// subtrees
+// ----------------------------------------------------------------------------
+template <typename Function>
+inline void forEachNode(Node& p_node, Function const& p_function)
+{
+    p_function(p_node);
+
+    for (size_t i = 0u; i < p_node.childrenCount(); ++i)
+    {
+        if (Node* child = p_node.childAt(i))
+        {
+            forEachNode(*child, p_function);
+        }
+    }
+}
+
 } // namespace detail
 
 // ----------------------------------------------------------------------------
-// Tree::findSubTree() implementations
+// Tree::setClock(), Tree::setTickMarker(), Tree::setCommandBuffer() and
+// Tree::fork() implementations
+// ----------------------------------------------------------------------------
+inline void Tree::setClock(Clock::Ptr p_clock)
+{
+    m_clock = std::move(p_clock);
+    if (!m_root)
+    {
+        return;
+    }
+
+    detail::forEachNode(*m_root, [this](Node& p_node) {
+        p_node.setClock(m_clock);
+        if (Tree* inner = detail::innerTree(&p_node))
+        {
+            inner->setClock(m_clock);
+        }
+    });
+}
+
+inline void Tree::setTickMarker(Node::TickMarker* p_marker)
+{
+    m_tickMarker = p_marker;
+    if (!m_root)
+    {
+        return;
+    }
+
+    detail::forEachNode(*m_root, [p_marker](Node& p_node) {
+        p_node.setTickMarker(p_marker);
+        if (Tree* inner = detail::innerTree(&p_node))
+        {
+            inner->setTickMarker(p_marker);
+        }
+    });
+}
+
+inline void Tree::setCommandBuffer(CommandBuffer* p_commands)
+{
+    m_commands = p_commands;
+    if (!m_root)
+    {
+        return;
+    }
+
+    detail::forEachNode(*m_root, [p_commands](Node& p_node) {
+        p_node.setCommandBuffer(p_commands);
+        if (Tree* inner = detail::innerTree(&p_node))
+        {
+            inner->setCommandBuffer(p_commands);
+        }
+    });
+}
+
+inline Tree::Ptr Tree::clone() const
+{
+    auto copy = Tree::create();
+    if (m_root)
+    {
+        copy->m_root = m_root->clone();
+        if (!copy->m_root)
+        {
+            return nullptr;
+        }
+    }
+    copy->m_blackboard = m_blackboard;
+    copy->m_status = m_status;
+    copy->m_outputRemapping = m_outputRemapping;
+    copy->m_parentBlackboard = m_parentBlackboard;
+    copy->m_clock = m_clock;
+    return copy;
+}
+
+inline void Tree::forkBlackboards(Blackboard::Forks& p_forks)
+{
+    auto forked = [&p_forks](Blackboard::Ptr const& p_blackboard) {
+        return p_blackboard ? p_blackboard->fork(p_forks) : nullptr;
+    };
+
+    m_blackboard = forked(m_blackboard);
+    m_parentBlackboard = forked(m_parentBlackboard);
+    if (!m_root)
+    {
+        return;
+    }
+
+    detail::forEachNode(*m_root, [&](Node& p_node) {
+        p_node.setBlackboard(forked(p_node.blackboard()));
+        if (Tree* inner = detail::innerTree(&p_node))
+        {
+            inner->forkBlackboards(p_forks);
+        }
+    });
+}
+
+inline Tree::Ptr Tree::fork(Clock::Ptr p_clock) const
+{
+    Blackboard::Forks forks;
+    return fork(forks, std::move(p_clock));
+}
+
+inline Tree::Ptr Tree::fork(Blackboard::Forks& p_forks,
+                            Clock::Ptr p_clock) const
+{
+    Tree::Ptr copy = clone();
+    if (!copy)
+    {
+        return nullptr;
+    }
+
+    // The fork is not tracked by the profiler of the original tree
+    if (m_tickMarker)
+    {
+        copy->setTickMarker(nullptr);
+    }
+    // Nor does it send commands to the actuators of the original tree
+    if (m_commands)
+    {
+        copy->setCommandBuffer(nullptr);
+    }
+
+    copy->forkBlackboards(p_forks);
+    if (p_clock)
+    {
+        copy->setClock(std::move(p_clock));
+    }
+    return copy;
+}
+
+// ----------------------------------------------------------------------------
+// Tree::saveState() and Tree::loadState() implementations
+// ----------------------------------------------------------------------------
+inline bool Tree::saveState(std::string& p_state) const
+{
+    encoding::put(p_state, m_status);
+    encoding::put(p_state, uint8_t(m_root != nullptr));
+    if (!m_root)
+    {
+        return true;
+    }
+
+    bool saved = true;
+    detail::forEachNode(*m_root, [&p_state, &saved](Node& p_node) {
+        saved = saved && p_node.saveState(p_state);
+        if (Tree* inner = detail::innerTree(&p_node); saved && inner)
+        {
+            saved = inner->saveState(p_state);
+        }
+    });
+    return saved;
+}
+
+inline bool Tree::loadState(encoding::Reader& p_state)
+{
+    Status status;
+    uint8_t has_root;
+    if (!p_state.get(status) || (status > Status::FAILURE) ||
+        !p_state.get(has_root) || (bool(has_root) != (m_root != nullptr)))
+    {
+        return false;
+    }
+    m_status = status;
+    if (!m_root)
+    {
+        return true;
+    }
+
+    bool loaded = true;
+    detail::forEachNode(*m_root, [&p_state, &loaded](Node& p_node) {
+        loaded = loaded && p_node.loadState(p_state);
+        if (Tree* inner = detail::innerTree(&p_node); loaded && inner)
+        {
+            loaded = inner->loadState(p_state);
+        }
+    });
+    return loaded;
+}
+
+// ----------------------------------------------------------------------------
+// Tree::findSubTree() and Tree::findDynamicSubTree() implementations
 // ----------------------------------------------------------------------------
 inline SubTreeNode* Tree::findSubTree(std::string const& p_name)
 {
@@ -529,4 +1283,9 @@ inline SubTreeNode const* Tree::findSubTree(std::string const& p_name) const
     return detail::findSubTreeRecursive(m_root.get(), p_name);
 }
 
+inline DynamicSubTree* Tree::findDynamicSubTree(std::string const& p_name)
+{
+    return detail::findDynamicSubTreeRecursive(m_root.get(), p_name);
+}
+
 } // namespace bt
@@ -0,0 +1,457 @@
+/**
+ * @file BatchedServices.hpp
+ * @brief Registry of services called by many trees, whose requests are
+ * batched and served together.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Blackboard/Blackboard.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Registry of named services whose requests are served by batches.
+//!
+//! Thousands of agent trees often call the same expensive service from their
+//! action leaves in the same tick (path planning, raycasts ...), while the
+//! service is far more efficient with batched requests. The BatchedServiceCall
+//! leaves enqueue their request here, the batch of pending requests is served
+//! by one call of the service, and each leaf gets its own response.
+//!
+//! A batch is served:
+//! - by flush(), called by the Executor at the point of the tick chosen with
+//!   Executor::setBatchFlush() (end of tick by default);
+//! - as soon as it holds Limits::maxBatch requests;
+//! - when its oldest request waited Limits::maxDelay (checked when enqueuing
+//!   and by flushExpired()).
+//!
+//! Services must be added before ticking the trees: add() is not
+//! thread-safe, the other methods are. A service is called by one thread at a
+//! time.
+//!
+//! Usage example:
+//! \code
+//!   auto services = std::make_shared<bt::BatchedServices>();
+//!   services->add("plan",
+//!       [&planner](auto const& p_requests, auto& p_responses) {
+//!           planner.solve(p_requests, p_responses);
+//!       });
+//!   factory.setBatchedServices(services);
+//! \endcode
+// ****************************************************************************
+class BatchedServices
+{
+public:
+
+    using Ptr = std::shared_ptr<BatchedServices>;
+    using Requests = std::vector<Blackboard::Value>;
+    using Responses = std::vector<Blackboard::Value>;
+    //! \brief Service filling the responses (as many as requests, initially
+    //! empty) of a batch of requests. An empty response is a failure.
+    using Function = std::function<void(Requests const&, Responses&)>;
+    using Duration = std::chrono::steady_clock::duration;
+
+    // ------------------------------------------------------------------------
+    //! \brief Thresholds serving a batch before the next flush().
+    // ------------------------------------------------------------------------
+    struct Limits
+    {
+        //! \brief Number of requests serving the batch (0: no limit).
+        size_t maxBatch = 0u;
+        //! \brief Age of the oldest request serving the batch (0: no limit).
+        Duration maxDelay = Duration::zero();
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Usage statistics of a service.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of requests served.
+        size_t requests = 0;
+        //! \brief Number of calls of the service.
+        size_t batches = 0;
+        //! \brief Number of requests cancelled before being served.
+        size_t cancelled = 0;
+        //! \brief Number of batches served because they were full.
+        size_t full = 0;
+        //! \brief Number of batches served because they were too old.
+        size_t expired = 0;
+
+        [[nodiscard]] double averageBatch() const
+        {
+            return (batches == 0u) ? 0.0 : double(requests) / double(batches);
+        }
+    };
+
+    // ************************************************************************
+    //! \brief Request pending in a batch, holding its response once served.
+    // ************************************************************************
+    class Call
+    {
+    public:
+
+        using Ptr = std::shared_ptr<Call>;
+
+        // --------------------------------------------------------------------
+        //! \brief Check if the request has been served.
+        // --------------------------------------------------------------------
+        [[nodiscard]] bool ready() const
+        {
+            return m_ready.load(std::memory_order_acquire);
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Get the response, empty on failure. Only valid once ready().
+        // --------------------------------------------------------------------
+        [[nodiscard]] Blackboard::Value const& response() const
+        {
+            return m_response;
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Get the response of a call, owning the call, to share it
+        //! with blackboards without copy. Only valid once ready().
+        // --------------------------------------------------------------------
+        [[nodiscard]] static std::shared_ptr<Blackboard::Value>
+        share(Ptr p_call)
+        {
+            Blackboard::Value* response = &p_call->m_response;
+            return std::shared_ptr<Blackboard::Value>(std::move(p_call),
+                                                      response);
+        }
+
+        // --------------------------------------------------------------------
+        //! \brief Withdraw the request from its batch if not yet served.
+        // --------------------------------------------------------------------
+        void cancel()
+        {
+            m_cancelled.store(true, std::memory_order_relaxed);
+        }
+
+    private:
+
+        friend class BatchedServices;
+
+        Blackboard::Value m_request;
+        Blackboard::Value m_response;
+        std::atomic<bool> m_ready{false};
+        std::atomic<bool> m_cancelled{false};
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Register a service (replacing any with the same name).
+    //! \param[in] p_name The name referenced by the BatchedServiceCall leaves.
+    //! \param[in] p_function The service.
+    //! \param[in] p_limits Thresholds serving a batch before the next flush.
+    // ------------------------------------------------------------------------
+    void add(std::string const& p_name, Function p_function, Limits p_limits)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->function = std::move(p_function);
+        entry->limits = p_limits;
+        m_entries[p_name] = std::move(entry);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Register a service served only by flush() (no thresholds).
+    // ------------------------------------------------------------------------
+    void add(std::string const& p_name, Function p_function)
+    {
+        add(p_name, std::move(p_function), Limits());
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a service is registered.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool has(std::string const& p_name) const
+    {
+        return m_entries.find(p_name) != m_entries.end();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add a request to the pending batch of a service, serving the
+    //! batch if it reaches a threshold.
+    //! \param[in] p_name The name of the service.
+    //! \param[in] p_request The request.
+    //! \return The pending call, or nullptr if the service is unknown. The
+    //!         request is withdrawn if the last copy of the returned pointer
+    //!         is released before the request is served.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Call::Ptr enqueue(std::string const& p_name,
+                                    Blackboard::Value p_request)
+    {
+        auto it = m_entries.find(p_name);
+        if (it == m_entries.end())
+        {
+            return nullptr;
+        }
+
+        Entry& entry = *it->second;
+        auto call = std::make_shared<Call>();
+        call->m_request = std::move(p_request);
+
+        bool full;
+        bool expired;
+        {
+            std::lock_guard<std::mutex> lock(entry.mutex);
+            auto const now = std::chrono::steady_clock::now();
+            if (entry.pending.empty())
+            {
+                entry.oldest = now;
+            }
+            entry.pending.push_back(call);
+            full = (entry.limits.maxBatch != 0u) &&
+                   (entry.pending.size() >= entry.limits.maxBatch);
+            expired = isExpired(entry, now);
+        }
+        if (full)
+        {
+            entry.full.fetch_add(1u, std::memory_order_relaxed);
+            serve(entry);
+        }
+        else if (expired)
+        {
+            entry.expired.fetch_add(1u, std::memory_order_relaxed);
+            serve(entry);
+        }
+
+        // The pointer of the caller owns the call and cancels it when released
+        Call* pointer = call.get();
+        return Call::Ptr(pointer,
+                         [owner = std::move(call)](Call*) { owner->cancel(); });
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Serve the pending batch of a service.
+    //! \return The number of requests served.
+    // ------------------------------------------------------------------------
+    size_t flush(std::string const& p_name)
+    {
+        auto it = m_entries.find(p_name);
+        return (it == m_entries.end()) ? 0u : serve(*it->second);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Serve the pending batches of all the services.
+    //! \return The number of requests served.
+    // ------------------------------------------------------------------------
+    size_t flush()
+    {
+        size_t served = 0u;
+        for (auto const& [name, entry] : m_entries)
+        {
+            served += serve(*entry);
+        }
+        return served;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Serve the pending batches whose oldest request waited more than
+    //! the maxDelay of their service.
+    //! \return The number of requests served.
+    // ------------------------------------------------------------------------
+    size_t flushExpired()
+    {
+        size_t served = 0u;
+        auto const now = std::chrono::steady_clock::now();
+        for (auto const& [name, entry] : m_entries)
+        {
+            bool expired;
+            {
+                std::lock_guard<std::mutex> lock(entry->mutex);
+                expired = isExpired(*entry, now);
+            }
+            if (expired)
+            {
+                entry->expired.fetch_add(1u, std::memory_order_relaxed);
+                served += serve(*entry);
+            }
+        }
+        return served;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of requests pending for a service.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t pending(std::string const& p_name) const
+    {
+        auto it = m_entries.find(p_name);
+        if (it == m_entries.end())
+        {
+            return 0u;
+        }
+        std::lock_guard<std::mutex> lock(it->second->mutex);
+        return it->second->pending.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statistics of a service.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics(std::string const& p_name) const
+    {
+        Statistics stats;
+        if (auto it = m_entries.find(p_name); it != m_entries.end())
+        {
+            Entry const& entry = *it->second;
+            stats.requests = entry.requests.load(std::memory_order_relaxed);
+            stats.batches = entry.batches.load(std::memory_order_relaxed);
+            stats.cancelled = entry.cancelled.load(std::memory_order_relaxed);
+            stats.full = entry.full.load(std::memory_order_relaxed);
+            stats.expired = entry.expired.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statistics summed over all services.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics() const
+    {
+        Statistics total;
+        for (auto const& [name, entry] : m_entries)
+        {
+            Statistics stats = statistics(name);
+            total.requests += stats.requests;
+            total.batches += stats.batches;
+            total.cancelled += stats.cancelled;
+            total.full += stats.full;
+            total.expired += stats.expired;
+        }
+        return total;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Reset the statistics of all services.
+    // ------------------------------------------------------------------------
+    void resetStatistics()
+    {
+        for (auto const& [name, entry] : m_entries)
+        {
+            entry->requests = 0u;
+            entry->batches = 0u;
+            entry->cancelled = 0u;
+            entry->full = 0u;
+            entry->expired = 0u;
+        }
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief A service, its pending batch and the buffers of the batch being
+    //! served (reused from one batch to the next).
+    // ------------------------------------------------------------------------
+    struct Entry
+    {
+        Function function;
+        Limits limits;
+        //! \brief Protects pending and oldest.
+        mutable std::mutex mutex;
+        std::vector<Call::Ptr> pending;
+        std::chrono::steady_clock::time_point oldest;
+        //! \brief Serializes the calls of the service and protects the
+        //! buffers below.
+        std::mutex serving;
+        std::vector<Call::Ptr> batch;
+        Requests inputs;
+        Responses outputs;
+        std::atomic<size_t> requests{0u};
+        std::atomic<size_t> batches{0u};
+        std::atomic<size_t> cancelled{0u};
+        std::atomic<size_t> full{0u};
+        std::atomic<size_t> expired{0u};
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if the oldest pending request of a service waited more
+    //! than its maxDelay. Must be called with the entry mutex locked.
+    // ------------------------------------------------------------------------
+    static bool isExpired(Entry const& p_entry,
+                          std::chrono::steady_clock::time_point p_now)
+    {
+        return (p_entry.limits.maxDelay != Duration::zero()) &&
+               !p_entry.pending.empty() &&
+               (p_now - p_entry.oldest >= p_entry.limits.maxDelay);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Serve the pending batch of a service: call the service with the
+    //! requests not cancelled, then hand the responses to their calls.
+    //! \return The number of requests served.
+    // ------------------------------------------------------------------------
+    static size_t serve(Entry& p_entry)
+    {
+        std::lock_guard<std::mutex> serving(p_entry.serving);
+        {
+            std::lock_guard<std::mutex> lock(p_entry.mutex);
+            p_entry.batch.swap(p_entry.pending);
+        }
+
+        // Withdraw the cancelled requests
+        size_t const size = p_entry.batch.size();
+        p_entry.batch.erase(
+            std::remove_if(p_entry.batch.begin(),
+                           p_entry.batch.end(),
+                           [](Call::Ptr const& p_call) {
+                               return p_call->m_cancelled.load(
+                                   std::memory_order_relaxed);
+                           }),
+            p_entry.batch.end());
+        p_entry.cancelled.fetch_add(size - p_entry.batch.size(),
+                                    std::memory_order_relaxed);
+        if (p_entry.batch.empty())
+        {
+            return 0u;
+        }
+
+        Requests& requests = p_entry.inputs;
+        Responses& responses = p_entry.outputs;
+        requests.clear();
+        for (auto& call : p_entry.batch)
+        {
+            requests.push_back(std::move(call->m_request));
+        }
+        responses.clear();
+        responses.resize(requests.size());
+        if (p_entry.function)
+        {
+            p_entry.function(requests, responses);
+        }
+
+        size_t const served = p_entry.batch.size();
+        for (size_t i = 0u; i < served; ++i)
+        {
+            Call& call = *p_entry.batch[i];
+            if (i < responses.size())
+            {
+                call.m_response = std::move(responses[i]);
+            }
+            call.m_ready.store(true, std::memory_order_release);
+        }
+        p_entry.batch.clear();
+        p_entry.requests.fetch_add(served, std::memory_order_relaxed);
+        p_entry.batches.fetch_add(1u, std::memory_order_relaxed);
+        return served;
+    }
+
+private:
+
+    std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+};
+
+} // namespace bt
@@ -0,0 +1,311 @@
+/**
+ * @file Executor.hpp
+ * @brief Batch executor ticking many behavior trees per tick.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Tree.hpp"
+#include "BlackThorn/Executor/BatchedServices.hpp"
+#include "BlackThorn/Executor/SharedComputations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Ticks a batch of trees (typically one per agent) once per tick(),
+//! sequentially or on a pool of worker threads.
+//!
+//! Each tick() starts a new tick of the shared computations, so that the
+//! SharedComputation leaves of all the trees compute a given query at most
+//! once per tick, and serves the batches of requests enqueued by the
+//! BatchedServiceCall leaves at the point chosen with setBatchFlush(). The
+//! trees are not owned by the executor and must outlive it. With several
+//! threads, trees are ticked concurrently: they must not share a blackboard
+//! or any non thread-safe state, except the shared computations and the
+//! batched services.
+//!
+//! Usage example:
+//! \code
+//!   bt::Executor executor(4);
+//!   executor.computations()->add("is_night", [&]() { return world.night; });
+//!   factory.setSharedComputations(executor.computations());
+//!   for (auto& agent: agents)
+//!       executor.add(*agent.tree);
+//!   while (running)
+//!       executor.tick();
+//! \endcode
+// ****************************************************************************
+class Executor
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief When tick() serves the pending batches of the batched services.
+    // ------------------------------------------------------------------------
+    enum class BatchFlush
+    {
+        //! \brief After ticking the trees: the leaves get their response at
+        //! the next tick.
+        EndOfTick,
+        //! \brief Before ticking the trees: the service sees the state
+        //! updated by the application between two ticks.
+        StartOfTick,
+        //! \brief Only when full or too old (see BatchedServices::Limits), or
+        //! when the application calls BatchedServices::flush().
+        Manual
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor - starts the worker threads.
+    //! \param[in] p_threads Number of threads ticking the trees, including
+    //!            the caller of tick(). 1 ticks the trees sequentially.
+    //! \param[in] p_computations The shared computations (a new registry is
+    //!            created when null).
+    //! \param[in] p_services The batched services (a new registry is created
+    //!            when null).
+    // ------------------------------------------------------------------------
+    explicit Executor(size_t p_threads = 1,
+                      SharedComputations::Ptr p_computations = nullptr,
+                      BatchedServices::Ptr p_services = nullptr)
+        : m_computations(p_computations
+                             ? std::move(p_computations)
+                             : std::make_shared<SharedComputations>()),
+          m_services(p_services ? std::move(p_services)
+                                : std::make_shared<BatchedServices>())
+    {
+        for (size_t i = 1u; i < p_threads; ++i)
+        {
+            m_workers.emplace_back([this] { run(); });
+        }
+    }
+
+    // Disable copy/move: workers reference this instance
+    Executor(Executor const&) = delete;
+    Executor& operator=(Executor const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - stops and joins the worker threads.
+    // ------------------------------------------------------------------------
+    ~Executor()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_start.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the shared computations of the trees.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] SharedComputations::Ptr const& computations() const
+    {
+        return m_computations;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the batched services called by the trees.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] BatchedServices::Ptr const& services() const
+    {
+        return m_services;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Choose when tick() serves the pending batches (EndOfTick by
+    //! default). Must not be called during tick().
+    // ------------------------------------------------------------------------
+    void setBatchFlush(BatchFlush p_flush)
+    {
+        m_flush = p_flush;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get when tick() serves the pending batches.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] BatchFlush batchFlush() const
+    {
+        return m_flush;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add a tree to tick. Must not be called during tick().
+    //! \param[in] p_tree The tree (not owned, must outlive the executor).
+    // ------------------------------------------------------------------------
+    void add(Tree& p_tree)
+    {
+        m_trees.push_back(&p_tree);
+        m_statuses.push_back(Status::INVALID);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Stop ticking a tree, keeping the order of the other trees. Must
+    //! not be called during tick().
+    //! \param[in] p_tree The tree.
+    //! \return False if the tree was not added.
+    // ------------------------------------------------------------------------
+    bool remove(Tree const& p_tree)
+    {
+        auto it = std::find(m_trees.begin(), m_trees.end(), &p_tree);
+        if (it == m_trees.end())
+        {
+            return false;
+        }
+        m_statuses.erase(m_statuses.begin() + (it - m_trees.begin()));
+        m_trees.erase(it);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of trees.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t size() const
+    {
+        return m_trees.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of threads ticking the trees.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t threads() const
+    {
+        return m_workers.size() + 1u;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start a new tick of the shared computations then tick all the
+    //! trees once, serving the batched services at the chosen point (the
+    //! batches too old are served at the end of each tick). Returns when all
+    //! the trees have been ticked.
+    //! \return The statuses of the trees, in the order they were added.
+    // ------------------------------------------------------------------------
+    std::vector<Status> const& tick()
+    {
+        m_computations->nextTick();
+        if (m_flush == BatchFlush::StartOfTick)
+        {
+            m_services->flush();
+        }
+
+        if (m_workers.empty())
+        {
+            for (size_t i = 0u; i < m_trees.size(); ++i)
+            {
+                m_statuses[i] = m_trees[i]->tick();
+            }
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_next.store(0u, std::memory_order_relaxed);
+                m_busy = m_workers.size();
+                ++m_generation;
+            }
+            m_start.notify_all();
+            tickTrees();
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_busy == 0u; });
+        }
+
+        if (m_flush == BatchFlush::EndOfTick)
+        {
+            m_services->flush();
+        }
+        else
+        {
+            m_services->flushExpired();
+        }
+        return m_statuses;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statuses returned by the trees at the last tick().
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<Status> const& statuses() const
+    {
+        return m_statuses;
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Tick the trees not yet taken by another thread.
+    // ------------------------------------------------------------------------
+    void tickTrees()
+    {
+        size_t i;
+        while ((i = m_next.fetch_add(1u, std::memory_order_relaxed)) <
+               m_trees.size())
+        {
+            m_statuses[i] = m_trees[i]->tick();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Worker thread loop: wait for a tick, take part in it.
+    // ------------------------------------------------------------------------
+    void run()
+    {
+        uint64_t generation = 0u;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_start.wait(lock, [this, generation] {
+                    return m_stop || (m_generation != generation);
+                });
+                if (m_stop)
+                {
+                    return;
+                }
+                generation = m_generation;
+            }
+
+            tickTrees();
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busy == 0u)
+            {
+                m_done.notify_one();
+            }
+        }
+    }
+
+private:
+
+    SharedComputations::Ptr m_computations;
+    BatchedServices::Ptr m_services;
+    BatchFlush m_flush = BatchFlush::EndOfTick;
+    std::vector<Tree*> m_trees;
+    std::vector<Status> m_statuses;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    //! \brief Index of the next tree to tick.
+    std::atomic<size_t> m_next{0u};
+    //! \brief Number of workers still ticking the current generation.
+    size_t m_busy = 0u;
+    //! \brief Incremented at each tick() to wake up the workers.
+    uint64_t m_generation = 0u;
+    bool m_stop = false;
+};
+
+} // namespace bt
@@ -0,0 +1,446 @@
+/**
+ * @file Pipeline.hpp
+ * @brief Sense-think-act loop pipelined over three threads.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Tree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Two buffers handed over from one producer thread to one consumer
+//! thread: the producer fills one buffer while the consumer reads the other.
+//! Buffers are reused, not reallocated.
+// ****************************************************************************
+template <typename T>
+class DoubleBuffer
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Wait for a free buffer to fill (producer).
+    //! \return The buffer, to publish() once filled.
+    // ------------------------------------------------------------------------
+    T& acquireWrite()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock, [this] { return m_written - m_read < 2u; });
+        return m_buffers[m_written % 2u];
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Hand the buffer filled over to the consumer (producer).
+    // ------------------------------------------------------------------------
+    void publish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_written;
+        }
+        m_changed.notify_all();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Tell the consumer that nothing more will be published
+    //! (producer).
+    // ------------------------------------------------------------------------
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closed = true;
+        }
+        m_changed.notify_all();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Wait for the oldest published buffer (consumer).
+    //! \return The buffer, to release() once read, or nullptr when closed
+    //!         and all buffers have been read.
+    // ------------------------------------------------------------------------
+    T* acquireRead()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_changed.wait(lock,
+                       [this] { return (m_read < m_written) || m_closed; });
+        return (m_read < m_written) ? &m_buffers[m_read % 2u] : nullptr;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Give the buffer read back to the producer (consumer).
+    // ------------------------------------------------------------------------
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_read;
+        }
+        m_changed.notify_all();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Reopen for a new run (no thread must be using the buffers).
+    // ------------------------------------------------------------------------
+    void reopen()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_written = m_read = 0u;
+        m_closed = false;
+    }
+
+private:
+
+    T m_buffers[2];
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    //! \brief Number of buffers published.
+    uint64_t m_written = 0u;
+    //! \brief Number of buffers released.
+    uint64_t m_read = 0u;
+    bool m_closed = false;
+};
+
+// ****************************************************************************
+//! \brief Runs the sense-think-act loop of a tree pipelined over three
+//! threads: while the tree is ticked for tick N, the inputs of tick N+1 are
+//! gathered and the outputs of tick N-1 are flushed. The loop period is the
+//! duration of the slowest stage instead of the sum of the three.
+//!
+//! - Sense: the sense function writes the inputs of the tick into a
+//!   blackboard of its own (double-buffered).
+//! - Think: the inputs are moved into the tree blackboard without copy (see
+//!   Blackboard::absorb()), then the tree is ticked. A copy-on-write
+//!   snapshot of the tree blackboard is handed over to the act stage.
+//! - Act: the act function reads the outputs from the snapshot.
+//!
+//! The depth (number of ticks in flight) trades latency for throughput: 1
+//! runs the stages one after the other (lowest end-to-end latency), 3
+//! overlaps the three stages (highest throughput, but a tick waits behind
+//! the previous ones). The end-to-end latency (from the beginning of the
+//! sensing to the end of the flushing) is measured for each tick.
+//!
+//! Only the think thread touches the tree and its blackboard while the
+//! pipeline runs. The act function must only read the snapshot (the parent
+//! blackboards are not part of it).
+//!
+//! Usage example:
+//! \code
+//!   bt::Pipeline pipeline(*tree,
+//!       [&](bt::Blackboard& inputs) { inputs.set("pose", lidar.pose()); },
+//!       [&](bt::Blackboard const& outputs, bt::Status) {
+//!           motors.send(outputs.getOrDefault<double>("speed"));
+//!       });
+//!   pipeline.start();
+//!   ...
+//!   pipeline.stop();
+//!   std::cout << pipeline.statistics().meanLatency().count() << " ns\n";
+//! \endcode
+// ****************************************************************************
+class Pipeline
+{
+public:
+
+    using Duration = std::chrono::nanoseconds;
+    //! \brief Gathers the inputs of a tick (sense thread).
+    using Sense = std::function<void(Blackboard& p_inputs)>;
+    //! \brief Flushes the outputs of a tick (act thread).
+    using Act =
+        std::function<void(Blackboard const& p_outputs, Status p_status)>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Latency versus throughput configuration.
+    // ------------------------------------------------------------------------
+    struct Config
+    {
+        //! \brief Number of ticks in flight, from 1 (sequential stages,
+        //! lowest latency) to 3 (overlapped stages, highest throughput).
+        size_t depth = 3u;
+        //! \brief Minimum period between the beginnings of two sensings (0:
+        //! as fast as the slowest stage).
+        Duration period = Duration::zero();
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Measures of the ticks flushed.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of ticks flushed.
+        uint64_t ticks = 0u;
+        //! \brief Sum of the end-to-end latencies.
+        Duration totalLatency = Duration::zero();
+        //! \brief Highest end-to-end latency.
+        Duration maxLatency = Duration::zero();
+        //! \brief End-to-end latency of the last tick.
+        Duration lastLatency = Duration::zero();
+        //! \brief Time between the first sensing and the last flushing.
+        Duration elapsed = Duration::zero();
+
+        //! \brief Mean end-to-end latency.
+        [[nodiscard]] Duration meanLatency() const
+        {
+            return (ticks == 0u) ? Duration::zero()
+                                 : totalLatency / int64_t(ticks);
+        }
+
+        //! \brief Ticks flushed per second.
+        [[nodiscard]] double throughput() const
+        {
+            return (elapsed.count() == 0)
+                       ? 0.0
+                       : double(ticks) * 1e9 / double(elapsed.count());
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_tree The tree (not owned, must outlive the pipeline).
+    //!            Its blackboard receives the inputs.
+    //! \param[in] p_sense The function gathering the inputs of a tick.
+    //! \param[in] p_act The function flushing the outputs of a tick.
+    //! \param[in] p_config The latency versus throughput configuration.
+    // ------------------------------------------------------------------------
+    Pipeline(Tree& p_tree, Sense p_sense, Act p_act, Config p_config)
+        : m_tree(p_tree),
+          m_sense(std::move(p_sense)),
+          m_act(std::move(p_act)),
+          m_config(p_config)
+    {
+        m_config.depth = std::clamp<size_t>(m_config.depth, 1u, 3u);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor with the default configuration (full overlap).
+    // ------------------------------------------------------------------------
+    Pipeline(Tree& p_tree, Sense p_sense, Act p_act)
+        : Pipeline(p_tree, std::move(p_sense), std::move(p_act), Config{})
+    {
+    }
+
+    // Disable copy/move: the threads reference this instance
+    Pipeline(Pipeline const&) = delete;
+    Pipeline& operator=(Pipeline const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - stops the pipeline.
+    // ------------------------------------------------------------------------
+    ~Pipeline()
+    {
+        stop();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start the three threads.
+    //! \param[in] p_ticks Number of ticks to run (0: until stop()).
+    // ------------------------------------------------------------------------
+    void start(uint64_t p_ticks = 0u)
+    {
+        stop();
+        m_inputs.reopen();
+        m_outputs.reopen();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = false;
+            m_inFlight = 0u;
+            m_statistics = Statistics{};
+        }
+        m_start = Clock::now();
+        m_sensing = std::thread([this, p_ticks] { sense(p_ticks); });
+        m_thinking = std::thread([this] { think(); });
+        m_acting = std::thread([this] { act(); });
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Wait for the ticks requested by start() to be flushed.
+    // ------------------------------------------------------------------------
+    void wait()
+    {
+        for (auto* thread : {&m_sensing, &m_thinking, &m_acting})
+        {
+            if (thread->joinable())
+            {
+                thread->join();
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Stop sensing, flush the ticks in flight and join the threads.
+    // ------------------------------------------------------------------------
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_slots.notify_all();
+        wait();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the measures of the ticks flushed so far.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_statistics;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the configuration.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Config const& config() const
+    {
+        return m_config;
+    }
+
+private:
+
+    using Clock = std::chrono::steady_clock;
+
+    //! \brief Inputs of a tick, from the sense to the think stage.
+    struct Inputs
+    {
+        Blackboard blackboard;
+        Clock::time_point sensed;
+    };
+
+    //! \brief Outputs of a tick, from the think to the act stage.
+    struct Outputs
+    {
+        Blackboard blackboard;
+        Status status = Status::INVALID;
+        Clock::time_point sensed;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Sense thread: gather the inputs while fewer ticks than the
+    //! depth are in flight.
+    // ------------------------------------------------------------------------
+    void sense(uint64_t p_ticks)
+    {
+        Clock::time_point next = Clock::now();
+        for (uint64_t tick = 0u; (p_ticks == 0u) || (tick < p_ticks); ++tick)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_slots.wait(lock, [this] {
+                    return m_stop || (m_inFlight < m_config.depth);
+                });
+                if (m_stop)
+                {
+                    break;
+                }
+                ++m_inFlight;
+            }
+
+            if (m_config.period > Duration::zero())
+            {
+                std::this_thread::sleep_until(next);
+                next += m_config.period;
+            }
+
+            Inputs& inputs = m_inputs.acquireWrite();
+            inputs.sensed = Clock::now();
+            m_sense(inputs.blackboard);
+            m_inputs.publish();
+        }
+        m_inputs.close();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Think thread: move the inputs into the tree blackboard, tick
+    //! the tree and snapshot its blackboard.
+    // ------------------------------------------------------------------------
+    void think()
+    {
+        Blackboard::Ptr blackboard = m_tree.blackboard();
+        while (Inputs* inputs = m_inputs.acquireRead())
+        {
+            Clock::time_point sensed = inputs->sensed;
+            if (blackboard)
+            {
+                blackboard->absorb(inputs->blackboard);
+            }
+            m_inputs.release();
+
+            Status status = m_tree.tick();
+
+            Outputs& outputs = m_outputs.acquireWrite();
+            if (blackboard)
+            {
+                outputs.blackboard = *blackboard;
+            }
+            outputs.status = status;
+            outputs.sensed = sensed;
+            m_outputs.publish();
+        }
+        m_outputs.close();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Act thread: flush the outputs and measure the latency.
+    // ------------------------------------------------------------------------
+    void act()
+    {
+        while (Outputs* outputs = m_outputs.acquireRead())
+        {
+            m_act(outputs->blackboard, outputs->status);
+            Clock::time_point now = Clock::now();
+            Duration latency =
+                std::chrono::duration_cast<Duration>(now - outputs->sensed);
+            m_outputs.release();
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                --m_inFlight;
+                ++m_statistics.ticks;
+                m_statistics.totalLatency += latency;
+                m_statistics.maxLatency =
+                    std::max(m_statistics.maxLatency, latency);
+                m_statistics.lastLatency = latency;
+                m_statistics.elapsed =
+                    std::chrono::duration_cast<Duration>(now - m_start);
+            }
+            m_slots.notify_all();
+        }
+    }
+
+private:
+
+    Tree& m_tree;
+    Sense m_sense;
+    Act m_act;
+    Config m_config;
+
+    DoubleBuffer<Inputs> m_inputs;
+    DoubleBuffer<Outputs> m_outputs;
+
+    //! \brief Protects the fields below.
+    mutable std::mutex m_mutex;
+    //! \brief Signals a tick leaving the pipeline, or the stop.
+    std::condition_variable m_slots;
+    //! \brief Number of ticks sensed and not flushed yet.
+    size_t m_inFlight = 0u;
+    bool m_stop = false;
+    Statistics m_statistics;
+    Clock::time_point m_start;
+
+    std::thread m_sensing;
+    std::thread m_thinking;
+    std::thread m_acting;
+};
+
+} // namespace bt
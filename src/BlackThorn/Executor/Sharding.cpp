@@ -0,0 +1,891 @@
+/**
+ * @file Sharding.cpp
+ * @brief Implementation of the consistent hashing ring, of the worker
+ * processes and of the coordinator moving agents between them.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Executor/Sharding.hpp"
+#include "BlackThorn/Blackboard/Journal.hpp"
+#include "BlackThorn/Builder/Builder.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace bt {
+
+// ----------------------------------------------------------------------------
+//! \brief Finalizer of splitmix64, spreading close keys over the ring.
+// ----------------------------------------------------------------------------
+static uint64_t mix(uint64_t p_value)
+{
+    p_value ^= p_value >> 30;
+    p_value *= 0xbf58476d1ce4e5b9ull;
+    p_value ^= p_value >> 27;
+    p_value *= 0x94d049bb133111ebull;
+    p_value ^= p_value >> 31;
+    return p_value;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Collect the blackboards of a tree and of its subtrees, in depth
+//! first order and without duplicates.
+// ----------------------------------------------------------------------------
+static void collectBlackboards(Tree& p_tree,
+                               std::vector<Blackboard::Ptr>& p_blackboards)
+{
+    if (Blackboard::Ptr blackboard = p_tree.blackboard();
+        blackboard && (std::find(p_blackboards.begin(),
+                                 p_blackboards.end(),
+                                 blackboard) == p_blackboards.end()))
+    {
+        p_blackboards.push_back(std::move(blackboard));
+    }
+    if (!p_tree.hasRoot())
+    {
+        return;
+    }
+    detail::forEachNode(p_tree.getRoot(), [&p_blackboards](Node& p_node) {
+        if (Tree* inner = detail::innerTree(&p_node))
+        {
+            collectBlackboards(*inner, p_blackboards);
+        }
+    });
+}
+
+// ============================================================================
+// ShardRing
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+uint64_t ShardRing::hash(std::string_view p_key)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : p_key)
+    {
+        hash ^= uint64_t(static_cast<unsigned char>(c));
+        hash *= 1099511628211ull;
+    }
+    return mix(hash);
+}
+
+// ----------------------------------------------------------------------------
+void ShardRing::add(Worker p_worker)
+{
+    if (has(p_worker))
+    {
+        return;
+    }
+
+    m_workers.push_back(p_worker);
+    for (size_t i = 0u; i < m_replicas; ++i)
+    {
+        m_points.emplace_back(mix((uint64_t(p_worker) << 32) | uint64_t(i)),
+                              p_worker);
+    }
+    std::sort(m_points.begin(), m_points.end());
+}
+
+// ----------------------------------------------------------------------------
+void ShardRing::remove(Worker p_worker)
+{
+    m_workers.erase(
+        std::remove(m_workers.begin(), m_workers.end(), p_worker),
+        m_workers.end());
+    m_points.erase(std::remove_if(m_points.begin(),
+                                  m_points.end(),
+                                  [p_worker](auto const& p_point) {
+                                      return p_point.second == p_worker;
+                                  }),
+                   m_points.end());
+}
+
+// ----------------------------------------------------------------------------
+bool ShardRing::has(Worker p_worker) const
+{
+    return std::find(m_workers.begin(), m_workers.end(), p_worker) !=
+           m_workers.end();
+}
+
+// ----------------------------------------------------------------------------
+std::optional<ShardRing::Worker>
+ShardRing::owner(std::string_view p_agent) const
+{
+    if (m_points.empty())
+    {
+        return std::nullopt;
+    }
+
+    auto it = std::lower_bound(m_points.begin(),
+                               m_points.end(),
+                               std::make_pair(hash(p_agent), Worker(0)));
+    return (it == m_points.end()) ? m_points.front().second : it->second;
+}
+
+// ============================================================================
+// Messages
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+//! \brief Write all the bytes, without SIGPIPE when the peer is gone.
+// ----------------------------------------------------------------------------
+static bool writeAll(int p_fd, char const* p_data, size_t p_size)
+{
+    while (p_size > 0u)
+    {
+        ssize_t n = ::send(p_fd, p_data, p_size, MSG_NOSIGNAL);
+        if ((n < 0) && (errno == ENOTSOCK))
+        {
+            n = ::write(p_fd, p_data, p_size);
+        }
+        if (n > 0)
+        {
+            p_data += n;
+            p_size -= size_t(n);
+        }
+        else if ((n < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Read exactly p_size bytes.
+// ----------------------------------------------------------------------------
+static bool readAll(int p_fd, char* p_data, size_t p_size)
+{
+    while (p_size > 0u)
+    {
+        ssize_t n = ::read(p_fd, p_data, p_size);
+        if (n > 0)
+        {
+            p_data += n;
+            p_size -= size_t(n);
+        }
+        else if ((n < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+namespace shard {
+
+// ----------------------------------------------------------------------------
+bool send(int p_fd, uint8_t p_type, std::string const& p_payload)
+{
+    if (p_payload.size() >= UINT32_MAX)
+    {
+        return false;
+    }
+
+    std::string header;
+    encoding::put(header, uint32_t(p_payload.size() + 1u));
+    encoding::put(header, p_type);
+    return writeAll(p_fd, header.data(), header.size()) &&
+           writeAll(p_fd, p_payload.data(), p_payload.size());
+}
+
+// ----------------------------------------------------------------------------
+bool receive(int p_fd, uint8_t& p_type, std::string& p_payload)
+{
+    uint32_t size;
+    if (!readAll(p_fd, reinterpret_cast<char*>(&size), sizeof(size)) ||
+        (size == 0u) || !readAll(p_fd, reinterpret_cast<char*>(&p_type), 1u))
+    {
+        return false;
+    }
+    p_payload.resize(size - 1u);
+    return readAll(p_fd, p_payload.data(), p_payload.size());
+}
+
+} // namespace shard
+
+// ============================================================================
+// ShardWorker
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+ShardWorker::ShardWorker(NodeFactory const& p_factory, size_t p_threads)
+    : m_factory(p_factory),
+      m_executor(p_threads,
+                 p_factory.sharedComputations(),
+                 p_factory.batchedServices())
+{
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<Tree::Ptr>
+ShardWorker::build(std::string const& p_document) const
+{
+    return Builder::fromText(m_factory, p_document);
+}
+
+// ----------------------------------------------------------------------------
+void ShardWorker::host(std::string const& p_name, Agent p_agent)
+{
+    Tree& tree = *p_agent.tree;
+    m_agents.emplace(p_name, std::move(p_agent));
+    m_executor.add(tree);
+    m_names.push_back(p_name);
+}
+
+// ----------------------------------------------------------------------------
+ShardWorker::Result ShardWorker::spawn(std::string const& p_name,
+                                       std::string const& p_document)
+{
+    if (m_agents.find(p_name) != m_agents.end())
+    {
+        return Result::error("Agent '" + p_name + "' already exists");
+    }
+
+    auto tree = build(p_document);
+    if (!tree)
+    {
+        return Result::error(tree.getError());
+    }
+    host(p_name, Agent{p_document, tree.moveValue()});
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+bool ShardWorker::remove(std::string const& p_name)
+{
+    auto it = m_agents.find(p_name);
+    if (it == m_agents.end())
+    {
+        return false;
+    }
+
+    m_executor.remove(*it->second.tree);
+    m_names.erase(std::find(m_names.begin(), m_names.end(), p_name));
+    m_agents.erase(it);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+Tree* ShardWorker::tree(std::string const& p_name) const
+{
+    auto it = m_agents.find(p_name);
+    return (it == m_agents.end()) ? nullptr : it->second.tree.get();
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<std::string>
+ShardWorker::snapshot(std::string const& p_name) const
+{
+    using Snapshot = robotik::Return<std::string>;
+
+    auto it = m_agents.find(p_name);
+    if (it == m_agents.end())
+    {
+        return Snapshot::error("Unknown agent '" + p_name + "'");
+    }
+    Agent const& agent = it->second;
+
+    std::string state;
+    if (!agent.tree->saveState(state))
+    {
+        return Snapshot::error("Agent '" + p_name +
+                               "' cannot be moved in its current state");
+    }
+
+    std::string snapshot;
+    encoding::putString(snapshot, p_name);
+    encoding::putString(snapshot, agent.document);
+    encoding::putString(snapshot, state);
+
+    std::vector<Blackboard::Ptr> blackboards;
+    collectBlackboards(*agent.tree, blackboards);
+    encoding::put(snapshot, uint32_t(blackboards.size()));
+    for (auto const& blackboard : blackboards)
+    {
+        std::string records;
+        if (!journal::putSnapshot(records, *blackboard))
+        {
+            return Snapshot::error("Agent '" + p_name +
+                                   "' has a blackboard value without binary "
+                                   "encoding");
+        }
+        encoding::putString(snapshot, records);
+    }
+    return Snapshot::success(std::move(snapshot));
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<std::string>
+ShardWorker::exportAgent(std::string const& p_name)
+{
+    auto result = snapshot(p_name);
+    if (result)
+    {
+        remove(p_name);
+    }
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<std::string>
+ShardWorker::importAgent(std::string const& p_snapshot)
+{
+    using Name = robotik::Return<std::string>;
+
+    encoding::Reader reader(p_snapshot.data(), p_snapshot.size());
+    std::string name;
+    std::string document;
+    std::string state;
+    uint32_t count;
+    if (!reader.getString(name) || !reader.getString(document) ||
+        !reader.getString(state) || !reader.get(count))
+    {
+        return Name::error("Truncated snapshot");
+    }
+    if (m_agents.find(name) != m_agents.end())
+    {
+        return Name::error("Agent '" + name + "' already exists");
+    }
+
+    auto built = build(document);
+    if (!built)
+    {
+        return Name::error(built.getError());
+    }
+    Tree::Ptr tree = built.moveValue();
+
+    encoding::Reader state_reader(state.data(), state.size());
+    if (!tree->loadState(state_reader) || !state_reader.atEnd())
+    {
+        return Name::error("The state of agent '" + name +
+                           "' does not match its tree");
+    }
+
+    std::vector<Blackboard::Ptr> blackboards;
+    collectBlackboards(*tree, blackboards);
+    if (blackboards.size() != count)
+    {
+        return Name::error("The blackboards of agent '" + name +
+                           "' do not match its tree");
+    }
+    for (auto const& blackboard : blackboards)
+    {
+        std::string records;
+        if (!reader.getString(records))
+        {
+            return Name::error("Truncated snapshot");
+        }
+
+        // Entries are replaced, versions included
+        for (auto const& key : blackboard->keys())
+        {
+            blackboard->remove(key);
+        }
+        BlackboardReplica replica(blackboard);
+        if (!replica.feed(records.data(), records.size()))
+        {
+            return Name::error("Corrupted blackboard of agent '" + name +
+                               "'");
+        }
+    }
+
+    host(name, Agent{std::move(document), std::move(tree)});
+    return Name::success(std::move(name));
+}
+
+// ----------------------------------------------------------------------------
+bool ShardWorker::serve(int p_fd)
+{
+    using shard::Command;
+    using shard::Reply;
+
+    auto reply = [p_fd](bool p_ok, std::string const& p_payload) {
+        return shard::send(
+            p_fd, uint8_t(p_ok ? Reply::Ok : Reply::Error), p_payload);
+    };
+
+    uint8_t type;
+    std::string payload;
+    while (shard::receive(p_fd, type, payload))
+    {
+        encoding::Reader reader(payload.data(), payload.size());
+        std::string name;
+        bool sent;
+
+        switch (Command(type))
+        {
+            case Command::Spawn:
+            {
+                std::string document;
+                if (!reader.getString(name) || !reader.getString(document))
+                {
+                    sent = reply(false, "Malformed command");
+                    break;
+                }
+                auto result = spawn(name, document);
+                sent = reply(bool(result), result ? "" : result.getError());
+                break;
+            }
+            case Command::Tick:
+            {
+                std::vector<Status> const& statuses = tick();
+                std::string result;
+                result.reserve(sizeof(uint32_t) + statuses.size());
+                encoding::put(result, uint32_t(statuses.size()));
+                for (Status status : statuses)
+                {
+                    encoding::put(result, uint8_t(status));
+                }
+                sent = reply(true, result);
+                break;
+            }
+            case Command::Export:
+            case Command::Snapshot:
+            {
+                if (!reader.getString(name))
+                {
+                    sent = reply(false, "Malformed command");
+                    break;
+                }
+                auto result = (Command(type) == Command::Export)
+                                  ? exportAgent(name)
+                                  : snapshot(name);
+                sent = reply(bool(result),
+                             result ? result.getValue() : result.getError());
+                break;
+            }
+            case Command::Import:
+            {
+                auto result = importAgent(payload);
+                sent = reply(bool(result),
+                             result ? result.getValue() : result.getError());
+                break;
+            }
+            case Command::Remove:
+            {
+                bool removed = reader.getString(name) && remove(name);
+                sent = reply(removed,
+                             removed ? "" : "Unknown agent '" + name + "'");
+                break;
+            }
+            case Command::Stop:
+                return reply(true, "");
+            default:
+                sent = reply(false, "Unknown command");
+                break;
+        }
+
+        if (!sent)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+// ============================================================================
+// Shards
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+Shards::~Shards()
+{
+    for (auto& link : m_links)
+    {
+        stop(link);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void Shards::stop(Link& p_link)
+{
+    if (p_link.fd < 0)
+    {
+        return;
+    }
+
+    uint8_t type;
+    std::string payload;
+    if (shard::send(p_link.fd, uint8_t(shard::Command::Stop), ""))
+    {
+        (void)shard::receive(p_link.fd, type, payload);
+    }
+    ::close(p_link.fd);
+    p_link.fd = -1;
+    if (p_link.pid > 0)
+    {
+        int status;
+        while ((::waitpid(p_link.pid, &status, 0) < 0) && (errno == EINTR))
+        {
+        }
+        p_link.pid = -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<Shards::Worker>
+Shards::spawnLocal(NodeFactory const& p_factory, size_t p_threads)
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+    {
+        return robotik::Return<Worker>::error(
+            std::string("socketpair failed: ") + std::strerror(errno));
+    }
+
+    pid_t pid = ::fork();
+    if (pid < 0)
+    {
+        int error = errno;
+        ::close(fds[0]);
+        ::close(fds[1]);
+        return robotik::Return<Worker>::error(
+            std::string("fork failed: ") + std::strerror(error));
+    }
+
+    if (pid == 0)
+    {
+        // Worker process: the streams to the other workers are not its own
+        ::close(fds[0]);
+        for (auto const& link : m_links)
+        {
+            if (link.fd >= 0)
+            {
+                ::close(link.fd);
+            }
+        }
+        bool served;
+        {
+            ShardWorker worker(p_factory, p_threads);
+            served = worker.serve(fds[1]);
+        }
+        ::_exit(served ? 0 : 1);
+    }
+
+    ::close(fds[1]);
+    return robotik::Return<Worker>::success(attach(fds[0], pid));
+}
+
+// ----------------------------------------------------------------------------
+Shards::Worker Shards::attach(int p_fd, pid_t p_pid)
+{
+    Worker worker = Worker(m_links.size());
+    Link link;
+    link.fd = p_fd;
+    link.pid = p_pid;
+    m_links.push_back(std::move(link));
+    m_ring.add(worker);
+    return worker;
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<std::string> Shards::call(Worker p_worker,
+                                          shard::Command p_command,
+                                          std::string const& p_payload)
+{
+    using Answer = robotik::Return<std::string>;
+
+    if ((p_worker >= m_links.size()) || (m_links[p_worker].fd < 0))
+    {
+        return Answer::error("Unknown worker " + std::to_string(p_worker));
+    }
+
+    int fd = m_links[p_worker].fd;
+    uint8_t type;
+    std::string payload;
+    if (!shard::send(fd, uint8_t(p_command), p_payload) ||
+        !shard::receive(fd, type, payload))
+    {
+        return Answer::error("Worker " + std::to_string(p_worker) +
+                             " does not answer");
+    }
+    if (shard::Reply(type) != shard::Reply::Ok)
+    {
+        return Answer::error(payload);
+    }
+    return Answer::success(std::move(payload));
+}
+
+// ----------------------------------------------------------------------------
+void Shards::forget(std::string const& p_name, Worker p_worker)
+{
+    auto& agents = m_links[p_worker].agents;
+    agents.erase(std::find(agents.begin(), agents.end(), p_name));
+    m_locations.erase(p_name);
+    m_statuses.erase(p_name);
+}
+
+// ----------------------------------------------------------------------------
+Shards::Result Shards::add(std::string const& p_name,
+                           std::string const& p_document)
+{
+    if (m_locations.find(p_name) != m_locations.end())
+    {
+        return Result::error("Agent '" + p_name + "' already exists");
+    }
+    auto owner = m_ring.owner(p_name);
+    if (!owner)
+    {
+        return Result::error("No worker");
+    }
+
+    std::string payload;
+    encoding::putString(payload, p_name);
+    encoding::putString(payload, p_document);
+    if (auto answer = call(*owner, shard::Command::Spawn, payload); !answer)
+    {
+        return Result::error(answer.getError());
+    }
+
+    m_links[*owner].agents.push_back(p_name);
+    m_locations.emplace(p_name, *owner);
+    m_statuses.emplace(p_name, Status::INVALID);
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+Shards::Result Shards::remove(std::string const& p_name)
+{
+    auto it = m_locations.find(p_name);
+    if (it == m_locations.end())
+    {
+        return Result::error("Unknown agent '" + p_name + "'");
+    }
+
+    Worker worker = it->second;
+    std::string payload;
+    encoding::putString(payload, p_name);
+    if (auto answer = call(worker, shard::Command::Remove, payload); !answer)
+    {
+        return Result::error(answer.getError());
+    }
+    forget(p_name, worker);
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+Shards::Result Shards::migrate(std::string const& p_name, Worker p_worker)
+{
+    auto it = m_locations.find(p_name);
+    if (it == m_locations.end())
+    {
+        return Result::error("Unknown agent '" + p_name + "'");
+    }
+    Worker source = it->second;
+    if (source == p_worker)
+    {
+        return Result::success(true);
+    }
+    if ((p_worker >= m_links.size()) || (m_links[p_worker].fd < 0))
+    {
+        return Result::error("Unknown worker " + std::to_string(p_worker));
+    }
+
+    // The agent is paused from its export to its import
+    auto const start = std::chrono::steady_clock::now();
+    std::string payload;
+    encoding::putString(payload, p_name);
+    auto snapshot = call(source, shard::Command::Export, payload);
+    if (!snapshot)
+    {
+        m_statistics.failures++;
+        return Result::error(snapshot.getError());
+    }
+    Status status = m_statuses[p_name];
+    forget(p_name, source);
+
+    Worker target = p_worker;
+    auto imported = call(target, shard::Command::Import, snapshot.getValue());
+    if (!imported)
+    {
+        // Resume the agent on its source
+        m_statistics.failures++;
+        target = source;
+        if (auto restored =
+                call(source, shard::Command::Import, snapshot.getValue());
+            !restored)
+        {
+            return Result::error("Agent '" + p_name +
+                                 "' lost: " + restored.getError());
+        }
+    }
+    m_links[target].agents.push_back(p_name);
+    m_locations.emplace(p_name, target);
+    m_statuses.emplace(p_name, status);
+    if (!imported)
+    {
+        return Result::error(imported.getError());
+    }
+
+    auto const pause = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start);
+    m_statistics.migrations++;
+    m_statistics.bytes += snapshot.getValue().size();
+    m_statistics.last_pause = pause;
+    m_statistics.max_pause = std::max(m_statistics.max_pause, pause);
+    m_statistics.total_pause += pause;
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<size_t> Shards::rebalance()
+{
+    std::vector<std::pair<std::string, Worker>> moves;
+    for (auto const& [name, worker] : m_locations)
+    {
+        if (auto owner = m_ring.owner(name); owner && (*owner != worker))
+        {
+            moves.emplace_back(name, *owner);
+        }
+    }
+    // Same order of moves whatever the order of the hash map
+    std::sort(moves.begin(), moves.end());
+
+    size_t moved = 0u;
+    std::string error;
+    for (auto const& [name, owner] : moves)
+    {
+        if (auto result = migrate(name, owner))
+        {
+            ++moved;
+        }
+        else if (error.empty())
+        {
+            error = result.getError();
+        }
+    }
+
+    if (!error.empty())
+    {
+        return robotik::Return<size_t>::error(error);
+    }
+    return robotik::Return<size_t>::success(moved);
+}
+
+// ----------------------------------------------------------------------------
+Shards::Result Shards::retire(Worker p_worker)
+{
+    if ((p_worker >= m_links.size()) || (m_links[p_worker].fd < 0))
+    {
+        return Result::error("Unknown worker " + std::to_string(p_worker));
+    }
+
+    m_ring.remove(p_worker);
+    auto moved = rebalance();
+    if (!m_links[p_worker].agents.empty())
+    {
+        m_ring.add(p_worker);
+        return Result::error(moved ? "No other worker" : moved.getError());
+    }
+    stop(m_links[p_worker]);
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+Shards::Result Shards::tick()
+{
+    // Send all the ticks first so that the workers tick in parallel
+    for (Worker worker = 0u; worker < m_links.size(); ++worker)
+    {
+        Link const& link = m_links[worker];
+        if ((link.fd >= 0) &&
+            !shard::send(link.fd, uint8_t(shard::Command::Tick), ""))
+        {
+            return Result::error("Worker " + std::to_string(worker) +
+                                 " does not answer");
+        }
+    }
+
+    std::string error;
+    for (Worker worker = 0u; worker < m_links.size(); ++worker)
+    {
+        Link const& link = m_links[worker];
+        uint8_t type;
+        std::string payload;
+        if (link.fd < 0)
+        {
+            continue;
+        }
+        if (!shard::receive(link.fd, type, payload))
+        {
+            error = "Worker " + std::to_string(worker) + " does not answer";
+            continue;
+        }
+
+        encoding::Reader reader(payload.data(), payload.size());
+        uint32_t count;
+        if ((shard::Reply(type) != shard::Reply::Ok) || !reader.get(count) ||
+            (count != link.agents.size()))
+        {
+            error = "Worker " + std::to_string(worker) + " is out of sync";
+            continue;
+        }
+        for (auto const& name : link.agents)
+        {
+            uint8_t status;
+            if (!reader.get(status))
+            {
+                break;
+            }
+            m_statuses[name] = Status(status);
+        }
+    }
+
+    if (!error.empty())
+    {
+        return Result::error(error);
+    }
+    return Result::success(true);
+}
+
+// ----------------------------------------------------------------------------
+robotik::Return<std::string> Shards::snapshot(std::string const& p_name)
+{
+    auto it = m_locations.find(p_name);
+    if (it == m_locations.end())
+    {
+        return robotik::Return<std::string>::error("Unknown agent '" +
+                                                   p_name + "'");
+    }
+    std::string payload;
+    encoding::putString(payload, p_name);
+    return call(it->second, shard::Command::Snapshot, payload);
+}
+
+// ----------------------------------------------------------------------------
+std::optional<Shards::Worker>
+Shards::location(std::string const& p_name) const
+{
+    auto it = m_locations.find(p_name);
+    if (it == m_locations.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+// ----------------------------------------------------------------------------
+std::vector<std::string> const& Shards::agents(Worker p_worker) const
+{
+    static std::vector<std::string> const none;
+    return (p_worker < m_links.size()) ? m_links[p_worker].agents : none;
+}
+
+} // namespace bt
@@ -0,0 +1,501 @@
+/**
+ * @file Sharding.hpp
+ * @brief Trees spread over worker processes by consistent hashing, with live
+ * migration of running trees between workers.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Builder/Factory.hpp"
+#include "BlackThorn/Common/Return.hpp"
+#include "BlackThorn/Core/Tree.hpp"
+#include "BlackThorn/Executor/Executor.hpp"
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Consistent hashing of agent names to workers.
+//!
+//! Each worker is placed at many points (replicas) of a 64-bit hash ring and
+//! an agent belongs to the worker of the first point following the hash of
+//! its name. Adding or removing a worker only moves the agents of the arcs
+//! it takes or gives back, about 1 / workers of the agents, instead of almost
+//! all of them with a modulo. The hash (FNV-1a followed by a 64-bit mixer)
+//! does not depend on the host, so all the processes agree on the owners.
+// ****************************************************************************
+class ShardRing
+{
+public:
+
+    using Worker = uint32_t;
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_replicas Number of points per worker: more points give a
+    //!            more even load at the cost of a larger ring.
+    // ------------------------------------------------------------------------
+    explicit ShardRing(size_t p_replicas = 128u)
+        : m_replicas(p_replicas == 0u ? 1u : p_replicas)
+    {
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Place a worker on the ring (no effect if already placed).
+    // ------------------------------------------------------------------------
+    void add(Worker p_worker);
+
+    // ------------------------------------------------------------------------
+    //! \brief Remove a worker from the ring: its agents go to the workers
+    //! following its points.
+    // ------------------------------------------------------------------------
+    void remove(Worker p_worker);
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a worker is placed on the ring.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool has(Worker p_worker) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the placed workers, in the order they were added.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<Worker> const& workers() const
+    {
+        return m_workers;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the worker owning an agent.
+    //! \param[in] p_agent The name of the agent.
+    //! \return The worker, or std::nullopt if the ring is empty.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::optional<Worker> owner(std::string_view p_agent) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Hash function of the ring, stable across hosts and builds.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static uint64_t hash(std::string_view p_key);
+
+private:
+
+    size_t m_replicas;
+    //! \brief Points of the ring sorted by hash.
+    std::vector<std::pair<uint64_t, Worker>> m_points;
+    std::vector<Worker> m_workers;
+};
+
+// ****************************************************************************
+//! \brief Messages between Shards and its workers.
+//!
+//! A message is: [u32 size of the rest][u8 command or reply][payload], in the
+//! native byte order (the coordinator and the workers run the same build).
+//! Strings in payloads are prefixed by their u32 size. Each command gets one
+//! reply: Ok with the result, or Error with a message.
+// ****************************************************************************
+namespace shard {
+
+//! \brief Commands of the coordinator.
+enum class Command : uint8_t
+{
+    Spawn = 1,    //!< Name + document -> nothing.
+    Tick = 2,     //!< Nothing -> u32 count + statuses of the agents.
+    Export = 3,   //!< Name -> snapshot (the agent is no longer hosted).
+    Import = 4,   //!< Snapshot -> name.
+    Snapshot = 5, //!< Name -> snapshot (the agent keeps running).
+    Remove = 6,   //!< Name -> nothing.
+    Stop = 7,     //!< Nothing -> nothing, then the worker returns.
+};
+
+//! \brief Replies of the workers.
+enum class Reply : uint8_t
+{
+    Ok = 0,    //!< Followed by the result.
+    Error = 1, //!< Followed by the error message.
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Write a message on a blocking stream.
+//! \return False on a write error.
+// ----------------------------------------------------------------------------
+bool send(int p_fd, uint8_t p_type, std::string const& p_payload);
+
+// ----------------------------------------------------------------------------
+//! \brief Read a message from a blocking stream.
+//! \return False on a read error or at the end of the stream.
+// ----------------------------------------------------------------------------
+bool receive(int p_fd, uint8_t& p_type, std::string& p_payload);
+
+} // namespace shard
+
+// ****************************************************************************
+//! \brief Hosts a shard of the agents in a worker process, driven by the
+//! commands of Shards read from a stream (socketpair, pipe pair or TCP
+//! connection).
+//!
+//! An agent is a tree built from a YAML description (see Builder) and named
+//! by a unique string. Agents are ticked together by an Executor. A running
+//! agent is moved to another worker with exportAgent() then importAgent():
+//! the snapshot holds the description, the execution state of the tree (see
+//! Tree::saveState()) and the local entries of its blackboards and of the
+//! blackboards of its subtrees (see journal::putSnapshot()), so that the
+//! agent resumes on the target where it stopped on the source.
+//!
+//! An agent cannot be moved while one of its nodes has a state bound to
+//! the process (pending I/O or batched request, runtime subtree content) or
+//! when a blackboard value has no binary encoding: exportAgent() then fails
+//! and the agent keeps running on its worker. Custom actions keeping state
+//! in their members between ticks must override Node::onSaveState() and
+//! Node::onLoadState() to be moved without changing their behavior.
+// ****************************************************************************
+class ShardWorker
+{
+public:
+
+    using Result = robotik::Return<bool>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_factory The factory of the custom nodes of the agents.
+    //!            Its shared computations and batched services are given to
+    //!            the executor ticking the agents.
+    //! \param[in] p_threads Number of threads ticking the agents.
+    // ------------------------------------------------------------------------
+    explicit ShardWorker(NodeFactory const& p_factory, size_t p_threads = 1u);
+
+    ShardWorker(ShardWorker const&) = delete;
+    ShardWorker& operator=(ShardWorker const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Build and host a new agent.
+    //! \param[in] p_name The unique name of the agent.
+    //! \param[in] p_document The YAML description of the tree.
+    //! \return An error if the name is taken or the description is invalid.
+    // ------------------------------------------------------------------------
+    Result spawn(std::string const& p_name, std::string const& p_document);
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the state of an agent without stopping it.
+    //! \return The snapshot, or an error if the agent is unknown or cannot
+    //!         be moved in its current state.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] robotik::Return<std::string>
+    snapshot(std::string const& p_name) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the state of an agent and stop hosting it.
+    //! \return The snapshot, or an error: the agent is then still hosted.
+    // ------------------------------------------------------------------------
+    robotik::Return<std::string> exportAgent(std::string const& p_name);
+
+    // ------------------------------------------------------------------------
+    //! \brief Rebuild an agent from a snapshot and host it.
+    //! \param[in] p_snapshot The snapshot given by exportAgent().
+    //! \return The name of the agent, or an error: the agent is then not
+    //!         hosted.
+    // ------------------------------------------------------------------------
+    robotik::Return<std::string> importAgent(std::string const& p_snapshot);
+
+    // ------------------------------------------------------------------------
+    //! \brief Stop hosting an agent.
+    //! \return False if the agent is unknown.
+    // ------------------------------------------------------------------------
+    bool remove(std::string const& p_name);
+
+    // ------------------------------------------------------------------------
+    //! \brief Tick all the agents once.
+    //! \return The statuses of the agents, in the order of names().
+    // ------------------------------------------------------------------------
+    std::vector<Status> const& tick()
+    {
+        return m_executor.tick();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the names of the agents, in the order they were added.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<std::string> const& names() const
+    {
+        return m_names;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the tree of an agent.
+    //! \return The tree, or nullptr if the agent is unknown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Tree* tree(std::string const& p_name) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Serve the commands of Shards until the Stop command or the end
+    //! of the stream.
+    //! \param[in] p_fd The blocking stream connected to the coordinator (not
+    //!            closed).
+    //! \return False if the stream failed or a message is corrupted.
+    // ------------------------------------------------------------------------
+    bool serve(int p_fd);
+
+private:
+
+    struct Agent
+    {
+        std::string document;
+        Tree::Ptr tree;
+    };
+
+    //! \brief Build the tree of an agent.
+    robotik::Return<Tree::Ptr> build(std::string const& p_document) const;
+    //! \brief Host a built agent.
+    void host(std::string const& p_name, Agent p_agent);
+
+private:
+
+    NodeFactory const& m_factory;
+    Executor m_executor;
+    std::unordered_map<std::string, Agent> m_agents;
+    //! \brief Names of the agents in the order of the executor.
+    std::vector<std::string> m_names;
+};
+
+// ****************************************************************************
+//! \brief Coordinator spreading agents over worker processes by consistent
+//! hashing (see ShardRing) and moving running agents between workers.
+//!
+//! Workers are local processes forked by spawnLocal(), or processes running
+//! ShardWorker::serve() on any host and connected with attach(). Each
+//! tick() sends one message to every worker, which ticks its agents in
+//! parallel with the other workers, then collects the statuses.
+//!
+//! When workers are added or removed, rebalance() moves the agents whose
+//! owner changed on the ring, between two ticks. An agent is paused from the
+//! export on its source to the import on its target: this migration pause is
+//! measured in statistics(). Timers are paused with the agent, so that they
+//! do not depend on the clocks of the hosts.
+//!
+//! Usage example:
+//! \code
+//!   bt::Shards shards;
+//!   for (size_t i = 0; i < 4; ++i)
+//!       shards.spawnLocal(factory);
+//!   for (auto const& [name, document] : agents)
+//!       shards.add(name, document);
+//!   while (running) {
+//!       shards.tick();
+//!       if (overloaded) {
+//!           shards.spawnLocal(factory);
+//!           shards.rebalance();
+//!       }
+//!   }
+//! \endcode
+// ****************************************************************************
+class Shards
+{
+public:
+
+    using Result = robotik::Return<bool>;
+    using Worker = ShardRing::Worker;
+
+    // ------------------------------------------------------------------------
+    //! \brief Migration statistics.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of agents moved.
+        size_t migrations = 0u;
+        //! \brief Number of moves that failed (the agent stayed on its
+        //! worker).
+        size_t failures = 0u;
+        //! \brief Size of the snapshots moved.
+        size_t bytes = 0u;
+        //! \brief Pause of the last agent moved.
+        std::chrono::nanoseconds last_pause{0};
+        //! \brief Longest pause.
+        std::chrono::nanoseconds max_pause{0};
+        //! \brief Sum of the pauses.
+        std::chrono::nanoseconds total_pause{0};
+
+        // --------------------------------------------------------------------
+        //! \brief Average pause of the agents moved.
+        // --------------------------------------------------------------------
+        [[nodiscard]] std::chrono::nanoseconds averagePause() const
+        {
+            using Rep = std::chrono::nanoseconds::rep;
+            return (migrations == 0u) ? std::chrono::nanoseconds(0)
+                                      : total_pause / Rep(migrations);
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_replicas Number of points per worker on the ring.
+    // ------------------------------------------------------------------------
+    explicit Shards(size_t p_replicas = 128u) : m_ring(p_replicas) {}
+
+    Shards(Shards const&) = delete;
+    Shards& operator=(Shards const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - stops the workers and waits for the local ones.
+    // ------------------------------------------------------------------------
+    ~Shards();
+
+    // ------------------------------------------------------------------------
+    //! \brief Fork a local worker process hosting its agents with a
+    //! ShardWorker, and place it on the ring. Fork the workers before
+    //! starting threads in this process.
+    //! \param[in] p_factory The factory of the custom nodes of the agents.
+    //! \param[in] p_threads Number of threads ticking the agents.
+    //! \return The worker, or an error if the process cannot be created.
+    // ------------------------------------------------------------------------
+    robotik::Return<Worker> spawnLocal(NodeFactory const& p_factory,
+                                       size_t p_threads = 1u);
+
+    // ------------------------------------------------------------------------
+    //! \brief Place a worker connected by a stream (e.g. a TCP connection
+    //! to a process running ShardWorker::serve()) on the ring.
+    //! \param[in] p_fd The blocking stream, closed by the destructor.
+    //! \param[in] p_pid The process to wait for, or -1 if not a child.
+    //! \return The worker.
+    // ------------------------------------------------------------------------
+    Worker attach(int p_fd, pid_t p_pid = -1);
+
+    // ------------------------------------------------------------------------
+    //! \brief Remove a worker from the ring, move its agents to the other
+    //! workers and stop it.
+    //! \return An error if an agent cannot be moved: the worker then stays
+    //!         on the ring with the agents not moved.
+    // ------------------------------------------------------------------------
+    Result retire(Worker p_worker);
+
+    // ------------------------------------------------------------------------
+    //! \brief Create an agent on the worker owning its name.
+    //! \param[in] p_name The unique name of the agent.
+    //! \param[in] p_document The YAML description of the tree.
+    // ------------------------------------------------------------------------
+    Result add(std::string const& p_name, std::string const& p_document);
+
+    // ------------------------------------------------------------------------
+    //! \brief Destroy an agent.
+    // ------------------------------------------------------------------------
+    Result remove(std::string const& p_name);
+
+    // ------------------------------------------------------------------------
+    //! \brief Move a running agent to a worker, between two ticks.
+    //! \return An error if the agent cannot be moved: it then keeps running
+    //!         on its worker.
+    // ------------------------------------------------------------------------
+    Result migrate(std::string const& p_name, Worker p_worker);
+
+    // ------------------------------------------------------------------------
+    //! \brief Move the agents whose owner changed on the ring.
+    //! \return The number of agents moved, or the error of the first agent
+    //!         that could not be moved (the others are still moved).
+    // ------------------------------------------------------------------------
+    robotik::Return<size_t> rebalance();
+
+    // ------------------------------------------------------------------------
+    //! \brief Tick all the agents once, the workers in parallel.
+    //! \return An error if a worker does not answer.
+    // ------------------------------------------------------------------------
+    Result tick();
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statuses of the agents at the last tick(), by name.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::unordered_map<std::string, Status> const&
+    statuses() const
+    {
+        return m_statuses;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the state of an agent without moving it (see
+    //! ShardWorker::snapshot()), e.g. to compare agents in tests.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] robotik::Return<std::string>
+    snapshot(std::string const& p_name);
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the worker hosting an agent.
+    //! \return The worker, or std::nullopt if the agent is unknown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::optional<Worker>
+    location(std::string const& p_name) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the names of the agents hosted by a worker.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<std::string> const& agents(Worker p_worker) const;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of agents.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t size() const
+    {
+        return m_locations.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the ring placing the agents.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] ShardRing const& ring() const
+    {
+        return m_ring;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the migration statistics.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics const& statistics() const
+    {
+        return m_statistics;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Reset the migration statistics.
+    // ------------------------------------------------------------------------
+    void resetStatistics()
+    {
+        m_statistics = Statistics();
+    }
+
+private:
+
+    struct Link
+    {
+        int fd = -1;
+        pid_t pid = -1;
+        //! \brief Names of the agents in the order of the worker.
+        std::vector<std::string> agents;
+    };
+
+    //! \brief Send a command and wait for its reply.
+    robotik::Return<std::string> call(Worker p_worker,
+                                      shard::Command p_command,
+                                      std::string const& p_payload);
+    //! \brief Forget an agent moved or destroyed on its worker.
+    void forget(std::string const& p_name, Worker p_worker);
+    //! \brief Stop a worker and release its stream.
+    void stop(Link& p_link);
+
+private:
+
+    ShardRing m_ring;
+    std::vector<Link> m_links;
+    std::unordered_map<std::string, Worker> m_locations;
+    std::unordered_map<std::string, Status> m_statuses;
+    Statistics m_statistics;
+};
+
+} // namespace bt
@@ -0,0 +1,224 @@
+/**
+ * @file SharedComputations.hpp
+ * @brief Registry of computations evaluated at most once per executor tick
+ * and shared by all the trees referencing them.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Blackboard/Blackboard.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Registry of named computations shared by many trees.
+//!
+//! Hundreds of agent trees often evaluate the same global queries at each
+//! tick ("is it night", "closest threat map" ...). Registering such a query
+//! here and referencing it from the trees with SharedComputation leaves
+//! computes it at most once per tick: the first tree needing the result
+//! computes it, the trees ticked concurrently wait for it, the following
+//! ones reuse it. The Executor starts a new tick with nextTick() before
+//! ticking its trees.
+//!
+//! Results are immutable once computed: they are shared (not copied) with
+//! the blackboards of the trees, which copy them on their first write (see
+//! Blackboard::share()).
+//!
+//! Computations must be added before ticking the trees: add() is not
+//! thread-safe, get() is.
+//!
+//! Usage example:
+//! \code
+//!   auto shared = std::make_shared<bt::SharedComputations>();
+//!   shared->add("is_night", [&world]() { return world.isNight(); });
+//!   factory.setSharedComputations(shared);
+//! \endcode
+// ****************************************************************************
+class SharedComputations
+{
+public:
+
+    using Ptr = std::shared_ptr<SharedComputations>;
+    //! \brief Computation returning its result, or an empty value on failure.
+    using Function = std::function<Blackboard::Value()>;
+    //! \brief Result shared with the blackboards.
+    using Result = std::shared_ptr<Blackboard::Value>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Usage statistics of a computation.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of results reused within a tick.
+        size_t hits = 0;
+        //! \brief Number of computations (at most one per tick).
+        size_t misses = 0;
+        //! \brief Number of hits that waited for a computation in progress.
+        size_t waits = 0;
+
+        [[nodiscard]] double hitRate() const
+        {
+            size_t total = hits + misses;
+            return (total == 0u) ? 0.0 : double(hits) / double(total);
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Register a computation (replacing any with the same name).
+    //! \param[in] p_name The name referenced by the SharedComputation leaves.
+    //! \param[in] p_function The computation.
+    // ------------------------------------------------------------------------
+    void add(std::string const& p_name, Function p_function)
+    {
+        auto entry = std::make_unique<Entry>();
+        entry->function = std::move(p_function);
+        m_entries[p_name] = std::move(entry);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a computation is registered.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool has(std::string const& p_name) const
+    {
+        return m_entries.find(p_name) != m_entries.end();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start a new tick: results of the previous tick are outdated.
+    //! Must not be called while trees are ticked.
+    // ------------------------------------------------------------------------
+    void nextTick()
+    {
+        m_tick.fetch_add(1u, std::memory_order_acq_rel);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the current tick number.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] uint64_t tick() const
+    {
+        return m_tick.load(std::memory_order_acquire);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the result of a computation for the current tick, computing
+    //! it if this is the first request of the tick.
+    //! \param[in] p_name The name of the computation.
+    //! \return The result, or nullptr if the computation is unknown or failed
+    //!         (a failed computation is not retried within the tick).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Result get(std::string const& p_name)
+    {
+        auto it = m_entries.find(p_name);
+        if (it == m_entries.end())
+        {
+            return nullptr;
+        }
+
+        Entry& entry = *it->second;
+        uint64_t const now = tick();
+
+        // Fast path: already computed during this tick
+        if (entry.computed.load(std::memory_order_acquire) == now)
+        {
+            entry.hits.fetch_add(1u, std::memory_order_relaxed);
+            return entry.result;
+        }
+
+        // Slow path: compute, or wait for the tree computing it
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        if (entry.computed.load(std::memory_order_relaxed) == now)
+        {
+            entry.hits.fetch_add(1u, std::memory_order_relaxed);
+            entry.waits.fetch_add(1u, std::memory_order_relaxed);
+            return entry.result;
+        }
+
+        entry.misses.fetch_add(1u, std::memory_order_relaxed);
+        Blackboard::Value value = entry.function ? entry.function()
+                                                 : Blackboard::Value();
+        entry.result = value.has_value()
+                           ? std::make_shared<Blackboard::Value>(
+                                 std::move(value))
+                           : nullptr;
+        entry.computed.store(now, std::memory_order_release);
+        return entry.result;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statistics of a computation.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics(std::string const& p_name) const
+    {
+        Statistics stats;
+        if (auto it = m_entries.find(p_name); it != m_entries.end())
+        {
+            stats.hits = it->second->hits.load(std::memory_order_relaxed);
+            stats.misses = it->second->misses.load(std::memory_order_relaxed);
+            stats.waits = it->second->waits.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statistics summed over all computations.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics() const
+    {
+        Statistics total;
+        for (auto const& [name, entry] : m_entries)
+        {
+            Statistics stats = statistics(name);
+            total.hits += stats.hits;
+            total.misses += stats.misses;
+            total.waits += stats.waits;
+        }
+        return total;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Reset the statistics of all computations.
+    // ------------------------------------------------------------------------
+    void resetStatistics()
+    {
+        for (auto const& [name, entry] : m_entries)
+        {
+            entry->hits = 0u;
+            entry->misses = 0u;
+            entry->waits = 0u;
+        }
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief A computation and its result for the tick it was computed.
+    // ------------------------------------------------------------------------
+    struct Entry
+    {
+        Function function;
+        std::mutex mutex;
+        //! \brief Tick of the result (ticks start at 1: never computed).
+        std::atomic<uint64_t> computed{0u};
+        Result result;
+        std::atomic<size_t> hits{0u};
+        std::atomic<size_t> misses{0u};
+        std::atomic<size_t> waits{0u};
+    };
+
+    std::unordered_map<std::string, std::unique_ptr<Entry>> m_entries;
+    std::atomic<uint64_t> m_tick{1u};
+};
+
+} // namespace bt
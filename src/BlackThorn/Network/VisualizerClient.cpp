@@ -8,13 +8,18 @@
 
 #include "VisualizerClient.hpp"
 #include "../BlackThorn.hpp"
+#include "../Profiler/SamplingProfiler.hpp"
+#include "../Profiler/StatusAggregator.hpp"
 
 #include <SFML/Network.hpp>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 
 namespace bt {
 
+namespace {
+
 // ****************************************************************************
 //! \brief Visitor that serializes a behavior tree to YAML format.
 //! This produces the same structure as the Builder expects when parsing.
@@ -60,10 +65,45 @@ public:
         indent_level--;
     }
 
+    void writeChildOrdering(ChildOrdering const& p_ordering)
+    {
+        if (!p_ordering.isEnabled())
+        {
+            return;
+        }
+        yaml << indent() << "unordered: true\n";
+        if (p_ordering.config().deterministic)
+        {
+            yaml << indent() << "deterministic: true\n";
+        }
+        yaml << indent()
+             << "reorder_period: " << p_ordering.config().reorder_period
+             << "\n";
+    }
+
+    // Quoted values are strings, else the type is inferred unless given
+    void writeSetBlackboardValue(SetBlackboard const& p_node)
+    {
+        SetBlackboard::Type type = p_node.getValueType();
+        if (type == SetBlackboard::Type::String)
+        {
+            yaml << indent() << "value: " << std::quoted(p_node.getValue())
+                 << "\n";
+            return;
+        }
+        yaml << indent() << "value: " << p_node.getValue() << "\n";
+        if (type != SetBlackboard::Type::Auto)
+        {
+            yaml << indent() << "type: " << SetBlackboard::toString(type)
+                 << "\n";
+        }
+    }
+
     // Composite nodes
     void visitSequence(Sequence const& p_node) override
     {
         writeNodeStart("Sequence", p_node);
+        writeChildOrdering(p_node.getOrdering());
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -109,6 +149,7 @@ public:
     void visitSelector(Selector const& p_node) override
     {
         writeNodeStart("Selector", p_node);
+        writeChildOrdering(p_node.getOrdering());
         if (p_node.hasChildren())
         {
             writeChildrenStart();
@@ -361,6 +402,20 @@ public:
         writeNodeEnd();
     }
 
+    void visitDynamicSubTree(DynamicSubTree const& p_node) override
+    {
+        writeNodeStart("DynamicSubTree", p_node);
+        // Inline the current content as children for visualization
+        Tree const* content = p_node.content();
+        if (content && content->hasRoot())
+        {
+            writeChildrenStart();
+            content->getRoot().accept(*this);
+            writeChildrenEnd();
+        }
+        writeNodeEnd();
+    }
+
     void visitWait(Wait const& p_node) override
     {
         writeNodeStart("Wait", p_node);
@@ -373,7 +428,34 @@ public:
     {
         writeNodeStart("SetBlackboard", p_node);
         yaml << indent() << "key: " << p_node.getKey() << "\n";
-        yaml << indent() << "value: " << p_node.getValue() << "\n";
+        writeSetBlackboardValue(p_node);
+        writeNodeEnd();
+    }
+
+    void visitSharedComputation(SharedComputation const& p_node) override
+    {
+        writeNodeStart("SharedComputation", p_node);
+        yaml << indent() << "computation: " << p_node.getComputation()
+             << "\n";
+        if (p_node.getKey() != p_node.getComputation())
+        {
+            yaml << indent() << "key: " << p_node.getKey() << "\n";
+        }
+        writeNodeEnd();
+    }
+
+    void visitBatchedServiceCall(BatchedServiceCall const& p_node) override
+    {
+        writeNodeStart("BatchedServiceCall", p_node);
+        yaml << indent() << "service: " << p_node.getService() << "\n";
+        if (!p_node.getRequest().empty())
+        {
+            yaml << indent() << "request: " << p_node.getRequest() << "\n";
+        }
+        if (p_node.getResponse() != p_node.getService())
+        {
+            yaml << indent() << "response: " << p_node.getResponse() << "\n";
+        }
         writeNodeEnd();
     }
 
@@ -395,6 +477,8 @@ public:
     bool m_is_root = false;
 };
 
+} // anonymous namespace
+
 // ----------------------------------------------------------------------------
 VisualizerClient::VisualizerClient() = default;
 
@@ -427,6 +511,9 @@ bool VisualizerClient::connect(std::string const& p_host, uint16_t p_port)
 
     m_tree_sent = false;
     m_last_states.clear();
+    m_last_orders.clear();
+    m_last_contents.clear();
+    m_last_distribution = 0;
 
     return true;
 }
@@ -443,6 +530,9 @@ void VisualizerClient::disconnect()
 
     m_tree_sent = false;
     m_last_states.clear();
+    m_last_orders.clear();
+    m_last_contents.clear();
+    m_last_distribution = 0;
 }
 
 // ----------------------------------------------------------------------------
@@ -461,6 +551,9 @@ bool VisualizerClient::send(std::string const& p_message)
 
     sf::Socket::Status status =
         m_socket->send(p_message.data(), p_message.size());
+    BT_TRACE(visualizer__send,
+             p_message.size(),
+             int(status == sf::Socket::Done));
 
     if (status != sf::Socket::Done)
     {
@@ -481,24 +574,7 @@ std::string VisualizerClient::serializeTreeToYaml(Tree const& p_tree) const
     return visitor.yaml.str();
 }
 
-// ----------------------------------------------------------------------------
-void VisualizerClient::sendTree(Tree const& p_tree)
-{
-    if (!isConnected() || m_tree_sent)
-    {
-        return;
-    }
-
-    std::string yaml = serializeTreeToYaml(p_tree);
-    std::string message = "YAML:" + yaml + "END_YAML\n";
-
-    if (send(message))
-    {
-        m_tree_sent = true;
-        std::cout << "VisualizerClient: Tree sent (" << yaml.size() << " bytes)"
-                  << std::endl;
-    }
-}
+namespace {
 
 // ****************************************************************************
 //! \brief Visitor that collects all nodes for state change detection.
@@ -508,6 +584,8 @@ class NodeCollectorVisitor: public ConstBehaviorTreeVisitor
 public:
 
     std::vector<Node const*> nodes;
+    std::vector<std::pair<Composite const*, ChildOrdering const*>> orderings;
+    std::vector<DynamicSubTree const*> dynamics;
 
     void collectNode(Node const& node)
     {
@@ -534,6 +612,10 @@ public:
 
     void visitSequence(Sequence const& p_node) override
     {
+        if (p_node.isUnordered())
+        {
+            orderings.emplace_back(&p_node, &p_node.getOrdering());
+        }
         visitComposite(p_node);
     }
     void visitReactiveSequence(ReactiveSequence const& p_node) override
@@ -546,6 +628,10 @@ public:
     }
     void visitSelector(Selector const& p_node) override
     {
+        if (p_node.isUnordered())
+        {
+            orderings.emplace_back(&p_node, &p_node.getOrdering());
+        }
         visitComposite(p_node);
     }
     void visitReactiveSelector(ReactiveSelector const& p_node) override
@@ -639,6 +725,17 @@ public:
             }
         }
     }
+    void visitDynamicSubTree(DynamicSubTree const& p_node) override
+    {
+        collectNode(p_node);
+        dynamics.push_back(&p_node);
+        // Also collect nodes from the current content
+        Tree const* content = p_node.content();
+        if (content && content->hasRoot())
+        {
+            content->getRoot().accept(*this);
+        }
+    }
     void visitWait(Wait const& p_node) override
     {
         collectNode(p_node);
@@ -647,6 +744,14 @@ public:
     {
         collectNode(p_node);
     }
+    void visitSharedComputation(SharedComputation const& p_node) override
+    {
+        collectNode(p_node);
+    }
+    void visitBatchedServiceCall(BatchedServiceCall const& p_node) override
+    {
+        collectNode(p_node);
+    }
 
     void visitTree(Tree const& tree) override
     {
@@ -657,6 +762,33 @@ public:
     }
 };
 
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendTree(Tree const& p_tree)
+{
+    if (!isConnected() || m_tree_sent)
+    {
+        return;
+    }
+
+    std::string yaml = serializeTreeToYaml(p_tree);
+    std::string message = "YAML:" + yaml + "END_YAML\n";
+
+    if (send(message))
+    {
+        m_tree_sent = true;
+        std::cout << "VisualizerClient: Tree sent (" << yaml.size() << " bytes)"
+                  << std::endl;
+
+        // Later contents of the DynamicSubTree nodes are sent as patches
+        NodeCollectorVisitor collector;
+        p_tree.accept(collector);
+        trackDynamicContents(collector.dynamics, false);
+    }
+}
+
+
 // ----------------------------------------------------------------------------
 void VisualizerClient::sendStateChanges(Tree const& p_tree)
 {
@@ -675,6 +807,9 @@ void VisualizerClient::sendStateChanges(Tree const& p_tree)
     NodeCollectorVisitor collector;
     p_tree.accept(collector);
 
+    // Patch the structure before sending the states of the new nodes
+    trackDynamicContents(collector.dynamics, true);
+
     // Build delta message using node IDs
     std::string message;
     bool has_changes = false;
@@ -707,6 +842,206 @@ void VisualizerClient::sendStateChanges(Tree const& p_tree)
     {
         send("S:" + message + "\n");
     }
+
+    // Send the evaluation order of unordered composites when it has changed.
+    // The order is given as the list of child node IDs.
+    for (auto const& [composite, ordering] : collector.orderings)
+    {
+        if (ordering->order().empty())
+        {
+            continue;
+        }
+
+        auto it = m_last_orders.find(composite->id());
+        if ((it != m_last_orders.end()) && (it->second == ordering->revision()))
+        {
+            continue;
+        }
+        m_last_orders[composite->id()] = ordering->revision();
+
+        std::string order = "O:" + std::to_string(composite->id()) + ":";
+        for (size_t i = 0; i < ordering->order().size(); ++i)
+        {
+            if (i > 0)
+            {
+                order += ",";
+            }
+            size_t index = ordering->order()[i];
+            order += std::to_string(composite->getChildren()[index]->id());
+        }
+        send(order + "\n");
+    }
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendHeat(Tree const& p_tree,
+                                SamplingProfiler const& p_profiler)
+{
+    if (!isConnected())
+    {
+        return;
+    }
+
+    size_t busy = p_profiler.statistics(p_tree).busy();
+    if (busy == 0u)
+    {
+        return;
+    }
+
+    // Percentages of the busy samples spent in the branch and in the node
+    std::string message = "H:";
+    bool first = true;
+    for (auto const& samples : p_profiler.hotNodes(p_tree))
+    {
+        if (!first)
+        {
+            message += ",";
+        }
+        message += std::to_string(samples.node->id()) + ":" +
+                   std::to_string(samples.total * 100u / busy) + ":" +
+                   std::to_string(samples.self * 100u / busy);
+        first = false;
+    }
+    send(message + "\n");
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendDistribution(StatusAggregator const& p_aggregator)
+{
+    if (!isConnected() || !m_tree_sent)
+    {
+        return;
+    }
+
+    size_t revision = p_aggregator.revision();
+    if (revision == m_last_distribution)
+    {
+        return;
+    }
+
+    // Number of instances, then the counts of each status per node
+    std::string message =
+        "D:" + std::to_string(p_aggregator.instances()) + ":";
+    bool first = true;
+    for (auto const& node : p_aggregator.distribution())
+    {
+        if (!first)
+        {
+            message += ",";
+        }
+        message += std::to_string(node.id);
+        for (uint32_t count : node.counts)
+        {
+            message += ":" + std::to_string(count);
+        }
+        first = false;
+    }
+    if (send(message + "\n"))
+    {
+        m_last_distribution = revision;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendBranchPatch(std::string const& p_header,
+                                       Node const& p_branch)
+{
+    YamlExportVisitor visitor;
+    visitor.m_is_root = true;
+    p_branch.accept(visitor);
+    if (!send(p_header + "\n" + visitor.yaml.str() + "END_PATCH\n"))
+    {
+        return;
+    }
+
+    // The nodes of the branch are new for the server
+    NodeCollectorVisitor collector;
+    p_branch.accept(collector);
+    for (Node const* node : collector.nodes)
+    {
+        m_last_states.erase(node->id());
+        m_last_orders.erase(node->id());
+    }
+    trackDynamicContents(collector.dynamics, false);
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendInsert(uint32_t p_parent_id,
+                                  size_t p_index,
+                                  Node const& p_branch)
+{
+    if (!isConnected() || !m_tree_sent)
+    {
+        return;
+    }
+
+    sendBranchPatch("PATCH:INSERT:" + std::to_string(p_parent_id) + ":" +
+                        std::to_string(p_index),
+                    p_branch);
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendRemove(uint32_t p_node_id)
+{
+    if (!isConnected() || !m_tree_sent)
+    {
+        return;
+    }
+
+    send("PATCH:REMOVE:" + std::to_string(p_node_id) + "\n");
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::sendReplace(uint32_t p_node_id, Node const& p_branch)
+{
+    if (!isConnected() || !m_tree_sent)
+    {
+        return;
+    }
+
+    sendBranchPatch("PATCH:REPLACE:" + std::to_string(p_node_id), p_branch);
+}
+
+// ----------------------------------------------------------------------------
+void VisualizerClient::trackDynamicContents(
+    std::vector<DynamicSubTree const*> const& p_nodes,
+    bool p_patch)
+{
+    for (DynamicSubTree const* node : p_nodes)
+    {
+        Tree const* tree = node->content();
+        Node const* root =
+            (tree && tree->hasRoot()) ? &tree->getRoot() : nullptr;
+
+        auto it = m_last_contents.find(node->id());
+        if (p_patch && (it != m_last_contents.end()))
+        {
+            if (it->second.swaps == node->swaps())
+            {
+                continue;
+            }
+
+            // Copied since the patch can add entries to the cache
+            Content const last = it->second;
+            if (last.has_root && root)
+            {
+                sendReplace(last.root_id, *root);
+            }
+            else if (last.has_root)
+            {
+                sendRemove(last.root_id);
+            }
+            else if (root)
+            {
+                sendInsert(node->id(), 0u, *root);
+            }
+        }
+
+        Content& content = m_last_contents[node->id()];
+        content.swaps = node->swaps();
+        content.has_root = (root != nullptr);
+        content.root_id = root ? root->id() : 0u;
+    }
 }
 
 } // namespace bt
@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // Forward declaration for SFML socket
 namespace sf {
@@ -25,6 +26,10 @@ namespace bt {
 
 // Forward declarations
 class Tree;
+class Node;
+class DynamicSubTree;
+class SamplingProfiler;
+class StatusAggregator;
 
 // ****************************************************************************
 //! \brief TCP client that sends behavior tree data to the visualizer server.
@@ -32,6 +37,12 @@ class Tree;
 //! The client connects to the editor running in visualizer mode and:
 //! 1. Sends the tree structure as YAML once at connection
 //! 2. Sends state changes (deltas) after each tick
+//! 3. Sends the evaluation order of unordered Sequence/Selector when it changes
+//! 4. Sends structure patches (insert, remove, replace a branch, keyed by node
+//!    ID) when the tree changes after it was sent, instead of the whole tree.
+//!    The new contents of DynamicSubTree nodes are patched automatically.
+//! 5. Sends the distribution of the statuses across the instances of the tree
+//!    (see StatusAggregator) instead of the states of a single instance.
 //!
 //! Usage:
 //! \code
@@ -97,6 +108,47 @@ public:
     // ------------------------------------------------------------------------
     void sendStateChanges(Tree const& p_tree);
 
+    // ------------------------------------------------------------------------
+    //! \brief Send the heat overlay of a profiled tree: the share of the busy
+    //! samples spent in each node and in its branch. Call it periodically
+    //! (e.g. once per second) while the profiler is sampling.
+    //! \param[in] p_tree The profiled tree.
+    //! \param[in] p_profiler The profiler to which the tree is attached.
+    // ------------------------------------------------------------------------
+    void sendHeat(Tree const& p_tree, SamplingProfiler const& p_profiler);
+
+    // ------------------------------------------------------------------------
+    //! \brief Send the distribution of the statuses across the instances of
+    //! the tree sent, if it changed since the last call. Call it at display
+    //! rate (e.g. 30 times per second): the message size depends on the
+    //! number of nodes, not on the number of instances.
+    //! \param[in] p_aggregator The collector the instances report to.
+    // ------------------------------------------------------------------------
+    void sendDistribution(StatusAggregator const& p_aggregator);
+
+    // ------------------------------------------------------------------------
+    //! \brief Patch the tree sent: insert a branch under a node.
+    //! \param[in] p_parent_id The ID of the parent node.
+    //! \param[in] p_index The position of the branch among the children of
+    //! the parent (appended if out of range).
+    //! \param[in] p_branch The root of the branch to insert.
+    // ------------------------------------------------------------------------
+    void sendInsert(uint32_t p_parent_id, size_t p_index, Node const& p_branch);
+
+    // ------------------------------------------------------------------------
+    //! \brief Patch the tree sent: remove a node and its descendants.
+    //! \param[in] p_node_id The ID of the node to remove.
+    // ------------------------------------------------------------------------
+    void sendRemove(uint32_t p_node_id);
+
+    // ------------------------------------------------------------------------
+    //! \brief Patch the tree sent: replace a node and its descendants by a
+    //! branch, at the same place.
+    //! \param[in] p_node_id The ID of the node to replace.
+    //! \param[in] p_branch The root of the new branch.
+    // ------------------------------------------------------------------------
+    void sendReplace(uint32_t p_node_id, Node const& p_branch);
+
 private:
 
     // ------------------------------------------------------------------------
@@ -113,6 +165,23 @@ private:
     // ------------------------------------------------------------------------
     std::string serializeTreeToYaml(Tree const& p_tree) const;
 
+    // ------------------------------------------------------------------------
+    //! \brief Send a patch carrying a branch, and forget the last states of
+    //! its nodes so that they are sent again with the next state changes.
+    //! \param[in] p_header The first line of the patch.
+    //! \param[in] p_branch The root of the branch.
+    // ------------------------------------------------------------------------
+    void sendBranchPatch(std::string const& p_header, Node const& p_branch);
+
+    // ------------------------------------------------------------------------
+    //! \brief Remember the contents of the DynamicSubTree nodes, and patch
+    //! the ones swapped since the last call.
+    //! \param[in] p_nodes The DynamicSubTree nodes of the tree.
+    //! \param[in] p_patch false when the contents are the ones just sent.
+    // ------------------------------------------------------------------------
+    void trackDynamicContents(std::vector<DynamicSubTree const*> const& p_nodes,
+                              bool p_patch);
+
 private:
 
     //! \brief TCP socket for server communication
@@ -124,6 +193,28 @@ private:
     //! \brief Cache of last sent states for delta detection (node_id -> status
     //! as int)
     std::unordered_map<uint32_t, int> m_last_states;
+
+    //! \brief Cache of last sent evaluation orders of unordered composites
+    //! (node_id -> ordering revision)
+    std::unordered_map<uint32_t, size_t> m_last_orders;
+
+    //! \brief Content of a DynamicSubTree node last sent.
+    struct Content
+    {
+        //! \brief Number of swaps of the node when sent.
+        size_t swaps = 0;
+        //! \brief False if the node had no content.
+        bool has_root = false;
+        //! \brief ID of the root of the content.
+        uint32_t root_id = 0;
+    };
+
+    //! \brief Revision of the last distribution sent (0 if none)
+    size_t m_last_distribution = 0;
+
+    //! \brief Cache of last sent contents of DynamicSubTree nodes (node_id ->
+    //! content)
+    std::unordered_map<uint32_t, Content> m_last_contents;
 };
 
 } // namespace bt
@@ -0,0 +1,352 @@
+/**
+ * @file ChildOrdering.hpp
+ * @brief Adaptive evaluation order for commutative Selector and Sequence.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Node.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Adaptive evaluation order of the children of an unordered Selector or
+//! Sequence.
+//!
+//! When the order of the children does not matter (i.e. the composite is
+//! commutative), the expected cost of the composite is minimized by ticking
+//! first the children with the smallest ratio cost / P(decisive), where
+//! decisive means SUCCESS for a Selector and FAILURE for a Sequence. Per-child
+//! statistics (average cost and decisive probability) are gathered on each
+//! evaluation and the order is recomputed every \c reorder_period evaluations
+//! of the composite. The order is only changed when the composite starts a
+//! new evaluation, never while a child is RUNNING.
+//!
+//! In the deterministic mode, the cost of a child is the number of ticks it
+//! consumed instead of its measured duration, so the resulting order only
+//! depends on the statuses returned by the children (useful for unit tests).
+// ****************************************************************************
+class ChildOrdering
+{
+public:
+
+    // ************************************************************************
+    //! \brief Settings of the adaptive ordering.
+    // ************************************************************************
+    struct Config
+    {
+        //! \brief Measure cost in ticks instead of nanoseconds.
+        bool deterministic = false;
+        //! \brief Number of evaluations of the composite between reorderings.
+        size_t reorder_period = 16;
+        //! \brief Weight of the latest sample in the average cost [0..1].
+        double smoothing = 0.1;
+    };
+
+    // ************************************************************************
+    //! \brief Statistics gathered for a single child.
+    // ************************************************************************
+    struct Statistics
+    {
+        //! \brief Number of completed (SUCCESS or FAILURE) evaluations.
+        size_t evaluations = 0;
+        //! \brief Number of evaluations that returned SUCCESS.
+        size_t successes = 0;
+        //! \brief Smoothed cost of a complete evaluation.
+        double cost = 0.0;
+        //! \brief Cost accumulated while the child is RUNNING.
+        double pending_cost = 0.0;
+
+        // --------------------------------------------------------------------
+        //! \brief Probability that the child returns SUCCESS, estimated with
+        //! a Laplace prior so that unseen outcomes are never impossible.
+        // --------------------------------------------------------------------
+        [[nodiscard]] double successProbability() const
+        {
+            return (double(successes) + 1.0) / (double(evaluations) + 2.0);
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Enable the adaptive ordering.
+    //! \param[in] p_config The ordering settings.
+    // ------------------------------------------------------------------------
+    void enable(Config const& p_config)
+    {
+        m_enabled = true;
+        m_config = p_config;
+        if (m_config.reorder_period == 0)
+        {
+            m_config.reorder_period = 1;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Is the adaptive ordering enabled?
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isEnabled() const
+    {
+        return m_enabled;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the ordering settings.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Config const& config() const
+    {
+        return m_config;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the current evaluation order as indices of children.
+    //! \return The indices of children, in the order they are ticked. Empty
+    //! until the first evaluation.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<size_t> const& order() const
+    {
+        return m_order;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of times the order has changed. Observers (i.e.
+    //! the visualizer) can compare it with a cached value to detect changes.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t revision() const
+    {
+        return m_revision;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the statistics gathered for each child.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<Statistics> const& statistics() const
+    {
+        return m_statistics;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start a new evaluation of the composite: rewind the cursor and
+    //! reorder the children if the reorder period has elapsed.
+    //! \param[in] p_count The number of children of the composite.
+    //! \param[in] p_decisive The child status stopping the composite.
+    // ------------------------------------------------------------------------
+    void begin(size_t p_count, Status p_decisive)
+    {
+        if (m_order.size() != p_count)
+        {
+            m_order.resize(p_count);
+            std::iota(m_order.begin(), m_order.end(), size_t(0));
+            m_statistics.assign(p_count, Statistics{});
+            m_evaluations = 0;
+        }
+        else if ((m_evaluations > 0u) &&
+                 (m_evaluations % m_config.reorder_period == 0u))
+        {
+            reorder(p_decisive);
+        }
+
+        m_cursor = 0;
+        m_evaluations++;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Tick the children in the current order until one of them
+    //! returns a status different from p_continue.
+    //! \param[in] p_children The children of the composite.
+    //! \param[in] p_continue The child status letting the composite continue
+    //! (FAILURE for a Selector, SUCCESS for a Sequence).
+    //! \return The status of the composite.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Status tick(std::vector<Node::Ptr> const& p_children,
+                              Status p_continue)
+    {
+        while (m_cursor < m_order.size())
+        {
+            size_t index = m_order[m_cursor];
+            Status status;
+            if (m_config.deterministic)
+            {
+                status = p_children[index]->tick();
+                record(index, status, 1.0);
+            }
+            else
+            {
+                auto start = std::chrono::steady_clock::now();
+                status = p_children[index]->tick();
+                auto elapsed = std::chrono::steady_clock::now() - start;
+                record(index,
+                       status,
+                       double(std::chrono::duration_cast<
+                                  std::chrono::nanoseconds>(elapsed)
+                                  .count()));
+            }
+
+            if (status != p_continue)
+            {
+                return status;
+            }
+            m_cursor++;
+        }
+
+        return p_continue;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Append the order, the statistics and the cursor to a buffer
+    //! (see Node::saveState()).
+    // ------------------------------------------------------------------------
+    void save(std::string& p_state) const
+    {
+        encoding::put(p_state, uint32_t(m_order.size()));
+        for (size_t i = 0u; i < m_order.size(); ++i)
+        {
+            Statistics const& stats = m_statistics[i];
+            encoding::put(p_state, uint32_t(m_order[i]));
+            encoding::put(p_state, uint64_t(stats.evaluations));
+            encoding::put(p_state, uint64_t(stats.successes));
+            encoding::put(p_state, stats.cost);
+            encoding::put(p_state, stats.pending_cost);
+        }
+        encoding::put(p_state, uint64_t(m_cursor));
+        encoding::put(p_state, uint64_t(m_evaluations));
+        encoding::put(p_state, uint64_t(m_revision));
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Read back the state appended by save().
+    //! \param[in,out] p_state The reader of the buffer.
+    //! \param[in] p_count The number of children of the composite.
+    //! \return False if the state is truncated or does not match the
+    //!         children.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool load(encoding::Reader& p_state, size_t p_count)
+    {
+        uint32_t size;
+        if (!p_state.get(size) || ((size != 0u) && (size != p_count)))
+        {
+            return false;
+        }
+
+        std::vector<size_t> order(size);
+        std::vector<Statistics> statistics(size);
+        for (size_t i = 0u; i < size; ++i)
+        {
+            uint32_t index;
+            uint64_t evaluations;
+            uint64_t successes;
+            if (!p_state.get(index) || (index >= size) ||
+                !p_state.get(evaluations) || !p_state.get(successes) ||
+                !p_state.get(statistics[i].cost) ||
+                !p_state.get(statistics[i].pending_cost))
+            {
+                return false;
+            }
+            order[i] = index;
+            statistics[i].evaluations = size_t(evaluations);
+            statistics[i].successes = size_t(successes);
+        }
+
+        uint64_t cursor;
+        uint64_t evaluations;
+        uint64_t revision;
+        if (!p_state.get(cursor) || (cursor > size) ||
+            !p_state.get(evaluations) || !p_state.get(revision))
+        {
+            return false;
+        }
+
+        m_order = std::move(order);
+        m_statistics = std::move(statistics);
+        m_cursor = size_t(cursor);
+        m_evaluations = size_t(evaluations);
+        m_revision = size_t(revision);
+        return true;
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Update the statistics of a child after it has been ticked.
+    // ------------------------------------------------------------------------
+    void record(size_t p_index, Status p_status, double p_cost)
+    {
+        Statistics& stats = m_statistics[p_index];
+        stats.pending_cost += p_cost;
+        if (p_status == Status::RUNNING)
+        {
+            return;
+        }
+
+        stats.cost = (stats.evaluations == 0u)
+                         ? stats.pending_cost
+                         : stats.cost + m_config.smoothing *
+                                            (stats.pending_cost - stats.cost);
+        stats.pending_cost = 0.0;
+        stats.evaluations++;
+        if (p_status == Status::SUCCESS)
+        {
+            stats.successes++;
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Sort children by increasing cost / P(decisive). Children never
+    //! evaluated come first so that they get sampled. Ties keep the YAML order.
+    // ------------------------------------------------------------------------
+    void reorder(Status p_decisive)
+    {
+        auto rank = [this, p_decisive](size_t p_index) {
+            Statistics const& stats = m_statistics[p_index];
+            if (stats.evaluations == 0u)
+            {
+                return 0.0;
+            }
+            double probability = stats.successProbability();
+            if (p_decisive == Status::FAILURE)
+            {
+                probability = 1.0 - probability;
+            }
+            return stats.cost / probability;
+        };
+
+        std::vector<size_t> order(m_order.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        std::stable_sort(
+            order.begin(), order.end(), [&rank](size_t p_a, size_t p_b) {
+                return rank(p_a) < rank(p_b);
+            });
+
+        if (order != m_order)
+        {
+            m_order = std::move(order);
+            m_revision++;
+        }
+    }
+
+private:
+
+    //! \brief Is the adaptive ordering enabled?
+    bool m_enabled = false;
+    //! \brief The ordering settings.
+    Config m_config;
+    //! \brief Indices of children in evaluation order.
+    std::vector<size_t> m_order;
+    //! \brief Per-child statistics (indexed as the children).
+    std::vector<Statistics> m_statistics;
+    //! \brief Position of the child being evaluated inside m_order.
+    size_t m_cursor = 0;
+    //! \brief Number of evaluations of the composite.
+    size_t m_evaluations = 0;
+    //! \brief Number of times the order has changed.
+    size_t m_revision = 0;
+};
+
+} // namespace bt
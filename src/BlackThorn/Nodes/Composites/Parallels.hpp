@@ -18,6 +18,10 @@ namespace bt {
 //! \brief The Parallel composite runs all children simultaneously.
 //! It requires a minimum number of successful or failed children to determine
 //! its own status.
+//! By default, the children still RUNNING when the outcome is decided are
+//! left as is (and resumed if the parallel is ticked again). With
+//! setHaltOnDecision(true), they are halted as soon as the outcome is decided
+//! (race semantics), freeing their resources early.
 // ****************************************************************************
 class Parallel final: public Composite
 {
@@ -60,6 +64,25 @@ public:
         return m_minFail;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Halt the children still RUNNING once the outcome is decided.
+    //! \param[in] p_enable True for race semantics, false (default) to leave
+    //! the running children untouched.
+    // ------------------------------------------------------------------------
+    void setHaltOnDecision(bool p_enable)
+    {
+        m_haltOnDecision = p_enable;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Are the running children halted once the outcome is decided?
+    //! \return The halt on decision flag.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool getHaltOnDecision() const
+    {
+        return m_haltOnDecision;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Run the parallel composite.
     //! \return The status of the parallel composite.
@@ -86,16 +109,21 @@ public:
 
         if (total_success >= m_minSuccess)
         {
-            return Status::SUCCESS;
+            return decide(Status::SUCCESS);
         }
         if (total_fail >= m_minFail)
         {
-            return Status::FAILURE;
+            return decide(Status::FAILURE);
         }
 
         return Status::RUNNING;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitParallel(*this);
@@ -105,15 +133,32 @@ public:
         p_visitor.visitParallel(*this);
     }
 
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Apply the halt on decision policy to the decided status.
+    // ------------------------------------------------------------------------
+    Status decide(Status p_status)
+    {
+        if (m_haltOnDecision)
+        {
+            haltRunningChildren();
+        }
+        return p_status;
+    }
+
 private:
 
     int m_minSuccess;
     int m_minFail;
+    bool m_haltOnDecision = false;
 };
 
 // ****************************************************************************
 //! \brief The ParallelAll composite runs all children simultaneously.
 //! It uses success/failure policies to determine its own status.
+//! Like Parallel, setHaltOnDecision(true) halts the children still RUNNING
+//! as soon as the outcome is decided.
 // ****************************************************************************
 class ParallelAll final: public Composite
 {
@@ -167,11 +212,11 @@ public:
 
         if (total_success >= minimumSuccess)
         {
-            return Status::SUCCESS;
+            return decide(Status::SUCCESS);
         }
         if (total_fail >= minimumFail)
         {
-            return Status::FAILURE;
+            return decide(Status::FAILURE);
         }
 
         return Status::RUNNING;
@@ -195,6 +240,30 @@ public:
         return m_failOnAll;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Halt the children still RUNNING once the outcome is decided.
+    //! \param[in] p_enable True for race semantics, false (default) to leave
+    //! the running children untouched.
+    // ------------------------------------------------------------------------
+    void setHaltOnDecision(bool p_enable)
+    {
+        m_haltOnDecision = p_enable;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Are the running children halted once the outcome is decided?
+    //! \return The halt on decision flag.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool getHaltOnDecision() const
+    {
+        return m_haltOnDecision;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitParallelAll(*this);
@@ -204,10 +273,25 @@ public:
         p_visitor.visitParallelAll(*this);
     }
 
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Apply the halt on decision policy to the decided status.
+    // ------------------------------------------------------------------------
+    Status decide(Status p_status)
+    {
+        if (m_haltOnDecision)
+        {
+            haltRunningChildren();
+        }
+        return p_status;
+    }
+
 private:
 
     bool m_successOnAll;
     bool m_failOnAll;
+    bool m_haltOnDecision = false;
 };
 
 } // namespace bt
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "BlackThorn/Core/Composite.hpp"
+#include "BlackThorn/Nodes/Composites/ChildOrdering.hpp"
 
 namespace bt {
 
@@ -32,6 +33,35 @@ public:
         return "Sequence";
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Declare the children as commutative (their order does not
+    //! matter) and let the sequence reorder them to minimize the expected cost
+    //! of an evaluation. See ChildOrdering.
+    //! \param[in] p_config The adaptive ordering settings.
+    // ------------------------------------------------------------------------
+    void setUnordered(ChildOrdering::Config const& p_config)
+    {
+        m_ordering.enable(p_config);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Are the children evaluated in an adaptive order?
+    //! \return True if setUnordered() has been called.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isUnordered() const
+    {
+        return m_ordering.isEnabled();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the adaptive ordering (current order and statistics).
+    //! \return The adaptive ordering.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] ChildOrdering const& getOrdering() const
+    {
+        return m_ordering;
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Set up the sequence.
     //! \return The status of the sequence.
@@ -39,6 +69,10 @@ public:
     [[nodiscard]] Status onSetUp() override
     {
         m_iterator = m_children.begin();
+        if (m_ordering.isEnabled())
+        {
+            m_ordering.begin(m_children.size(), Status::FAILURE);
+        }
         return Status::RUNNING;
     }
 
@@ -48,6 +82,11 @@ public:
     // ------------------------------------------------------------------------
     [[nodiscard]] Status onRunning() override
     {
+        if (m_ordering.isEnabled())
+        {
+            return m_ordering.tick(m_children, Status::SUCCESS);
+        }
+
         while (m_iterator != m_children.end())
         {
             if (auto status = (*m_iterator)->tick(); status != Status::SUCCESS)
@@ -61,6 +100,11 @@ public:
         return Status::SUCCESS;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     // ------------------------------------------------------------------------
     //! \brief Accept a visitor.
     // ------------------------------------------------------------------------
@@ -72,6 +116,33 @@ public:
     {
         p_visitor.visitSequence(*this);
     }
+
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the current child and the adaptive ordering.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        if (!Composite::onSaveState(p_state))
+        {
+            return false;
+        }
+        m_ordering.save(p_state);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the current child and the adaptive ordering.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        return Composite::onLoadState(p_state) &&
+               m_ordering.load(p_state, m_children.size());
+    }
+
+    //! \brief Adaptive order of children when unordered.
+    ChildOrdering m_ordering;
 };
 
 // ****************************************************************************
@@ -113,6 +184,11 @@ public:
         return Status::SUCCESS;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitReactiveSequence(*this);
@@ -163,6 +239,11 @@ public:
         return Status::SUCCESS;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitSequenceWithMemory(*this);
@@ -40,6 +40,11 @@ public:
         return (status == Status::RUNNING) ? Status::RUNNING : Status::SUCCESS;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitForceSuccess(*this);
@@ -77,6 +82,11 @@ public:
         return (status == Status::RUNNING) ? Status::RUNNING : Status::FAILURE;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitForceFailure(*this);
@@ -124,6 +134,11 @@ public:
         return s;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitInverter(*this);
@@ -197,6 +212,11 @@ public:
         m_cached_status = Status::INVALID;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitRunOnce(*this);
@@ -206,6 +226,26 @@ public:
         p_visitor.visitRunOnce(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save whether the child has completed and its status.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        encoding::put(p_state, m_executed);
+        encoding::put(p_state, m_cached_status);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore whether the child has completed and its status.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        return p_state.get(m_executed) && p_state.get(m_cached_status);
+    }
+
 private:
 
     bool m_executed = false;
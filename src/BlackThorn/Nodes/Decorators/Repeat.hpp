@@ -127,6 +127,11 @@ public:
         return m_repetitions;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitRepeater(*this);
@@ -136,6 +141,34 @@ public:
         p_visitor.visitRepeater(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the count and the limit of repetitions.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        encoding::put(p_state, uint64_t(m_count));
+        encoding::put(p_state, uint64_t(m_repetitions));
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the count and the limit of repetitions.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        uint64_t count;
+        uint64_t repetitions;
+        if (!p_state.get(count) || !p_state.get(repetitions))
+        {
+            return false;
+        }
+        m_count = size_t(count);
+        m_repetitions = size_t(repetitions);
+        return true;
+    }
+
 private:
 
     size_t m_count = 0;
@@ -235,6 +268,11 @@ public:
         return m_attempts;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitUntilSuccess(*this);
@@ -244,6 +282,31 @@ public:
         p_visitor.visitUntilSuccess(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the count of attempts.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        encoding::put(p_state, uint64_t(m_count));
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the count of attempts.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        uint64_t count;
+        if (!p_state.get(count))
+        {
+            return false;
+        }
+        m_count = size_t(count);
+        return true;
+    }
+
 private:
 
     size_t m_count = 0;
@@ -339,6 +402,11 @@ public:
         return m_attempts;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitUntilFailure(*this);
@@ -348,6 +416,31 @@ public:
         p_visitor.visitUntilFailure(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the count of attempts.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        encoding::put(p_state, uint64_t(m_count));
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the count of attempts.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        uint64_t count;
+        if (!p_state.get(count))
+        {
+            return false;
+        }
+        m_count = size_t(count);
+        return true;
+    }
+
 private:
 
     size_t m_count = 0;
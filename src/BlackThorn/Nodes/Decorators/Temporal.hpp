@@ -25,7 +25,6 @@ class Timeout final: public Decorator
 {
 public:
 
-    using Clock = std::chrono::steady_clock;
     using Duration = std::chrono::milliseconds;
 
     // ------------------------------------------------------------------------
@@ -78,7 +77,7 @@ public:
         {
             m_timeout = Duration(m_default_timeout);
         }
-        m_start_time = Clock::now();
+        m_start_time = now();
         return Status::RUNNING;
     }
 
@@ -89,7 +88,7 @@ public:
     [[nodiscard]] Status onRunning() override
     {
         auto elapsed =
-            std::chrono::duration_cast<Duration>(Clock::now() - m_start_time);
+            std::chrono::duration_cast<Duration>(now() - m_start_time);
 
         if (elapsed >= m_timeout)
         {
@@ -114,6 +113,11 @@ public:
         return static_cast<size_t>(m_timeout.count());
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitTimeout(*this);
@@ -123,11 +127,37 @@ public:
         p_visitor.visitTimeout(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the timeout and the time elapsed since the start.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        encoding::put(p_state, int64_t(m_timeout.count()));
+        saveTime(p_state, m_start_time);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the timeout and the start time.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        int64_t timeout;
+        if (!p_state.get(timeout) || !loadTime(p_state, m_start_time))
+        {
+            return false;
+        }
+        m_timeout = Duration(timeout);
+        return true;
+    }
+
 private:
 
     size_t m_default_timeout;
     Duration m_timeout;
-    Clock::time_point m_start_time;
+    Clock::TimePoint m_start_time;
 };
 
 // ****************************************************************************
@@ -139,16 +169,15 @@ class Delay final: public Decorator
 {
 public:
 
-    using Clock = std::chrono::steady_clock;
     using Duration = std::chrono::milliseconds;
 
     // ------------------------------------------------------------------------
     //! \brief Get the string representation of the node type.
-    //! \return The string "⏳ Delay".
+    //! \return The string "Delay".
     // ------------------------------------------------------------------------
     [[nodiscard]] static constexpr char const* toString()
     {
-        return "⏳ Delay";
+        return "Delay";
     }
 
     // ------------------------------------------------------------------------
@@ -166,7 +195,7 @@ public:
     // ------------------------------------------------------------------------
     [[nodiscard]] Status onSetUp() override
     {
-        m_start_time = Clock::now();
+        m_start_time = now();
         m_delay_passed = false;
         return Status::RUNNING;
     }
@@ -179,8 +208,8 @@ public:
     {
         if (!m_delay_passed)
         {
-            auto elapsed = std::chrono::duration_cast<Duration>(Clock::now() -
-                                                                m_start_time);
+            auto elapsed =
+                std::chrono::duration_cast<Duration>(now() - m_start_time);
 
             if (elapsed < m_delay)
             {
@@ -202,6 +231,11 @@ public:
         return static_cast<size_t>(m_delay.count());
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitDelay(*this);
@@ -211,10 +245,31 @@ public:
         p_visitor.visitDelay(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the time elapsed since the start.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        saveTime(p_state, m_start_time);
+        encoding::put(p_state, m_delay_passed);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the start time.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        return loadTime(p_state, m_start_time) &&
+               p_state.get(m_delay_passed);
+    }
+
 private:
 
     Duration m_delay;
-    Clock::time_point m_start_time;
+    Clock::TimePoint m_start_time;
     bool m_delay_passed = false;
 };
 
@@ -228,16 +283,15 @@ class Cooldown final: public Decorator
 {
 public:
 
-    using Clock = std::chrono::steady_clock;
     using Duration = std::chrono::milliseconds;
 
     // ------------------------------------------------------------------------
     //! \brief Get the string representation of the node type.
-    //! \return The string "❄️ Cooldown".
+    //! \return The string "Cooldown".
     // ------------------------------------------------------------------------
     [[nodiscard]] static constexpr char const* toString()
     {
-        return "❄️ Cooldown";
+        return "Cooldown";
     }
 
     // ------------------------------------------------------------------------
@@ -259,7 +313,7 @@ public:
         if (m_in_cooldown)
         {
             auto elapsed = std::chrono::duration_cast<Duration>(
-                Clock::now() - m_cooldown_start);
+                now() - m_cooldown_start);
 
             if (elapsed < m_cooldown)
             {
@@ -281,7 +335,7 @@ public:
         if (status != Status::RUNNING)
         {
             // Child finished, start cooldown
-            m_cooldown_start = Clock::now();
+            m_cooldown_start = now();
             m_in_cooldown = true;
         }
 
@@ -297,6 +351,11 @@ public:
         return static_cast<size_t>(m_cooldown.count());
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return cloneAs(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitCooldown(*this);
@@ -306,10 +365,31 @@ public:
         p_visitor.visitCooldown(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the time elapsed since the start of the cooldown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        saveTime(p_state, m_cooldown_start);
+        encoding::put(p_state, m_in_cooldown);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the start of the cooldown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        return loadTime(p_state, m_cooldown_start) &&
+               p_state.get(m_in_cooldown);
+    }
+
 private:
 
     Duration m_cooldown;
-    Clock::time_point m_cooldown_start;
+    Clock::TimePoint m_cooldown_start;
     bool m_in_cooldown = false;
 };
 
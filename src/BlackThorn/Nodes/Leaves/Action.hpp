@@ -101,6 +101,11 @@ public:
         return m_func != nullptr;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<SugarAction>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitSugarAction(*this);
@@ -37,6 +37,11 @@ public:
         return Status::SUCCESS;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<Success>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitSuccess(*this);
@@ -72,6 +77,11 @@ public:
         return Status::FAILURE;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<Failure>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitFailure(*this);
@@ -0,0 +1,185 @@
+/**
+ * @file BatchedServiceCall.hpp
+ * @brief BatchedServiceCall leaf node.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Leaf.hpp"
+#include "BlackThorn/Executor/BatchedServices.hpp"
+
+#include <string>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief The BatchedServiceCall leaf calls a service shared by many trees
+//! (see BatchedServices): its setup enqueues the request read from the
+//! blackboard into the pending batch of the service, then the leaf stays
+//! RUNNING until the batch is served. The response is shared with the
+//! blackboard without copy. Returns SUCCESS, or FAILURE if the service is
+//! unknown, the request key is missing or the response is empty.
+//! Halting the leaf withdraws its request if not yet served.
+// ****************************************************************************
+class BatchedServiceCall final: public Leaf
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the string representation of the node type.
+    //! \return The string "BatchedServiceCall".
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static constexpr char const* toString()
+    {
+        return "BatchedServiceCall";
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_services The registry of batched services.
+    //! \param[in] p_service The name of the service.
+    //! \param[in] p_request The blackboard key of the request (an empty
+    //!            request is sent when empty).
+    //! \param[in] p_response The blackboard key receiving the response (the
+    //!            name of the service when empty).
+    // ------------------------------------------------------------------------
+    BatchedServiceCall(BatchedServices::Ptr p_services,
+                       std::string p_service,
+                       std::string p_request = {},
+                       std::string p_response = {})
+        : m_services(std::move(p_services)),
+          m_service(std::move(p_service)),
+          m_request(std::move(p_request)),
+          m_response(p_response.empty() ? m_service : std::move(p_response))
+    {
+        m_type = toString();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Enqueue the request into the pending batch of the service.
+    //! \return RUNNING, or FAILURE if the request cannot be sent.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Status onSetUp() override
+    {
+        Blackboard::Value request;
+        if (!m_request.empty())
+        {
+            Blackboard::Value const* value =
+                m_blackboard ? m_blackboard->lookup(m_request) : nullptr;
+            if (value == nullptr)
+            {
+                return Status::FAILURE;
+            }
+            request = *value;
+        }
+
+        m_call = m_services->enqueue(m_service, std::move(request));
+        return (m_call == nullptr) ? Status::FAILURE : Status::RUNNING;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Wait for the batch to be served and store the response in the
+    //! blackboard.
+    //! \return RUNNING until served, then SUCCESS, or FAILURE if the response
+    //!         is empty.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Status onRunning() override
+    {
+        if (!m_call->ready())
+        {
+            return Status::RUNNING;
+        }
+
+        BatchedServices::Call::Ptr call = std::move(m_call);
+        if (!call->response().has_value())
+        {
+            return Status::FAILURE;
+        }
+        if (m_blackboard)
+        {
+            m_blackboard->share(m_response,
+                                BatchedServices::Call::share(std::move(call)));
+        }
+        return Status::SUCCESS;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if the service is registered.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_services != nullptr) && m_services->has(m_service);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the name of the service.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& getService() const
+    {
+        return m_service;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the blackboard key of the request.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& getRequest() const
+    {
+        return m_request;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the blackboard key receiving the response.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& getResponse() const
+    {
+        return m_response;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<BatchedServiceCall>(*this);
+    }
+
+    void accept(ConstBehaviorTreeVisitor& p_visitor) const override
+    {
+        p_visitor.visitBatchedServiceCall(*this);
+    }
+    void accept(BehaviorTreeVisitor& p_visitor) override
+    {
+        p_visitor.visitBatchedServiceCall(*this);
+    }
+
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Withdraw the request if not yet served.
+    // ------------------------------------------------------------------------
+    void onHalt() override
+    {
+        // The request is withdrawn if no clone of the leaf waits for it
+        m_call.reset();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief A request waiting in the batch of this process cannot follow
+    //! the tree.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string&) const override
+    {
+        return m_call == nullptr;
+    }
+
+private:
+
+    BatchedServices::Ptr m_services;
+    std::string m_service;
+    std::string m_request;
+    std::string m_response;
+    //! \brief Pending request, shared by the clones of a running leaf.
+    BatchedServices::Call::Ptr m_call;
+};
+
+} // namespace bt
@@ -76,6 +76,11 @@ public:
         return m_func != nullptr;
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<Condition>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitCondition(*this);
@@ -0,0 +1,498 @@
+/**
+ * @file IO.cpp
+ * @brief Implementation of the I/O-bound action leaves woken by the Reactor.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Nodes/Leaves/IO.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+
+extern char** environ;
+
+namespace bt {
+
+// ----------------------------------------------------------------------------
+//! \brief Switch a file descriptor to non-blocking mode.
+// ----------------------------------------------------------------------------
+static bool setNonBlocking(int p_fd)
+{
+    int flags = ::fcntl(p_fd, F_GETFL, 0);
+    return (flags >= 0) && (::fcntl(p_fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Result of reading all available bytes of a non-blocking fd.
+// ----------------------------------------------------------------------------
+enum class ReadResult
+{
+    WouldBlock, //!< No more bytes for now.
+    EndOfFile,  //!< The writer closed its end.
+    Error       //!< read() failed.
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Append all available bytes of a non-blocking fd to a buffer.
+// ----------------------------------------------------------------------------
+static ReadResult readAvailable(int p_fd, std::string& p_buffer)
+{
+    char chunk[4096];
+    for (;;)
+    {
+        ssize_t count = ::read(p_fd, chunk, sizeof(chunk));
+        if (count > 0)
+        {
+            p_buffer.append(chunk, size_t(count));
+        }
+        else if (count == 0)
+        {
+            return ReadResult::EndOfFile;
+        }
+        else if (errno == EINTR)
+        {
+            continue;
+        }
+        else if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            return ReadResult::WouldBlock;
+        }
+        else
+        {
+            return ReadResult::Error;
+        }
+    }
+}
+
+// ============================================================================
+// ReadLine
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+ReadLine::ReadLine(Reactor::Ptr p_reactor, int p_fd)
+    : m_reactor(std::move(p_reactor)), m_fd(p_fd)
+{
+    m_type = "ReadLine";
+}
+
+// ----------------------------------------------------------------------------
+ReadLine::~ReadLine()
+{
+    if (m_reactor)
+    {
+        m_reactor->remove(m_fd);
+    }
+}
+
+// ----------------------------------------------------------------------------
+PortList ReadLine::providedPorts() const
+{
+    PortList ports;
+    ports.addOutput<std::string>("line");
+    return ports;
+}
+
+// ----------------------------------------------------------------------------
+bool ReadLine::extractLine()
+{
+    size_t eol = m_buffer.find('\n');
+    if (eol == std::string::npos)
+    {
+        return false;
+    }
+    m_line.assign(m_buffer, 0, eol);
+    m_buffer.erase(0, eol + 1u);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+Status ReadLine::onSetUp()
+{
+    if (!setNonBlocking(m_fd))
+    {
+        return Status::FAILURE;
+    }
+    if (!m_reactor->add(m_fd, EPOLLIN, [this](uint32_t) { m_ready = true; }))
+    {
+        return Status::FAILURE;
+    }
+
+    // Bytes may already be pending: try a first read without waiting for the
+    // reactor.
+    m_ready = true;
+    return Status::RUNNING;
+}
+
+// ----------------------------------------------------------------------------
+Status ReadLine::onRunning()
+{
+    if (extractLine())
+    {
+        setOutput("line", m_line);
+        return Status::SUCCESS;
+    }
+    if (!m_ready)
+    {
+        return Status::RUNNING;
+    }
+
+    m_ready = false;
+    ReadResult result = readAvailable(m_fd, m_buffer);
+    if (extractLine())
+    {
+        setOutput("line", m_line);
+        return Status::SUCCESS;
+    }
+    if (result == ReadResult::Error)
+    {
+        return Status::FAILURE;
+    }
+    if (result == ReadResult::EndOfFile)
+    {
+        // Last line without trailing '\n'
+        if (m_buffer.empty())
+        {
+            return Status::FAILURE;
+        }
+        m_line = std::move(m_buffer);
+        m_buffer.clear();
+        setOutput("line", m_line);
+        return Status::SUCCESS;
+    }
+    return Status::RUNNING;
+}
+
+// ----------------------------------------------------------------------------
+void ReadLine::onTearDown(Status)
+{
+    m_reactor->remove(m_fd);
+}
+
+// ----------------------------------------------------------------------------
+void ReadLine::onHalt()
+{
+    m_reactor->remove(m_fd);
+}
+
+// ----------------------------------------------------------------------------
+bool ReadLine::onSaveState(std::string&) const
+{
+    // The bytes read belong to a descriptor of this process
+    return (m_status != Status::RUNNING) && m_buffer.empty();
+}
+
+// ============================================================================
+// SpawnProcess
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+SpawnProcess::SpawnProcess(Reactor::Ptr p_reactor, std::string p_command)
+    : m_reactor(std::move(p_reactor)), m_command(std::move(p_command))
+{
+    m_type = "SpawnProcess";
+}
+
+// ----------------------------------------------------------------------------
+SpawnProcess::~SpawnProcess()
+{
+    onHalt();
+}
+
+// ----------------------------------------------------------------------------
+PortList SpawnProcess::providedPorts() const
+{
+    PortList ports;
+    ports.addOutput<std::string>("output");
+    ports.addOutput<int>("exit_code");
+    return ports;
+}
+
+// ----------------------------------------------------------------------------
+Status SpawnProcess::onSetUp()
+{
+    m_output.clear();
+    m_exit_code = -1;
+    m_pipe_ready = false;
+    m_pipe_closed = false;
+    m_exited = false;
+
+    int fds[2];
+    if (::pipe2(fds, O_CLOEXEC | O_NONBLOCK) != 0)
+    {
+        return Status::FAILURE;
+    }
+
+    // The child writes its standard output into the pipe. Its end of the pipe
+    // is blocking as expected by most programs.
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+    ::fcntl(fds[1], F_SETFL, 0);
+
+    char const* argv[] = {"sh", "-c", m_command.c_str(), nullptr};
+    int error = ::posix_spawn(&m_pid,
+                              "/bin/sh",
+                              &actions,
+                              nullptr,
+                              const_cast<char* const*>(argv),
+                              environ);
+    posix_spawn_file_actions_destroy(&actions);
+    ::close(fds[1]);
+    if (error != 0)
+    {
+        ::close(fds[0]);
+        m_pid = -1;
+        return Status::FAILURE;
+    }
+
+    m_pipe = fds[0];
+    m_reactor->add(m_pipe, EPOLLIN, [this](uint32_t) { m_pipe_ready = true; });
+
+    // Watch the process exit. Without pidfd (Linux < 5.3) the process is
+    // reaped by polling once its standard output is closed.
+#ifdef SYS_pidfd_open
+    m_pidfd = int(::syscall(SYS_pidfd_open, m_pid, 0));
+    if (m_pidfd >= 0)
+    {
+        m_reactor->add(m_pidfd, EPOLLIN, [this](uint32_t) { reap(false); });
+    }
+#endif
+
+    m_pipe_ready = true;
+    return Status::RUNNING;
+}
+
+// ----------------------------------------------------------------------------
+bool SpawnProcess::drainPipe()
+{
+    if (readAvailable(m_pipe, m_output) == ReadResult::WouldBlock)
+    {
+        return true;
+    }
+
+    m_reactor->remove(m_pipe);
+    ::close(m_pipe);
+    m_pipe = -1;
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+bool SpawnProcess::reap(bool p_block)
+{
+    if (m_exited)
+    {
+        return true;
+    }
+
+    int status = 0;
+    pid_t pid = ::waitpid(m_pid, &status, p_block ? 0 : WNOHANG);
+    if (pid != m_pid)
+    {
+        return false;
+    }
+
+    m_exited = true;
+    m_pid = -1;
+    m_exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+Status SpawnProcess::onRunning()
+{
+    if (m_pipe_ready && !m_pipe_closed)
+    {
+        m_pipe_ready = false;
+        m_pipe_closed = !drainPipe();
+    }
+
+    // Once the output is closed, the process has exited or is about to: poll
+    // when no pidfd can wake us.
+    if (m_pipe_closed && (m_pidfd < 0))
+    {
+        reap(false);
+    }
+
+    if (!m_pipe_closed || !m_exited)
+    {
+        return Status::RUNNING;
+    }
+
+    closeAll();
+    setOutput("output", m_output);
+    setOutput("exit_code", m_exit_code);
+    return (m_exit_code == 0) ? Status::SUCCESS : Status::FAILURE;
+}
+
+// ----------------------------------------------------------------------------
+void SpawnProcess::closeAll()
+{
+    if (m_pipe >= 0)
+    {
+        m_reactor->remove(m_pipe);
+        ::close(m_pipe);
+        m_pipe = -1;
+    }
+    if (m_pidfd >= 0)
+    {
+        m_reactor->remove(m_pidfd);
+        ::close(m_pidfd);
+        m_pidfd = -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void SpawnProcess::onHalt()
+{
+    if ((m_pid > 0) && !m_exited)
+    {
+        ::kill(m_pid, SIGKILL);
+        reap(true);
+        m_exit_code = -1;
+    }
+    closeAll();
+}
+
+// ----------------------------------------------------------------------------
+bool SpawnProcess::onSaveState(std::string&) const
+{
+    // A running child process cannot follow the tree
+    return m_status != Status::RUNNING;
+}
+
+// ============================================================================
+// ConnectSocket
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+ConnectSocket::ConnectSocket(Reactor::Ptr p_reactor,
+                             std::string p_host,
+                             uint16_t p_port)
+    : m_reactor(std::move(p_reactor)), m_host(std::move(p_host)), m_port(p_port)
+{
+    m_type = "ConnectSocket";
+}
+
+// ----------------------------------------------------------------------------
+ConnectSocket::~ConnectSocket()
+{
+    abort();
+}
+
+// ----------------------------------------------------------------------------
+PortList ConnectSocket::providedPorts() const
+{
+    PortList ports;
+    ports.addOutput<int>("socket");
+    return ports;
+}
+
+// ----------------------------------------------------------------------------
+void ConnectSocket::abort()
+{
+    if (m_pending >= 0)
+    {
+        m_reactor->remove(m_pending);
+        ::close(m_pending);
+        m_pending = -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+Status ConnectSocket::onSetUp()
+{
+    m_connected = -1;
+    m_ready = false;
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    std::string service = std::to_string(m_port);
+    if (::getaddrinfo(m_host.c_str(), service.c_str(), &hints, &addresses) !=
+        0)
+    {
+        return Status::FAILURE;
+    }
+
+    // Only the first address is tried
+    m_pending = ::socket(addresses->ai_family,
+                         addresses->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                         addresses->ai_protocol);
+    int result = (m_pending < 0) ? -1
+                                 : ::connect(m_pending,
+                                             addresses->ai_addr,
+                                             addresses->ai_addrlen);
+    int connect_errno = errno;
+    ::freeaddrinfo(addresses);
+
+    if (m_pending < 0)
+    {
+        return Status::FAILURE;
+    }
+    if ((result != 0) && (connect_errno != EINPROGRESS))
+    {
+        abort();
+        return Status::FAILURE;
+    }
+
+    // Connected immediately (i.e. loopback) or when the socket is writable
+    m_ready = (result == 0);
+    if (!m_ready &&
+        !m_reactor->add(
+            m_pending, EPOLLOUT, [this](uint32_t) { m_ready = true; }))
+    {
+        abort();
+        return Status::FAILURE;
+    }
+    return Status::RUNNING;
+}
+
+// ----------------------------------------------------------------------------
+Status ConnectSocket::onRunning()
+{
+    if (!m_ready)
+    {
+        return Status::RUNNING;
+    }
+
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if ((::getsockopt(m_pending, SOL_SOCKET, SO_ERROR, &error, &length) != 0) ||
+        (error != 0))
+    {
+        abort();
+        return Status::FAILURE;
+    }
+
+    m_reactor->remove(m_pending);
+    m_connected = m_pending;
+    m_pending = -1;
+    setOutput("socket", m_connected);
+    return Status::SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+void ConnectSocket::onHalt()
+{
+    abort();
+}
+
+// ----------------------------------------------------------------------------
+bool ConnectSocket::onSaveState(std::string&) const
+{
+    // A pending connection cannot follow the tree
+    return m_status != Status::RUNNING;
+}
+
+} // namespace bt
@@ -0,0 +1,259 @@
+/**
+ * @file IO.hpp
+ * @brief I/O-bound action leaves woken by the Reactor: ReadLine,
+ * SpawnProcess, ConnectSocket.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Common/Reactor.hpp"
+#include "BlackThorn/Nodes/Leaves/Action.hpp"
+
+#include <sys/types.h>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Read one line ('\n' excluded) from a file descriptor (pipe, socket,
+//! tty ...) without blocking the tick. The leaf returns RUNNING until a
+//! complete line is available. Bytes following the line are kept for the next
+//! run. The file descriptor is not owned and is switched to non-blocking mode.
+//!
+//! Output port: "line" (std::string).
+//! Returns FAILURE on read error, or on end of file with no pending bytes.
+// ****************************************************************************
+class ReadLine final: public Action
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_reactor The reactor waking the leaf.
+    //! \param[in] p_fd The file descriptor to read from.
+    // ------------------------------------------------------------------------
+    ReadLine(Reactor::Ptr p_reactor, int p_fd);
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - unregisters the file descriptor.
+    // ------------------------------------------------------------------------
+    ~ReadLine() override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the ports provided by the node.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] PortList providedPorts() const override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the last line read.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& line() const
+    {
+        return m_line;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a reactor is attached.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_reactor != nullptr) && (m_fd >= 0);
+    }
+
+protected:
+
+    [[nodiscard]] Status onSetUp() override;
+    [[nodiscard]] Status onRunning() override;
+    void onTearDown(Status p_status) override;
+    void onHalt() override;
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override;
+
+private:
+
+    //! \brief Move the first line of the buffer to m_line if any.
+    bool extractLine();
+
+private:
+
+    Reactor::Ptr m_reactor;
+    int m_fd;
+    //! \brief Set by the reactor when the fd is readable.
+    bool m_ready = false;
+    //! \brief Bytes read but not yet consumed.
+    std::string m_buffer;
+    //! \brief The last line read.
+    std::string m_line;
+};
+
+// ****************************************************************************
+//! \brief Run a shell command in a subprocess and wait for its completion
+//! without blocking the tick. The standard output of the process is captured
+//! through a pipe and the process exit is watched with a pidfd (both are
+//! registered with the reactor).
+//!
+//! Output ports: "output" (std::string, the captured standard output) and
+//! "exit_code" (int).
+//! Returns SUCCESS if the process exited with code 0, else FAILURE. A halted
+//! leaf kills its process.
+// ****************************************************************************
+class SpawnProcess final: public Action
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_reactor The reactor waking the leaf.
+    //! \param[in] p_command The command given to "/bin/sh -c".
+    // ------------------------------------------------------------------------
+    SpawnProcess(Reactor::Ptr p_reactor, std::string p_command);
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - kills the process if still running.
+    // ------------------------------------------------------------------------
+    ~SpawnProcess() override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the ports provided by the node.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] PortList providedPorts() const override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the command run by the leaf.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& command() const
+    {
+        return m_command;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the standard output of the last process.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& output() const
+    {
+        return m_output;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the exit code of the last process (-1 if killed or not
+    //! started).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] int exitCode() const
+    {
+        return m_exit_code;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a reactor is attached.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_reactor != nullptr) && !m_command.empty();
+    }
+
+protected:
+
+    [[nodiscard]] Status onSetUp() override;
+    [[nodiscard]] Status onRunning() override;
+    void onHalt() override;
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override;
+
+private:
+
+    //! \brief Read the available bytes of the pipe. Return false on EOF.
+    bool drainPipe();
+    //! \brief Reap the process if it has exited. Return true when reaped.
+    bool reap(bool p_block);
+    //! \brief Unregister and close the pipe and the pidfd.
+    void closeAll();
+
+private:
+
+    Reactor::Ptr m_reactor;
+    std::string m_command;
+    pid_t m_pid = -1;
+    int m_pipe = -1;
+    int m_pidfd = -1;
+    bool m_pipe_ready = false;
+    bool m_pipe_closed = false;
+    bool m_exited = false;
+    std::string m_output;
+    int m_exit_code = -1;
+};
+
+// ****************************************************************************
+//! \brief Open a TCP connection without blocking the tick: the socket is
+//! created non-blocking and the leaf is woken when the connection is
+//! established or refused.
+//!
+//! Output port: "socket" (int, the connected file descriptor). The ownership
+//! of the socket is transferred to the user who shall close it.
+//! Returns FAILURE if the address cannot be resolved or the connection fails.
+//! \note The host shall preferably be a numeric address: name resolution is
+//! done with the blocking getaddrinfo().
+// ****************************************************************************
+class ConnectSocket final: public Action
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_reactor The reactor waking the leaf.
+    //! \param[in] p_host The server address.
+    //! \param[in] p_port The server port.
+    // ------------------------------------------------------------------------
+    ConnectSocket(Reactor::Ptr p_reactor, std::string p_host, uint16_t p_port);
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - closes a pending connection.
+    // ------------------------------------------------------------------------
+    ~ConnectSocket() override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the ports provided by the node.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] PortList providedPorts() const override;
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the last connected socket (-1 if none). The leaf does not
+    //! own it.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] int socket() const
+    {
+        return m_connected;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a reactor is attached.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_reactor != nullptr) && !m_host.empty();
+    }
+
+protected:
+
+    [[nodiscard]] Status onSetUp() override;
+    [[nodiscard]] Status onRunning() override;
+    void onHalt() override;
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override;
+
+private:
+
+    //! \brief Unregister and close the pending socket.
+    void abort();
+
+private:
+
+    Reactor::Ptr m_reactor;
+    std::string m_host;
+    uint16_t m_port;
+    //! \brief Socket being connected.
+    int m_pending = -1;
+    //! \brief Last connected socket, owned by the user.
+    int m_connected = -1;
+    bool m_ready = false;
+};
+
+} // namespace bt
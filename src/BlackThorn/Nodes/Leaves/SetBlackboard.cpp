@@ -0,0 +1,431 @@
+/**
+ * @file SetBlackboard.cpp
+ * @brief Implementation of the SetBlackboard leaf: build-time parsing of the
+ * value and tick-time evaluation.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "BlackThorn/Nodes/Leaves/SetBlackboard.hpp"
+
+#include "BlackThorn/Common/Literal.hpp"
+
+#include <sstream>
+
+namespace bt {
+
+// ----------------------------------------------------------------------------
+//! \brief Extract the key of a "${key}" reference.
+// ----------------------------------------------------------------------------
+static bool parseReference(std::string const& p_text, std::string& p_key)
+{
+    if ((p_text.size() < 4u) || (p_text.compare(0, 2, "${") != 0) ||
+        (p_text.back() != '}'))
+    {
+        return false;
+    }
+    p_key = p_text.substr(2, p_text.size() - 3u);
+    return !p_key.empty() && (p_key.find_first_of("${}") == std::string::npos);
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::parseType(std::string const& p_name, Type& p_type)
+{
+    for (Type type :
+         {Type::Auto, Type::Int, Type::Double, Type::Bool, Type::String})
+    {
+        if (p_name == toString(type))
+        {
+            p_type = type;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ----------------------------------------------------------------------------
+SetBlackboard::SetBlackboard(std::string p_key,
+                             std::string p_value,
+                             Type p_type)
+    : m_key(std::move(p_key)), m_value(std::move(p_value)), m_value_type(p_type)
+{
+    m_type = toString();
+    parse();
+}
+
+// ----------------------------------------------------------------------------
+SetBlackboard::SetBlackboard(std::string p_key,
+                             std::string p_value,
+                             Blackboard::Ptr p_blackboard)
+    : SetBlackboard(std::move(p_key), std::move(p_value), Type::Auto)
+{
+    setBlackboard(p_blackboard);
+}
+
+// ----------------------------------------------------------------------------
+SetBlackboard::SetBlackboard(std::string p_key,
+                             std::string p_value,
+                             Type p_type,
+                             Blackboard::Ptr p_blackboard)
+    : SetBlackboard(std::move(p_key), std::move(p_value), p_type)
+{
+    setBlackboard(p_blackboard);
+}
+
+// ----------------------------------------------------------------------------
+void SetBlackboard::parse()
+{
+    if (parseReference(m_value, m_source))
+    {
+        m_kind = Kind::Copy;
+        m_valid = true;
+    }
+    else if ((m_value_type != Type::String) && parseExpression(m_value))
+    {
+        m_kind = Kind::Expression;
+        m_valid = true;
+    }
+    else
+    {
+        m_kind = Kind::Literal;
+        m_valid = parseLiteral(m_value);
+    }
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::parseLiteral(std::string const& p_text)
+{
+    switch (m_value_type)
+    {
+        case Type::Int:
+            m_resolved = Type::Int;
+            return literal::parseInt(p_text, m_int);
+        case Type::Double:
+            m_resolved = Type::Double;
+            return literal::parseDouble(p_text, m_double);
+        case Type::Bool:
+            m_resolved = Type::Bool;
+            if (p_text == "1" || p_text == "0")
+            {
+                m_bool = (p_text == "1");
+                return true;
+            }
+            return literal::parseBool(p_text, m_bool);
+        case Type::String:
+            break;
+        case Type::Auto:
+        {
+            literal::Scalar const scalar = literal::classify(p_text);
+            switch (scalar.type)
+            {
+                case literal::Scalar::Type::Int:
+                    m_resolved = Type::Int;
+                    m_int = scalar.integer;
+                    return true;
+                case literal::Scalar::Type::Double:
+                    m_resolved = Type::Double;
+                    m_double = scalar.real;
+                    return true;
+                case literal::Scalar::Type::Bool:
+                    m_resolved = Type::Bool;
+                    m_bool = scalar.boolean;
+                    return true;
+                case literal::Scalar::Type::String:
+                    break;
+            }
+            break;
+        }
+    }
+
+    m_resolved = Type::String;
+    m_string = p_text;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::parseExpression(std::string const& p_text)
+{
+    std::istringstream stream(p_text);
+    std::string token;
+    std::vector<Operand> operands;
+    std::vector<char> operators;
+
+    for (size_t i = 0; stream >> token; ++i)
+    {
+        if (i % 2u == 1u)
+        {
+            if ((token.size() != 1u) ||
+                (std::string("+-*/").find(token[0]) == std::string::npos))
+            {
+                return false;
+            }
+            operators.push_back(token[0]);
+            continue;
+        }
+
+        Operand operand;
+        if (!parseReference(token, operand.key))
+        {
+            if (literal::parseInt(token, operand.constant.integer))
+            {
+                operand.constant.is_integer = true;
+            }
+            else if (literal::parseDouble(token, operand.constant.real))
+            {
+                operand.constant.is_integer = false;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        operands.push_back(std::move(operand));
+    }
+
+    // At least one operator and no dangling one
+    if (operators.empty() || (operands.size() != operators.size() + 1u))
+    {
+        return false;
+    }
+
+    m_operands = std::move(operands);
+    m_operators = std::move(operators);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+Status SetBlackboard::onRunning()
+{
+    if (!m_blackboard)
+    {
+        return Status::SUCCESS;
+    }
+
+    switch (m_kind)
+    {
+        case Kind::Copy:
+            return copy() ? Status::SUCCESS : Status::FAILURE;
+        case Kind::Expression:
+            return evaluate() ? Status::SUCCESS : Status::FAILURE;
+        case Kind::Literal:
+            break;
+    }
+
+    switch (m_resolved)
+    {
+        case Type::Int:
+            m_blackboard->set(m_key, m_int);
+            break;
+        case Type::Double:
+            m_blackboard->set(m_key, m_double);
+            break;
+        case Type::Bool:
+            m_blackboard->set(m_key, m_bool);
+            break;
+        default:
+            m_blackboard->set(m_key, m_string);
+            break;
+    }
+    return Status::SUCCESS;
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::copy()
+{
+    if (m_source == m_key)
+    {
+        return m_blackboard->has(m_key);
+    }
+
+    // Blackboard values are reference counted: the pointer stays valid while
+    // m_key is written, even if the blackboard detaches from a fork.
+    Blackboard::Value const* source = m_blackboard->lookup(m_source);
+    if (source == nullptr)
+    {
+        return false;
+    }
+
+    if (auto const* i = std::any_cast<int>(source))
+    {
+        m_blackboard->set(m_key, *i);
+    }
+    else if (auto const* d = std::any_cast<double>(source))
+    {
+        m_blackboard->set(m_key, *d);
+    }
+    else if (auto const* b = std::any_cast<bool>(source))
+    {
+        m_blackboard->set(m_key, *b);
+    }
+    else if (auto const* s = std::any_cast<std::string>(source))
+    {
+        m_blackboard->set(m_key, *s);
+    }
+    else
+    {
+        m_blackboard->setRaw(m_key, *source);
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::read(Operand const& p_operand, Number& p_number) const
+{
+    if (p_operand.key.empty())
+    {
+        p_number = p_operand.constant;
+        return true;
+    }
+
+    Blackboard::Value const* value = m_blackboard->lookup(p_operand.key);
+    if (value == nullptr)
+    {
+        return false;
+    }
+    if (auto const* i = std::any_cast<int>(value))
+    {
+        p_number.is_integer = true;
+        p_number.integer = *i;
+    }
+    else if (auto const* d = std::any_cast<double>(value))
+    {
+        p_number.is_integer = false;
+        p_number.real = *d;
+    }
+    else if (auto const* b = std::any_cast<bool>(value))
+    {
+        p_number.is_integer = true;
+        p_number.integer = *b ? 1 : 0;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::apply(char p_operator, Number& p_lhs, Number const& p_rhs)
+{
+    if (p_lhs.is_integer && p_rhs.is_integer)
+    {
+        switch (p_operator)
+        {
+            case '+':
+                p_lhs.integer += p_rhs.integer;
+                return true;
+            case '-':
+                p_lhs.integer -= p_rhs.integer;
+                return true;
+            case '*':
+                p_lhs.integer *= p_rhs.integer;
+                return true;
+            default:
+                if (p_rhs.integer == 0)
+                {
+                    return false;
+                }
+                p_lhs.integer /= p_rhs.integer;
+                return true;
+        }
+    }
+
+    double lhs = p_lhs.asDouble();
+    double rhs = p_rhs.asDouble();
+    p_lhs.is_integer = false;
+    switch (p_operator)
+    {
+        case '+':
+            p_lhs.real = lhs + rhs;
+            break;
+        case '-':
+            p_lhs.real = lhs - rhs;
+            break;
+        case '*':
+            p_lhs.real = lhs * rhs;
+            break;
+        default:
+            p_lhs.real = lhs / rhs;
+            break;
+    }
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+bool SetBlackboard::evaluate()
+{
+    // Two accumulators give * and / precedence over + and -.
+    Number sum;
+    Number term;
+    char pending = '+';
+
+    if (!read(m_operands[0], term))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < m_operators.size(); ++i)
+    {
+        Number rhs;
+        if (!read(m_operands[i + 1u], rhs))
+        {
+            return false;
+        }
+
+        char op = m_operators[i];
+        if ((op == '*') || (op == '/'))
+        {
+            if (!apply(op, term, rhs))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if (!apply(pending, sum, term))
+            {
+                return false;
+            }
+            pending = op;
+            term = rhs;
+        }
+    }
+    if (!apply(pending, sum, term))
+    {
+        return false;
+    }
+
+    write(sum);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+void SetBlackboard::write(Number const& p_number)
+{
+    switch (m_value_type)
+    {
+        case Type::Int:
+            m_blackboard->set(m_key,
+                              p_number.is_integer ? p_number.integer
+                                                  : int(p_number.real));
+            break;
+        case Type::Double:
+            m_blackboard->set(m_key, p_number.asDouble());
+            break;
+        case Type::Bool:
+            m_blackboard->set(m_key, p_number.asDouble() != 0.0);
+            break;
+        default:
+            if (p_number.is_integer)
+            {
+                m_blackboard->set(m_key, p_number.integer);
+            }
+            else
+            {
+                m_blackboard->set(m_key, p_number.real);
+            }
+            break;
+    }
+}
+
+} // namespace bt
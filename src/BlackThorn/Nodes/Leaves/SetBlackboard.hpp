@@ -11,6 +11,7 @@
 #include "BlackThorn/Core/Leaf.hpp"
 
 #include <string>
+#include <vector>
 
 namespace bt {
 
@@ -18,11 +19,53 @@ namespace bt {
 //! \brief The SetBlackboard leaf writes a value to the blackboard and
 //! returns SUCCESS. This is useful for setting state variables during
 //! tree execution.
+//!
+//! The value text is parsed once, when the leaf is constructed, into one of:
+//! - a typed literal (int, double, bool or std::string): "42", "3.5", "true",
+//!   "hello", with the grammar of literal::classify() shared with the YAML
+//!   blackboard loader;
+//! - a copy of another blackboard entry, keeping its type: "${other}";
+//! - a simple arithmetic expression whose operands are numbers or
+//!   blackboard entries, separated from the + - * / operators by spaces:
+//!   "${counter} + 1", "${speed} * 0.5 - ${offset}". The usual precedence
+//!   applies (no parentheses). Integer operands give an integer result
+//!   (integer division), otherwise a double.
+//!
+//! Ticking the leaf therefore never parses text, and assigns the value in
+//! place when the key already holds the same type (no allocation).
+//! The tick returns FAILURE if a referenced entry is missing or not
+//! numeric, or on an integer division by zero.
 // ****************************************************************************
 class SetBlackboard final: public Leaf
 {
 public:
 
+    // ------------------------------------------------------------------------
+    //! \brief Type of the value written to the blackboard.
+    // ------------------------------------------------------------------------
+    enum class Type
+    {
+        //! \brief Inferred from the text: int, then double, then bool, else
+        //! string.
+        Auto,
+        Int,
+        Double,
+        Bool,
+        //! \brief The text is written verbatim (no inference, no expression).
+        //! A single "${key}" reference is still copied.
+        String
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief How the value is produced at each tick.
+    // ------------------------------------------------------------------------
+    enum class Kind
+    {
+        Literal,
+        Copy,
+        Expression
+    };
+
     // ------------------------------------------------------------------------
     //! \brief Get the string representation of the node type.
     //! \return The string "SetBlackboard".
@@ -33,42 +76,80 @@ public:
     }
 
     // ------------------------------------------------------------------------
-    //! \brief Constructor taking key and value to set.
-    //! \param[in] p_key The blackboard key to set.
-    //! \param[in] p_value The value to set (as string).
+    //! \brief Get the YAML name of a value type ("auto", "int" ...).
     // ------------------------------------------------------------------------
-    SetBlackboard(std::string p_key, std::string p_value)
-        : m_key(std::move(p_key)), m_value(std::move(p_value))
+    [[nodiscard]] static constexpr char const* toString(Type p_type)
     {
-        m_type = toString();
+        switch (p_type)
+        {
+            case Type::Int:
+                return "int";
+            case Type::Double:
+                return "double";
+            case Type::Bool:
+                return "bool";
+            case Type::String:
+                return "string";
+            default:
+                return "auto";
+        }
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Parse the YAML name of a value type.
+    //! \param[in] p_name "auto", "int", "double", "bool" or "string".
+    //! \param[out] p_type The parsed type.
+    //! \return False if the name is unknown.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static bool parseType(std::string const& p_name,
+                                        Type& p_type);
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor taking key and value to set.
+    //! \param[in] p_key The blackboard key to set.
+    //! \param[in] p_value The value to set (as text, see class description).
+    //! \param[in] p_type The type of the value (inferred by default).
+    // ------------------------------------------------------------------------
+    SetBlackboard(std::string p_key,
+                  std::string p_value,
+                  Type p_type = Type::Auto);
+
     // ------------------------------------------------------------------------
     //! \brief Constructor taking key, value and blackboard.
     //! \param[in] p_key The blackboard key to set.
-    //! \param[in] p_value The value to set (as string).
+    //! \param[in] p_value The value to set (as text, see class description).
     //! \param[in] p_blackboard The blackboard to use.
     // ------------------------------------------------------------------------
     SetBlackboard(std::string p_key,
                   std::string p_value,
-                  Blackboard::Ptr p_blackboard)
-        : m_key(std::move(p_key)), m_value(std::move(p_value))
-    {
-        m_type = toString();
-        setBlackboard(p_blackboard);
-    }
+                  Blackboard::Ptr p_blackboard);
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor taking key, value, type and blackboard.
+    //! \param[in] p_key The blackboard key to set.
+    //! \param[in] p_value The value to set (as text, see class description).
+    //! \param[in] p_type The type of the value.
+    //! \param[in] p_blackboard The blackboard to use.
+    // ------------------------------------------------------------------------
+    SetBlackboard(std::string p_key,
+                  std::string p_value,
+                  Type p_type,
+                  Blackboard::Ptr p_blackboard);
 
     // ------------------------------------------------------------------------
     //! \brief Run the SetBlackboard leaf.
-    //! \return SUCCESS after setting the value.
+    //! \return SUCCESS after setting the value, FAILURE if the value cannot
+    //! be computed.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Status onRunning() override;
+
     // ------------------------------------------------------------------------
-    [[nodiscard]] Status onRunning() override
+    //! \brief Check if the value has been parsed successfully (i.e. "abc"
+    //! cannot be an int).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
     {
-        if (m_blackboard)
-        {
-            m_blackboard->set(m_key, m_value);
-        }
-        return Status::SUCCESS;
+        return m_valid && !m_key.empty();
     }
 
     // ------------------------------------------------------------------------
@@ -82,13 +163,34 @@ public:
 
     // ------------------------------------------------------------------------
     //! \brief Get the value that will be set.
-    //! \return The value as string.
+    //! \return The value as given to the constructor.
     // ------------------------------------------------------------------------
     [[nodiscard]] std::string const& getValue() const
     {
         return m_value;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Get the type requested for the value.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Type getValueType() const
+    {
+        return m_value_type;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get how the value is produced (literal, copy or expression).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Kind getKind() const
+    {
+        return m_kind;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<SetBlackboard>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitSetBlackboard(*this);
@@ -98,10 +200,72 @@ public:
         p_visitor.visitSetBlackboard(*this);
     }
 
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Number handled by expressions.
+    // ------------------------------------------------------------------------
+    struct Number
+    {
+        bool is_integer = true;
+        int integer = 0;
+        double real = 0.0;
+
+        [[nodiscard]] double asDouble() const
+        {
+            return is_integer ? double(integer) : real;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Operand of an expression: a constant or a blackboard entry.
+    // ------------------------------------------------------------------------
+    struct Operand
+    {
+        //! \brief Blackboard key, empty for a constant.
+        std::string key;
+        Number constant;
+    };
+
+    //! \brief Parse m_value according to m_value_type.
+    void parse();
+    //! \brief Parse a literal according to m_value_type into m_resolved.
+    bool parseLiteral(std::string const& p_text);
+    //! \brief Parse "a op b op c ...". Return false if not an expression.
+    bool parseExpression(std::string const& p_text);
+    //! \brief Read an operand from the blackboard.
+    bool read(Operand const& p_operand, Number& p_number) const;
+    //! \brief Apply a binary operator.
+    static bool apply(char p_operator, Number& p_lhs, Number const& p_rhs);
+    //! \brief Evaluate the expression and write its result.
+    bool evaluate();
+    //! \brief Copy the entry m_source to m_key.
+    bool copy();
+    //! \brief Write a number converted to the requested type.
+    void write(Number const& p_number);
+
 private:
 
     std::string m_key;
+    //! \brief The value text, kept for export.
     std::string m_value;
+    Type m_value_type;
+    Kind m_kind = Kind::Literal;
+    bool m_valid = false;
+
+    //! \brief Concrete type of the literal (never Auto).
+    Type m_resolved = Type::String;
+    int m_int = 0;
+    double m_double = 0.0;
+    bool m_bool = false;
+    std::string m_string;
+
+    //! \brief Key copied for Kind::Copy.
+    std::string m_source;
+
+    //! \brief Expression: operands[0] op[0] operands[1] op[1] ...
+    std::vector<Operand> m_operands;
+    std::vector<char> m_operators;
 };
 
 } // namespace bt
@@ -0,0 +1,119 @@
+/**
+ * @file SharedComputation.hpp
+ * @brief SharedComputation leaf node.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Leaf.hpp"
+#include "BlackThorn/Executor/SharedComputations.hpp"
+
+#include <string>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief The SharedComputation leaf gets the result of a computation shared
+//! by many trees (see SharedComputations), computed at most once per executor
+//! tick, and stores it in the blackboard.
+//! The result is shared with the blackboard without copy. Returns SUCCESS,
+//! or FAILURE if the computation failed (empty result).
+// ****************************************************************************
+class SharedComputation final: public Leaf
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the string representation of the node type.
+    //! \return The string "SharedComputation".
+    // ------------------------------------------------------------------------
+    [[nodiscard]] static constexpr char const* toString()
+    {
+        return "SharedComputation";
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_computations The registry of shared computations.
+    //! \param[in] p_computation The name of the computation.
+    //! \param[in] p_key The blackboard key receiving the result (the name of
+    //!            the computation when empty).
+    // ------------------------------------------------------------------------
+    SharedComputation(SharedComputations::Ptr p_computations,
+                      std::string p_computation,
+                      std::string p_key = {})
+        : m_computations(std::move(p_computations)),
+          m_computation(std::move(p_computation)),
+          m_key(p_key.empty() ? m_computation : std::move(p_key))
+    {
+        m_type = toString();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the result and store it in the blackboard.
+    //! \return SUCCESS, or FAILURE if the computation failed.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Status onRunning() override
+    {
+        SharedComputations::Result result = m_computations->get(m_computation);
+        if (result == nullptr)
+        {
+            return Status::FAILURE;
+        }
+        if (m_blackboard)
+        {
+            m_blackboard->share(m_key, std::move(result));
+        }
+        return Status::SUCCESS;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if the computation is registered.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isValid() const override
+    {
+        return (m_computations != nullptr) &&
+               m_computations->has(m_computation);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the name of the computation.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& getComputation() const
+    {
+        return m_computation;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the blackboard key receiving the result.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string const& getKey() const
+    {
+        return m_key;
+    }
+
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<SharedComputation>(*this);
+    }
+
+    void accept(ConstBehaviorTreeVisitor& p_visitor) const override
+    {
+        p_visitor.visitSharedComputation(*this);
+    }
+    void accept(BehaviorTreeVisitor& p_visitor) override
+    {
+        p_visitor.visitSharedComputation(*this);
+    }
+
+private:
+
+    SharedComputations::Ptr m_computations;
+    std::string m_computation;
+    std::string m_key;
+};
+
+} // namespace bt
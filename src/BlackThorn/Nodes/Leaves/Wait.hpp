@@ -22,7 +22,6 @@ class Wait final: public Leaf
 {
 public:
 
-    using Clock = std::chrono::steady_clock;
     using Duration = std::chrono::milliseconds;
 
     // ------------------------------------------------------------------------
@@ -49,7 +48,7 @@ public:
     // ------------------------------------------------------------------------
     [[nodiscard]] Status onSetUp() override
     {
-        m_start_time = Clock::now();
+        m_start_time = now();
         return Status::RUNNING;
     }
 
@@ -60,7 +59,7 @@ public:
     [[nodiscard]] Status onRunning() override
     {
         auto elapsed =
-            std::chrono::duration_cast<Duration>(Clock::now() - m_start_time);
+            std::chrono::duration_cast<Duration>(now() - m_start_time);
 
         if (elapsed >= m_duration)
         {
@@ -79,6 +78,11 @@ public:
         return static_cast<size_t>(m_duration.count());
     }
 
+    [[nodiscard]] Node::Ptr clone() const override
+    {
+        return std::make_unique<Wait>(*this);
+    }
+
     void accept(ConstBehaviorTreeVisitor& p_visitor) const override
     {
         p_visitor.visitWait(*this);
@@ -88,10 +92,29 @@ public:
         p_visitor.visitWait(*this);
     }
 
+protected:
+
+    // ------------------------------------------------------------------------
+    //! \brief Save the time elapsed since the start.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onSaveState(std::string& p_state) const override
+    {
+        saveTime(p_state, m_start_time);
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Restore the start time.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool onLoadState(encoding::Reader& p_state) override
+    {
+        return loadTime(p_state, m_start_time);
+    }
+
 private:
 
     Duration m_duration;
-    Clock::time_point m_start_time;
+    Clock::TimePoint m_start_time;
 };
 
 } // namespace bt
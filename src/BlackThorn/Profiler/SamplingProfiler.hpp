@@ -0,0 +1,480 @@
+/**
+ * @file SamplingProfiler.hpp
+ * @brief Statistical sampling profiler of behavior trees, cheap enough to run
+ * continuously in production.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Tree.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Sampling profiler finding the nodes in which the trees spend their
+//! time, without instrumenting each tick.
+//!
+//! Attaching a tree gives it a tick marker: while a node is ticked, it stores
+//! itself in the marker (one relaxed store when entering and when leaving
+//! Node::tick()). A background thread reads the markers of the attached trees
+//! at a fixed period and counts, for each node, the samples where it was the
+//! innermost node being ticked. As a node has a single path from the root,
+//! these counts give both the hot nodes and the hot paths: the samples of a
+//! node plus the ones of its descendants are the time spent in its branch.
+//!
+//! The result can be exported as collapsed stacks (the input format of the
+//! flame graph tools: "root;child;leaf count" per line) or sent to Oakular
+//! as a heat overlay with VisualizerClient::sendHeat().
+//!
+//! Trees must be attached once built, while they are not ticked, and must
+//! outlive the profiler or be detached before being destroyed.
+//!
+//! Usage example:
+//! \code
+//!   bt::SamplingProfiler profiler(std::chrono::milliseconds(1));
+//!   profiler.attach(*tree, "npc");
+//!   profiler.start();
+//!   while (running)
+//!       tree->tick();
+//!   profiler.stop();
+//!   std::ofstream("npc.folded") << profiler.collapsedStacks();
+//! \endcode
+// ****************************************************************************
+class SamplingProfiler
+{
+public:
+
+    // ------------------------------------------------------------------------
+    //! \brief Samples of a node.
+    // ------------------------------------------------------------------------
+    struct NodeSamples
+    {
+        //! \brief The node.
+        Node const* node = nullptr;
+        //! \brief Path from the root, frames separated by ';'.
+        std::string path;
+        //! \brief Samples where the node was the innermost node ticked.
+        size_t self = 0;
+        //! \brief Samples where the node or a descendant was ticked.
+        size_t total = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Sampling statistics of a tree.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of samples taken.
+        size_t samples = 0;
+        //! \brief Samples where the tree was not ticked.
+        size_t idle = 0;
+        //! \brief Samples where a node added after attach() was ticked.
+        size_t untracked = 0;
+
+        //! \brief Samples where a known node of the tree was ticked.
+        [[nodiscard]] size_t busy() const
+        {
+            return samples - idle - untracked;
+        }
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Constructor.
+    //! \param[in] p_period The sampling period of the background thread.
+    // ------------------------------------------------------------------------
+    explicit SamplingProfiler(
+        std::chrono::microseconds p_period = std::chrono::milliseconds(1))
+        : m_period(p_period)
+    {
+    }
+
+    // Disable copy/move: the trees reference the markers of this instance
+    SamplingProfiler(SamplingProfiler const&) = delete;
+    SamplingProfiler& operator=(SamplingProfiler const&) = delete;
+
+    // ------------------------------------------------------------------------
+    //! \brief Destructor - stops sampling and detaches the trees.
+    // ------------------------------------------------------------------------
+    ~SamplingProfiler()
+    {
+        stop();
+        for (auto const& profile : m_profiles)
+        {
+            profile->tree->setTickMarker(nullptr);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start profiling a tree (replacing its previous profile).
+    //! \param[in] p_tree The tree, built and not being ticked (not owned).
+    //! \param[in] p_label The root frame of its collapsed stacks. Trees with
+    //!            the same label (e.g. the same agent tree instantiated many
+    //!            times) are merged in the collapsed stacks.
+    // ------------------------------------------------------------------------
+    void attach(Tree& p_tree, std::string p_label = "tree")
+    {
+        auto profile = std::make_unique<Profile>();
+        profile->tree = &p_tree;
+        profile->label = std::move(p_label);
+        if (p_tree.hasRoot())
+        {
+            index(*profile, p_tree.getRoot(), NO_PARENT);
+        }
+        profile->self.resize(profile->nodes.size(), 0u);
+        p_tree.setTickMarker(&profile->marker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = find(p_tree);
+        if (it != m_profiles.end())
+        {
+            *it = std::move(profile);
+        }
+        else
+        {
+            m_profiles.push_back(std::move(profile));
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Stop profiling a tree and forget its samples.
+    //! \param[in] p_tree The tree, not being ticked.
+    // ------------------------------------------------------------------------
+    void detach(Tree& p_tree)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = find(p_tree);
+        if (it != m_profiles.end())
+        {
+            p_tree.setTickMarker(nullptr);
+            m_profiles.erase(it);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Start the background sampling thread.
+    // ------------------------------------------------------------------------
+    void start()
+    {
+        std::lock_guard<std::mutex> lock(m_control);
+        if (m_thread.joinable())
+        {
+            return;
+        }
+        m_stop = false;
+        m_thread = std::thread([this] { run(); });
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Stop the background sampling thread. Samples are kept.
+    // ------------------------------------------------------------------------
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_control);
+            m_stop = true;
+        }
+        m_wakeup.notify_all();
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if the background sampling thread is running.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] bool isRunning() const
+    {
+        return m_thread.joinable();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the sampling period.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::chrono::microseconds period() const
+    {
+        return m_period;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Take one sample of all the attached trees. Called periodically
+    //! by the background thread, can also be called from any thread.
+    // ------------------------------------------------------------------------
+    void sample()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto const& profile : m_profiles)
+        {
+            ++profile->statistics.samples;
+            Node const* node = profile->marker.load(std::memory_order_relaxed);
+            if (node == nullptr)
+            {
+                ++profile->statistics.idle;
+                continue;
+            }
+            auto it = profile->indices.find(node);
+            if (it == profile->indices.end())
+            {
+                ++profile->statistics.untracked;
+                continue;
+            }
+            ++profile->self[it->second];
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Forget all the samples.
+    // ------------------------------------------------------------------------
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto const& profile : m_profiles)
+        {
+            profile->statistics = Statistics{};
+            std::fill(profile->self.begin(), profile->self.end(), 0u);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the sampling statistics of a tree.
+    //! \param[in] p_tree The tree (empty statistics if not attached).
+    // ------------------------------------------------------------------------
+    [[nodiscard]] Statistics statistics(Tree const& p_tree) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = find(p_tree);
+        return (it != m_profiles.end()) ? (*it)->statistics : Statistics{};
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the sampled nodes of a tree, hottest first.
+    //! \param[in] p_tree The tree (empty if not attached).
+    //! \return The nodes with at least one sample in their branch, sorted by
+    //! decreasing self samples then by decreasing total samples.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<NodeSamples> hotNodes(Tree const& p_tree) const
+    {
+        std::vector<NodeSamples> result;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = find(p_tree);
+        if (it == m_profiles.end())
+        {
+            return result;
+        }
+
+        Profile const& profile = **it;
+        std::vector<size_t> total = totals(profile);
+        for (size_t i = 0u; i < profile.nodes.size(); ++i)
+        {
+            if (total[i] > 0u)
+            {
+                result.push_back(NodeSamples{
+                    profile.nodes[i], path(profile, i), profile.self[i],
+                    total[i]});
+            }
+        }
+        std::sort(result.begin(),
+                  result.end(),
+                  [](NodeSamples const& p_a, NodeSamples const& p_b) {
+                      return (p_a.self != p_b.self) ? (p_a.self > p_b.self)
+                                                    : (p_a.total > p_b.total);
+                  });
+        return result;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Export the samples of all the attached trees as collapsed
+    //! stacks, one "frame;frame;...;frame count" line per sampled node,
+    //! ready for flamegraph.pl, speedscope or inferno.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::string collapsedStacks() const
+    {
+        std::map<std::string, size_t> stacks;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto const& profile : m_profiles)
+            {
+                for (size_t i = 0u; i < profile->nodes.size(); ++i)
+                {
+                    if (profile->self[i] > 0u)
+                    {
+                        stacks[path(*profile, i)] += profile->self[i];
+                    }
+                }
+            }
+        }
+
+        std::string result;
+        for (auto const& [stack, count] : stacks)
+        {
+            result += stack + " " + std::to_string(count) + "\n";
+        }
+        return result;
+    }
+
+private:
+
+    static constexpr size_t NO_PARENT = size_t(-1);
+
+    // ------------------------------------------------------------------------
+    //! \brief Profile of an attached tree. Nodes are indexed in depth-first
+    //! order, so the parent of a node is always before it.
+    // ------------------------------------------------------------------------
+    struct Profile
+    {
+        Tree* tree = nullptr;
+        std::string label;
+        Node::TickMarker marker{nullptr};
+        std::vector<Node const*> nodes;
+        std::vector<size_t> parents;
+        std::vector<std::string> frames;
+        std::unordered_map<Node const*, size_t> indices;
+        std::vector<size_t> self;
+        Statistics statistics;
+    };
+
+    using Profiles = std::vector<std::unique_ptr<Profile>>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Index a node, its descendants and the nodes of its subtree.
+    //! The content swapped in a DynamicSubTree after attach() is not indexed:
+    //! its samples are counted as untracked.
+    // ------------------------------------------------------------------------
+    static void index(Profile& p_profile, Node& p_node, size_t p_parent)
+    {
+        // A subtree definition may be shared: keep its first occurrence
+        if (!p_profile.indices.emplace(&p_node, p_profile.nodes.size()).second)
+        {
+            return;
+        }
+
+        size_t const current = p_profile.nodes.size();
+        p_profile.nodes.push_back(&p_node);
+        p_profile.parents.push_back(p_parent);
+        p_profile.frames.push_back(frame(p_node));
+
+        for (size_t i = 0u; i < p_node.childrenCount(); ++i)
+        {
+            if (Node* child = p_node.childAt(i))
+            {
+                index(p_profile, *child, current);
+            }
+        }
+        if (Tree* inner = detail::innerTree(&p_node); inner && inner->hasRoot())
+        {
+            index(p_profile, inner->getRoot(), current);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Name of a node in the collapsed stacks.
+    // ------------------------------------------------------------------------
+    static std::string frame(Node const& p_node)
+    {
+        std::string name = !p_node.name.empty()   ? p_node.name
+                           : !p_node.type().empty() ? p_node.type()
+                                                    : std::string("Node");
+        std::replace(name.begin(), name.end(), ';', '_');
+        std::replace(name.begin(), name.end(), '\n', ' ');
+        return name;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Path of a node from the root of its tree.
+    // ------------------------------------------------------------------------
+    static std::string path(Profile const& p_profile, size_t p_index)
+    {
+        std::vector<size_t> chain;
+        for (size_t i = p_index; i != NO_PARENT; i = p_profile.parents[i])
+        {
+            chain.push_back(i);
+        }
+
+        std::string result = p_profile.label;
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+        {
+            result += ";" + p_profile.frames[*it];
+        }
+        return result;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Samples of each node including its descendants.
+    // ------------------------------------------------------------------------
+    static std::vector<size_t> totals(Profile const& p_profile)
+    {
+        std::vector<size_t> total = p_profile.self;
+        for (size_t i = total.size(); i-- > 1u;)
+        {
+            total[p_profile.parents[i]] += total[i];
+        }
+        return total;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Find the profile of a tree.
+    // ------------------------------------------------------------------------
+    Profiles::const_iterator find(Tree const& p_tree) const
+    {
+        return std::find_if(m_profiles.begin(),
+                            m_profiles.end(),
+                            [&p_tree](std::unique_ptr<Profile> const& p) {
+                                return p->tree == &p_tree;
+                            });
+    }
+
+    Profiles::iterator find(Tree const& p_tree)
+    {
+        return std::find_if(m_profiles.begin(),
+                            m_profiles.end(),
+                            [&p_tree](std::unique_ptr<Profile> const& p) {
+                                return p->tree == &p_tree;
+                            });
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Background thread loop: sample at each period until stopped.
+    // ------------------------------------------------------------------------
+    void run()
+    {
+        auto next = std::chrono::steady_clock::now() + m_period;
+        std::unique_lock<std::mutex> lock(m_control);
+        while (!m_wakeup.wait_until(lock, next, [this] { return m_stop; }))
+        {
+            lock.unlock();
+            sample();
+            lock.lock();
+            next += m_period;
+        }
+    }
+
+private:
+
+    std::chrono::microseconds m_period;
+    //! \brief Profiles of the attached trees (markers must not move).
+    Profiles m_profiles;
+    //! \brief Protects the profiles and their samples.
+    mutable std::mutex m_mutex;
+
+    std::thread m_thread;
+    //! \brief Protects the stop flag of the sampling thread.
+    std::mutex m_control;
+    std::condition_variable m_wakeup;
+    bool m_stop = false;
+};
+
+} // namespace bt
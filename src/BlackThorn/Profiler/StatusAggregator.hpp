@@ -0,0 +1,278 @@
+/**
+ * @file StatusAggregator.hpp
+ * @brief Distribution of the node statuses across many instances of the same
+ * tree definition.
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include "BlackThorn/Core/Tree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace bt {
+
+// ****************************************************************************
+//! \brief Collector counting, for each node ID of a tree definition, how many
+//! instances of the tree are in each status.
+//!
+//! Each instance (e.g. one agent of a crowd) reports its tree after its ticks
+//! with its instance ID. The collector keeps the last statuses of each
+//! instance and only applies their changes (deltas) to the counts, so that
+//! the cost of a report does not depend on the number of instances. Reports
+//! of different instances may come from different threads: the statuses of
+//! an instance are compared without lock, and the counts are updated under a
+//! short lock. An instance must not be reported by two threads at once.
+//!
+//! The distribution is read by VisualizerClient::sendDistribution(), whose
+//! message size depends on the number of nodes only: Oakular shows a single
+//! tree whose nodes display the share of the instances in each status.
+//!
+//! Instances are expected to share the tree definition, hence the node IDs.
+//!
+//! Usage example:
+//! \code
+//!   bt::StatusAggregator aggregator;
+//!   // On the agent threads, after each tick
+//!   agent.tree->tick();
+//!   aggregator.report(agent.id, *agent.tree);
+//!   // On the monitoring thread, at display rate
+//!   visualizer->sendDistribution(aggregator);
+//! \endcode
+// ****************************************************************************
+class StatusAggregator
+{
+public:
+
+    //! \brief Number of instances in each status, indexed by Status.
+    using Counts = std::array<uint32_t, 4u>;
+
+    // ------------------------------------------------------------------------
+    //! \brief Distribution of the statuses of a node across the instances.
+    // ------------------------------------------------------------------------
+    struct NodeDistribution
+    {
+        //! \brief ID of the node in the tree definition.
+        uint32_t id = 0;
+        //! \brief Number of instances in each status, indexed by Status.
+        Counts counts{};
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Report the current statuses of an instance.
+    //! \param[in] p_instance The ID of the instance.
+    //! \param[in] p_tree The tree of the instance (read only).
+    // ------------------------------------------------------------------------
+    void report(uint32_t p_instance, Tree& p_tree)
+    {
+        Instance& instance = findOrCreate(p_instance);
+
+        // Statuses of the instance, compared with the ones of the last report
+        instance.scratch.clear();
+        if (p_tree.hasRoot())
+        {
+            collect(p_tree.getRoot(), instance.scratch);
+        }
+        std::vector<State> const& last = instance.states;
+        std::vector<State> const& current = instance.scratch;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        bool changed = false;
+        size_t const common = std::min(last.size(), current.size());
+        size_t i = 0u;
+        for (; (i < common) && (last[i].id == current[i].id); ++i)
+        {
+            if (last[i].status != current[i].status)
+            {
+                --m_counts[current[i].id][last[i].status];
+                ++m_counts[current[i].id][current[i].status];
+                changed = true;
+            }
+        }
+
+        // The structure differs from here (first report, new content of a
+        // DynamicSubTree...): recount the remaining nodes
+        if ((i < last.size()) || (i < current.size()))
+        {
+            uncount(last.begin() + std::ptrdiff_t(i), last.end());
+            count(current.begin() + std::ptrdiff_t(i), current.end());
+            changed = true;
+        }
+        if (changed)
+        {
+            ++m_revision;
+        }
+        instance.states.swap(instance.scratch);
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Remove an instance from the distribution (e.g. agent despawned).
+    //! \param[in] p_instance The ID of the instance.
+    // ------------------------------------------------------------------------
+    void remove(uint32_t p_instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_instances.find(p_instance);
+        if (it == m_instances.end())
+        {
+            return;
+        }
+        uncount(it->second->states.begin(), it->second->states.end());
+        m_instances.erase(it);
+        ++m_revision;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of instances reported and not removed.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t instances() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_instances.size();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the revision of the distribution, incremented each time it
+    //! changes.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] size_t revision() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_revision;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the distribution of the statuses of each node, sorted by
+    //! node ID. Nodes appearing several times in a tree (e.g. a shared
+    //! subtree) are counted once per occurrence.
+    // ------------------------------------------------------------------------
+    [[nodiscard]] std::vector<NodeDistribution> distribution() const
+    {
+        std::vector<NodeDistribution> nodes;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            nodes.reserve(m_counts.size());
+            for (auto const& [id, counts] : m_counts)
+            {
+                nodes.push_back({id, counts});
+            }
+        }
+        std::sort(nodes.begin(),
+                  nodes.end(),
+                  [](NodeDistribution const& p_a, NodeDistribution const& p_b)
+                  { return p_a.id < p_b.id; });
+        return nodes;
+    }
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Status of a node of an instance.
+    // ------------------------------------------------------------------------
+    struct State
+    {
+        uint32_t id;
+        uint8_t status;
+    };
+
+    using Iterator = std::vector<State>::const_iterator;
+
+    // ------------------------------------------------------------------------
+    //! \brief Last statuses of an instance, in depth-first order.
+    // ------------------------------------------------------------------------
+    struct Instance
+    {
+        std::vector<State> states;
+        //! \brief Statuses being collected, kept to reuse its memory.
+        std::vector<State> scratch;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the instance of the given ID, created if new. Instances are
+    //! allocated separately so that they stay in place when others are added.
+    // ------------------------------------------------------------------------
+    Instance& findOrCreate(uint32_t p_instance)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& instance = m_instances[p_instance];
+        if (!instance)
+        {
+            instance = std::make_unique<Instance>();
+        }
+        return *instance;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Collect the statuses of a node, its descendants and the content
+    //! of its subtree.
+    // ------------------------------------------------------------------------
+    static void collect(Node& p_node, std::vector<State>& p_states)
+    {
+        p_states.push_back({p_node.id(), uint8_t(p_node.status())});
+        for (size_t i = 0u; i < p_node.childrenCount(); ++i)
+        {
+            if (Node* child = p_node.childAt(i))
+            {
+                collect(*child, p_states);
+            }
+        }
+        if (Tree* inner = detail::innerTree(&p_node); inner && inner->hasRoot())
+        {
+            collect(inner->getRoot(), p_states);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Remove statuses from the counts. Called with the lock held.
+    // ------------------------------------------------------------------------
+    void uncount(Iterator p_begin, Iterator p_end)
+    {
+        for (auto state = p_begin; state != p_end; ++state)
+        {
+            auto it = m_counts.find(state->id);
+            --it->second[state->status];
+            if (std::all_of(it->second.begin(),
+                            it->second.end(),
+                            [](uint32_t p_count) { return p_count == 0u; }))
+            {
+                // Node no longer used by any instance
+                m_counts.erase(it);
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add statuses to the counts. Called with the lock held.
+    // ------------------------------------------------------------------------
+    void count(Iterator p_begin, Iterator p_end)
+    {
+        for (auto state = p_begin; state != p_end; ++state)
+        {
+            ++m_counts[state->id][state->status];
+        }
+    }
+
+private:
+
+    //! \brief Protects the instances map and the counts.
+    mutable std::mutex m_mutex;
+    //! \brief Instances reported (instance ID -> last statuses).
+    std::unordered_map<uint32_t, std::unique_ptr<Instance>> m_instances;
+    //! \brief Distribution of the statuses (node ID -> counts).
+    std::unordered_map<uint32_t, Counts> m_counts;
+    //! \brief Incremented each time the counts change.
+    size_t m_revision = 0u;
+};
+
+} // namespace bt
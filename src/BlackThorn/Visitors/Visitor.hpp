@@ -14,6 +14,7 @@ namespace bt {
 // Forward declarations
 class Tree;
 class SubTreeNode;
+class DynamicSubTree;
 class Sequence;
 class ReactiveSequence;
 class SequenceWithMemory;
@@ -40,6 +41,8 @@ class Action;
 class SugarAction;
 class Wait;
 class SetBlackboard;
+class SharedComputation;
+class BatchedServiceCall;
 
 // ****************************************************************************
 //! \brief Const visitor interface for behavior tree nodes (read-only).
@@ -94,8 +97,11 @@ public:
     virtual void visitAction(Action const& p_node) = 0;
     virtual void visitSugarAction(SugarAction const& p_node) = 0;
     virtual void visitSubTree(SubTreeNode const& p_node) = 0;
+    virtual void visitDynamicSubTree(DynamicSubTree const& p_node) = 0;
     virtual void visitWait(Wait const& p_node) = 0;
     virtual void visitSetBlackboard(SetBlackboard const& p_node) = 0;
+    virtual void visitSharedComputation(SharedComputation const& p_node) = 0;
+    virtual void visitBatchedServiceCall(BatchedServiceCall const& p_node) = 0;
 
     // Tree node
     virtual void visitTree(Tree const& p_node) = 0;
@@ -154,8 +160,11 @@ public:
     virtual void visitAction(Action& p_node) = 0;
     virtual void visitSugarAction(SugarAction& p_node) = 0;
     virtual void visitSubTree(SubTreeNode& p_node) = 0;
+    virtual void visitDynamicSubTree(DynamicSubTree& p_node) = 0;
     virtual void visitWait(Wait& p_node) = 0;
     virtual void visitSetBlackboard(SetBlackboard& p_node) = 0;
+    virtual void visitSharedComputation(SharedComputation& p_node) = 0;
+    virtual void visitBatchedServiceCall(BatchedServiceCall& p_node) = 0;
 
     // Tree node
     virtual void visitTree(Tree& p_node) = 0;
@@ -202,6 +202,13 @@ void IDE::onDrawMenuBar()
         {
             m_show_blackboard_panel = !m_show_blackboard_panel;
         }
+
+        // Toggle the overlay of the per-frame timings and counters
+        if (ImGui::MenuItem(
+                "Performance HUD", nullptr, m_show_performance_hud))
+        {
+            m_show_performance_hud = !m_show_performance_hud;
+        }
         ImGui::EndMenu();
     }
 
@@ -347,11 +354,16 @@ void IDE::drawBehaviorTree()
     bool const is_edit_mode = (m_mode == Mode::Creation);
     IDE::LayoutDirection layout_dir = getCurrentTreeView().layout_direction;
     int layout_dir_int = static_cast<int>(layout_dir);
-    m_renderer->drawBehaviorTree(visible_nodes,
-                                 visible_links,
-                                 layout_dir_int,
-                                 m_blackboard.get(),
-                                 !is_edit_mode);
+    {
+        PerformanceHUD::ScopedTimer timer(m_hud,
+                                          PerformanceHUD::Stage::Rendering);
+        m_renderer->drawBehaviorTree(visible_nodes,
+                                     visible_links,
+                                     layout_dir_int,
+                                     m_blackboard.get(),
+                                     !is_edit_mode);
+    }
+    m_hud.addDrawCounts(m_renderer->drawCounts());
 
     // Save positions back to current view's node_positions (in case Renderer
     // modified them)
@@ -643,6 +655,8 @@ IDE::TreeView* IDE::findTreeViewByRootId(int root_id)
 // ----------------------------------------------------------------------------
 void IDE::autoLayoutNodes()
 {
+    PerformanceHUD::ScopedTimer timer(m_hud, PerformanceHUD::Stage::Layout);
+
     int root_id = getCurrentTreeView().root_id;
     if (root_id < 0)
         return;
@@ -774,6 +788,42 @@ void IDE::layoutNodeRecursive(IDE::Node* p_node,
     }
 }
 
+// ----------------------------------------------------------------------------
+void IDE::layoutRegion(ID p_root_id)
+{
+    PerformanceHUD::ScopedTimer timer(m_hud, PerformanceHUD::Stage::Layout);
+
+    Node* root = findNode(p_root_id);
+    if (!root)
+        return;
+
+    // Lay out the branch from the current position of its root, then move it
+    // back there since the root is centered over its children
+    ImVec2 const anchor = getNodePosition(p_root_id);
+    float max_extent =
+        (getCurrentTreeView().layout_direction == LayoutDirection::LeftToRight)
+            ? anchor.y
+            : anchor.x;
+    layoutNodeRecursive(root, anchor.x, anchor.y, max_extent);
+
+    ImVec2 const placed = getNodePosition(p_root_id);
+    ImVec2 const offset(anchor.x - placed.x, anchor.y - placed.y);
+    std::vector<ID> branch = {p_root_id};
+    while (!branch.empty())
+    {
+        Node* node = findNode(branch.back());
+        branch.pop_back();
+        if (!node)
+            continue;
+
+        ImVec2 const position = getNodePosition(node->id);
+        setNodePosition(node->id,
+                        ImVec2(position.x + offset.x, position.y + offset.y));
+        branch.insert(
+            branch.end(), node->children.begin(), node->children.end());
+    }
+}
+
 // ----------------------------------------------------------------------------
 void IDE::toggleSubTreeExpansion(int node_id)
 {
@@ -1117,6 +1167,136 @@ void IDE::loadFromYamlString(const std::string& p_yaml_content)
     }
 }
 
+// ----------------------------------------------------------------------------
+bool IDE::applyStructurePatch(Server::StructurePatch const& p_patch)
+{
+    using Kind = Server::StructurePatch::Kind;
+
+    Node* target = findNode(p_patch.node_id);
+    if (!target)
+    {
+        std::cerr << "Structure patch on unknown node " << p_patch.node_id
+                  << std::endl;
+        return false;
+    }
+
+    if (p_patch.kind == Kind::Insert)
+    {
+        int branch_id = parseYamlBranch(p_patch.yaml, target->id);
+        if (branch_id < 0)
+            return false;
+
+        // References to the elements of m_nodes survive insertions
+        auto& children = target->children;
+        size_t index = std::min(p_patch.index, children.size());
+        children.insert(children.begin() + std::ptrdiff_t(index), branch_id);
+        layoutRegion(target->id);
+        return true;
+    }
+
+    // Detach the node from its parent, remembering its place
+    ID const node_id = target->id;
+    ID const parent_id = target->parent;
+    ImVec2 const position = getNodePosition(node_id);
+    size_t index = 0;
+    if (Node* parent = findNode(parent_id))
+    {
+        auto& children = parent->children;
+        auto it = std::find(children.begin(), children.end(), node_id);
+        index = size_t(std::distance(children.begin(), it));
+        if (it != children.end())
+        {
+            children.erase(it);
+        }
+    }
+
+    // Erased before parsing the new branch so that its _id are free again
+    eraseBranch(node_id);
+
+    ID branch_id = -1;
+    if (p_patch.kind == Kind::Replace)
+    {
+        branch_id = parseYamlBranch(p_patch.yaml, parent_id);
+        if (branch_id >= 0)
+        {
+            if (Node* parent = findNode(parent_id))
+            {
+                parent->children.insert(
+                    parent->children.begin() + std::ptrdiff_t(index),
+                    branch_id);
+            }
+        }
+    }
+
+    // The node was the root of a view
+    for (auto& [name, view] : m_tree_views)
+    {
+        if (view.root_id == node_id)
+        {
+            view.root_id = branch_id;
+        }
+    }
+
+    if (parent_id >= 0)
+    {
+        layoutRegion(parent_id);
+    }
+    else if (branch_id >= 0)
+    {
+        setNodePosition(branch_id, position);
+        layoutRegion(branch_id);
+    }
+    return (p_patch.kind == Kind::Remove) || (branch_id >= 0);
+}
+
+// ----------------------------------------------------------------------------
+int IDE::parseYamlBranch(std::string const& p_yaml, ID p_parent_id)
+{
+    try
+    {
+        return parseYamlNode(YAML::Load(p_yaml), p_parent_id);
+    }
+    catch (const YAML::Exception& e)
+    {
+        std::cerr << "YAML parsing error: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+void IDE::eraseBranch(ID p_id)
+{
+    std::unordered_set<ID> erased;
+    std::vector<ID> branch = {p_id};
+    while (!branch.empty())
+    {
+        ID const id = branch.back();
+        branch.pop_back();
+        auto it = m_nodes.find(id);
+        if (it == m_nodes.end() || !erased.insert(id).second)
+            continue;
+
+        auto const& children = it->second.children;
+        branch.insert(branch.end(), children.begin(), children.end());
+        m_nodes.erase(it);
+        for (auto& [name, view] : m_tree_views)
+        {
+            view.node_positions.erase(id);
+        }
+    }
+
+    m_dfs_node_order.erase(std::remove_if(m_dfs_node_order.begin(),
+                                          m_dfs_node_order.end(),
+                                          [&erased](ID id)
+                                          { return erased.count(id) > 0u; }),
+                           m_dfs_node_order.end());
+    if (erased.count(m_selected_node_id) > 0u)
+    {
+        m_selected_node_id = -1;
+    }
+}
+
+// ----------------------------------------------------------------------------
 void IDE::saveToYaml(const std::string& p_filepath)
 {
     std::cout << "Saving tree to: " << p_filepath << std::endl;
@@ -1293,6 +1473,30 @@ void IDE::serializeNodeToYaml(YAML::Emitter& p_out,
               << p_node->subtree_reference;
     }
 
+    if (p_node->is_unordered)
+    {
+        p_out << YAML::Key << "unordered" << YAML::Value << true;
+    }
+
+    if (p_node->type == "SetBlackboard")
+    {
+        p_out << YAML::Key << "key" << YAML::Value << p_node->set_key;
+        if (p_node->set_type == "string")
+        {
+            p_out << YAML::Key << "value" << YAML::Value << YAML::DoubleQuoted
+                  << p_node->set_value;
+        }
+        else
+        {
+            p_out << YAML::Key << "value" << YAML::Value << p_node->set_value;
+            if (p_node->set_type != "auto")
+            {
+                p_out << YAML::Key << "type" << YAML::Value
+                      << p_node->set_type;
+            }
+        }
+    }
+
     // Save inputs as parameters with ${variable} reference format
     if (!p_node->inputs.empty())
     {
@@ -1380,8 +1584,27 @@ int IDE::parseYamlNode(const YAML::Node& p_yaml_node, int p_parent_id)
     std::string node_type = it->first.as<std::string>();
     YAML::Node node_data = it->second;
 
+    // Keep the _id of the node when it is free, so that the messages of the
+    // visualizer client, keyed by _id, reach it
+    int node_id = -1;
+    if (node_data["_id"])
+    {
+        int const wanted = node_data["_id"].as<int>();
+        if (wanted > 0 && m_nodes.count(wanted) == 0u)
+        {
+            node_id = wanted;
+            m_unique_node_id = std::max(m_unique_node_id, wanted + 1);
+        }
+    }
+    if (node_id < 0)
+    {
+        node_id = getNextNodeId();
+    }
+
+    // Reserve the ID while the children are parsed
+    m_nodes.emplace(node_id, IDE::Node{});
+
     // Create the editor node
-    int node_id = getNextNodeId();
     std::string node_name = node_type;
 
     // Extract name if provided
@@ -1406,6 +1629,33 @@ int IDE::parseYamlNode(const YAML::Node& p_yaml_node, int p_parent_id)
             node_data["reference"].as<std::string>();
     }
 
+    // Commutative Sequence/Selector
+    if (node_data["unordered"])
+    {
+        editor_node.is_unordered = node_data["unordered"].as<bool>();
+    }
+
+    // SetBlackboard: quoted values are strings, else inferred unless typed
+    if (editor_node.type == "SetBlackboard")
+    {
+        if (node_data["key"])
+        {
+            editor_node.set_key = node_data["key"].as<std::string>();
+        }
+        if (node_data["value"])
+        {
+            editor_node.set_value = node_data["value"].as<std::string>();
+            if (node_data["value"].Tag() == "!")
+            {
+                editor_node.set_type = "string";
+            }
+        }
+        if (node_data["type"])
+        {
+            editor_node.set_type = node_data["type"].as<std::string>();
+        }
+    }
+
     // Extract inputs
     if (node_data["inputs"])
     {
@@ -1480,7 +1730,7 @@ int IDE::parseYamlNode(const YAML::Node& p_yaml_node, int p_parent_id)
     }
 
     // Add node to the map
-    m_nodes.emplace(node_id, std::move(editor_node));
+    m_nodes[node_id] = std::move(editor_node);
 
     return node_id;
 }
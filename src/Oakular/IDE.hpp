@@ -11,10 +11,12 @@
 #include "Application/Application.hpp"
 #include "BlackThorn/BlackThorn.hpp"
 #include "BlackThorn/Common/Signal.hpp"
+#include "PerformanceHUD.hpp"
 #include "Server.hpp"
 
 #include <imgui.h>
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -111,11 +113,33 @@ public:
         std::string subtree_reference;
         //! \brief SubTree expansion state
         bool is_expanded = false;
+        //! \brief Commutative Sequence/Selector whose children are reordered
+        //! at runtime (YAML "unordered: true")
+        bool is_unordered = false;
+        //! \brief Key written by a SetBlackboard node
+        std::string set_key;
+        //! \brief Value text written by a SetBlackboard node (literal,
+        //! ${reference} or expression)
+        std::string set_value;
+        //! \brief Value type of a SetBlackboard node ("auto", "int",
+        //! "double", "bool" or "string")
+        std::string set_type = "auto";
         //! \brief Optional: reference to actual BT node
         std::shared_ptr<bt::Node> bt_node;
         //! \brief Runtime status for visualizer mode (0=INVALID, 1=RUNNING,
         //! 2=SUCCESS, 3=FAILURE)
         int runtime_status = 0;
+        //! \brief Position of the node in the evaluation order chosen by its
+        //! unordered parent for visualizer mode (-1 if not applicable)
+        int evaluation_rank = -1;
+        //! \brief Percentage of the profiler samples spent in the branch of
+        //! the node for visualizer mode (-1 if not profiled)
+        int heat_total = -1;
+        //! \brief Percentage of the profiler samples spent in the node itself
+        int heat_self = 0;
+        //! \brief Number of tree instances in each status (indexed by
+        //! runtime_status) for the aggregated visualizer mode
+        std::array<uint32_t, 4> distribution{};
     };
 
     // ------------------------------------------------------------------------
@@ -208,6 +232,16 @@ protected: // Core functionality for derived classes
     // ------------------------------------------------------------------------
     void loadFromYamlString(std::string const& p_yaml_content);
 
+    // ------------------------------------------------------------------------
+    //! \brief Apply an incremental change of the structure of the tree loaded
+    //! by loadFromYamlString(), keyed by the _id of the nodes. Only the branch
+    //! under the parent of the change is laid out again, its parent staying in
+    //! place so that the view does not jump.
+    //! \param p_patch The patch received by the server.
+    //! \return false if the nodes of the patch are unknown.
+    // ------------------------------------------------------------------------
+    bool applyStructurePatch(Server::StructurePatch const& p_patch);
+
     // ------------------------------------------------------------------------
     //! \brief Save a tree to a YAML file.
     //! \param p_filepath The path to the YAML file.
@@ -293,6 +327,9 @@ private: // Tree conversion (internal)
                              float p_x,
                              float p_y,
                              float& p_max_extent);
+    void layoutRegion(ID p_root_id);
+    void eraseBranch(ID p_id);
+    int parseYamlBranch(std::string const& p_yaml, ID p_parent_id);
 
 private: // auto-increment unique identifiers
 
@@ -348,6 +385,10 @@ protected:
     std::shared_ptr<bt::Blackboard> m_blackboard;
     //! \brief Flag to show the blackboard panel.
     bool m_show_blackboard_panel = true;
+    //! \brief Per-frame timings and counters of the editor.
+    PerformanceHUD m_hud;
+    //! \brief Flag to show the performance overlay.
+    bool m_show_performance_hud = false;
     //! \brief DFS order of node IDs for visualizer mode (maps index -> node_id)
     std::vector<ID> m_dfs_node_order;
 };
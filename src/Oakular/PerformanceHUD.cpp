@@ -0,0 +1,163 @@
+/**
+ * @file PerformanceHUD.cpp
+ * @brief Overlay displaying the per-frame timings and counters of Oakular
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "PerformanceHUD.hpp"
+
+#include <imgui.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+//! \brief Resident memory of the process (Linux), or 0 if unknown.
+// ----------------------------------------------------------------------------
+static size_t residentMemory()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t total_pages = 0;
+    size_t resident_pages = 0;
+    if (!(statm >> total_pages >> resident_pages))
+        return 0;
+    return resident_pages * size_t(sysconf(_SC_PAGESIZE));
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Convert a duration to milliseconds.
+// ----------------------------------------------------------------------------
+static double toMilliseconds(PerformanceHUD::Clock::duration const p_duration)
+{
+    return std::chrono::duration<double, std::milli>(p_duration).count();
+}
+
+// ----------------------------------------------------------------------------
+void PerformanceHUD::newFrame()
+{
+    Clock::time_point const now = Clock::now();
+    m_current.total = now - m_frame_start;
+    m_frame_start = now;
+
+    for (size_t i = 0; i < m_current.stages.size(); ++i)
+    {
+        m_next_window.max_stages[i] =
+            std::max(m_next_window.max_stages[i], m_current.stages[i]);
+    }
+    m_next_window.max_total =
+        std::max(m_next_window.max_total, m_current.total);
+    ++m_window_frames;
+
+    m_last = m_current;
+    m_current = Frame{};
+
+    if (now - m_window_start >= std::chrono::seconds(1))
+    {
+        closeWindow(now);
+    }
+}
+
+// ----------------------------------------------------------------------------
+void PerformanceHUD::addDrawCounts(DrawCounts const& p_counts)
+{
+    m_current.counts.nodes_drawn += p_counts.nodes_drawn;
+    m_current.counts.nodes_culled += p_counts.nodes_culled;
+    m_current.counts.links_drawn += p_counts.links_drawn;
+    m_current.counts.links_culled += p_counts.links_culled;
+}
+
+// ----------------------------------------------------------------------------
+void PerformanceHUD::closeWindow(Clock::time_point const p_now)
+{
+    double const seconds =
+        std::chrono::duration<double>(p_now - m_window_start).count();
+
+    m_next_window.frames_per_second = double(m_window_frames) / seconds;
+    m_next_window.bytes_per_second =
+        double(m_traffic.bytes - m_window_traffic.bytes) / seconds;
+    m_next_window.messages_per_second =
+        double(m_traffic.messages - m_window_traffic.messages) / seconds;
+    m_next_window.status_updates_per_second =
+        double(m_traffic.status_updates - m_window_traffic.status_updates) /
+        seconds;
+    m_next_window.resident_bytes = residentMemory();
+
+    m_window = m_next_window;
+    m_next_window = Window{};
+    m_window_start = p_now;
+    m_window_frames = 0;
+    m_window_traffic = m_traffic;
+}
+
+// ----------------------------------------------------------------------------
+void PerformanceHUD::draw(bool* p_open) const
+{
+    // Top right corner of the main viewport
+    constexpr float margin = 10.0f;
+    ImGuiViewport const* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(
+        ImVec2(viewport->WorkPos.x + viewport->WorkSize.x - margin,
+               viewport->WorkPos.y + margin),
+        ImGuiCond_Always,
+        ImVec2(1.0f, 0.0f));
+    ImGui::SetNextWindowBgAlpha(0.75f);
+
+    ImGuiWindowFlags const flags =
+        ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize |
+        ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing |
+        ImGuiWindowFlags_NoNav | ImGuiWindowFlags_NoMove;
+    if (!ImGui::Begin("Performance HUD", p_open, flags))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Text("Frame: %.2f ms (max %.2f ms), %.0f FPS",
+                toMilliseconds(m_last.total),
+                toMilliseconds(m_window.max_total),
+                m_window.frames_per_second);
+    ImGui::Separator();
+
+    // Per-stage timings of the last frame and peaks of the last second
+    if (ImGui::BeginTable("Stages", 3))
+    {
+        ImGui::TableSetupColumn("Stage");
+        ImGui::TableSetupColumn("Last (ms)");
+        ImGui::TableSetupColumn("Max 1s (ms)");
+        ImGui::TableHeadersRow();
+        for (size_t i = 0; i < m_last.stages.size(); ++i)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(toString(Stage(i)));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", toMilliseconds(m_last.stages[i]));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", toMilliseconds(m_window.max_stages[i]));
+        }
+        ImGui::EndTable();
+    }
+    ImGui::Separator();
+
+    ImGui::Text("Nodes: %zu drawn, %zu culled",
+                m_last.counts.nodes_drawn,
+                m_last.counts.nodes_culled);
+    ImGui::Text("Links: %zu drawn, %zu culled",
+                m_last.counts.links_drawn,
+                m_last.counts.links_culled);
+    ImGui::Separator();
+
+    ImGui::Text("Incoming: %.1f KB/s, %.0f msg/s",
+                m_window.bytes_per_second / 1024.0,
+                m_window.messages_per_second);
+    ImGui::Text("Status updates: %.0f /s",
+                m_window.status_updates_per_second);
+    ImGui::Text("Resident memory: %.1f MB",
+                double(m_window.resident_bytes) / (1024.0 * 1024.0));
+
+    ImGui::End();
+}
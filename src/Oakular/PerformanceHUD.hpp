@@ -0,0 +1,195 @@
+/**
+ * @file PerformanceHUD.hpp
+ * @brief Overlay displaying the per-frame timings and counters of Oakular
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// ****************************************************************************
+//! \brief Performance overlay of Oakular, telling where the time of a frame
+//! goes when the editor gets slow.
+//!
+//! Displays:
+//! - the duration of each stage of the frame (network parsing, layout,
+//!   rendering, blackboard panel), measured by scoped timers cheap enough to
+//!   stay compiled in (two steady clock reads per stage);
+//! - the number of nodes and links drawn versus culled (outside the canvas);
+//! - the incoming bytes, messages and node status updates per second;
+//! - the resident memory of the process.
+//!
+//! Timings are measured whether the overlay is shown or not, so that opening
+//! it shows the current state immediately.
+// ****************************************************************************
+class PerformanceHUD
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    // ------------------------------------------------------------------------
+    //! \brief Timed stages of a frame.
+    // ------------------------------------------------------------------------
+    enum class Stage
+    {
+        Network,    //!< Server::update()
+        Layout,     //!< IDE::autoLayoutNodes()
+        Rendering,  //!< Renderer::drawBehaviorTree()
+        Blackboard, //!< Blackboard panel
+        Count
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the name of a stage.
+    // ------------------------------------------------------------------------
+    static constexpr char const* toString(Stage const p_stage)
+    {
+        constexpr std::array<char const*, size_t(Stage::Count)> names = {
+            "Network", "Layout", "Rendering", "Blackboard"};
+        return names[size_t(p_stage)];
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add the lifetime of the timer to the duration of a stage of
+    //! the current frame.
+    // ------------------------------------------------------------------------
+    class ScopedTimer
+    {
+    public:
+
+        ScopedTimer(PerformanceHUD& p_hud, Stage const p_stage)
+            : m_hud(p_hud), m_stage(p_stage), m_start(Clock::now())
+        {
+        }
+
+        ~ScopedTimer()
+        {
+            m_hud.addTime(m_stage, Clock::now() - m_start);
+        }
+
+        ScopedTimer(ScopedTimer const&) = delete;
+        ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+    private:
+
+        PerformanceHUD& m_hud;
+        Stage m_stage;
+        Clock::time_point m_start;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Number of nodes and links drawn and culled by the renderer.
+    // ------------------------------------------------------------------------
+    struct DrawCounts
+    {
+        size_t nodes_drawn = 0;
+        size_t nodes_culled = 0;
+        size_t links_drawn = 0;
+        size_t links_culled = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Cumulated traffic received by the server.
+    // ------------------------------------------------------------------------
+    struct Traffic
+    {
+        uint64_t bytes = 0;
+        uint64_t messages = 0;
+        uint64_t status_updates = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Close the current frame and start a new one. Call it once per
+    //! frame, before the timed stages.
+    // ------------------------------------------------------------------------
+    void newFrame();
+
+    // ------------------------------------------------------------------------
+    //! \brief Add a duration to a stage of the current frame.
+    // ------------------------------------------------------------------------
+    void addTime(Stage const p_stage, Clock::duration const p_duration)
+    {
+        m_current.stages[size_t(p_stage)] += p_duration;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Add the counts of a drawing of the current frame.
+    // ------------------------------------------------------------------------
+    void addDrawCounts(DrawCounts const& p_counts);
+
+    // ------------------------------------------------------------------------
+    //! \brief Set the traffic received by the server since its start, from
+    //! which the rates per second are computed.
+    // ------------------------------------------------------------------------
+    void setTraffic(Traffic const& p_traffic)
+    {
+        m_traffic = p_traffic;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Draw the overlay in the top right corner of the main viewport.
+    //! \param[in,out] p_open Cleared when the user closes the overlay.
+    // ------------------------------------------------------------------------
+    void draw(bool* p_open) const;
+
+private:
+
+    // ------------------------------------------------------------------------
+    //! \brief Timings and counts of a frame.
+    // ------------------------------------------------------------------------
+    struct Frame
+    {
+        std::array<Clock::duration, size_t(Stage::Count)> stages{};
+        Clock::duration total{};
+        DrawCounts counts;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Rates and peaks refreshed once per second.
+    // ------------------------------------------------------------------------
+    struct Window
+    {
+        double frames_per_second = 0.0;
+        double bytes_per_second = 0.0;
+        double messages_per_second = 0.0;
+        double status_updates_per_second = 0.0;
+        std::array<Clock::duration, size_t(Stage::Count)> max_stages{};
+        Clock::duration max_total{};
+        size_t resident_bytes = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Close the one second window: compute the rates and read the
+    //! memory usage.
+    // ------------------------------------------------------------------------
+    void closeWindow(Clock::time_point const p_now);
+
+private:
+
+    //! \brief Frame being measured.
+    Frame m_current;
+    //! \brief Last complete frame.
+    Frame m_last;
+    //! \brief Beginning of the current frame.
+    Clock::time_point m_frame_start = Clock::now();
+
+    //! \brief Values of the last complete window.
+    Window m_window;
+    //! \brief Peaks of the current window.
+    Window m_next_window;
+    //! \brief Beginning of the current window.
+    Clock::time_point m_window_start = Clock::now();
+    //! \brief Number of frames of the current window.
+    size_t m_window_frames = 0;
+    //! \brief Traffic at the beginning of the current window.
+    Traffic m_window_traffic;
+    //! \brief Traffic received so far.
+    Traffic m_traffic;
+};
@@ -11,6 +11,8 @@
 
 #include <imgui.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <iomanip>
 #include <sstream>
@@ -191,6 +193,13 @@ void Renderer::drawBehaviorTree(std::unordered_map<ID, IDE::Node>& p_nodes,
         calculatePinPositions(visual, has_input, has_output, is_top_to_bottom);
     }
 
+    // Nodes and links outside the canvas are not drawn (their visuals are
+    // still computed for the interactions)
+    ImRect const canvas(m_canvas_pos,
+                        ImVec2(m_canvas_pos.x + m_canvas_size.x,
+                               m_canvas_pos.y + m_canvas_size.y));
+    m_draw_counts = PerformanceHUD::DrawCounts{};
+
     // Second pass: draw links (below nodes)
     for (auto const& link : p_links)
     {
@@ -201,6 +210,17 @@ void Renderer::drawBehaviorTree(std::unordered_map<ID, IDE::Node>& p_nodes,
         {
             ImVec2 start = from_it->second.output_pin_pos;
             ImVec2 end = to_it->second.input_pin_pos;
+
+            // The bezier curve stays within the box of its end points
+            ImRect box(ImMin(start, end), ImMax(start, end));
+            box.Expand(LINK_THICKNESS);
+            if (!canvas.Overlaps(box))
+            {
+                ++m_draw_counts.links_culled;
+                continue;
+            }
+            ++m_draw_counts.links_drawn;
+
             bool is_selected = (link.from_node == m_selected_link_from &&
                                 link.to_node == m_selected_link_to);
             bool is_top_to_bottom =
@@ -229,6 +249,12 @@ void Renderer::drawBehaviorTree(std::unordered_map<ID, IDE::Node>& p_nodes,
          static_cast<int>(IDE::LayoutDirection::TopToBottom));
     for (auto& [id, node] : p_nodes)
     {
+        if (!canvas.Overlaps(m_node_visuals[id].bounds))
+        {
+            ++m_draw_counts.nodes_culled;
+            continue;
+        }
+        ++m_draw_counts.nodes_drawn;
         drawNode(node, is_top_to_bottom);
     }
 
@@ -295,6 +321,17 @@ void Renderer::drawNode(IDE::Node const& p_node, bool p_is_top_to_bottom)
     draw_list->AddRectFilled(
         pos, ImVec2(pos.x + size.x, pos.y + size.y), bg_color, NODE_ROUNDING);
 
+    // Heat overlay of the sampling profiler: the hotter the branch, the
+    // redder the body
+    if (p_node.heat_total > 0)
+    {
+        auto alpha = int(40 + 2 * std::min(p_node.heat_total, 100));
+        draw_list->AddRectFilled(pos,
+                                 ImVec2(pos.x + size.x, pos.y + size.y),
+                                 IM_COL32(255, 40, 0, alpha),
+                                 NODE_ROUNDING);
+    }
+
     // Header
     float header_height = 24.0f;
     draw_list->AddRectFilled(pos,
@@ -317,6 +354,26 @@ void Renderer::drawNode(IDE::Node const& p_node, bool p_is_top_to_bottom)
             button_pos, IM_COL32(150, 200, 255, 255), expand_text);
     }
 
+    // Rank in the evaluation order chosen by an unordered parent
+    if (p_node.evaluation_rank >= 0)
+    {
+        std::string rank_text = "#" + std::to_string(p_node.evaluation_rank + 1);
+        float offset = (p_node.type == "SubTree") ? 60.0f : 30.0f;
+        auto rank_pos = ImVec2(pos.x + size.x - offset, pos.y + 4);
+        draw_list->AddText(
+            rank_pos, IM_COL32(255, 255, 255, 200), rank_text.c_str());
+    }
+
+    // Share of the profiler samples in the branch and in the node itself
+    if (p_node.heat_total > 0)
+    {
+        std::string heat_text = std::to_string(p_node.heat_total) + "% (self " +
+                                std::to_string(p_node.heat_self) + "%)";
+        auto heat_pos = ImVec2(pos.x + NODE_PADDING, pos.y + size.y - 18);
+        draw_list->AddText(
+            heat_pos, IM_COL32(255, 220, 200, 255), heat_text.c_str());
+    }
+
     // Node name
     text_pos.y += header_height + NODE_PADDING;
     draw_list->AddText(
@@ -332,6 +389,65 @@ void Renderer::drawNode(IDE::Node const& p_node, bool p_is_top_to_bottom)
         text_pos.y += 18;
     }
 
+    // SetBlackboard assignment
+    if (p_node.type == "SetBlackboard" && !p_node.set_key.empty())
+    {
+        std::string set_text = p_node.set_key + " = " + p_node.set_value;
+        if (p_node.set_type != "auto")
+        {
+            set_text += " (" + p_node.set_type + ")";
+        }
+        draw_list->AddText(
+            text_pos, IM_COL32(180, 180, 180, 200), set_text.c_str());
+        text_pos.y += 18;
+    }
+
+    // Share of the tree instances in each status (aggregated visualizer)
+    uint32_t instances = 0;
+    for (uint32_t count : p_node.distribution)
+    {
+        instances += count;
+    }
+    if (instances > 0)
+    {
+        static constexpr std::array<char const*, 4> labels = {
+            "I", "R", "S", "F"};
+        static constexpr std::array<ImU32, 4> colors = {
+            IM_COL32(80, 80, 80, 255),
+            IM_COL32(255, 180, 0, 255),
+            IM_COL32(50, 200, 50, 255),
+            IM_COL32(200, 50, 50, 255)};
+
+        std::string share_text;
+        for (size_t i = 0; i < p_node.distribution.size(); ++i)
+        {
+            if (p_node.distribution[i] > 0)
+            {
+                share_text += std::string(labels[i]) + " " +
+                              std::to_string(100u * p_node.distribution[i] /
+                                             instances) +
+                              "% ";
+            }
+        }
+        draw_list->AddText(
+            text_pos, IM_COL32(220, 220, 220, 255), share_text.c_str());
+        text_pos.y += 18;
+
+        // Stacked bar of the shares
+        float const bar_width = size.x - 2.0f * NODE_PADDING;
+        float x = text_pos.x;
+        for (size_t i = 0; i < p_node.distribution.size(); ++i)
+        {
+            float const width =
+                bar_width * float(p_node.distribution[i]) / float(instances);
+            draw_list->AddRectFilled(ImVec2(x, text_pos.y),
+                                     ImVec2(x + width, text_pos.y + 6),
+                                     colors[i]);
+            x += width;
+        }
+        text_pos.y += 8;
+    }
+
     // Inputs
     if (!p_node.inputs.empty())
     {
@@ -718,6 +834,20 @@ ImVec2 Renderer::calculateNodeSize(const IDE::Node& p_node) const
         height += 18.0f + 18.0f; // Reference + expand button
     }
 
+    // SetBlackboard assignment
+    if (p_node.type == "SetBlackboard" && !p_node.set_key.empty())
+    {
+        height += 18.0f;
+    }
+
+    // Share of the tree instances in each status
+    if (std::any_of(p_node.distribution.begin(),
+                    p_node.distribution.end(),
+                    [](uint32_t p_count) { return p_count > 0; }))
+    {
+        height += 18.0f + 8.0f; // Shares + stacked bar
+    }
+
     // Inputs
     if (!p_node.inputs.empty())
     {
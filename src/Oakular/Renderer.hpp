@@ -116,6 +116,15 @@ public:
         return screenToCanvas(screen_pos);
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of nodes and links drawn and culled (outside the
+    //! canvas) by the last call to drawBehaviorTree().
+    // ------------------------------------------------------------------------
+    PerformanceHUD::DrawCounts const& drawCounts() const
+    {
+        return m_draw_counts;
+    }
+
 private:
 
     // ------------------------------------------------------------------------
@@ -278,4 +287,6 @@ private:
     bool m_link_deleted_this_frame = false;
     bool m_link_dropped_in_void = false;
     int m_layout_direction = 1; // 0 = LeftToRight, 1 = TopToBottom
+    //! \brief Nodes and links drawn and culled by the last drawing.
+    PerformanceHUD::DrawCounts m_draw_counts;
 };
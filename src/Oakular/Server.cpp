@@ -60,6 +60,15 @@ void Server::stop()
     m_receive_buffer.clear();
     m_node_states.clear();
     m_states_updated = false;
+    m_child_orders.clear();
+    m_orders_updated = false;
+    m_node_heat.clear();
+    m_heat_updated = false;
+    m_node_distribution.clear();
+    m_distribution_instances = 0;
+    m_distribution_updated = false;
+    m_patches.clear();
+    m_pending_patch.reset();
 
     std::cout << "Server stopped" << std::endl;
 }
@@ -104,6 +113,7 @@ void Server::parseStatusMessage(std::string const& msg)
             int node_id = std::stoi(pair.substr(0, colon_pos));
             int status = std::stoi(pair.substr(colon_pos + 1));
             m_node_states[node_id] = status;
+            ++m_statistics.status_updates;
         }
         catch (std::exception const&)
         {
@@ -115,6 +125,230 @@ void Server::parseStatusMessage(std::string const& msg)
     m_states_updated = true;
 }
 
+// ----------------------------------------------------------------------------
+void Server::parseOrderMessage(std::string const& msg)
+{
+    // Format: "O:node_id:child_id,child_id,...\n"
+    if (msg.size() < 3 || msg[0] != 'O' || msg[1] != ':')
+    {
+        return;
+    }
+
+    std::string data = msg.substr(2);
+    if (!data.empty() && data.back() == '\n')
+    {
+        data.pop_back();
+    }
+
+    size_t colon_pos = data.find(':');
+    if (colon_pos == std::string::npos)
+    {
+        return;
+    }
+
+    try
+    {
+        int node_id = std::stoi(data.substr(0, colon_pos));
+        std::vector<int> order;
+        std::istringstream stream(data.substr(colon_pos + 1));
+        std::string child;
+        while (std::getline(stream, child, ','))
+        {
+            order.push_back(std::stoi(child));
+        }
+        m_child_orders[node_id] = std::move(order);
+    }
+    catch (std::exception const&)
+    {
+        // Ignore parsing errors
+        return;
+    }
+
+    m_orders_updated = true;
+}
+
+// ----------------------------------------------------------------------------
+void Server::parseHeatMessage(std::string const& msg)
+{
+    // Format: "H:node_id:total:self,node_id:total:self,...\n"
+    if (msg.size() < 2 || msg[0] != 'H' || msg[1] != ':')
+    {
+        return;
+    }
+
+    std::string data = msg.substr(2);
+    if (!data.empty() && data.back() == '\n')
+    {
+        data.pop_back();
+    }
+
+    // Each message is a full profile: nodes absent are no longer hot
+    m_node_heat.clear();
+    std::istringstream stream(data);
+    std::string entry;
+    while (std::getline(stream, entry, ','))
+    {
+        size_t first = entry.find(':');
+        size_t second = entry.find(':', first + 1u);
+        if (first == std::string::npos || second == std::string::npos)
+        {
+            continue;
+        }
+
+        try
+        {
+            int node_id = std::stoi(entry.substr(0, first));
+            int total =
+                std::stoi(entry.substr(first + 1u, second - first - 1u));
+            int self = std::stoi(entry.substr(second + 1u));
+            m_node_heat[node_id] = {total, self};
+        }
+        catch (std::exception const&)
+        {
+            // Ignore parsing errors
+            continue;
+        }
+    }
+
+    m_heat_updated = true;
+}
+
+// ----------------------------------------------------------------------------
+void Server::parseDistributionMessage(std::string const& msg)
+{
+    // Format: "D:instances:node_id:invalid:running:success:failure,...\n"
+    if (msg.size() < 3 || msg[0] != 'D' || msg[1] != ':')
+    {
+        return;
+    }
+
+    std::string data = msg.substr(2);
+    if (!data.empty() && data.back() == '\n')
+    {
+        data.pop_back();
+    }
+
+    size_t colon_pos = data.find(':');
+    if (colon_pos == std::string::npos)
+    {
+        return;
+    }
+
+    // Each message is a full distribution: nodes absent are no longer used
+    m_node_distribution.clear();
+    try
+    {
+        m_distribution_instances =
+            uint32_t(std::stoul(data.substr(0, colon_pos)));
+    }
+    catch (std::exception const&)
+    {
+        // Ignore parsing errors
+        return;
+    }
+
+    std::istringstream stream(data.substr(colon_pos + 1));
+    std::string entry;
+    while (std::getline(stream, entry, ','))
+    {
+        std::istringstream fields(entry);
+        std::string field;
+        std::array<uint32_t, 4> counts{};
+        int node_id = 0;
+        size_t count = 0;
+        try
+        {
+            for (; std::getline(fields, field, ':') && count < 5u; ++count)
+            {
+                if (count == 0u)
+                {
+                    node_id = std::stoi(field);
+                }
+                else
+                {
+                    counts[count - 1u] = uint32_t(std::stoul(field));
+                }
+            }
+        }
+        catch (std::exception const&)
+        {
+            // Ignore parsing errors
+            continue;
+        }
+        if (count == 5u)
+        {
+            m_node_distribution[node_id] = counts;
+        }
+    }
+
+    m_distribution_updated = true;
+}
+
+// ----------------------------------------------------------------------------
+void Server::parsePatchMessage(std::string const& msg)
+{
+    // Format: "PATCH:INSERT:parent_id:index\n" followed by the YAML branch
+    // and "END_PATCH\n", "PATCH:REMOVE:node_id\n", or "PATCH:REPLACE:node_id\n"
+    // followed by the YAML branch and "END_PATCH\n"
+    std::string data = msg.substr(6);
+    if (!data.empty() && data.back() == '\n')
+    {
+        data.pop_back();
+    }
+
+    size_t colon_pos = data.find(':');
+    if (colon_pos == std::string::npos)
+    {
+        return;
+    }
+
+    std::string const kind = data.substr(0, colon_pos);
+    std::string const arguments = data.substr(colon_pos + 1);
+    StructurePatch patch;
+    try
+    {
+        if (kind == "INSERT")
+        {
+            size_t index_pos = arguments.find(':');
+            if (index_pos == std::string::npos)
+            {
+                return;
+            }
+            patch.kind = StructurePatch::Kind::Insert;
+            patch.node_id = std::stoi(arguments.substr(0, index_pos));
+            patch.index = size_t(std::stoul(arguments.substr(index_pos + 1)));
+        }
+        else if (kind == "REMOVE")
+        {
+            patch.kind = StructurePatch::Kind::Remove;
+            patch.node_id = std::stoi(arguments);
+        }
+        else if (kind == "REPLACE")
+        {
+            patch.kind = StructurePatch::Kind::Replace;
+            patch.node_id = std::stoi(arguments);
+        }
+        else
+        {
+            return;
+        }
+    }
+    catch (std::exception const&)
+    {
+        // Ignore parsing errors
+        return;
+    }
+
+    if (patch.kind == StructurePatch::Kind::Remove)
+    {
+        m_patches.push_back(std::move(patch));
+    }
+    else
+    {
+        m_pending_patch = std::make_unique<StructurePatch>(std::move(patch));
+    }
+}
+
 // ----------------------------------------------------------------------------
 void Server::update()
 {
@@ -139,6 +373,15 @@ void Server::update()
             m_yaml_data.clear();
             m_node_states.clear();
             m_states_updated = false;
+            m_child_orders.clear();
+            m_orders_updated = false;
+            m_node_heat.clear();
+            m_heat_updated = false;
+            m_node_distribution.clear();
+            m_distribution_instances = 0;
+            m_distribution_updated = false;
+            m_patches.clear();
+            m_pending_patch.reset();
         }
         else
         {
@@ -158,6 +401,7 @@ void Server::update()
         if (status == sf::Socket::Done)
         {
             m_receive_buffer.append(buffer, received);
+            m_statistics.bytes += received;
 
             // Process complete messages (ending with newline)
             size_t newline_pos;
@@ -167,9 +411,23 @@ void Server::update()
                 std::string message =
                     m_receive_buffer.substr(0, newline_pos + 1);
                 m_receive_buffer.erase(0, newline_pos + 1);
+                ++m_statistics.messages;
 
                 // Check message type
-                if (message.rfind("YAML:", 0) == 0)
+                if (m_pending_patch)
+                {
+                    // YAML branch of a patch - accumulate until END_PATCH
+                    if (message.rfind("END_PATCH", 0) == 0)
+                    {
+                        m_patches.push_back(std::move(*m_pending_patch));
+                        m_pending_patch.reset();
+                    }
+                    else
+                    {
+                        m_pending_patch->yaml += message;
+                    }
+                }
+                else if (message.rfind("YAML:", 0) == 0)
                 {
                     // YAML message - accumulate until END_YAML
                     m_yaml_data += message.substr(5); // Remove "YAML:" prefix
@@ -186,6 +444,26 @@ void Server::update()
                     // Status update message
                     parseStatusMessage(message);
                 }
+                else if (message.rfind("O:", 0) == 0)
+                {
+                    // Evaluation order of an unordered composite
+                    parseOrderMessage(message);
+                }
+                else if (message.rfind("H:", 0) == 0)
+                {
+                    // Heat overlay of the sampling profiler
+                    parseHeatMessage(message);
+                }
+                else if (message.rfind("D:", 0) == 0)
+                {
+                    // Distribution of the statuses across the instances
+                    parseDistributionMessage(message);
+                }
+                else if (message.rfind("PATCH:", 0) == 0)
+                {
+                    // Incremental change of the tree structure
+                    parsePatchMessage(message);
+                }
                 else if (!m_has_tree)
                 {
                     // Could be continuation of YAML data
@@ -214,6 +492,15 @@ void Server::update()
             m_has_tree = false;
             m_node_states.clear();
             m_states_updated = false;
+            m_child_orders.clear();
+            m_orders_updated = false;
+            m_node_heat.clear();
+            m_heat_updated = false;
+            m_node_distribution.clear();
+            m_distribution_instances = 0;
+            m_distribution_updated = false;
+            m_patches.clear();
+            m_pending_patch.reset();
         }
         // sf::Socket::NotReady is normal in non-blocking mode
     }
@@ -10,10 +10,12 @@
 
 #include <SFML/Network.hpp>
 
+#include <array>
 #include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // ****************************************************************************
 //! \briefTCP server that receives behavior tree data from clients
@@ -26,6 +28,41 @@ class Server
 {
 public:
 
+    // ------------------------------------------------------------------------
+    //! \brief Traffic received since the creation of the server.
+    // ------------------------------------------------------------------------
+    struct Statistics
+    {
+        //! \brief Number of bytes received.
+        uint64_t bytes = 0;
+        //! \brief Number of messages (lines) received.
+        uint64_t messages = 0;
+        //! \brief Number of node status updates received.
+        uint64_t status_updates = 0;
+    };
+
+    // ------------------------------------------------------------------------
+    //! \brief Incremental change of the structure of the received tree.
+    // ------------------------------------------------------------------------
+    struct StructurePatch
+    {
+        enum class Kind
+        {
+            Insert,  //!< Insert the branch under the node at the index
+            Remove,  //!< Remove the node and its descendants
+            Replace, //!< Replace the node and its descendants by the branch
+        };
+
+        Kind kind = Kind::Insert;
+        //! \brief ID of the parent node (Insert) or of the node to remove or
+        //! replace.
+        int node_id = -1;
+        //! \brief Position of the branch among the children (Insert).
+        size_t index = 0;
+        //! \brief YAML of the branch (Insert, Replace), with _id fields.
+        std::string yaml;
+    };
+
     ~Server();
 
     // ------------------------------------------------------------------------
@@ -106,6 +143,124 @@ public:
         m_states_updated = false;
     }
 
+    // ------------------------------------------------------------------------
+    //! \brief Check if evaluation orders of unordered composites have been
+    //! received.
+    // ------------------------------------------------------------------------
+    bool hasOrderUpdate() const
+    {
+        return m_orders_updated;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the evaluation orders of unordered composites.
+    //! \return The map composite node ID -> child node IDs in the order they
+    //! are ticked.
+    // ------------------------------------------------------------------------
+    std::unordered_map<int, std::vector<int>> const& getChildOrders() const
+    {
+        return m_child_orders;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Clear the orders update flag after reading.
+    // ------------------------------------------------------------------------
+    void clearOrderUpdate()
+    {
+        m_orders_updated = false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a heat overlay of the sampling profiler has been
+    //! received.
+    // ------------------------------------------------------------------------
+    bool hasHeatUpdate() const
+    {
+        return m_heat_updated;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the heat overlay of the last profile received.
+    //! \return The map node ID -> (percentage of the samples in its branch,
+    //! percentage of the samples in the node itself). Nodes not sampled are
+    //! absent.
+    // ------------------------------------------------------------------------
+    std::unordered_map<int, std::pair<int, int>> const& getNodeHeat() const
+    {
+        return m_node_heat;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Clear the heat update flag after reading.
+    // ------------------------------------------------------------------------
+    void clearHeatUpdate()
+    {
+        m_heat_updated = false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if a distribution of the statuses across the instances of
+    //! the tree has been received.
+    // ------------------------------------------------------------------------
+    bool hasDistributionUpdate() const
+    {
+        return m_distribution_updated;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the distribution of the statuses of the last message.
+    //! \return The map node ID -> number of instances in each status (indexed
+    //! by 0=INVALID, 1=RUNNING, 2=SUCCESS, 3=FAILURE).
+    // ------------------------------------------------------------------------
+    std::unordered_map<int, std::array<uint32_t, 4>> const&
+    getNodeDistribution() const
+    {
+        return m_node_distribution;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the number of instances of the last distribution received.
+    // ------------------------------------------------------------------------
+    uint32_t getDistributionInstances() const
+    {
+        return m_distribution_instances;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Clear the distribution update flag after reading.
+    // ------------------------------------------------------------------------
+    void clearDistributionUpdate()
+    {
+        m_distribution_updated = false;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Check if structure patches have been received.
+    // ------------------------------------------------------------------------
+    bool hasStructurePatches() const
+    {
+        return !m_patches.empty();
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the structure patches received since the last call, in the
+    //! order they have to be applied.
+    // ------------------------------------------------------------------------
+    std::vector<StructurePatch> takeStructurePatches()
+    {
+        std::vector<StructurePatch> patches;
+        patches.swap(m_patches);
+        return patches;
+    }
+
+    // ------------------------------------------------------------------------
+    //! \brief Get the traffic received since the creation of the server.
+    // ------------------------------------------------------------------------
+    Statistics const& statistics() const
+    {
+        return m_statistics;
+    }
+
 private:
 
     // ------------------------------------------------------------------------
@@ -115,6 +270,33 @@ private:
     // ------------------------------------------------------------------------
     void parseStatusMessage(std::string const& msg);
 
+    // ------------------------------------------------------------------------
+    //! \brief Parse an evaluation order message of an unordered composite.
+    //! \param[in] msg The message in format "O:node_id:child_id,child_id,..."
+    // ------------------------------------------------------------------------
+    void parseOrderMessage(std::string const& msg);
+
+    // ------------------------------------------------------------------------
+    //! \brief Parse a heat overlay message of the sampling profiler.
+    //! \param[in] msg The message in format "H:node_id:total:self,..."
+    // ------------------------------------------------------------------------
+    void parseHeatMessage(std::string const& msg);
+
+    // ------------------------------------------------------------------------
+    //! \brief Parse a distribution message of the status aggregator.
+    //! \param[in] msg The message in format
+    //! "D:instances:node_id:invalid:running:success:failure,..."
+    // ------------------------------------------------------------------------
+    void parseDistributionMessage(std::string const& msg);
+
+    // ------------------------------------------------------------------------
+    //! \brief Parse the first line of a structure patch. Patches carrying a
+    //! branch wait for their YAML lines until "END_PATCH".
+    //! \param[in] msg The message in format "PATCH:INSERT:parent_id:index",
+    //! "PATCH:REMOVE:node_id" or "PATCH:REPLACE:node_id"
+    // ------------------------------------------------------------------------
+    void parsePatchMessage(std::string const& msg);
+
     std::unique_ptr<sf::TcpListener> m_listener;
     std::unique_ptr<sf::TcpSocket> m_client_socket;
     bool m_connected = false;
@@ -128,4 +310,25 @@ private:
     std::unordered_map<int, int> m_node_states;
     //! \brief Flag indicating if states have been updated since last read
     bool m_states_updated = false;
+    //! \brief Evaluation order of unordered composites (node ID -> child IDs)
+    std::unordered_map<int, std::vector<int>> m_child_orders;
+    //! \brief Flag indicating if orders have been updated since last read
+    bool m_orders_updated = false;
+    //! \brief Heat of the profiled nodes (node ID -> total %, self %)
+    std::unordered_map<int, std::pair<int, int>> m_node_heat;
+    //! \brief Flag indicating if the heat has been updated since last read
+    bool m_heat_updated = false;
+    //! \brief Statuses of the nodes across the instances (node ID -> counts)
+    std::unordered_map<int, std::array<uint32_t, 4>> m_node_distribution;
+    //! \brief Number of instances of the distribution
+    uint32_t m_distribution_instances = 0;
+    //! \brief Flag indicating if the distribution has been updated since
+    //! last read
+    bool m_distribution_updated = false;
+    //! \brief Structure patches not read yet
+    std::vector<StructurePatch> m_patches;
+    //! \brief Patch waiting for the end of its YAML branch
+    std::unique_ptr<StructurePatch> m_pending_patch;
+    //! \brief Traffic received since the creation of the server
+    Statistics m_statistics;
 };
@@ -142,6 +142,45 @@ public:
     void accept(bt::BehaviorTreeVisitor&) override {}
 };
 
+// ****************************************************************************
+//! \brief Test leaf node like Calculate, with typed port handles.
+// ****************************************************************************
+class TypedCalculate: public bt::Leaf
+{
+public:
+
+    bt::PortList providedPorts() const override
+    {
+        bt::PortList ports;
+        ports.addInput<int>(m_a.name());
+        ports.addInput<int>(m_b.name());
+        ports.addOutput<int>(m_result.name());
+        return ports;
+    }
+
+    bt::Status onRunning() override
+    {
+        auto a = getInput(m_a);
+        auto b = getInput(m_b);
+        if (a && b)
+        {
+            setOutput(m_result, *a + *b);
+            return bt::Status::SUCCESS;
+        }
+
+        return bt::Status::FAILURE;
+    }
+
+    void accept(bt::ConstBehaviorTreeVisitor&) const override {}
+    void accept(bt::BehaviorTreeVisitor&) override {}
+
+private:
+
+    bt::Key<int> const m_a{"a"};
+    bt::Key<int> const m_b{"b"};
+    bt::Key<int> const m_result{"result"};
+};
+
 // ****************************************************************************
 //! \brief Test leaf node that processes Position structs from blackboard.
 //! \details Used for testing custom struct types with blackboard ports.
@@ -409,6 +448,200 @@ TEST(TestBlackboard, CreateChild)
     EXPECT_FALSE(parent->has("child_data"));
 }
 
+// ===========================================================================
+// In-place Mutation Tests
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test that modify updates the stored container without copying it.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, ModifyInPlace)
+{
+    // GIVEN: A blackboard holding a vector
+    auto bb = std::make_shared<bt::Blackboard>();
+    int const* storage =
+        bb->emplace<std::vector<int>>("samples", 1000u, 0).data();
+    auto version = bb->version("samples");
+
+    // WHEN: Modifying the vector in place
+    bool found = bb->modify<std::vector<int>>(
+        "samples", [&storage](std::vector<int>& p_samples) {
+            EXPECT_EQ(p_samples.data(), storage);
+            p_samples[0] = 42;
+        });
+
+    // THEN: EXPECT the value is updated and the version bumped once
+    EXPECT_TRUE(found);
+    EXPECT_EQ(bb->get<std::vector<int>>("samples")->at(0), 42);
+    EXPECT_EQ(bb->version("samples"), version + 1u);
+
+    // Unknown key or type mismatch: the function is not called
+    EXPECT_FALSE(bb->modify<std::vector<int>>(
+        "unknown", [](std::vector<int>&) { FAIL(); }));
+    EXPECT_FALSE(
+        bb->modify<std::string>("samples", [](std::string&) { FAIL(); }));
+    EXPECT_EQ(bb->version("samples"), version + 1u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test that modify reaches entries of the parent blackboard.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, ModifyParentEntry)
+{
+    auto parent = std::make_shared<bt::Blackboard>();
+    parent->set("counter", 1);
+    auto child = parent->createChild();
+
+    EXPECT_TRUE(child->modify<int>("counter", [](int& p_value) { ++p_value; }));
+    EXPECT_EQ(parent->get<int>("counter").value(), 2);
+    EXPECT_TRUE(child->keys().empty());
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test that every write bumps the version of the entry.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, Versions)
+{
+    bt::Blackboard bb;
+    EXPECT_EQ(bb.version("value"), 0u);
+
+    bb.set("value", 1);
+    EXPECT_EQ(bb.version("value"), 1u);
+    bb.set("value", 2);
+    bb.setRaw("value", std::any(3));
+    EXPECT_EQ(bb.version("value"), 3u);
+    bb.emplace<std::string>("value", 4u, 'x');
+    EXPECT_EQ(bb.version("value"), 4u);
+    EXPECT_EQ(bb.get<std::string>("value").value(), "xxxx");
+
+    bb.remove("value");
+    EXPECT_EQ(bb.version("value"), 0u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test that a fork shares values until one side writes them.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, ForkCopyOnWrite)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->emplace<std::vector<int>>("samples", 1000u, 1);
+    bb->set("count", 1);
+
+    auto fork = bb->fork();
+    EXPECT_EQ(fork->lookup("samples"), bb->lookup("samples"));
+    EXPECT_EQ(fork->version("count"), 1u);
+
+    // Writing one entry of the fork copies this entry only
+    EXPECT_TRUE(fork->modify<std::vector<int>>(
+        "samples", [](std::vector<int>& p_samples) { p_samples[0] = 2; }));
+    EXPECT_NE(fork->lookup("samples"), bb->lookup("samples"));
+    EXPECT_EQ(bb->get<std::vector<int>>("samples")->at(0), 1);
+    EXPECT_EQ(fork->get<std::vector<int>>("samples")->at(0), 2);
+    EXPECT_EQ(fork->lookup("count"), bb->lookup("count"));
+
+    // Writes to the original are not seen by the fork
+    bb->set("count", 5);
+    bb->remove("samples");
+    EXPECT_EQ(fork->get<int>("count"), 1);
+    EXPECT_TRUE(fork->has("samples"));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test that forking a child blackboard forks its parents once.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, ForkParents)
+{
+    auto parent = std::make_shared<bt::Blackboard>();
+    parent->set("shared", 1);
+    auto first = parent->createChild();
+    auto second = parent->createChild();
+
+    bt::Blackboard::Forks forks;
+    auto first_fork = first->fork(forks);
+    auto second_fork = second->fork(forks);
+    ASSERT_EQ(forks.size(), 3u);
+    auto parent_fork = forks.at(parent.get());
+
+    // Both forked children see the same forked parent
+    EXPECT_TRUE(second_fork->modify<int>("shared", [](int& p) { p = 2; }));
+    EXPECT_EQ(first_fork->get<int>("shared"), 2);
+    EXPECT_EQ(parent_fork->get<int>("shared"), 2);
+    EXPECT_EQ(parent->get<int>("shared"), 1);
+}
+
+// ===========================================================================
+// Key Handle Tests (Key.hpp)
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test that key handles and strings name the same entries.
+//! \details GIVEN a child blackboard and a handle, WHEN writing and reading
+//!          through the handle or the name, locally and in the parent, THEN
+//!          EXPECT the same entries are accessed and the listener receives
+//!          the name of the key.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, KeyHandles)
+{
+    // GIVEN: A child blackboard and a handle
+    auto parent = std::make_shared<bt::Blackboard>();
+    auto child = parent->createChild();
+    bt::BlackboardKey const health("health");
+    std::vector<std::string> written;
+    child->setListener(
+        [&written](std::string const& p_key, bt::Blackboard::Version, auto)
+        { written.push_back(p_key); });
+
+    // WHEN: Writing through the handle in the parent
+    parent->set(health, 100);
+
+    // THEN: EXPECT the child finds it by handle and by name
+    EXPECT_EQ(child->get<int>(health), 100);
+    EXPECT_EQ(child->get<int>("health"), 100);
+    EXPECT_EQ(child->get<int>(std::string_view("health")), 100);
+    EXPECT_TRUE(child->has(health));
+    EXPECT_EQ(child->version(health), 1u);
+
+    // WHEN: Writing through the handle in the child
+    child->set(health, 50);
+    EXPECT_TRUE(child->modify<int>("health", [](int& p) { p -= 10; }));
+
+    // THEN: EXPECT the local entry hides the one of the parent
+    EXPECT_EQ(child->get<int>(health), 40);
+    EXPECT_EQ(parent->get<int>(health), 100);
+    EXPECT_EQ(child->keys(), std::vector<std::string>({"health"}));
+    EXPECT_EQ(written, std::vector<std::string>({"health", "health"}));
+
+    // WHEN: Removing it by handle
+    child->remove(health);
+
+    // THEN: EXPECT the entry of the parent is visible again
+    EXPECT_EQ(child->get<int>("health"), 100);
+    EXPECT_EQ(written.size(), 3u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the typed key handles.
+//! \details GIVEN a typed key, WHEN setting a value of another type, THEN
+//!          EXPECT it is stored with the type of the key and read without
+//!          template argument.
+// ------------------------------------------------------------------------
+TEST(TestBlackboard, TypedKeys)
+{
+    // GIVEN: A typed key
+    auto bb = std::make_shared<bt::Blackboard>();
+    bt::Key<double> const speed("speed");
+
+    // WHEN: Setting a value of another type
+    bb->set(speed, 2);
+
+    // THEN: EXPECT it is stored with the type of the key
+    std::optional<double> value = bb->get(speed);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_DOUBLE_EQ(*value, 2.0);
+    EXPECT_FALSE(bb->get<int>("speed").has_value());
+    EXPECT_DOUBLE_EQ(bb->getOrDefault(speed, 0.0), 2.0);
+}
+
 // ===========================================================================
 // Variable Resolution Tests (Resolver.hpp)
 // ===========================================================================
@@ -566,6 +799,35 @@ TEST(TestVariableResolver, ResolveNonExistentVariable)
     EXPECT_EQ(result, "${missing}");
 }
 
+// ------------------------------------------------------------------------
+//! \brief Test the exception-free parsing of references and literals.
+//! \details GIVEN malformed references and literals, WHEN resolving them,
+//!          THEN EXPECT no match or std::nullopt instead of exceptions.
+// ------------------------------------------------------------------------
+TEST(TestVariableResolver, MalformedExpressions)
+{
+    bt::Blackboard bb;
+    bb.set("a", std::string("x"));
+
+    std::string_view key;
+    EXPECT_TRUE(bt::VariableResolver::isReference("${a}", key));
+    EXPECT_EQ(key, "a");
+    EXPECT_FALSE(bt::VariableResolver::isReference("${}", key));
+    EXPECT_FALSE(bt::VariableResolver::isReference("${a", key));
+    EXPECT_FALSE(bt::VariableResolver::isReference("${a}${b}", key));
+    EXPECT_FALSE(bt::VariableResolver::isReference("a}", key));
+
+    EXPECT_EQ(bt::VariableResolver::resolve("${}${a}-${a", bb), "${}x-${a");
+
+    EXPECT_FALSE(bt::VariableResolver::resolveValue<int>("abc", bb));
+    EXPECT_FALSE(bt::VariableResolver::resolveValue<int>("99999999999", bb));
+    EXPECT_FALSE(bt::VariableResolver::resolveValue<int>(" 12px", bb));
+    EXPECT_EQ(*bt::VariableResolver::resolveValue<int>("0x1F", bb), 31);
+    EXPECT_FALSE(bt::VariableResolver::resolveValue<double>("", bb));
+    EXPECT_DOUBLE_EQ(*bt::VariableResolver::resolveValue<double>("2.5", bb),
+                     2.5);
+}
+
 // ===========================================================================
 // Port System Tests (Ports.hpp)
 // ===========================================================================
@@ -751,3 +1013,32 @@ TEST(TestNodeWithBlackboard, LiteralValues)
     ASSERT_TRUE(result.has_value());
     EXPECT_EQ(*result, 12);
 }
+
+// ------------------------------------------------------------------------
+//! \brief Test node integration with blackboard using typed port handles.
+//! \details GIVEN a node reading and writing its ports through Key<int>
+//!          handles, WHEN executing the node, THEN EXPECT the ports are
+//!          remapped like string ports.
+// ------------------------------------------------------------------------
+TEST(TestNodeWithBlackboard, TypedPorts)
+{
+    // GIVEN: A node reading and writing its ports through handles
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("x", 10);
+
+    auto node = std::make_unique<TypedCalculate>();
+    node->setBlackboard(bb);
+
+    // WHEN: Executing the node
+    std::unordered_map<std::string, std::string> config;
+    config["a"] = "${x}";
+    config["b"] = "7";
+    config["result"] = "${sum}";
+    node->setPortRemapping(config);
+
+    bt::Status status = node->tick();
+    EXPECT_EQ(status, bt::Status::SUCCESS);
+
+    // THEN: EXPECT the ports are remapped like string ports
+    EXPECT_EQ(bb->get<int>("sum"), 17);
+}
@@ -0,0 +1,173 @@
+/**
+ * @file TestJournal.cpp
+ * @brief Unit tests for the blackboard change journal and its replica.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Journal.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <fcntl.h>
+#include <sys/socket.h>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Ship the pending records of the journal to the replica.
+// ----------------------------------------------------------------------------
+bool ship(bt::BlackboardJournal& p_journal, bt::BlackboardReplica& p_replica)
+{
+    bool ok = p_replica.feed(p_journal.data().data(), p_journal.pending());
+    p_journal.consume(p_journal.pending());
+    return ok;
+}
+
+struct Opaque
+{
+    int x;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// Listener Tests
+// ===========================================================================
+
+TEST(TestBlackboardJournal, ListenerSeesAllWrites)
+{
+    bt::Blackboard bb;
+    std::vector<std::pair<std::string, bt::Blackboard::Version>> writes;
+    bb.setListener([&writes](bt::Blackboard::Key const& p_key,
+                             bt::Blackboard::Version p_version,
+                             bt::Blackboard::Value const*) {
+        writes.emplace_back(p_key, p_version);
+    });
+
+    bb.set("a", 1);
+    bb.setRaw("a", std::any(2));
+    bb.emplace<std::string>("b", "text");
+    bb.modify<int>("a", [](int& p_a) { ++p_a; });
+    bb.remove("b");
+    bb.remove("unknown");
+
+    ASSERT_EQ(writes.size(), 5u);
+    EXPECT_EQ(writes[2].first, "b");
+    EXPECT_EQ(writes[3].second, 3u);
+    EXPECT_EQ(writes[4].second, 2u);
+
+    // Forks are not observed
+    auto fork = bb.fork();
+    fork->set("a", 0);
+    EXPECT_EQ(writes.size(), 5u);
+}
+
+// ===========================================================================
+// Replication Tests
+// ===========================================================================
+
+TEST(TestBlackboardJournal, ReplicateWrites)
+{
+    auto primary = std::make_shared<bt::Blackboard>();
+    primary->set("initial", 7);
+
+    bt::BlackboardJournal journal(primary);
+    EXPECT_EQ(journal.sequence(), 1u); // Snapshot
+
+    primary->set("count", 1);
+    primary->set("count", 2);
+    primary->set("name", std::string("robot"));
+    primary->set("ratio", 0.5);
+    primary->set("flag", true);
+    primary->set("samples", std::vector<double>{1.0, 2.0});
+    primary->set("list", std::vector<std::any>{1, std::string("two")});
+    primary->set("dict", std::unordered_map<std::string, std::any>{
+                             {"x", 1.5}, {"y", false}});
+    primary->set("opaque", Opaque{3});
+    EXPECT_EQ(journal.unsupported(), 1u);
+
+    auto standby = std::make_shared<bt::Blackboard>();
+    bt::BlackboardReplica replica(standby);
+    ASSERT_TRUE(ship(journal, replica));
+    EXPECT_EQ(replica.sequence(), journal.sequence());
+    EXPECT_EQ(replica.statistics().records, 9u);
+    EXPECT_LE(replica.statistics().lag, replica.statistics().max_lag);
+
+    EXPECT_EQ(*standby->get<int>("initial"), 7);
+    EXPECT_EQ(*standby->get<int>("count"), 2);
+    EXPECT_EQ(standby->version("count"), primary->version("count"));
+    EXPECT_EQ(*standby->get<std::string>("name"), "robot");
+    EXPECT_DOUBLE_EQ(*standby->get<double>("ratio"), 0.5);
+    EXPECT_TRUE(*standby->get<bool>("flag"));
+    EXPECT_EQ(standby->get<std::vector<double>>("samples")->size(), 2u);
+    auto list = standby->get<std::vector<std::any>>("list");
+    ASSERT_TRUE(list.has_value());
+    EXPECT_EQ(std::any_cast<std::string>((*list)[1]), "two");
+    auto dict =
+        standby->get<std::unordered_map<std::string, std::any>>("dict");
+    ASSERT_TRUE(dict.has_value());
+    EXPECT_DOUBLE_EQ(std::any_cast<double>(dict->at("x")), 1.5);
+    EXPECT_FALSE(standby->has("opaque"));
+
+    primary->remove("count");
+    ASSERT_TRUE(ship(journal, replica));
+    EXPECT_FALSE(standby->has("count"));
+}
+
+TEST(TestBlackboardJournal, PartialRecordsAndGaps)
+{
+    auto primary = std::make_shared<bt::Blackboard>();
+    bt::BlackboardJournal journal(primary);
+    primary->set("a", 1);
+    primary->set("b", std::string("hello"));
+
+    auto standby = std::make_shared<bt::Blackboard>();
+    bt::BlackboardReplica replica(standby);
+
+    // Byte per byte
+    std::string data = journal.data();
+    journal.consume(data.size());
+    for (char c : data)
+    {
+        ASSERT_TRUE(replica.feed(&c, 1u));
+    }
+    EXPECT_EQ(*standby->get<std::string>("b"), "hello");
+    EXPECT_EQ(replica.sequence(), 2u);
+
+    // A lost record is detected
+    primary->set("a", 2);
+    journal.consume(journal.pending());
+    primary->set("a", 3);
+    EXPECT_FALSE(ship(journal, replica));
+}
+
+TEST(TestBlackboardJournal, ReplicateOverSocket)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+    auto primary = std::make_shared<bt::Blackboard>();
+    bt::BlackboardJournal journal(primary);
+    auto standby = std::make_shared<bt::Blackboard>();
+    bt::BlackboardReplica replica(standby);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        primary->set("tick", i);
+        ASSERT_TRUE(journal.flush(fds[0]));
+        ASSERT_TRUE(replica.receive(fds[1]));
+    }
+    EXPECT_EQ(journal.pending(), 0u);
+    EXPECT_EQ(*standby->get<int>("tick"), 99);
+    EXPECT_EQ(replica.sequence(), 100u);
+
+    // End of file: the primary is gone
+    ::close(fds[0]);
+    EXPECT_FALSE(replica.receive(fds[1]));
+    ::close(fds[1]);
+}
@@ -0,0 +1,200 @@
+/**
+ * @file TestMappedData.cpp
+ * @brief Unit tests for the bulk data mapped in memory and referenced by
+ * blackboard entries.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/MappedData.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Write p_count doubles 0.5, 1.5, 2.5 ... in a binary file of the
+//! temporary directory.
+//! \return The path of the file.
+// ----------------------------------------------------------------------------
+std::filesystem::path writeDoubles(std::string const& p_name, size_t p_count)
+{
+    auto path = std::filesystem::temp_directory_path() / p_name;
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (size_t i = 0u; i < p_count; ++i)
+    {
+        double const value = double(i) + 0.5;
+        file.write(reinterpret_cast<char const*>(&value), sizeof(value));
+    }
+    return path;
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Mapped files
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test the sharing of the mappings.
+//! \details GIVEN a binary file, WHEN mapping it twice, then replacing it by
+//!          a renamed file, THEN EXPECT the same mapping while unchanged and
+//!          a new mapping for the new file.
+// ------------------------------------------------------------------------
+TEST(TestMappedFile, SharedMapping)
+{
+    // GIVEN: A binary file
+    auto path = writeDoubles("blackthorn_mapped_shared.bin", 8u);
+
+    // WHEN: Mapping it twice
+    auto first = bt::MappedFile::open(path.string());
+    auto second = bt::MappedFile::open(path.string());
+
+    // THEN: EXPECT the same mapping
+    ASSERT_TRUE(first) << first.getError();
+    ASSERT_TRUE(second) << second.getError();
+    EXPECT_EQ(first.getValue(), second.getValue());
+    EXPECT_EQ(first.getValue()->size(), 8u * sizeof(double));
+
+    // WHEN: Replacing it by a renamed file
+    auto other = writeDoubles("blackthorn_mapped_shared.tmp", 4u);
+    std::filesystem::rename(other, path);
+    auto third = bt::MappedFile::open(path.string());
+
+    // THEN: EXPECT a new mapping, the old one still readable
+    ASSERT_TRUE(third) << third.getError();
+    EXPECT_NE(third.getValue(), first.getValue());
+    EXPECT_EQ(third.getValue()->size(), 4u * sizeof(double));
+    EXPECT_EQ(first.getValue()->size(), 8u * sizeof(double));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the views of a mapped file.
+//! \details GIVEN a mapped file of doubles, WHEN viewing all of it, a part of
+//!          it or out of it, THEN EXPECT the values without copy, or errors.
+// ------------------------------------------------------------------------
+TEST(TestMappedArray, View)
+{
+    // GIVEN: A mapped file of doubles
+    auto path = writeDoubles("blackthorn_mapped_view.bin", 10u);
+    auto file = bt::MappedFile::open(path.string());
+    ASSERT_TRUE(file) << file.getError();
+
+    // WHEN: Viewing all of it
+    auto all = bt::MappedArray<double>::view(file.getValue());
+
+    // THEN: EXPECT the values without copy
+    ASSERT_TRUE(all) << all.getError();
+    ASSERT_EQ(all.getValue().size(), 10u);
+    EXPECT_EQ(static_cast<void const*>(all.getValue().data()),
+              static_cast<void const*>(file.getValue()->data()));
+    EXPECT_DOUBLE_EQ(all.getValue()[9], 9.5);
+
+    // WHEN: Viewing a part of it
+    auto part =
+        bt::MappedArray<double>::view(file.getValue(), 2u * sizeof(double), 3u);
+
+    // THEN: EXPECT the values of the part
+    ASSERT_TRUE(part) << part.getError();
+    double sum = 0.0;
+    for (double value : part.getValue())
+    {
+        sum += value;
+    }
+    EXPECT_DOUBLE_EQ(sum, 2.5 + 3.5 + 4.5);
+
+    // THEN: EXPECT errors out of the file or misaligned
+    EXPECT_FALSE(bt::MappedArray<double>::view(file.getValue(), 0u, 11u));
+    EXPECT_FALSE(bt::MappedArray<double>::view(file.getValue(), 81u));
+    EXPECT_FALSE(bt::MappedArray<double>::view(file.getValue(), 4u));
+    EXPECT_FALSE(bt::MappedArray<int32_t>::view(file.getValue(), 78u));
+    auto last = bt::MappedArray<int32_t>::view(file.getValue(), 76u);
+    ASSERT_TRUE(last) << last.getError();
+    EXPECT_EQ(last.getValue().size(), 1u);
+    EXPECT_FALSE(bt::MappedFile::open(path.string() + ".missing"));
+}
+
+// ===========================================================================
+// YAML
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test the loading and dumping of mapped arrays.
+//! \details GIVEN a YAML map tagged !mmap, WHEN loading it, then dumping and
+//!          loading the blackboard again, THEN EXPECT views of the same
+//!          mapping.
+// ------------------------------------------------------------------------
+TEST(TestMappedArray, Serializer)
+{
+    // GIVEN: A YAML map tagged !mmap with a path relative to a directory
+    auto path = writeDoubles("blackthorn_mapped_yaml.bin", 16u);
+    YAML::Node yaml = YAML::Load(R"(
+path: !mmap {file: blackthorn_mapped_yaml.bin, type: double, offset: 8}
+bytes: !mmap {file: blackthorn_mapped_yaml.bin, type: uint8, count: 4}
+)");
+
+    // WHEN: Loading it
+    bt::Blackboard bb;
+    bt::BlackboardSerializer::Context context;
+    context.directory = path.parent_path();
+    bt::BlackboardSerializer::load(bb, yaml, context);
+
+    // THEN: EXPECT views of the file
+    auto values = bb.get<bt::MappedArray<double>>("path");
+    ASSERT_TRUE(values);
+    ASSERT_EQ(values->size(), 15u);
+    EXPECT_DOUBLE_EQ((*values)[0], 1.5);
+    auto bytes = bb.get<bt::MappedArray<uint8_t>>("bytes");
+    ASSERT_TRUE(bytes);
+    EXPECT_EQ(bytes->size(), 4u);
+    EXPECT_EQ(bytes->file(), values->file());
+
+    // WHEN: Dumping and loading the blackboard again
+    bt::Blackboard copy;
+    bt::BlackboardSerializer::load(copy, bt::BlackboardSerializer::dump(bb));
+
+    // THEN: EXPECT views of the same mapping
+    auto reloaded = copy.get<bt::MappedArray<double>>("path");
+    ASSERT_TRUE(reloaded);
+    EXPECT_EQ(reloaded->data(), values->data());
+    EXPECT_EQ(reloaded->size(), 15u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the malformed mapped arrays.
+//! \details GIVEN maps tagged !mmap with missing fields, an unknown type, a
+//!          missing file or a view out of the file, WHEN loading them, THEN
+//!          EXPECT a YAML exception.
+// ------------------------------------------------------------------------
+TEST(TestMappedArray, SerializerErrors)
+{
+    // GIVEN: A binary file of 4 doubles
+    auto path = writeDoubles("blackthorn_mapped_errors.bin", 4u);
+    bt::BlackboardSerializer::Context context;
+    context.directory = path.parent_path();
+    bt::Blackboard bb;
+
+    // THEN: EXPECT a YAML exception for the malformed maps
+    for (char const* text :
+         {"a: !mmap {type: double}",
+          "a: !mmap {file: blackthorn_mapped_errors.bin}",
+          "a: !mmap {file: blackthorn_mapped_errors.bin, type: complex}",
+          "a: !mmap {file: blackthorn_mapped_missing.bin, type: double}",
+          "a: !mmap {file: blackthorn_mapped_errors.bin, type: double, "
+          "count: 5}",
+          "a: !mmap {file: blackthorn_mapped_errors.bin, type: double, "
+          "offset: -8}",
+          "a: !mmap blackthorn_mapped_errors.bin"})
+    {
+        EXPECT_THROW(
+            bt::BlackboardSerializer::load(bb, YAML::Load(text), context),
+            YAML::Exception)
+            << text;
+    }
+}
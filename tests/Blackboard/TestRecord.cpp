@@ -0,0 +1,245 @@
+/**
+ * @file TestRecord.cpp
+ * @brief Unit tests for the blackboard records typed by a schema.
+ *
+ * Corresponds to src/BlackThorn/Blackboard/Record.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Schema Robot { name: string, battery: int, pose: Pose { x, y:
+//! double }, docked: bool, speed: double }.
+// ----------------------------------------------------------------------------
+bt::RecordSchema::Ptr robotSchema()
+{
+    bt::RecordSchema pose("Pose");
+    pose.add("x", bt::FieldType::Double);
+    pose.add("y", bt::FieldType::Double);
+
+    bt::RecordSchema robot("Robot");
+    robot.add("name", bt::FieldType::String);
+    robot.add("battery", bt::FieldType::Int);
+    robot.add("pose", pose);
+    robot.add("docked", bt::FieldType::Bool);
+    robot.add("speed", bt::FieldType::Double);
+    return std::make_shared<bt::RecordSchema const>(std::move(robot));
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Schemas
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test the layout of the fields.
+//! \details GIVEN a schema mixing types and a nested record, WHEN looking at
+//!          its fields, THEN EXPECT nested fields flattened, reals first and
+//!          contiguous, then integers, then booleans.
+// ------------------------------------------------------------------------
+TEST(TestRecordSchema, Layout)
+{
+    // GIVEN: A schema mixing types and a nested record
+    auto schema = robotSchema();
+
+    // THEN: EXPECT nested fields flattened in the order of declaration
+    ASSERT_EQ(schema->fields().size(), 6u);
+    EXPECT_EQ(schema->fields()[2].path, "pose.x");
+    EXPECT_EQ(schema->fields()[3].path, "pose.y");
+
+    // THEN: EXPECT reals first and contiguous, then integers, then booleans
+    EXPECT_EQ(schema->reals(), 3u);
+    EXPECT_EQ(schema->find("pose.x")->offset, 0u);
+    EXPECT_EQ(schema->find("pose.y")->offset, sizeof(double));
+    EXPECT_EQ(schema->find("speed")->offset, 2u * sizeof(double));
+    EXPECT_EQ(schema->find("battery")->offset, 3u * sizeof(double));
+    EXPECT_EQ(schema->find("docked")->offset,
+              3u * sizeof(double) + sizeof(int));
+    EXPECT_EQ(schema->bytes(), 3u * sizeof(double) + sizeof(int) + 1u);
+    EXPECT_EQ(schema->strings(), 1u);
+    EXPECT_EQ(schema->find("pose"), nullptr);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the refused fields.
+//! \details GIVEN a schema with fields, WHEN adding empty, dotted, duplicate
+//!          or overlapping names, THEN EXPECT them refused.
+// ------------------------------------------------------------------------
+TEST(TestRecordSchema, InvalidFields)
+{
+    // GIVEN: A schema with fields
+    bt::RecordSchema pose("Pose");
+    ASSERT_TRUE(pose.add("x", bt::FieldType::Double));
+    bt::RecordSchema robot("Robot");
+    ASSERT_TRUE(robot.add("pose", pose));
+
+    // THEN: EXPECT invalid names refused
+    EXPECT_FALSE(robot.add("", bt::FieldType::Int));
+    EXPECT_FALSE(robot.add("a.b", bt::FieldType::Int));
+    EXPECT_FALSE(robot.add("pose", bt::FieldType::Int));
+    EXPECT_FALSE(robot.add("pose", pose));
+    EXPECT_TRUE(robot.add("poses", bt::FieldType::Int));
+    EXPECT_FALSE(pose.add("x", bt::FieldType::Int));
+
+    // THEN: EXPECT handles only resolved for the right type
+    EXPECT_TRUE(robot.field<double>("pose.x"));
+    EXPECT_FALSE(robot.field<int>("pose.x"));
+    EXPECT_FALSE(robot.field<double>("pose.z"));
+}
+
+// ===========================================================================
+// Records
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test reading and writing the fields of a record.
+//! \details GIVEN a record, WHEN writing fields by handle and by path, THEN
+//!          EXPECT the values read back, zeros for the others, and the reals
+//!          readable as an array.
+// ------------------------------------------------------------------------
+TEST(TestRecord, Fields)
+{
+    // GIVEN: A record
+    auto schema = robotSchema();
+    bt::Record robot(schema);
+    auto const x = *schema->field<double>("pose.x");
+    auto const name = *schema->field<std::string>("name");
+
+    // WHEN: Writing fields by handle and by path
+    robot.set(x, 1.5);
+    robot.set(name, std::string("R2"));
+    EXPECT_TRUE(robot.set("battery", 80));
+    EXPECT_TRUE(robot.set("docked", true));
+    EXPECT_TRUE(robot.set("speed", 0.25));
+    EXPECT_FALSE(robot.set("battery", 80.0));
+    EXPECT_FALSE(robot.set("unknown", 1));
+
+    // THEN: EXPECT the values read back, zeros for the others
+    EXPECT_DOUBLE_EQ(robot.get(x), 1.5);
+    EXPECT_EQ(robot.get(name), "R2");
+    EXPECT_EQ(robot.get<int>("battery"), 80);
+    EXPECT_EQ(robot.get<bool>("docked"), true);
+    EXPECT_EQ(robot.get<double>("pose.y"), 0.0);
+    EXPECT_FALSE(robot.get<double>("battery"));
+
+    // THEN: EXPECT the reals readable as an array
+    double const* reals = robot.reals();
+    EXPECT_DOUBLE_EQ(reals[0], 1.5);
+    EXPECT_DOUBLE_EQ(reals[1], 0.0);
+    EXPECT_DOUBLE_EQ(reals[2], 0.25);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test a record stored in a blackboard.
+//! \details GIVEN a record in a blackboard, WHEN modifying it in place and
+//!          forking the blackboard, THEN EXPECT the value of each blackboard
+//!          kept apart.
+// ------------------------------------------------------------------------
+TEST(TestRecord, InBlackboard)
+{
+    // GIVEN: A record in a blackboard
+    auto schema = robotSchema();
+    auto const x = *schema->field<double>("pose.x");
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("robot", bt::Record(schema));
+
+    // WHEN: Modifying it in place and forking the blackboard
+    EXPECT_TRUE(bb->modify<bt::Record>("robot",
+                                       [&x](bt::Record& p_robot)
+                                       { p_robot.set(x, 3.0); }));
+    auto fork = bb->fork();
+    EXPECT_TRUE(fork->modify<bt::Record>("robot",
+                                         [&x](bt::Record& p_robot)
+                                         { p_robot.set(x, 4.0); }));
+
+    // THEN: EXPECT the value of each blackboard kept apart
+    auto const* robot = std::any_cast<bt::Record>(bb->lookup("robot"));
+    ASSERT_NE(robot, nullptr);
+    EXPECT_DOUBLE_EQ(robot->get(x), 3.0);
+    EXPECT_DOUBLE_EQ(
+        std::any_cast<bt::Record>(fork->lookup("robot"))->get(x), 4.0);
+}
+
+// ===========================================================================
+// YAML
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test the loading and dumping of records.
+//! \details GIVEN a YAML map tagged with a schema name, WHEN loading it, then
+//!          dumping and loading the blackboard again, THEN EXPECT a record
+//!          holding the values.
+// ------------------------------------------------------------------------
+TEST(TestRecord, Serializer)
+{
+    // GIVEN: A YAML map tagged with a schema name
+    bt::RecordSchemas schemas;
+    schemas.add(robotSchema());
+    YAML::Node yaml = YAML::Load(R"(
+robot: !Robot
+  name: R2
+  battery: 0x50
+  pose: {x: 1.5, y: -2}
+  docked: yes
+untyped: {a: 1}
+)");
+
+    // WHEN: Loading it
+    bt::Blackboard bb;
+    bt::BlackboardSerializer::load(bb, yaml, nullptr, &schemas);
+
+    // THEN: EXPECT a record holding the values
+    auto const* robot = std::any_cast<bt::Record>(bb.lookup("robot"));
+    ASSERT_NE(robot, nullptr);
+    EXPECT_EQ(robot->get<std::string>("name"), "R2");
+    EXPECT_EQ(robot->get<int>("battery"), 80);
+    EXPECT_EQ(robot->get<double>("pose.y"), -2.0);
+    EXPECT_EQ(robot->get<bool>("docked"), true);
+    EXPECT_EQ(robot->get<double>("speed"), 0.0);
+    EXPECT_TRUE(
+        (bb.get<std::unordered_map<std::string, std::any>>("untyped")));
+
+    // WHEN: Dumping and loading the blackboard again
+    bt::Blackboard copy;
+    bt::BlackboardSerializer::load(
+        copy, bt::BlackboardSerializer::dump(bb), nullptr, &schemas);
+
+    // THEN: EXPECT the same record
+    robot = std::any_cast<bt::Record>(copy.lookup("robot"));
+    ASSERT_NE(robot, nullptr);
+    EXPECT_EQ(robot->get<double>("pose.x"), 1.5);
+    EXPECT_EQ(robot->get<int>("battery"), 80);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the records not matching their schema.
+//! \details GIVEN tagged maps with an unknown field, a malformed value or a
+//!          scalar, WHEN loading them, THEN EXPECT a YAML exception.
+// ------------------------------------------------------------------------
+TEST(TestRecord, SerializerErrors)
+{
+    // GIVEN: A schema
+    bt::RecordSchemas schemas;
+    schemas.add(robotSchema());
+    bt::Blackboard bb;
+
+    // THEN: EXPECT a YAML exception for maps not matching it
+    for (char const* text : {"r: !Robot {batery: 1}",
+                             "r: !Robot {battery: 1.5}",
+                             "r: !Robot {pose: 1.0}",
+                             "r: !Robot 42"})
+    {
+        EXPECT_THROW(bt::BlackboardSerializer::load(
+                         bb, YAML::Load(text), nullptr, &schemas),
+                     YAML::Exception)
+            << text;
+    }
+}
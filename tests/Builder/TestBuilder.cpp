@@ -118,6 +118,24 @@ BehaviorTree:
     EXPECT_EQ(tree->tick(), bt::Status::FAILURE);
 }
 
+TEST(TestBuilder, ParseNodeWithEmptyContent)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  Sequence:
+    children:
+      - Success: {}
+      - Success:
+)";
+
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto tree = result.moveValue();
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+}
+
 TEST(TestBuilder, ParseSimpleSequence)
 {
     std::string yaml = R"(
@@ -441,6 +459,129 @@ BehaviorTree:
     EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
 }
 
+TEST(TestBuilder, ParseParallelHaltOnDecision)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  Parallel:
+    name: Race
+    success_threshold: 1
+    failure_threshold: 2
+    halt_on_decision: true
+    children:
+      - Success:
+          name: Winner
+      - Wait:
+          name: Loser
+          milliseconds: 10000
+)";
+
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    ASSERT_TRUE(result.isSuccess());
+    auto tree = result.moveValue();
+    auto const& race = dynamic_cast<bt::Parallel const&>(tree->getRoot());
+    EXPECT_TRUE(race.getHaltOnDecision());
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(race.getChildren()[1]->status(), bt::Status::INVALID);
+
+    std::string exported = bt::Exporter::toYAML(*tree);
+    EXPECT_NE(exported.find("halt_on_decision: true"), std::string::npos);
+}
+
+TEST(TestBuilder, ParseUnorderedSelector)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  Selector:
+    name: Fallbacks
+    unordered: true
+    deterministic: true
+    reorder_period: 4
+    children:
+      - Failure:
+          name: Child1
+      - Success:
+          name: Child2
+)";
+
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto tree = result.moveValue();
+    auto& selector = dynamic_cast<bt::Selector&>(tree->getRoot());
+    ASSERT_TRUE(selector.isUnordered());
+    EXPECT_TRUE(selector.getOrdering().config().deterministic);
+    EXPECT_EQ(selector.getOrdering().config().reorder_period, 4u);
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+
+    // The options survive a YAML export
+    std::string exported = bt::Exporter::toYAML(*tree);
+    EXPECT_NE(exported.find("unordered: true"), std::string::npos);
+    EXPECT_NE(exported.find("reorder_period: 4"), std::string::npos);
+}
+
+TEST(TestBuilder, ParseTypedSetBlackboard)
+{
+    std::string yaml = R"(
+Blackboard:
+  counter: 1
+
+BehaviorTree:
+  Sequence:
+    name: Setters
+    children:
+      - SetBlackboard:
+          key: count
+          value: 42
+      - SetBlackboard:
+          key: label
+          value: "42"
+      - SetBlackboard:
+          key: ratio
+          value: 2
+          type: double
+      - SetBlackboard:
+          key: counter
+          value: ${counter} * 2 + 1
+)";
+
+    bt::NodeFactory factory;
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto result = bt::Builder::fromText(factory, yaml, bb);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto tree = result.moveValue();
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(bb->get<int>("count").value(), 42);
+    EXPECT_EQ(bb->get<std::string>("label").value(), "42");
+    EXPECT_DOUBLE_EQ(bb->get<double>("ratio").value(), 2.0);
+    EXPECT_EQ(bb->get<int>("counter").value(), 3);
+
+    // The types survive a YAML export
+    std::string exported = bt::Exporter::toYAML(*tree);
+    EXPECT_NE(exported.find("value: \"42\""), std::string::npos);
+    EXPECT_NE(exported.find("type: double"), std::string::npos);
+    EXPECT_NE(exported.find("value: ${counter} * 2 + 1"), std::string::npos);
+}
+
+TEST(TestBuilder, ParseSetBlackboardInvalidType)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  SetBlackboard:
+    key: count
+    value: abc
+    type: int
+)";
+
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, yaml);
+    EXPECT_FALSE(result.isSuccess());
+}
+
 // ===========================================================================
 // Custom Action Tests
 // ===========================================================================
@@ -866,6 +1007,24 @@ BehaviorTree:
     EXPECT_NE(result.getError().find("YAML"), std::string::npos);
 }
 
+TEST(TestBuilder, ErrorMalformedNumericField)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  Repeat:
+    times: -5
+    child:
+      - Success
+)";
+
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_NE(result.getError().find("YAML"), std::string::npos);
+    EXPECT_NE(result.getError().find("line 4"), std::string::npos);
+}
+
 TEST(TestBuilder, ErrorActionNotInFactory)
 {
     std::string yaml = R"(
@@ -940,6 +1099,178 @@ TEST(TestBuilder, ErrorFileNotFound)
     EXPECT_FALSE(result.isSuccess());
 }
 
+// ===========================================================================
+// Subtree Library Tests
+// ===========================================================================
+
+namespace {
+
+void writeFile(std::filesystem::path const& p_path, std::string const& p_text)
+{
+    std::ofstream file(p_path);
+    file << p_text;
+}
+
+std::filesystem::path makeLibraryDirectory()
+{
+    auto directory =
+        std::filesystem::temp_directory_path() / "blackthorn_library_test";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+    return directory;
+}
+
+} // anonymous namespace
+
+TEST(TestBuilder, IncludeLibraryParsedOnce)
+{
+    auto directory = makeLibraryDirectory();
+    writeFile(directory / "library.yaml", R"(
+SubTrees:
+  Succeed:
+    Success: {}
+  Fail:
+    Failure: {}
+)");
+    writeFile(directory / "first.yaml", R"(
+include: library.yaml
+BehaviorTree:
+  SubTree:
+    reference: Succeed
+)");
+    // Local subtrees take precedence over the included ones
+    writeFile(directory / "second.yaml", R"(
+include:
+  - library.yaml
+BehaviorTree:
+  Sequence:
+    children:
+      - SubTree:
+          reference: Succeed
+      - SubTree:
+          reference: Fail
+SubTrees:
+  Fail:
+    Success: {}
+)");
+
+    bt::Builder::clearLibraryCache();
+    auto before = bt::Builder::libraryStatistics();
+
+    bt::NodeFactory factory;
+    auto first =
+        bt::Builder::fromFile(factory, (directory / "first.yaml").string());
+    ASSERT_TRUE(first.isSuccess()) << first.getError();
+    auto second =
+        bt::Builder::fromFile(factory, (directory / "second.yaml").string());
+    ASSERT_TRUE(second.isSuccess()) << second.getError();
+
+    EXPECT_EQ(first.getValue()->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(second.getValue()->tick(), bt::Status::SUCCESS);
+
+    auto after = bt::Builder::libraryStatistics();
+    EXPECT_EQ(after.files, 1u);
+    EXPECT_EQ(after.loads - before.loads, 1u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TestBuilder, IncludeLibraryReloadedWhenModified)
+{
+    auto directory = makeLibraryDirectory();
+    auto library = directory / "library.yaml";
+    writeFile(library, "SubTrees:\n  Task:\n    Success: {}\n");
+    std::string const tree = "include: " + library.string() +
+                             "\nBehaviorTree:\n  SubTree:\n"
+                             "    reference: Task\n";
+
+    bt::Builder::clearLibraryCache();
+    bt::NodeFactory factory;
+    auto first = bt::Builder::fromText(factory, tree);
+    ASSERT_TRUE(first.isSuccess()) << first.getError();
+    EXPECT_EQ(first.getValue()->tick(), bt::Status::SUCCESS);
+
+    // Move the modification time so that the change is seen whatever the
+    // resolution of the file system clock.
+    auto mtime = std::filesystem::last_write_time(library);
+    writeFile(library, "SubTrees:\n  Task:\n    Failure: {}\n");
+    std::filesystem::last_write_time(library, mtime + std::chrono::seconds(2));
+
+    auto loads = bt::Builder::libraryStatistics().loads;
+    auto second = bt::Builder::fromText(factory, tree);
+    ASSERT_TRUE(second.isSuccess()) << second.getError();
+    EXPECT_EQ(second.getValue()->tick(), bt::Status::FAILURE);
+    EXPECT_EQ(bt::Builder::libraryStatistics().loads, loads + 1u);
+
+    // Already built trees keep the library they were built with
+    EXPECT_EQ(first.getValue()->tick(), bt::Status::SUCCESS);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TestBuilder, IncludeNestedLibraries)
+{
+    auto directory = makeLibraryDirectory();
+    std::filesystem::create_directories(directory / "common");
+    writeFile(directory / "common" / "base.yaml",
+              "SubTrees:\n  Base:\n    Success: {}\n");
+    writeFile(directory / "common" / "library.yaml", R"(
+include: base.yaml
+SubTrees:
+  Task:
+    SubTree:
+      reference: Base
+)");
+    writeFile(directory / "tree.yaml", R"(
+include: common/library.yaml
+BehaviorTree:
+  SubTree:
+    reference: Task
+)");
+
+    bt::Builder::clearLibraryCache();
+    bt::NodeFactory factory;
+    auto result =
+        bt::Builder::fromFile(factory, (directory / "tree.yaml").string());
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    EXPECT_EQ(result.getValue()->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(bt::Builder::libraryStatistics().files, 2u);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(TestBuilder, ErrorIncludeLibrary)
+{
+    auto directory = makeLibraryDirectory();
+    writeFile(directory / "a.yaml", "include: b.yaml\n");
+    writeFile(directory / "b.yaml", "include: a.yaml\n");
+    writeFile(directory / "circular.yaml",
+              "include: a.yaml\nBehaviorTree:\n  Success: {}\n");
+    writeFile(directory / "missing.yaml",
+              "include: none.yaml\nBehaviorTree:\n  Success: {}\n");
+    writeFile(directory / "invalid.yaml",
+              "include: {a: b}\nBehaviorTree:\n  Success: {}\n");
+
+    bt::NodeFactory factory;
+    auto circular =
+        bt::Builder::fromFile(factory, (directory / "circular.yaml").string());
+    ASSERT_FALSE(circular.isSuccess());
+    EXPECT_NE(circular.getError().find("Circular include"), std::string::npos);
+
+    auto missing =
+        bt::Builder::fromFile(factory, (directory / "missing.yaml").string());
+    ASSERT_FALSE(missing.isSuccess());
+    EXPECT_NE(missing.getError().find("Cannot find subtree library"),
+              std::string::npos);
+
+    auto invalid =
+        bt::Builder::fromFile(factory, (directory / "invalid.yaml").string());
+    EXPECT_FALSE(invalid.isSuccess());
+
+    std::filesystem::remove_all(directory);
+}
+
 // ===========================================================================
 // Complex Integration Tests
 // ===========================================================================
@@ -1130,6 +1461,38 @@ BehaviorTree:
     EXPECT_EQ(coords->size(), 2);
 }
 
+TEST(TestBuilder, BlackboardLiteralGrammar)
+{
+    std::string yaml = R"(
+Blackboard:
+  hexadecimal: 0x1F
+  big: 99999999999
+  exponent: 1e3
+  infinity: -.inf
+  enabled: yes
+  version: 1.2.3
+  label: 12px
+
+BehaviorTree:
+  Success:
+    name: TestNode
+)";
+
+    bt::NodeFactory factory;
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto result = bt::Builder::fromText(factory, yaml, bb);
+
+    ASSERT_TRUE(result.isSuccess());
+
+    EXPECT_EQ(bb->get<int>("hexadecimal"), 31);
+    EXPECT_DOUBLE_EQ(bb->get<double>("big").value(), 99999999999.0);
+    EXPECT_DOUBLE_EQ(bb->get<double>("exponent").value(), 1000.0);
+    EXPECT_LT(bb->get<double>("infinity").value(), -1e308);
+    EXPECT_EQ(bb->get<bool>("enabled"), true);
+    EXPECT_EQ(bb->get<std::string>("version"), "1.2.3");
+    EXPECT_EQ(bb->get<std::string>("label"), "12px");
+}
+
 // ===========================================================================
 // Port Remapping Tests
 // ===========================================================================
@@ -1339,4 +1702,230 @@ BehaviorTree:
     EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
     // Third tick completes the 3 repetitions
     EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
-}
\ No newline at end of file
+}
+TEST(TestBuilder, ParseSharedComputation)
+{
+    std::string yaml = R"(
+BehaviorTree:
+  SharedComputation:
+    name: ReadThreat
+    computation: threat
+    key: threat_level
+)";
+
+    bt::NodeFactory factory;
+    auto missing = bt::Builder::fromText(factory, yaml);
+    EXPECT_FALSE(missing.isSuccess());
+
+    auto shared = std::make_shared<bt::SharedComputations>();
+    shared->add("threat", []() { return bt::Blackboard::Value(3); });
+    factory.setSharedComputations(shared);
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    ASSERT_TRUE(result.isSuccess());
+    auto tree = result.moveValue();
+    ASSERT_TRUE(tree->isValid());
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(*tree->blackboard()->get<int>("threat_level"), 3);
+
+    std::string exported = bt::Exporter::toYAML(*tree);
+    EXPECT_NE(exported.find("computation: threat"), std::string::npos);
+    EXPECT_NE(exported.find("key: threat_level"), std::string::npos);
+}
+
+// ===========================================================================
+// Record Schemas Tests
+// ===========================================================================
+
+TEST(TestBuilder, ParseSchemasSection)
+{
+    std::string yaml = R"(
+Schemas:
+  Pose:
+    x: double
+    y: double
+  Robot:
+    name: string
+    battery: int
+    pose: Pose
+
+Blackboard:
+  robot: !Robot
+    name: R2
+    battery: 80
+    pose: {x: 1.5, y: 2.5}
+
+BehaviorTree:
+  Action:
+    name: TestAction
+    parameters:
+      target: !Pose {x: 4.0}
+)";
+
+    bt::NodeFactory factory;
+    factory.registerNode<TestAction>("TestAction");
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto result = bt::Builder::fromText(factory, yaml, bb);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto const* robot = std::any_cast<bt::Record>(bb->lookup("robot"));
+    ASSERT_NE(robot, nullptr);
+    EXPECT_EQ(robot->schema().name(), "Robot");
+    EXPECT_EQ(robot->get<std::string>("name"), "R2");
+    EXPECT_EQ(robot->get<int>("battery"), 80);
+    EXPECT_EQ(robot->get<double>("pose.y"), 2.5);
+    EXPECT_EQ(robot->schema().reals(), 2u);
+
+    auto const* target = std::any_cast<bt::Record>(bb->lookup("target"));
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->get<double>("x"), 4.0);
+}
+
+TEST(TestBuilder, ParseSchemasRegisteredInFactory)
+{
+    std::string yaml = R"(
+Schemas:
+  Waypoint:
+    label: string
+    pose: Pose
+
+Blackboard:
+  home: !Waypoint
+    label: dock
+    pose: {x: -1, theta: 0.5}
+
+BehaviorTree:
+  Success:
+    name: TestNode
+)";
+
+    bt::RecordSchema pose("Pose");
+    pose.add("x", bt::FieldType::Double);
+    pose.add("theta", bt::FieldType::Double);
+    auto schemas = std::make_shared<bt::RecordSchemas>();
+    schemas->add(std::make_shared<bt::RecordSchema const>(pose));
+
+    bt::NodeFactory factory;
+    factory.setRecordSchemas(schemas);
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto result = bt::Builder::fromText(factory, yaml, bb);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto const* home = std::any_cast<bt::Record>(bb->lookup("home"));
+    ASSERT_NE(home, nullptr);
+    EXPECT_EQ(home->get<double>("pose.x"), -1.0);
+    EXPECT_EQ(home->get<double>("pose.theta"), 0.5);
+
+    // The schemas of the document are not added to the ones of the factory
+    EXPECT_EQ(schemas->find("Waypoint"), nullptr);
+}
+
+TEST(TestBuilder, ErrorSchemas)
+{
+    bt::NodeFactory factory;
+    for (char const* yaml : {R"(
+Schemas:
+  Robot: {pose: Pose}
+BehaviorTree:
+  Success
+)",
+                             R"(
+Schemas:
+  Robot: [x, y]
+BehaviorTree:
+  Success
+)",
+                             R"(
+Schemas:
+  Robot: {x: double}
+Blackboard:
+  robot: !Robot {x: fast}
+BehaviorTree:
+  Success
+)"})
+    {
+        EXPECT_FALSE(bt::Builder::fromText(factory, yaml).isSuccess()) << yaml;
+    }
+}
+
+TEST(TestBuilder, ParseMappedBlackboardEntry)
+{
+    auto directory = makeLibraryDirectory();
+    std::vector<float> const values = {1.0f, 2.0f, 3.0f};
+    {
+        std::ofstream file(directory / "values.bin", std::ios::binary);
+        file.write(reinterpret_cast<char const*>(values.data()),
+                   std::streamsize(values.size() * sizeof(float)));
+    }
+    // Relative paths are relative to the directory of the tree file
+    writeFile(directory / "tree.yaml", R"(
+Blackboard:
+  values: !mmap {file: values.bin, type: float}
+BehaviorTree:
+  Success: {}
+)");
+
+    bt::NodeFactory factory;
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto result = bt::Builder::fromFile(
+        factory, (directory / "tree.yaml").string(), bb);
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+
+    auto mapped = bb->get<bt::MappedArray<float>>("values");
+    ASSERT_TRUE(mapped.has_value());
+    ASSERT_EQ(mapped->size(), 3u);
+    EXPECT_FLOAT_EQ((*mapped)[2], 3.0f);
+
+    auto missing = bt::Builder::fromText(factory, R"(
+Blackboard:
+  values: !mmap {file: /nonexistent/values.bin, type: float}
+BehaviorTree:
+  Success: {}
+)");
+    EXPECT_FALSE(missing.isSuccess());
+}
+
+TEST(TestBuilder, ParseBatchedServiceCall)
+{
+    std::string yaml = R"(
+Blackboard:
+  goal: 4
+BehaviorTree:
+  BatchedServiceCall:
+    name: Plan
+    service: plan
+    request: goal
+    response: path
+)";
+
+    bt::NodeFactory factory;
+    auto missing = bt::Builder::fromText(factory, yaml);
+    EXPECT_FALSE(missing.isSuccess());
+
+    auto services = std::make_shared<bt::BatchedServices>();
+    services->add("plan",
+                  [](bt::BatchedServices::Requests const& p_requests,
+                     bt::BatchedServices::Responses& p_responses)
+                  {
+                      for (size_t i = 0u; i < p_requests.size(); ++i)
+                      {
+                          p_responses[i] =
+                              std::any_cast<int>(p_requests[i]) * 10;
+                      }
+                  });
+    factory.setBatchedServices(services);
+    auto result = bt::Builder::fromText(factory, yaml);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    auto tree = result.moveValue();
+    ASSERT_TRUE(tree->isValid());
+    EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
+    services->flush();
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(*tree->blackboard()->get<int>("path"), 40);
+
+    std::string exported = bt::Exporter::toYAML(*tree);
+    EXPECT_NE(exported.find("service: plan"), std::string::npos);
+    EXPECT_NE(exported.find("request: goal"), std::string::npos);
+    EXPECT_NE(exported.find("response: path"), std::string::npos);
+}
@@ -0,0 +1,164 @@
+/**
+ * @file TestFragmentBuilder.cpp
+ * @brief Unit tests for bt::FragmentBuilder.
+ *
+ * Corresponds to src/BlackThorn/Builder/FragmentBuilder.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+//! \brief Tree waiting for a plan.
+constexpr char const* HOST_YAML = R"(
+Blackboard:
+  goal: 7
+BehaviorTree:
+  Sequence:
+    children:
+      - DynamicSubTree:
+          name: Plan
+)";
+
+//! \brief Plan reading a key of the tree and writing a local key.
+constexpr char const* PLAN_YAML = R"(
+BehaviorTree:
+  SetBlackboard:
+    key: target
+    value: ${goal} + 1
+)";
+
+//! \brief Another plan.
+constexpr char const* OTHER_PLAN_YAML = R"(
+BehaviorTree:
+  Failure:
+    name: Abort
+)";
+
+// ----------------------------------------------------------------------------
+//! \brief Build the tree waiting for a plan.
+// ----------------------------------------------------------------------------
+bt::Tree::Ptr buildHost(bt::NodeFactory const& p_factory)
+{
+    auto result = bt::Builder::fromText(p_factory, HOST_YAML);
+    EXPECT_TRUE(result.isSuccess()) << result.getError();
+    return result.moveValue();
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------
+//! \brief Test swapping a plan built off-thread into a running tree.
+//! \details GIVEN a tree waiting for a plan, WHEN a plan is built, THEN
+//!          EXPECT it is swapped in at the next tick, reads the tree
+//!          blackboard and writes to its own blackboard.
+// ------------------------------------------------------------------------
+TEST(TestFragmentBuilder, BuildAndSwap)
+{
+    // GIVEN: A tree waiting for a plan
+    bt::NodeFactory factory;
+    bt::FragmentBuilder fragments(factory);
+    auto tree = buildHost(factory);
+    bt::DynamicSubTree* plan = tree->findDynamicSubTree("Plan");
+    ASSERT_NE(plan, nullptr);
+    EXPECT_EQ(tree->tick(), bt::Status::FAILURE);
+
+    // WHEN: A plan is built
+    auto result = fragments.build(*plan, PLAN_YAML).get();
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    EXPECT_FALSE(result.getValue());
+
+    // THEN: EXPECT it is swapped in at the next tick
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(plan->swaps(), 1u);
+    ASSERT_NE(plan->content(), nullptr);
+    EXPECT_EQ(plan->content()->blackboard()->get<int>("target"), 8);
+    EXPECT_FALSE(tree->blackboard()->has("target"));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the cache of fragments.
+//! \details GIVEN a plan already built, WHEN building it again, THEN EXPECT
+//!          it is forked from the cache with its own blackboard.
+// ------------------------------------------------------------------------
+TEST(TestFragmentBuilder, RepeatedPlanFromCache)
+{
+    // GIVEN: A plan already built
+    bt::NodeFactory factory;
+    bt::FragmentBuilder fragments(factory);
+    auto tree = buildHost(factory);
+    bt::DynamicSubTree* plan = tree->findDynamicSubTree("Plan");
+    ASSERT_NE(plan, nullptr);
+    ASSERT_TRUE(fragments.build(*plan, PLAN_YAML).get().isSuccess());
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    bt::Blackboard::Ptr first = plan->content()->blackboard();
+
+    // WHEN: Building it again
+    tree->blackboard()->set("goal", 41);
+    auto result = fragments.build(*plan, PLAN_YAML).get();
+
+    // THEN: EXPECT it is forked from the cache with its own blackboard
+    ASSERT_TRUE(result.isSuccess()) << result.getError();
+    EXPECT_TRUE(result.getValue());
+    EXPECT_EQ(tree->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(plan->swaps(), 2u);
+    EXPECT_EQ(plan->content()->blackboard()->get<int>("target"), 42);
+    EXPECT_EQ(first->get<int>("target"), 8);
+    EXPECT_EQ(fragments.statistics().hits, 1u);
+    EXPECT_EQ(fragments.statistics().misses, 1u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the eviction of the least recently used fragment.
+//! \details GIVEN a cache of one fragment, WHEN alternating two plans, THEN
+//!          EXPECT each one is built again.
+// ------------------------------------------------------------------------
+TEST(TestFragmentBuilder, CacheEviction)
+{
+    // GIVEN: A cache of one fragment
+    bt::NodeFactory factory;
+    bt::FragmentBuilder fragments(factory, 1u);
+
+    // WHEN: Alternating two plans
+    EXPECT_TRUE(fragments.instantiate(PLAN_YAML, nullptr).isSuccess());
+    EXPECT_TRUE(fragments.instantiate(OTHER_PLAN_YAML, nullptr).isSuccess());
+    EXPECT_TRUE(fragments.instantiate(PLAN_YAML, nullptr).isSuccess());
+    EXPECT_TRUE(fragments.instantiate(PLAN_YAML, nullptr).isSuccess());
+
+    // THEN: EXPECT each one is built again
+    EXPECT_EQ(fragments.statistics().misses, 3u);
+    EXPECT_EQ(fragments.statistics().hits, 1u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test a plan failing to build.
+//! \details GIVEN a running plan, WHEN building an invalid plan, THEN
+//!          EXPECT an error and the running plan is kept.
+// ------------------------------------------------------------------------
+TEST(TestFragmentBuilder, InvalidPlanKeepsContent)
+{
+    // GIVEN: A running plan
+    bt::NodeFactory factory;
+    bt::FragmentBuilder fragments(factory);
+    auto tree = buildHost(factory);
+    bt::DynamicSubTree* plan = tree->findDynamicSubTree("Plan");
+    ASSERT_NE(plan, nullptr);
+    ASSERT_TRUE(fragments.build(*plan, OTHER_PLAN_YAML).get().isSuccess());
+    EXPECT_EQ(tree->tick(), bt::Status::FAILURE);
+
+    // WHEN: Building an invalid plan
+    auto result =
+        fragments.build(*plan, "BehaviorTree:\n  Unknown: {}\n").get();
+
+    // THEN: EXPECT an error and the running plan is kept
+    EXPECT_TRUE(result.isError());
+    EXPECT_FALSE(plan->mailbox()->hasPending());
+    EXPECT_EQ(tree->tick(), bt::Status::FAILURE);
+    EXPECT_EQ(plan->swaps(), 1u);
+    EXPECT_EQ(plan->content()->getRoot().name, "Abort");
+}
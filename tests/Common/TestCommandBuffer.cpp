@@ -0,0 +1,227 @@
+/**
+ * @file TestCommandBuffer.cpp
+ * @brief Unit tests for the per-tick CommandBuffer.
+ *
+ * Corresponds to src/BlackThorn/Common/CommandBuffer.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+// ****************************************************************************
+//! \brief Action commanding a speed, increased by steps of 1 up to p_target
+//! within the same tick, and commanding a stop when halted.
+// ****************************************************************************
+class Drive final: public bt::Action
+{
+public:
+
+    explicit Drive(int p_target, bt::Status p_status = bt::Status::RUNNING)
+        : m_target(p_target), m_status(p_status)
+    {
+    }
+
+    [[nodiscard]] bt::Status onRunning() override
+    {
+        for (int speed = 1; speed <= m_target; ++speed)
+        {
+            command("speed", speed);
+        }
+        return m_status;
+    }
+
+    void onHalt() override
+    {
+        command("stop", true);
+    }
+
+    [[nodiscard]] bt::Node::Ptr clone() const override
+    {
+        return std::make_unique<Drive>(*this);
+    }
+
+private:
+
+    int m_target;
+    bt::Status m_status;
+};
+
+// ****************************************************************************
+//! \brief Action recording the number of commands sent when it is ticked.
+// ****************************************************************************
+class Probe final: public bt::Action
+{
+public:
+
+    explicit Probe(std::vector<int> const& p_sent) : m_sent(p_sent) {}
+
+    [[nodiscard]] bt::Status onRunning() override
+    {
+        seen = m_sent.size();
+        return bt::Status::SUCCESS;
+    }
+
+    size_t seen = 0u;
+
+private:
+
+    std::vector<int> const& m_sent;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Buffer with a "speed" channel accepting speeds up to 5 and a
+//! "stop" channel, recording the commands sent.
+// ----------------------------------------------------------------------------
+struct Actuators
+{
+    Actuators()
+    {
+        commands.addChannel<int>(
+            "speed",
+            [this](int const& p_speed) { speeds.push_back(p_speed); },
+            [](int const& p_speed) { return p_speed <= 5; });
+        commands.addChannel<bool>("stop",
+                                  [this](bool const&) { ++stops; });
+    }
+
+    bt::CommandBuffer commands;
+    std::vector<int> speeds;
+    size_t stops = 0u;
+};
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------
+//! \brief Test the coalescing of the commands of a tick.
+//! \details GIVEN an action commanding three speeds per tick, WHEN ticking
+//!          twice, THEN EXPECT only the last speed of each tick is sent.
+// ------------------------------------------------------------------------
+TEST(TestCommandBuffer, LastCommandOfTheTickWins)
+{
+    // GIVEN: An action commanding three speeds per tick
+    Actuators actuators;
+    bt::Tree tree;
+    (void)tree.createRoot<Drive>(3);
+    tree.setCommandBuffer(&actuators.commands);
+
+    // WHEN: Ticking twice
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+
+    // THEN: EXPECT only the last speed of each tick is sent
+    EXPECT_EQ(actuators.speeds, std::vector<int>({3, 3}));
+    EXPECT_EQ(actuators.commands.pending(), 0u);
+    EXPECT_EQ(actuators.commands.statistics().pushed, 6u);
+    EXPECT_EQ(actuators.commands.statistics().coalesced, 4u);
+    EXPECT_EQ(actuators.commands.statistics().sent, 2u);
+    EXPECT_EQ(actuators.commands.statistics().flushes, 2u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the flush at the end of the outermost tick.
+//! \details GIVEN a subtree commanding a speed followed by a probe, WHEN
+//!          ticking, THEN EXPECT nothing is sent before the end of the tick.
+// ------------------------------------------------------------------------
+TEST(TestCommandBuffer, FlushedAtTheEndOfTheOutermostTick)
+{
+    // GIVEN: A subtree commanding a speed followed by a probe
+    Actuators actuators;
+    auto subtree = bt::Tree::create();
+    (void)subtree->createRoot<Drive>(2, bt::Status::SUCCESS);
+    bt::Tree tree;
+    auto& seq = tree.createRoot<bt::Sequence>();
+    seq.addChild(bt::Node::create<bt::SubTreeNode>(
+        std::make_shared<bt::SubTreeHandle>("Sub", std::move(subtree))));
+    auto& probe = seq.addChild<Probe>(actuators.speeds);
+    tree.setCommandBuffer(&actuators.commands);
+
+    // WHEN: Ticking
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+
+    // THEN: EXPECT nothing is sent before the end of the tick
+    EXPECT_EQ(probe.seen, 0u);
+    EXPECT_EQ(actuators.speeds, std::vector<int>({2}));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the commands of a node halted during the tick.
+//! \details GIVEN an action which commanded a speed during the tick, WHEN
+//!          halting it before the end of the tick, THEN EXPECT the speed is
+//!          discarded and the stop commanded by onHalt() is sent.
+// ------------------------------------------------------------------------
+TEST(TestCommandBuffer, HaltedNodeCommandsDiscarded)
+{
+    // GIVEN: An action which commanded a speed during the tick
+    Actuators actuators;
+    Drive drive(2);
+    drive.setCommandBuffer(&actuators.commands);
+    actuators.commands.beginTick();
+    EXPECT_EQ(drive.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(actuators.commands.pending(), 1u);
+
+    // WHEN: Halting it before the end of the tick
+    drive.halt();
+    actuators.commands.endTick();
+
+    // THEN: EXPECT the speed is discarded and the stop is sent
+    EXPECT_TRUE(actuators.speeds.empty());
+    EXPECT_EQ(actuators.stops, 1u);
+    EXPECT_EQ(actuators.commands.statistics().discarded, 1u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the refused commands.
+//! \details GIVEN a buffer, WHEN pushing to an unknown channel, a command of
+//!          the wrong type and an invalid command, THEN EXPECT none is sent.
+// ------------------------------------------------------------------------
+TEST(TestCommandBuffer, RejectedCommands)
+{
+    // GIVEN: A buffer
+    Actuators actuators;
+    bt::CommandBuffer& commands = actuators.commands;
+
+    // WHEN: Pushing to an unknown channel, a command of the wrong type and
+    // an invalid command
+    EXPECT_FALSE(commands.push("steering", 0.5));
+    EXPECT_FALSE(commands.push("speed", 2.5));
+    EXPECT_TRUE(commands.push("speed", 9));
+    EXPECT_FALSE(commands.addChannel<int>("speed", nullptr));
+
+    // THEN: EXPECT none is sent
+    EXPECT_EQ(commands.flush(), 0u);
+    EXPECT_TRUE(actuators.speeds.empty());
+    EXPECT_EQ(commands.statistics().rejected, 3u);
+    EXPECT_EQ(commands.statistics().flushes, 0u);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the commands of a forked tree.
+//! \details GIVEN a tree with a command buffer, WHEN ticking a fork, THEN
+//!          EXPECT the commands of the fork are dropped.
+// ------------------------------------------------------------------------
+TEST(TestCommandBuffer, ForkDoesNotSendCommands)
+{
+    // GIVEN: A tree with a command buffer
+    Actuators actuators;
+    bt::Tree tree;
+    (void)tree.createRoot<Drive>(1);
+    tree.setCommandBuffer(&actuators.commands);
+
+    // WHEN: Ticking a fork
+    auto fork = tree.fork();
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->tick(), bt::Status::RUNNING);
+
+    // THEN: EXPECT the commands of the fork are dropped
+    EXPECT_EQ(fork->commandBuffer(), nullptr);
+    EXPECT_EQ(fork->getRoot().commandBuffer(), nullptr);
+    EXPECT_EQ(actuators.commands.statistics().pushed, 0u);
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(actuators.speeds, std::vector<int>({1}));
+}
@@ -0,0 +1,142 @@
+/**
+ * @file TestLiteral.cpp
+ * @brief Unit tests for the exception-free parsing of scalar literals.
+ *
+ * Corresponds to src/BlackThorn/Common/Literal.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/Common/Literal.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+// ------------------------------------------------------------------------
+//! \brief Test the grammar of the integers.
+//! \details GIVEN decimal, hexadecimal and malformed texts, WHEN parsing them
+//!          as integers, THEN EXPECT only whole, in-range integers accepted
+//!          and the output left untouched otherwise.
+// ------------------------------------------------------------------------
+TEST(TestLiteral, ParseInt)
+{
+    int value = 0;
+    EXPECT_TRUE(bt::literal::parseInt("42", value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(bt::literal::parseInt("+7", value));
+    EXPECT_EQ(value, 7);
+    EXPECT_TRUE(bt::literal::parseInt("-13", value));
+    EXPECT_EQ(value, -13);
+    EXPECT_TRUE(bt::literal::parseInt("042", value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(bt::literal::parseInt("0x1F", value));
+    EXPECT_EQ(value, 31);
+
+    value = 5;
+    for (char const* text : {"", "+", "-", "+-1", "0x", "0x-1", " 1", "1 ",
+                             "12px", "1.0", "1e3", "99999999999"})
+    {
+        EXPECT_FALSE(bt::literal::parseInt(text, value)) << text;
+    }
+    EXPECT_EQ(value, 5);
+
+    size_t size = 0u;
+    EXPECT_FALSE(bt::literal::parseInt("-1", size));
+    EXPECT_TRUE(bt::literal::parseInt("18446744073709551615", size));
+    EXPECT_EQ(size, SIZE_MAX);
+    uint8_t byte = 0u;
+    EXPECT_FALSE(bt::literal::parseInt("256", byte));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the grammar of the reals.
+//! \details GIVEN decimal, exponent, YAML special and malformed texts, WHEN
+//!          parsing them as reals, THEN EXPECT the YAML grammar is followed.
+// ------------------------------------------------------------------------
+TEST(TestLiteral, ParseDouble)
+{
+    double value = 0.0;
+    EXPECT_TRUE(bt::literal::parseDouble("3.5", value));
+    EXPECT_DOUBLE_EQ(value, 3.5);
+    EXPECT_TRUE(bt::literal::parseDouble("-.5", value));
+    EXPECT_DOUBLE_EQ(value, -0.5);
+    EXPECT_TRUE(bt::literal::parseDouble("2.", value));
+    EXPECT_DOUBLE_EQ(value, 2.0);
+    EXPECT_TRUE(bt::literal::parseDouble("1e3", value));
+    EXPECT_DOUBLE_EQ(value, 1000.0);
+    EXPECT_TRUE(bt::literal::parseDouble("+1.5E-2", value));
+    EXPECT_DOUBLE_EQ(value, 0.015);
+    EXPECT_TRUE(bt::literal::parseDouble("-.inf", value));
+    EXPECT_TRUE(std::isinf(value) && (value < 0.0));
+    EXPECT_TRUE(bt::literal::parseDouble(".NaN", value));
+    EXPECT_TRUE(std::isnan(value));
+
+    value = 5.0;
+    for (char const* text : {"", ".", "-", "e3", "1e", "1e+", "1.5.2", "inf",
+                             "nan", "-.nan", ".iNf", "0x1p3", " 1.0", "1e999"})
+    {
+        EXPECT_FALSE(bt::literal::parseDouble(text, value)) << text;
+    }
+    EXPECT_DOUBLE_EQ(value, 5.0);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the grammar of the booleans.
+//! \details GIVEN the YAML 1.1 boolean words in several cases, WHEN parsing
+//!          them, THEN EXPECT lower, capitalized and upper cases accepted,
+//!          mixed cases and digits refused.
+// ------------------------------------------------------------------------
+TEST(TestLiteral, ParseBool)
+{
+    bool value = false;
+    for (char const* text : {"true", "True", "TRUE", "yes", "on", "Y"})
+    {
+        value = false;
+        EXPECT_TRUE(bt::literal::parseBool(text, value)) << text;
+        EXPECT_TRUE(value) << text;
+    }
+    for (char const* text : {"false", "False", "FALSE", "no", "OFF", "n"})
+    {
+        value = true;
+        EXPECT_TRUE(bt::literal::parseBool(text, value)) << text;
+        EXPECT_FALSE(value) << text;
+    }
+    for (char const* text : {"", "tRUE", "TRue", "1", "0", "yess", "nope"})
+    {
+        EXPECT_FALSE(bt::literal::parseBool(text, value)) << text;
+    }
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the type inference of literals.
+//! \details GIVEN texts of each type, WHEN classifying them, THEN EXPECT int
+//!          first, then double, then bool, else string.
+// ------------------------------------------------------------------------
+TEST(TestLiteral, Classify)
+{
+    using Type = bt::literal::Scalar::Type;
+
+    bt::literal::Scalar scalar = bt::literal::classify("-12");
+    EXPECT_EQ(scalar.type, Type::Int);
+    EXPECT_EQ(scalar.integer, -12);
+
+    scalar = bt::literal::classify("99999999999");
+    EXPECT_EQ(scalar.type, Type::Double);
+    EXPECT_DOUBLE_EQ(scalar.real, 99999999999.0);
+
+    scalar = bt::literal::classify("0.25");
+    EXPECT_EQ(scalar.type, Type::Double);
+    EXPECT_DOUBLE_EQ(scalar.real, 0.25);
+
+    scalar = bt::literal::classify("Yes");
+    EXPECT_EQ(scalar.type, Type::Bool);
+    EXPECT_TRUE(scalar.boolean);
+
+    for (char const* text : {"", "hello", "1.2.3", "-", "${key}", "12 px"})
+    {
+        EXPECT_EQ(bt::literal::classify(text).type, Type::String) << text;
+    }
+}
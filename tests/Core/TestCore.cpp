@@ -404,3 +404,351 @@ TEST(TestNodeLifecycle, HaltComposite)
     // THEN: EXPECT the composite status becomes INVALID
     EXPECT_EQ(seq->status(), bt::Status::INVALID);
 }
+
+// ------------------------------------------------------------------------
+//! \brief Test the RTTI-free traversal of the tree.
+//! \details GIVEN composites, decorators and leaves, WHEN counting their
+//!          children, THEN EXPECT the tree structure.
+// ------------------------------------------------------------------------
+TEST(TestTree, ChildrenTraversal)
+{
+    auto sequence = bt::Node::create<bt::Sequence>();
+    auto inverter = bt::Node::create<bt::Inverter>();
+    EXPECT_EQ(inverter->childrenCount(), 0u);
+    auto success = bt::Node::create<bt::Success>();
+    bt::Node* leaf = success.get();
+    inverter->setChild(std::move(success));
+    sequence->addChild(std::move(inverter));
+    sequence->addChild(bt::Node::create<bt::Failure>());
+
+    ASSERT_EQ(sequence->childrenCount(), 2u);
+    bt::Node* first = sequence->childAt(0u);
+    ASSERT_EQ(first->childrenCount(), 1u);
+    EXPECT_EQ(first->childAt(0u), leaf);
+    EXPECT_EQ(leaf->childrenCount(), 0u);
+    EXPECT_EQ(sequence->childAt(1u)->childAt(0u), nullptr);
+}
+
+// ===========================================================================
+// Tree Fork Tests
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test forking a running tree driven by a simulated clock.
+//! \details GIVEN a tree waiting in the middle of a sequence, WHEN forking
+//!          it with its own manual clock and advancing that clock, THEN
+//!          EXPECT the fork resumes where the tree was and its writes are
+//!          not seen by the original tree.
+// ------------------------------------------------------------------------
+TEST(TestTreeFork, ForkRunningTreeWithSimulatedClock)
+{
+    // GIVEN: A tree waiting in the middle of a sequence
+    auto clock = std::make_shared<bt::ManualClock>();
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("counter", 0);
+
+    bt::Tree tree;
+    tree.setBlackboard(bb);
+    auto& seq = tree.createRoot<bt::Sequence>();
+    seq.addChild(
+        bt::Node::create<bt::SetBlackboard>("counter", "${counter} + 1", bb));
+    seq.addChild(bt::Node::create<bt::Wait>(1000));
+    seq.addChild(bt::Node::create<bt::SetBlackboard>("done", "true", bb));
+    tree.setClock(clock);
+
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(bb->get<int>("counter"), 1);
+
+    // WHEN: Forking it with its own clock and advancing that clock
+    auto simulated = std::make_shared<bt::ManualClock>(clock->now());
+    auto fork = tree.fork(simulated);
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->status(), bt::Status::RUNNING);
+    EXPECT_EQ(fork->clock(), simulated);
+    EXPECT_NE(fork->blackboard(), bb);
+
+    EXPECT_EQ(fork->tick(), bt::Status::RUNNING);
+    simulated->advance(std::chrono::seconds(1));
+
+    // THEN: EXPECT the fork resumes after the first child
+    EXPECT_EQ(fork->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(fork->blackboard()->get<int>("counter"), 1);
+    EXPECT_EQ(fork->blackboard()->get<bool>("done"), true);
+
+    // THEN: EXPECT the original tree is still waiting on its own clock
+    EXPECT_FALSE(bb->has("done"));
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    clock->advance(std::chrono::seconds(1));
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(bb->get<int>("counter"), 1);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test forking a tree whose subtree writes to the parent blackboard.
+//! \details GIVEN a subtree propagating an output to the tree blackboard,
+//!          WHEN ticking a fork, THEN EXPECT the output is written to the
+//!          forked blackboard only.
+// ------------------------------------------------------------------------
+TEST(TestTreeFork, ForkSubTreeBlackboards)
+{
+    // GIVEN: A subtree propagating an output to the tree blackboard
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto nested = bb->createChild();
+    auto subtree = bt::Tree::create();
+    subtree->setBlackboard(nested);
+    subtree->setRoot(
+        bt::Node::create<bt::SetBlackboard>("result", "42", nested));
+    subtree->setOutputRemapping({{"result", "answer"}});
+    subtree->setParentBlackboard(bb);
+
+    bt::Tree tree;
+    tree.setBlackboard(bb);
+    tree.setRoot(bt::Node::create<bt::SubTreeNode>(
+        std::make_shared<bt::SubTreeHandle>("Sub", std::move(subtree))));
+
+    // WHEN: Ticking a fork
+    auto fork = tree.fork();
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->tick(), bt::Status::SUCCESS);
+
+    // THEN: EXPECT the output is only written to the forked blackboard
+    EXPECT_EQ(fork->blackboard()->get<int>("answer"), 42);
+    EXPECT_FALSE(bb->has("answer"));
+    EXPECT_FALSE(nested->has("result"));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test forking a tree holding a node that cannot be cloned.
+//! \details GIVEN a tree with a custom action not overriding clone(), WHEN
+//!          forking it, THEN EXPECT nullptr.
+// ------------------------------------------------------------------------
+TEST(TestTreeFork, NotClonableNode)
+{
+    // GIVEN: A tree with a custom action not overriding clone()
+    bt::Tree tree;
+    auto& seq = tree.createRoot<bt::Sequence>();
+    seq.addChild(bt::Node::create<bt::Success>());
+    seq.addChild(bt::Node::create<StatusAction>(bt::Status::SUCCESS));
+
+    // WHEN: Forking it / THEN: EXPECT nullptr
+    EXPECT_EQ(tree.fork(), nullptr);
+}
+
+// ===========================================================================
+// Tree State Tests
+// ===========================================================================
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Tree counting its starts, then waiting 3 times 100 ms before
+//! writing "done".
+// ----------------------------------------------------------------------------
+bt::Tree::Ptr waitingTree(bt::Blackboard::Ptr const& p_bb,
+                          bt::Clock::Ptr const& p_clock)
+{
+    auto tree = bt::Tree::create();
+    tree->setBlackboard(p_bb);
+    auto& seq = tree->createRoot<bt::Sequence>();
+    seq.addChild(bt::Node::create<bt::SetBlackboard>(
+        "starts", "${starts} + 1", p_bb));
+    auto repeater = bt::Node::create<bt::Repeater>(3);
+    repeater->setChild(bt::Node::create<bt::Wait>(100));
+    seq.addChild(std::move(repeater));
+    seq.addChild(bt::Node::create<bt::SetBlackboard>("done", "true", p_bb));
+    tree->setClock(p_clock);
+    return tree;
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------
+//! \brief Test moving the execution state of a running tree to a copy.
+//! \details GIVEN a tree waiting inside a repeater, and a copy of the tree
+//!          with a clock of another origin, WHEN loading the state of the
+//!          tree into the copy, THEN EXPECT the copy resumes where the tree
+//!          stopped: same cursor, count and elapsed time.
+// ------------------------------------------------------------------------
+TEST(TestTreeState, ResumeRunningTree)
+{
+    // GIVEN: A tree waiting inside a repeater
+    auto clock = std::make_shared<bt::ManualClock>();
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("starts", 0);
+    auto tree = waitingTree(bb, clock);
+    EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
+    clock->advance(std::chrono::milliseconds(100));
+    EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
+    clock->advance(std::chrono::milliseconds(60));
+
+    // GIVEN: A copy with a clock of another origin
+    auto other_clock = std::make_shared<bt::ManualClock>(
+        clock->now() + std::chrono::hours(5));
+    auto other_bb = std::make_shared<bt::Blackboard>();
+    other_bb->set("starts", 0);
+    auto copy = waitingTree(other_bb, other_clock);
+
+    // WHEN: Loading the state of the tree into the copy
+    std::string state;
+    ASSERT_TRUE(tree->saveState(state));
+    bt::encoding::Reader reader(state.data(), state.size());
+    ASSERT_TRUE(copy->loadState(reader));
+    EXPECT_TRUE(reader.atEnd());
+
+    // THEN: EXPECT the copy resumes where the tree stopped
+    EXPECT_EQ(copy->status(), bt::Status::RUNNING);
+    auto& repeater = static_cast<bt::Repeater&>(
+        *copy->getRoot().childAt(1));
+    EXPECT_EQ(repeater.getCount(), 1u);
+    other_clock->advance(std::chrono::milliseconds(39));
+    EXPECT_EQ(copy->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(repeater.getCount(), 1u);
+    other_clock->advance(std::chrono::milliseconds(1));
+    EXPECT_EQ(copy->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(repeater.getCount(), 2u);
+    EXPECT_EQ(copy->tick(), bt::Status::RUNNING);
+    other_clock->advance(std::chrono::milliseconds(100));
+    EXPECT_EQ(copy->tick(), bt::Status::SUCCESS);
+
+    // The first child is not run again
+    EXPECT_EQ(other_bb->get<int>("starts"), 0);
+    EXPECT_EQ(other_bb->get<bool>("done"), true);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test loading a state into a tree of another structure.
+//! \details GIVEN the state of a running tree, WHEN loading it into a tree
+//!          of other nodes or from a truncated buffer, THEN EXPECT false.
+// ------------------------------------------------------------------------
+TEST(TestTreeState, RejectsOtherTree)
+{
+    // GIVEN: The state of a running tree
+    auto clock = std::make_shared<bt::ManualClock>();
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("starts", 0);
+    auto tree = waitingTree(bb, clock);
+    EXPECT_EQ(tree->tick(), bt::Status::RUNNING);
+    std::string state;
+    ASSERT_TRUE(tree->saveState(state));
+
+    // WHEN: Loading it into a tree of other nodes / THEN: EXPECT false
+    bt::Tree other;
+    auto& seq = other.createRoot<bt::Sequence>();
+    seq.addChild(bt::Node::create<bt::Success>());
+    bt::encoding::Reader reader(state.data(), state.size());
+    EXPECT_FALSE(other.loadState(reader));
+
+    // WHEN: Loading a truncated state / THEN: EXPECT false
+    auto copy = waitingTree(bb, clock);
+    bt::encoding::Reader truncated(state.data(), state.size() - 1u);
+    EXPECT_FALSE(copy->loadState(truncated));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test saving a tree whose content was replaced at runtime.
+//! \details GIVEN a DynamicSubTree whose content was swapped in, WHEN
+//!          saving the state of the tree, THEN EXPECT false since the
+//!          content cannot be rebuilt from the description of the tree.
+// ------------------------------------------------------------------------
+TEST(TestTreeState, RuntimeContentIsNotSaved)
+{
+    // GIVEN: A DynamicSubTree whose content was swapped in
+    bt::Tree tree;
+    auto& dynamic = tree.createRoot<bt::DynamicSubTree>();
+    std::string state;
+    EXPECT_TRUE(tree.saveState(state));
+
+    auto content = bt::Tree::create();
+    (void)content->createRoot<StatusAction>(bt::Status::RUNNING);
+    dynamic.replace(std::move(content));
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+
+    // WHEN: Saving the state of the tree / THEN: EXPECT false
+    state.clear();
+    EXPECT_FALSE(tree.saveState(state));
+}
+
+// ===========================================================================
+// DynamicSubTree Tests
+// ===========================================================================
+
+// ------------------------------------------------------------------------
+//! \brief Test a DynamicSubTree without content.
+//! \details GIVEN a DynamicSubTree without content, WHEN ticking it, THEN
+//!          EXPECT FAILURE.
+// ------------------------------------------------------------------------
+TEST(TestDynamicSubTree, FailsWithoutContent)
+{
+    bt::Tree tree;
+    auto& dynamic = tree.createRoot<bt::DynamicSubTree>();
+
+    EXPECT_TRUE(tree.isValid());
+    EXPECT_EQ(tree.tick(), bt::Status::FAILURE);
+    EXPECT_EQ(dynamic.content(), nullptr);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test replacing the content of a running DynamicSubTree.
+//! \details GIVEN a DynamicSubTree whose content is running, WHEN
+//!          replacing its content, THEN EXPECT the content is swapped in at
+//!          the next tick, and the old content is halted.
+// ------------------------------------------------------------------------
+TEST(TestDynamicSubTree, SwapContentBetweenTicks)
+{
+    // GIVEN: A DynamicSubTree whose content is running
+    auto running = bt::Tree::create();
+    auto& action = running->createRoot<StatusAction>(bt::Status::RUNNING);
+    bt::Tree tree;
+    auto& dynamic =
+        tree.createRoot<bt::DynamicSubTree>(std::move(running));
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(action.status(), bt::Status::RUNNING);
+
+    // WHEN: Replacing its content
+    auto next = bt::Tree::create();
+    int counter = 0;
+    (void)next->createRoot<CounterAction>(&counter);
+    dynamic.replace(std::move(next));
+    EXPECT_EQ(counter, 0);
+    EXPECT_EQ(dynamic.swaps(), 0u);
+
+    // THEN: EXPECT the content is swapped at the next tick, the old content
+    // being halted
+    EXPECT_EQ(action.status(), bt::Status::RUNNING);
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(counter, 1);
+    EXPECT_EQ(dynamic.swaps(), 1u);
+    EXPECT_FALSE(dynamic.mailbox()->hasPending());
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test forking a tree holding a DynamicSubTree.
+//! \details GIVEN a DynamicSubTree whose content writes to its blackboard,
+//!          WHEN ticking a fork of the tree, THEN EXPECT the content is
+//!          cloned with a forked blackboard.
+// ------------------------------------------------------------------------
+TEST(TestDynamicSubTree, ForkClonesContent)
+{
+    // GIVEN: A DynamicSubTree whose content writes to its blackboard
+    auto bb = std::make_shared<bt::Blackboard>();
+    auto nested = bb->createChild();
+    auto content = bt::Tree::create();
+    content->setBlackboard(nested);
+    content->setRoot(
+        bt::Node::create<bt::SetBlackboard>("result", "42", nested));
+    bt::Tree tree;
+    tree.setBlackboard(bb);
+    tree.setRoot(bt::Node::create<bt::DynamicSubTree>(std::move(content)));
+
+    // WHEN: Ticking a fork of the tree
+    auto fork = tree.fork();
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->tick(), bt::Status::SUCCESS);
+
+    // THEN: EXPECT the content is cloned with a forked blackboard
+    EXPECT_FALSE(nested->has("result"));
+    auto* dynamic = static_cast<bt::DynamicSubTree*>(&fork->getRoot());
+    ASSERT_NE(dynamic->content(), nullptr);
+    EXPECT_EQ(dynamic->content()->blackboard()->get<int>("result"), 42);
+}
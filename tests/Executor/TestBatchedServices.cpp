@@ -0,0 +1,290 @@
+/**
+ * @file TestBatchedServices.cpp
+ * @brief Unit tests for the batched services, the BatchedServiceCall leaf and
+ * their flushing by the Executor.
+ *
+ * Corresponds to src/BlackThorn/Executor/BatchedServices.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <atomic>
+#include <thread>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Service squaring integer requests, counting its calls. Requests
+//! that are not integers get an empty response (failure).
+// ----------------------------------------------------------------------------
+bt::BatchedServices::Function square(std::atomic<size_t>& p_calls)
+{
+    return [&p_calls](bt::BatchedServices::Requests const& p_requests,
+                      bt::BatchedServices::Responses& p_responses)
+    {
+        ++p_calls;
+        for (size_t i = 0u; i < p_requests.size(); ++i)
+        {
+            if (auto const* value = std::any_cast<int>(&p_requests[i]))
+            {
+                p_responses[i] = *value * *value;
+            }
+        }
+    };
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Agent tree calling the service "square" with its blackboard entry
+//! "x", the response being stored in "y".
+// ----------------------------------------------------------------------------
+struct Agent
+{
+    Agent(bt::BatchedServices::Ptr const& p_services, int p_x)
+        : blackboard(std::make_shared<bt::Blackboard>())
+    {
+        blackboard->set("x", p_x);
+        auto leaf = bt::Node::create<bt::BatchedServiceCall>(
+            p_services, "square", "x", "y");
+        leaf->setBlackboard(blackboard);
+        tree.setRoot(std::move(leaf));
+        tree.setBlackboard(blackboard);
+    }
+
+    bt::Blackboard::Ptr blackboard;
+    bt::Tree tree;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// BatchedServices Tests
+// ===========================================================================
+
+TEST(TestBatchedServices, FlushServesOneBatch)
+{
+    bt::BatchedServices services;
+    std::atomic<size_t> calls{0u};
+    services.add("square", square(calls));
+
+    EXPECT_TRUE(services.has("square"));
+    EXPECT_EQ(services.enqueue("unknown", 1), nullptr);
+
+    auto first = services.enqueue("square", 3);
+    auto second = services.enqueue("square", std::string("three"));
+    auto third = services.enqueue("square", 4);
+    ASSERT_NE(first, nullptr);
+    EXPECT_FALSE(first->ready());
+    EXPECT_EQ(services.pending("square"), 3u);
+    EXPECT_EQ(calls, 0u);
+
+    EXPECT_EQ(services.flush(), 3u);
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(services.pending("square"), 0u);
+    ASSERT_TRUE(first->ready());
+    EXPECT_EQ(std::any_cast<int>(first->response()), 9);
+    EXPECT_FALSE(second->response().has_value());
+    EXPECT_EQ(std::any_cast<int>(third->response()), 16);
+
+    // Nothing pending: the service is not called
+    EXPECT_EQ(services.flush("square"), 0u);
+    EXPECT_EQ(calls, 1u);
+
+    auto stats = services.statistics("square");
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.batches, 1u);
+    EXPECT_DOUBLE_EQ(stats.averageBatch(), 3.0);
+
+    services.resetStatistics();
+    EXPECT_EQ(services.statistics().requests, 0u);
+}
+
+TEST(TestBatchedServices, SizeAndDelayThresholds)
+{
+    bt::BatchedServices services;
+    std::atomic<size_t> calls{0u};
+    bt::BatchedServices::Limits by_size;
+    by_size.maxBatch = 2u;
+    services.add("square", square(calls), by_size);
+    bt::BatchedServices::Limits by_delay;
+    by_delay.maxDelay = std::chrono::milliseconds(1);
+    services.add("slow", square(calls), by_delay);
+
+    // The second request fills the batch and serves it
+    auto first = services.enqueue("square", 2);
+    EXPECT_FALSE(first->ready());
+    auto second = services.enqueue("square", 3);
+    EXPECT_TRUE(first->ready());
+    EXPECT_TRUE(second->ready());
+    EXPECT_EQ(services.statistics("square").full, 1u);
+
+    // The batch waiting more than 1 ms is served by flushExpired()
+    auto third = services.enqueue("slow", 4);
+    EXPECT_EQ(services.flushExpired(), 0u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    EXPECT_EQ(services.flushExpired(), 1u);
+    EXPECT_EQ(std::any_cast<int>(third->response()), 16);
+    EXPECT_EQ(services.statistics("slow").expired, 1u);
+    EXPECT_EQ(calls, 2u);
+}
+
+TEST(TestBatchedServices, ReleasedCallIsWithdrawn)
+{
+    bt::BatchedServices services;
+    std::atomic<size_t> calls{0u};
+    services.add("square", square(calls));
+
+    auto kept = services.enqueue("square", 5);
+    auto copy = kept;
+    (void)services.enqueue("square", 6);
+    kept.reset();
+
+    EXPECT_EQ(services.flush(), 1u);
+    EXPECT_EQ(std::any_cast<int>(copy->response()), 25);
+    EXPECT_EQ(services.statistics("square").cancelled, 1u);
+
+    // A batch of withdrawn requests does not call the service
+    (void)services.enqueue("square", 7);
+    EXPECT_EQ(services.flush(), 0u);
+    EXPECT_EQ(calls, 1u);
+}
+
+// ===========================================================================
+// BatchedServiceCall Leaf Tests
+// ===========================================================================
+
+TEST(TestBatchedServiceCall, RunningUntilServed)
+{
+    auto services = std::make_shared<bt::BatchedServices>();
+    std::atomic<size_t> calls{0u};
+    services->add("square", square(calls));
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("x", 7);
+
+    bt::BatchedServiceCall leaf(services, "square", "x", "y");
+    leaf.setBlackboard(bb);
+    EXPECT_TRUE(leaf.isValid());
+    EXPECT_EQ(leaf.getRequest(), "x");
+    EXPECT_EQ(leaf.getResponse(), "y");
+
+    EXPECT_EQ(leaf.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(leaf.tick(), bt::Status::RUNNING);
+    EXPECT_EQ(services->pending("square"), 1u);
+    services->flush();
+    EXPECT_EQ(leaf.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(*bb->get<int>("y"), 49);
+
+    // The next run sends a new request
+    bb->set("x", 8);
+    EXPECT_EQ(leaf.tick(), bt::Status::RUNNING);
+    services->flush();
+    EXPECT_EQ(leaf.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(*bb->get<int>("y"), 64);
+    EXPECT_EQ(calls, 2u);
+}
+
+TEST(TestBatchedServiceCall, FailureAndInvalid)
+{
+    auto services = std::make_shared<bt::BatchedServices>();
+    std::atomic<size_t> calls{0u};
+    services->add("square", square(calls));
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("text", std::string("seven"));
+
+    // Empty response
+    bt::BatchedServiceCall wrong(services, "square", "text");
+    wrong.setBlackboard(bb);
+    EXPECT_EQ(wrong.getResponse(), "square");
+    EXPECT_EQ(wrong.tick(), bt::Status::RUNNING);
+    services->flush();
+    EXPECT_EQ(wrong.tick(), bt::Status::FAILURE);
+
+    // Missing request
+    bt::BatchedServiceCall missing(services, "square", "nothing");
+    missing.setBlackboard(bb);
+    EXPECT_EQ(missing.tick(), bt::Status::FAILURE);
+
+    bt::BatchedServiceCall unknown(services, "unknown");
+    EXPECT_FALSE(unknown.isValid());
+    EXPECT_EQ(unknown.tick(), bt::Status::FAILURE);
+}
+
+TEST(TestBatchedServiceCall, HaltWithdrawsRequest)
+{
+    auto services = std::make_shared<bt::BatchedServices>();
+    std::atomic<size_t> calls{0u};
+    services->add("square", square(calls));
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("x", 2);
+
+    bt::BatchedServiceCall leaf(services, "square", "x", "y");
+    leaf.setBlackboard(bb);
+    EXPECT_EQ(leaf.tick(), bt::Status::RUNNING);
+    leaf.halt();
+
+    EXPECT_EQ(services->flush(), 0u);
+    EXPECT_EQ(services->statistics("square").cancelled, 1u);
+    EXPECT_EQ(calls, 0u);
+    EXPECT_FALSE(bb->get<int>("y"));
+}
+
+// ===========================================================================
+// Executor Tests
+// ===========================================================================
+
+TEST(TestExecutor, BatchesServiceCallsOfAllTrees)
+{
+    bt::Executor executor(4);
+    std::atomic<size_t> calls{0u};
+    executor.services()->add("square", square(calls));
+    EXPECT_EQ(executor.batchFlush(), bt::Executor::BatchFlush::EndOfTick);
+
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (int i = 0; i < 64; ++i)
+    {
+        agents.push_back(std::make_unique<Agent>(executor.services(), i));
+        executor.add(agents.back()->tree);
+    }
+
+    // The requests of the 64 trees are served by one call at the end of tick
+    for (bt::Status status : executor.tick())
+    {
+        EXPECT_EQ(status, bt::Status::RUNNING);
+    }
+    EXPECT_EQ(calls, 1u);
+    for (bt::Status status : executor.tick())
+    {
+        EXPECT_EQ(status, bt::Status::SUCCESS);
+    }
+    for (int i = 0; i < 64; ++i)
+    {
+        EXPECT_EQ(*agents[size_t(i)]->blackboard->get<int>("y"), i * i);
+    }
+
+    auto stats = executor.services()->statistics("square");
+    EXPECT_EQ(stats.requests, 64u);
+    EXPECT_EQ(stats.batches, 1u);
+}
+
+TEST(TestExecutor, ManualBatchFlush)
+{
+    bt::Executor executor;
+    executor.setBatchFlush(bt::Executor::BatchFlush::Manual);
+    std::atomic<size_t> calls{0u};
+    executor.services()->add("square", square(calls));
+
+    Agent agent(executor.services(), 3);
+    executor.add(agent.tree);
+
+    EXPECT_EQ(executor.tick()[0], bt::Status::RUNNING);
+    EXPECT_EQ(executor.tick()[0], bt::Status::RUNNING);
+    EXPECT_EQ(calls, 0u);
+
+    executor.services()->flush();
+    EXPECT_EQ(executor.tick()[0], bt::Status::SUCCESS);
+    EXPECT_EQ(*agent.blackboard->get<int>("y"), 9);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file TestExecutor.cpp
+ * @brief Unit tests for the batch Executor, the shared computations and the
+ * SharedComputation leaf.
+ *
+ * Corresponds to src/BlackThorn/Executor/
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <atomic>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Agent tree reading the shared computation "threat" into its own
+//! blackboard.
+// ----------------------------------------------------------------------------
+struct Agent
+{
+    explicit Agent(bt::SharedComputations::Ptr const& p_computations)
+        : blackboard(std::make_shared<bt::Blackboard>())
+    {
+        auto leaf = bt::Node::create<bt::SharedComputation>(p_computations,
+                                                            "threat");
+        leaf->setBlackboard(blackboard);
+        tree.setRoot(std::move(leaf));
+        tree.setBlackboard(blackboard);
+    }
+
+    bt::Blackboard::Ptr blackboard;
+    bt::Tree tree;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// SharedComputations Tests
+// ===========================================================================
+
+TEST(TestSharedComputations, ComputedOncePerTick)
+{
+    bt::SharedComputations shared;
+    int calls = 0;
+    shared.add("threat", [&calls]() { return bt::Blackboard::Value(++calls); });
+
+    EXPECT_TRUE(shared.has("threat"));
+    EXPECT_FALSE(shared.has("unknown"));
+    EXPECT_EQ(shared.get("unknown"), nullptr);
+
+    auto first = shared.get("threat");
+    auto second = shared.get("threat");
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(std::any_cast<int>(*first), 1);
+    EXPECT_EQ(calls, 1);
+
+    shared.nextTick();
+    auto third = shared.get("threat");
+    EXPECT_EQ(std::any_cast<int>(*third), 2);
+    EXPECT_EQ(std::any_cast<int>(*first), 1);
+
+    auto stats = shared.statistics("threat");
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 1.0 / 3.0);
+
+    shared.resetStatistics();
+    EXPECT_EQ(shared.statistics().misses, 0u);
+}
+
+TEST(TestSharedComputations, FailureNotRetriedWithinTick)
+{
+    bt::SharedComputations shared;
+    int calls = 0;
+    shared.add("broken", [&calls]() {
+        ++calls;
+        return bt::Blackboard::Value();
+    });
+
+    EXPECT_EQ(shared.get("broken"), nullptr);
+    EXPECT_EQ(shared.get("broken"), nullptr);
+    EXPECT_EQ(calls, 1);
+}
+
+// ===========================================================================
+// SharedComputation Leaf Tests
+// ===========================================================================
+
+TEST(TestSharedComputation, StoresResultInBlackboard)
+{
+    auto shared = std::make_shared<bt::SharedComputations>();
+    shared->add("threat", []() { return bt::Blackboard::Value(42); });
+    auto bb = std::make_shared<bt::Blackboard>();
+
+    bt::SharedComputation leaf(shared, "threat", "level");
+    leaf.setBlackboard(bb);
+    EXPECT_TRUE(leaf.isValid());
+    EXPECT_EQ(leaf.getKey(), "level");
+    EXPECT_EQ(leaf.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(*bb->get<int>("level"), 42);
+
+    // Writing the blackboard does not alter the shared result
+    bb->set("level", 0);
+    EXPECT_EQ(std::any_cast<int>(*shared->get("threat")), 42);
+}
+
+TEST(TestSharedComputation, FailureAndInvalid)
+{
+    auto shared = std::make_shared<bt::SharedComputations>();
+    shared->add("broken", []() { return bt::Blackboard::Value(); });
+
+    bt::SharedComputation broken(shared, "broken");
+    EXPECT_EQ(broken.getKey(), "broken");
+    EXPECT_EQ(broken.tick(), bt::Status::FAILURE);
+
+    bt::SharedComputation unknown(shared, "unknown");
+    EXPECT_FALSE(unknown.isValid());
+}
+
+// ===========================================================================
+// Executor Tests
+// ===========================================================================
+
+TEST(TestExecutor, SequentialSharesComputation)
+{
+    bt::Executor executor;
+    int calls = 0;
+    executor.computations()->add("threat", [&calls]() {
+        return bt::Blackboard::Value(++calls);
+    });
+
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (int i = 0; i < 8; ++i)
+    {
+        agents.push_back(std::make_unique<Agent>(executor.computations()));
+        executor.add(agents.back()->tree);
+    }
+    EXPECT_EQ(executor.size(), 8u);
+    EXPECT_EQ(executor.threads(), 1u);
+
+    for (int tick = 1; tick <= 3; ++tick)
+    {
+        for (bt::Status status : executor.tick())
+        {
+            EXPECT_EQ(status, bt::Status::SUCCESS);
+        }
+        EXPECT_EQ(calls, tick);
+        for (auto const& agent : agents)
+        {
+            EXPECT_EQ(*agent->blackboard->get<int>("threat"), tick);
+        }
+    }
+
+    auto stats = executor.computations()->statistics();
+    EXPECT_EQ(stats.misses, 3u);
+    EXPECT_EQ(stats.hits, 21u);
+}
+
+TEST(TestExecutor, ThreadPoolSharesComputation)
+{
+    bt::Executor executor(4);
+    std::atomic<int> calls{0};
+    executor.computations()->add("threat", [&calls]() {
+        return bt::Blackboard::Value(++calls);
+    });
+
+    std::vector<std::unique_ptr<Agent>> agents;
+    for (int i = 0; i < 64; ++i)
+    {
+        agents.push_back(std::make_unique<Agent>(executor.computations()));
+        executor.add(agents.back()->tree);
+    }
+    EXPECT_EQ(executor.threads(), 4u);
+
+    for (int tick = 1; tick <= 50; ++tick)
+    {
+        executor.tick();
+        ASSERT_EQ(calls.load(), tick);
+        for (auto const& agent : agents)
+        {
+            ASSERT_EQ(*agent->blackboard->get<int>("threat"), tick);
+        }
+    }
+    for (bt::Status status : executor.statuses())
+    {
+        EXPECT_EQ(status, bt::Status::SUCCESS);
+    }
+
+    auto stats = executor.computations()->statistics("threat");
+    EXPECT_EQ(stats.misses, 50u);
+    EXPECT_EQ(stats.hits, 50u * 63u);
+    EXPECT_LE(stats.waits, stats.hits);
+}
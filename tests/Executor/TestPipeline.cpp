@@ -0,0 +1,157 @@
+/**
+ * @file TestPipeline.cpp
+ * @brief Unit tests for the sense-think-act Pipeline.
+ *
+ * Corresponds to src/BlackThorn/Executor/Pipeline.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <atomic>
+
+namespace {
+
+//! \brief Tree doubling its input.
+constexpr char const* DOUBLER_YAML = R"(
+Blackboard:
+  input: 0
+BehaviorTree:
+  SetBlackboard:
+    key: output
+    value: ${input} * 2
+)";
+
+// ----------------------------------------------------------------------------
+//! \brief Build the tree doubling its input.
+// ----------------------------------------------------------------------------
+bt::Tree::Ptr buildDoubler()
+{
+    bt::NodeFactory factory;
+    auto result = bt::Builder::fromText(factory, DOUBLER_YAML);
+    EXPECT_TRUE(result.isSuccess()) << result.getError();
+    return result.moveValue();
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------
+//! \brief Test the data flowing through the three stages.
+//! \details GIVEN a pipeline sensing the tick number and a tree doubling it,
+//!          WHEN running 100 ticks, THEN EXPECT the outputs are flushed in
+//!          order with the doubled inputs.
+// ------------------------------------------------------------------------
+TEST(TestPipeline, DataFlowsInOrder)
+{
+    // GIVEN: A pipeline sensing the tick number and a tree doubling it
+    auto tree = buildDoubler();
+    int sensed = 0;
+    std::vector<int> flushed;
+    std::vector<bt::Status> statuses;
+    bt::Pipeline pipeline(
+        *tree,
+        [&](bt::Blackboard& p_inputs) { p_inputs.set("input", ++sensed); },
+        [&](bt::Blackboard const& p_outputs, bt::Status p_status) {
+            flushed.push_back(p_outputs.getOrDefault<int>("output", -1));
+            statuses.push_back(p_status);
+        });
+
+    // WHEN: Running 100 ticks
+    pipeline.start(100u);
+    pipeline.wait();
+
+    // THEN: EXPECT the outputs are flushed in order with the doubled inputs
+    ASSERT_EQ(flushed.size(), 100u);
+    for (size_t i = 0; i < flushed.size(); ++i)
+    {
+        EXPECT_EQ(flushed[i], 2 * int(i + 1));
+        EXPECT_EQ(statuses[i], bt::Status::SUCCESS);
+    }
+    EXPECT_EQ(pipeline.statistics().ticks, 100u);
+    EXPECT_GE(pipeline.statistics().maxLatency,
+              pipeline.statistics().meanLatency());
+    EXPECT_EQ(tree->blackboard()->get<int>("input"), 100);
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the depth bounding the ticks in flight.
+//! \details GIVEN pipelines of depth 1 and 3, WHEN running them, THEN EXPECT
+//!          at most depth stages are busy at the same time.
+// ------------------------------------------------------------------------
+TEST(TestPipeline, DepthBoundsTicksInFlight)
+{
+    for (size_t depth : {1u, 3u})
+    {
+        // GIVEN: A pipeline of the given depth
+        auto tree = buildDoubler();
+        std::atomic<int> busy{0};
+        std::atomic<int> highest{0};
+        auto work = [&] {
+            int now = ++busy;
+            int seen = highest.load();
+            while ((now > seen) && !highest.compare_exchange_weak(seen, now))
+            {
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            --busy;
+        };
+        bt::Pipeline::Config config;
+        config.depth = depth;
+        bt::Pipeline pipeline(
+            *tree,
+            [&](bt::Blackboard& p_inputs) {
+                work();
+                p_inputs.set("input", 1);
+            },
+            [&](bt::Blackboard const&, bt::Status) { work(); },
+            config);
+
+        // WHEN: Running it
+        pipeline.start(50u);
+        pipeline.wait();
+
+        // THEN: EXPECT at most depth stages are busy at the same time
+        EXPECT_EQ(pipeline.statistics().ticks, 50u);
+        EXPECT_LE(size_t(highest.load()), depth);
+        if (depth == 1u)
+        {
+            EXPECT_EQ(highest.load(), 1);
+        }
+    }
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test stopping a pipeline running without limit.
+//! \details GIVEN a pipeline running until stopped, WHEN stopping it, THEN
+//!          EXPECT every tick sensed is flushed.
+// ------------------------------------------------------------------------
+TEST(TestPipeline, StopFlushesTicksInFlight)
+{
+    // GIVEN: A pipeline running until stopped
+    auto tree = buildDoubler();
+    std::atomic<uint64_t> sensed{0};
+    std::atomic<uint64_t> flushed{0};
+    bt::Pipeline pipeline(
+        *tree,
+        [&](bt::Blackboard& p_inputs) {
+            p_inputs.set("input", int(++sensed));
+        },
+        [&](bt::Blackboard const&, bt::Status) { ++flushed; });
+    pipeline.start();
+    while (flushed.load() < 10u)
+    {
+        std::this_thread::yield();
+    }
+
+    // WHEN: Stopping it
+    pipeline.stop();
+
+    // THEN: EXPECT every tick sensed is flushed
+    EXPECT_EQ(sensed.load(), flushed.load());
+    EXPECT_EQ(pipeline.statistics().ticks, flushed.load());
+    EXPECT_GT(pipeline.statistics().throughput(), 0.0);
+}
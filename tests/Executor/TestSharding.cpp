@@ -0,0 +1,402 @@
+/**
+ * @file TestSharding.cpp
+ * @brief Unit tests for the consistent hashing of agents to workers, the
+ * saving of their state and their live migration between worker processes.
+ *
+ * Corresponds to src/BlackThorn/Executor/Sharding.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <map>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Action taking two ticks to increment the "steps" entry, failing
+//! every third step. Its tick counter is saved with the tree.
+// ----------------------------------------------------------------------------
+class StepAction final: public bt::Action
+{
+public:
+
+    bt::Status onSetUp() override
+    {
+        m_ticks = 0u;
+        return bt::Status::RUNNING;
+    }
+
+    bt::Status onRunning() override
+    {
+        if (++m_ticks < 2u)
+        {
+            return bt::Status::RUNNING;
+        }
+        int steps = blackboard()->getOrDefault<int>("steps") + 1;
+        blackboard()->set("steps", steps);
+        return (steps % 3 == 0) ? bt::Status::FAILURE : bt::Status::SUCCESS;
+    }
+
+protected:
+
+    bool onSaveState(std::string& p_state) const override
+    {
+        bt::encoding::put(p_state, m_ticks);
+        return true;
+    }
+
+    bool onLoadState(bt::encoding::Reader& p_state) override
+    {
+        return p_state.get(m_ticks);
+    }
+
+private:
+
+    uint32_t m_ticks = 0u;
+};
+
+//! \brief Agent whose statuses depend on its cursor, its repeater, its
+//! custom action and its blackboard.
+constexpr char const* AGENT_YAML = R"(
+Blackboard:
+  steps: 0
+BehaviorTree:
+  Sequence:
+    children:
+      - Repeat:
+          times: 2
+          child:
+            - Action:
+                name: Step
+      - Action:
+          name: Step
+      - SetBlackboard:
+          key: laps
+          value: ${steps} / 3
+)";
+
+//! \brief Blackboard value without binary encoding.
+struct Pose
+{
+    double x = 0.0;
+    double y = 0.0;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Factory knowing the custom action of the agents.
+// ----------------------------------------------------------------------------
+bt::NodeFactory agentFactory()
+{
+    bt::NodeFactory factory;
+    factory.registerNode<StepAction>("Step");
+    return factory;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tick a worker and get the statuses of its agents by name.
+// ----------------------------------------------------------------------------
+std::map<std::string, bt::Status> tickWorker(bt::ShardWorker& p_worker)
+{
+    std::map<std::string, bt::Status> statuses;
+    auto const& result = p_worker.tick();
+    for (size_t i = 0u; i < result.size(); ++i)
+    {
+        statuses[p_worker.names()[i]] = result[i];
+    }
+    return statuses;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Get the execution state of the tree from an agent snapshot.
+// ----------------------------------------------------------------------------
+std::string treeState(std::string const& p_snapshot)
+{
+    bt::encoding::Reader reader(p_snapshot.data(), p_snapshot.size());
+    std::string name, document, state;
+    EXPECT_TRUE(reader.getString(name) && reader.getString(document) &&
+                reader.getString(state));
+    return state;
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// ShardRing Tests
+// ===========================================================================
+
+TEST(TestShardRing, NoWorker)
+{
+    bt::ShardRing ring;
+    EXPECT_FALSE(ring.owner("agent").has_value());
+
+    ring.add(7u);
+    EXPECT_TRUE(ring.has(7u));
+    EXPECT_EQ(ring.owner("agent"), 7u);
+
+    ring.remove(7u);
+    EXPECT_FALSE(ring.has(7u));
+    EXPECT_FALSE(ring.owner("agent").has_value());
+}
+
+TEST(TestShardRing, SpreadsAgentsEvenly)
+{
+    bt::ShardRing ring;
+    for (bt::ShardRing::Worker worker = 0u; worker < 4u; ++worker)
+    {
+        ring.add(worker);
+    }
+
+    std::map<bt::ShardRing::Worker, size_t> load;
+    for (size_t i = 0u; i < 4000u; ++i)
+    {
+        load[*ring.owner("agent-" + std::to_string(i))]++;
+    }
+
+    ASSERT_EQ(load.size(), 4u);
+    for (auto const& [worker, agents] : load)
+    {
+        EXPECT_GT(agents, 700u) << "worker " << worker;
+        EXPECT_LT(agents, 1300u) << "worker " << worker;
+    }
+}
+
+TEST(TestShardRing, AddingWorkerMovesFewAgents)
+{
+    bt::ShardRing ring;
+    for (bt::ShardRing::Worker worker = 0u; worker < 4u; ++worker)
+    {
+        ring.add(worker);
+    }
+    std::vector<bt::ShardRing::Worker> before;
+    for (size_t i = 0u; i < 4000u; ++i)
+    {
+        before.push_back(*ring.owner("agent-" + std::to_string(i)));
+    }
+
+    // Only the agents taken by the new worker move
+    ring.add(4u);
+    size_t moved = 0u;
+    for (size_t i = 0u; i < 4000u; ++i)
+    {
+        auto owner = *ring.owner("agent-" + std::to_string(i));
+        if (owner != before[i])
+        {
+            EXPECT_EQ(owner, 4u);
+            moved++;
+        }
+    }
+    EXPECT_GT(moved, 500u);
+    EXPECT_LT(moved, 1100u);
+
+    // Removing it gives them back
+    ring.remove(4u);
+    for (size_t i = 0u; i < 4000u; ++i)
+    {
+        EXPECT_EQ(*ring.owner("agent-" + std::to_string(i)), before[i]);
+    }
+}
+
+// ===========================================================================
+// ShardWorker Tests
+// ===========================================================================
+
+TEST(TestShardWorker, SpawnAndRemove)
+{
+    auto factory = agentFactory();
+    bt::ShardWorker worker(factory);
+
+    EXPECT_TRUE(worker.spawn("a", AGENT_YAML).isSuccess());
+    EXPECT_FALSE(worker.spawn("a", AGENT_YAML).isSuccess());
+    EXPECT_FALSE(worker.spawn("b", "BehaviorTree: {Unknown: {}}")
+                     .isSuccess());
+    ASSERT_EQ(worker.names().size(), 1u);
+    EXPECT_NE(worker.tree("a"), nullptr);
+    EXPECT_EQ(worker.tree("b"), nullptr);
+
+    EXPECT_TRUE(worker.remove("a"));
+    EXPECT_FALSE(worker.remove("a"));
+    EXPECT_TRUE(worker.names().empty());
+}
+
+TEST(TestShardWorker, ExportImportResumesAgent)
+{
+    auto factory = agentFactory();
+    bt::ShardWorker source(factory);
+    bt::ShardWorker target(factory);
+    ASSERT_TRUE(source.spawn("migrant", AGENT_YAML).isSuccess());
+    ASSERT_TRUE(source.spawn("twin", AGENT_YAML).isSuccess());
+
+    // Both agents are in the middle of their repeater
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        auto statuses = tickWorker(source);
+        EXPECT_EQ(statuses["migrant"], statuses["twin"]);
+    }
+    auto version = source.tree("migrant")->blackboard()->version("steps");
+    EXPECT_GT(version, 0u);
+
+    // Move the migrant to the target
+    auto snapshot = source.exportAgent("migrant");
+    ASSERT_TRUE(snapshot.isSuccess()) << snapshot.getError();
+    EXPECT_EQ(source.tree("migrant"), nullptr);
+    auto name = target.importAgent(snapshot.getValue());
+    ASSERT_TRUE(name.isSuccess()) << name.getError();
+    EXPECT_EQ(name.getValue(), "migrant");
+    ASSERT_NE(target.tree("migrant"), nullptr);
+    EXPECT_EQ(target.tree("migrant")->blackboard()->version("steps"),
+              version);
+
+    // It behaves as its twin that did not move
+    for (size_t i = 0u; i < 20u; ++i)
+    {
+        auto twin = tickWorker(source)["twin"];
+        EXPECT_EQ(tickWorker(target)["migrant"], twin) << "tick " << i;
+    }
+    EXPECT_EQ(treeState(target.snapshot("migrant").getValue()),
+              treeState(source.snapshot("twin").getValue()));
+    EXPECT_EQ(target.tree("migrant")->blackboard()->get<int>("steps"),
+              source.tree("twin")->blackboard()->get<int>("steps"));
+}
+
+TEST(TestShardWorker, RejectsUnmovableAgent)
+{
+    auto factory = agentFactory();
+    bt::ShardWorker worker(factory);
+    ASSERT_TRUE(worker.spawn("a", AGENT_YAML).isSuccess());
+    (void)worker.tick();
+
+    // A value without binary encoding keeps the agent on its worker
+    worker.tree("a")->blackboard()->set("pose", Pose{});
+    auto snapshot = worker.exportAgent("a");
+    EXPECT_FALSE(snapshot.isSuccess());
+    EXPECT_NE(worker.tree("a"), nullptr);
+
+    // Unknown agents and invalid snapshots are refused
+    EXPECT_FALSE(worker.exportAgent("unknown").isSuccess());
+    EXPECT_FALSE(worker.importAgent("garbage").isSuccess());
+
+    // An agent cannot be imported twice
+    worker.tree("a")->blackboard()->remove("pose");
+    snapshot = worker.snapshot("a");
+    ASSERT_TRUE(snapshot.isSuccess()) << snapshot.getError();
+    EXPECT_FALSE(worker.importAgent(snapshot.getValue()).isSuccess());
+
+    // A truncated snapshot is refused
+    std::string truncated = snapshot.getValue();
+    truncated.pop_back();
+    EXPECT_TRUE(worker.remove("a"));
+    EXPECT_FALSE(worker.importAgent(truncated).isSuccess());
+    EXPECT_TRUE(worker.names().empty());
+}
+
+// ===========================================================================
+// Shards Tests (several local worker processes)
+// ===========================================================================
+
+TEST(TestShards, MigratesRunningAgentsBetweenProcesses)
+{
+    auto factory = agentFactory();
+    bt::Shards shards;
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        ASSERT_TRUE(shards.spawnLocal(factory).isSuccess());
+    }
+    ASSERT_TRUE(shards.add("migrant", AGENT_YAML).isSuccess());
+    ASSERT_TRUE(shards.add("twin", AGENT_YAML).isSuccess());
+    EXPECT_FALSE(shards.add("twin", AGENT_YAML).isSuccess());
+    EXPECT_EQ(shards.size(), 2u);
+
+    // Move the migrant to the next worker every few ticks, whatever the
+    // node it is running
+    for (size_t i = 0u; i < 40u; ++i)
+    {
+        if (i % 3u == 1u)
+        {
+            auto worker = (*shards.location("migrant") + 1u) % 3u;
+            ASSERT_TRUE(shards.migrate("migrant", worker).isSuccess());
+            EXPECT_EQ(shards.location("migrant"), worker);
+        }
+        ASSERT_TRUE(shards.tick().isSuccess());
+        EXPECT_EQ(shards.statuses().at("migrant"),
+                  shards.statuses().at("twin"))
+            << "tick " << i;
+    }
+
+    auto migrant = shards.snapshot("migrant");
+    auto twin = shards.snapshot("twin");
+    ASSERT_TRUE(migrant.isSuccess()) << migrant.getError();
+    ASSERT_TRUE(twin.isSuccess()) << twin.getError();
+    EXPECT_EQ(treeState(migrant.getValue()), treeState(twin.getValue()));
+
+    // The pauses were measured
+    auto const& statistics = shards.statistics();
+    EXPECT_EQ(statistics.migrations, 13u);
+    EXPECT_EQ(statistics.failures, 0u);
+    EXPECT_GT(statistics.bytes, 0u);
+    EXPECT_GT(statistics.max_pause.count(), 0);
+    EXPECT_GE(statistics.max_pause, statistics.averagePause());
+    EXPECT_GT(statistics.averagePause().count(), 0);
+
+    // Unknown agents and workers are refused
+    EXPECT_FALSE(shards.migrate("unknown", 0u).isSuccess());
+    EXPECT_FALSE(shards.migrate("migrant", 42u).isSuccess());
+    EXPECT_TRUE(shards.remove("migrant").isSuccess());
+    EXPECT_FALSE(shards.remove("migrant").isSuccess());
+    EXPECT_EQ(shards.size(), 1u);
+}
+
+TEST(TestShards, RebalanceAndRetire)
+{
+    auto factory = agentFactory();
+    bt::Shards shards;
+    ASSERT_TRUE(shards.spawnLocal(factory).isSuccess());
+    ASSERT_TRUE(shards.spawnLocal(factory).isSuccess());
+    for (size_t i = 0u; i < 60u; ++i)
+    {
+        ASSERT_TRUE(
+            shards.add("agent-" + std::to_string(i), AGENT_YAML).isSuccess());
+    }
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        ASSERT_TRUE(shards.tick().isSuccess());
+    }
+
+    // A new worker takes its share of the agents
+    auto worker = shards.spawnLocal(factory);
+    ASSERT_TRUE(worker.isSuccess()) << worker.getError();
+    auto moved = shards.rebalance();
+    ASSERT_TRUE(moved.isSuccess()) << moved.getError();
+    EXPECT_EQ(moved.getValue(), shards.agents(worker.getValue()).size());
+    EXPECT_GT(moved.getValue(), 5u);
+    EXPECT_LT(moved.getValue(), 40u);
+    EXPECT_EQ(shards.statistics().migrations, moved.getValue());
+    for (size_t i = 0u; i < 60u; ++i)
+    {
+        std::string name = "agent-" + std::to_string(i);
+        EXPECT_EQ(shards.location(name), shards.ring().owner(name));
+    }
+
+    // The agents keep running in step
+    for (size_t i = 0u; i < 5u; ++i)
+    {
+        ASSERT_TRUE(shards.tick().isSuccess());
+        for (auto const& [name, status] : shards.statuses())
+        {
+            EXPECT_EQ(status, shards.statuses().at("agent-0")) << name;
+        }
+    }
+
+    // Retiring a worker moves its agents to the others
+    ASSERT_TRUE(shards.retire(0u).isSuccess());
+    EXPECT_FALSE(shards.ring().has(0u));
+    EXPECT_TRUE(shards.agents(0u).empty());
+    EXPECT_EQ(shards.size(), 60u);
+    ASSERT_TRUE(shards.tick().isSuccess());
+    EXPECT_EQ(shards.statuses().size(), 60u);
+    EXPECT_EQ(shards.rebalance().getValue(), 0u);
+}
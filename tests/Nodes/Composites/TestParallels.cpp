@@ -59,6 +59,28 @@ public:
     }
 };
 
+// Keeps running and counts how many times it has been halted
+class HaltCounterAction final: public bt::Action
+{
+public:
+
+    explicit HaltCounterAction(int* halts) : m_halts(halts) {}
+
+    bt::Status onRunning() override
+    {
+        return bt::Status::RUNNING;
+    }
+
+    void onHalt() override
+    {
+        (*m_halts)++;
+    }
+
+private:
+
+    int* m_halts;
+};
+
 } // anonymous namespace
 
 // ===========================================================================
@@ -111,6 +133,37 @@ TEST(TestParallel, AllChildrenExecuted)
     EXPECT_EQ(counter, 3);
 }
 
+TEST(TestParallel, RunningChildrenKeptByDefault)
+{
+    int halts = 0;
+    auto parallel = bt::Node::create<bt::Parallel>(1, 1);
+    parallel->addChild(bt::Node::create<bt::Success>());
+    parallel->addChild(bt::Node::create<HaltCounterAction>(&halts));
+
+    EXPECT_FALSE(parallel->getHaltOnDecision());
+    EXPECT_EQ(parallel->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(halts, 0);
+    EXPECT_EQ(parallel->getChildren()[1]->status(), bt::Status::RUNNING);
+}
+
+TEST(TestParallel, HaltOnDecision)
+{
+    int halts = 0;
+    auto parallel = bt::Node::create<bt::Parallel>(2, 1);
+    parallel->setHaltOnDecision(true);
+    parallel->addChild(bt::Node::create<HaltCounterAction>(&halts));
+    parallel->addChild(bt::Node::create<bt::Failure>());
+    parallel->addChild(bt::Node::create<HaltCounterAction>(&halts));
+
+    // The failure decides the outcome: both losers are halted at once
+    EXPECT_EQ(parallel->tick(), bt::Status::FAILURE);
+    EXPECT_EQ(halts, 2);
+    for (auto const& child : parallel->getChildren())
+    {
+        EXPECT_NE(child->status(), bt::Status::RUNNING);
+    }
+}
+
 TEST(TestParallel, GetThresholds)
 {
     auto parallel = bt::Node::create<bt::Parallel>(3, 2);
@@ -161,6 +214,19 @@ TEST(TestParallelAll, FailOnAll)
     EXPECT_EQ(parallel->tick(), bt::Status::FAILURE);
 }
 
+TEST(TestParallelAll, HaltOnDecision)
+{
+    int halts = 0;
+    auto parallel = bt::Node::create<bt::ParallelAll>(false, true);
+    parallel->setHaltOnDecision(true);
+    parallel->addChild(bt::Node::create<HaltCounterAction>(&halts));
+    parallel->addChild(bt::Node::create<bt::Success>());
+
+    EXPECT_EQ(parallel->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(halts, 1);
+    EXPECT_EQ(parallel->getChildren()[0]->status(), bt::Status::INVALID);
+}
+
 TEST(TestParallelAll, GetPolicies)
 {
     auto parallel = bt::Node::create<bt::ParallelAll>(true, false);
@@ -132,6 +132,58 @@ TEST(TestSelector, ExecutionStopsOnSuccess)
     EXPECT_EQ(counter, 0); // Third child never executed
 }
 
+TEST(TestSelector, UnorderedMovesDecisiveChildFirst)
+{
+    int counter = 0;
+    auto selector = bt::Node::create<bt::Selector>();
+    selector->addChild(bt::Node::create<bt::Failure>());
+    selector->addChild(bt::Node::create<bt::Failure>());
+    selector->addChild(bt::Node::create<CounterAction>(&counter));
+    selector->setUnordered({/*deterministic*/ true, /*reorder_period*/ 2});
+    ASSERT_TRUE(selector->isUnordered());
+
+    // Declaration order while statistics are gathered
+    EXPECT_EQ(selector->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(selector->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(counter, 2);
+    EXPECT_EQ(selector->getOrdering().order(),
+              (std::vector<size_t>{0u, 1u, 2u}));
+
+    // The only child able to succeed is now ticked first
+    EXPECT_EQ(selector->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(counter, 3);
+    EXPECT_EQ(selector->getOrdering().order(),
+              (std::vector<size_t>{2u, 0u, 1u}));
+    EXPECT_EQ(selector->getOrdering().revision(), 1u);
+
+    auto const& stats = selector->getOrdering().statistics();
+    EXPECT_EQ(stats[0].evaluations, 2u);
+    EXPECT_EQ(stats[0].successes, 0u);
+    EXPECT_EQ(stats[2].evaluations, 3u);
+    EXPECT_EQ(stats[2].successes, 3u);
+}
+
+TEST(TestSelector, UnorderedResumesRunningChild)
+{
+    int calls = 0;
+    auto selector = bt::Node::create<bt::Selector>();
+    selector->addChild(bt::Node::create<bt::Failure>());
+    selector->addChild(bt::Node::create<LambdaTestAction>([&calls]() {
+        return (++calls < 3) ? bt::Status::RUNNING : bt::Status::SUCCESS;
+    }));
+    selector->setUnordered({/*deterministic*/ true, /*reorder_period*/ 1});
+
+    EXPECT_EQ(selector->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(selector->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(selector->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(calls, 3);
+
+    // A RUNNING evaluation is a single sample costing three ticks
+    auto const& stats = selector->getOrdering().statistics();
+    EXPECT_EQ(stats[1].evaluations, 1u);
+    EXPECT_DOUBLE_EQ(stats[1].cost, 3.0);
+}
+
 // ===========================================================================
 // ReactiveSelector Tests
 // ===========================================================================
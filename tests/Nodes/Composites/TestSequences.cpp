@@ -192,6 +192,42 @@ TEST(TestSequence, ExecutionOrder)
     EXPECT_EQ(execution_order[2], 3);
 }
 
+TEST(TestSequence, UnorderedMovesFailingChildFirst)
+{
+    std::vector<int> execution_order;
+    auto sequence = bt::Node::create<bt::Sequence>();
+    for (int i = 1; i <= 3; ++i)
+    {
+        sequence->addChild(
+            bt::Node::create<bt::SugarAction>([&execution_order, i]() {
+                execution_order.push_back(i);
+                return (i == 3) ? bt::Status::FAILURE : bt::Status::SUCCESS;
+            }));
+    }
+    sequence->setUnordered({/*deterministic*/ true, /*reorder_period*/ 1});
+
+    EXPECT_EQ(sequence->tick(), bt::Status::FAILURE);
+    EXPECT_EQ(execution_order, (std::vector<int>{1, 2, 3}));
+
+    // The failing child short-circuits the sequence as soon as possible
+    execution_order.clear();
+    EXPECT_EQ(sequence->tick(), bt::Status::FAILURE);
+    EXPECT_EQ(execution_order, (std::vector<int>{3}));
+    EXPECT_EQ(sequence->getOrdering().order(),
+              (std::vector<size_t>{2u, 0u, 1u}));
+}
+
+TEST(TestSequence, OrderedByDefault)
+{
+    auto sequence = bt::Node::create<bt::Sequence>();
+    sequence->addChild(bt::Node::create<bt::Success>());
+    sequence->addChild(bt::Node::create<bt::Failure>());
+
+    EXPECT_FALSE(sequence->isUnordered());
+    EXPECT_EQ(sequence->tick(), bt::Status::FAILURE);
+    EXPECT_TRUE(sequence->getOrdering().order().empty());
+}
+
 // ===========================================================================
 // ReactiveSequence Tests
 // ===========================================================================
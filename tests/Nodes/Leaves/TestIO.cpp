@@ -0,0 +1,229 @@
+/**
+ * @file TestIO.cpp
+ * @brief Unit tests for the I/O-bound leaves and their reactor.
+ *
+ * Corresponds to src/BlackThorn/Nodes/Leaves/IO.hpp and
+ * src/BlackThorn/Common/Reactor.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Tick a node, sleeping on the reactor between ticks, until it is no
+//! longer RUNNING or the deadline expires.
+// ----------------------------------------------------------------------------
+bt::Status tickUntilDone(bt::Node& p_node, bt::Reactor& p_reactor)
+{
+    bt::Status status = p_node.tick();
+    for (int i = 0; (i < 100) && (status == bt::Status::RUNNING); ++i)
+    {
+        p_reactor.wait(std::chrono::milliseconds(50));
+        status = p_node.tick();
+    }
+    return status;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Local TCP server stand-in listening on a random loopback port.
+// ----------------------------------------------------------------------------
+struct LocalServer
+{
+    LocalServer()
+    {
+        fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        ::bind(fd, reinterpret_cast<sockaddr*>(&address), length);
+        ::listen(fd, 1);
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length);
+        port = ntohs(address.sin_port);
+    }
+
+    ~LocalServer()
+    {
+        close();
+    }
+
+    void close()
+    {
+        if (fd >= 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+
+    int fd = -1;
+    uint16_t port = 0;
+};
+
+} // anonymous namespace
+
+// ===========================================================================
+// Reactor Tests
+// ===========================================================================
+
+TEST(TestReactor, DispatchReadyDescriptors)
+{
+    bt::Reactor reactor;
+    ASSERT_TRUE(reactor.isValid());
+
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    uint32_t received = 0;
+    ASSERT_TRUE(
+        reactor.add(fds[0], EPOLLIN, [&received](uint32_t p_events) {
+            received = p_events;
+        }));
+    EXPECT_TRUE(reactor.contains(fds[0]));
+    EXPECT_EQ(reactor.poll(), 0u);
+
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    EXPECT_EQ(reactor.poll(), 1u);
+    EXPECT_TRUE(received & EPOLLIN);
+
+    reactor.remove(fds[0]);
+    EXPECT_EQ(reactor.size(), 0u);
+    EXPECT_EQ(reactor.poll(), 0u);
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+// ===========================================================================
+// ReadLine Tests
+// ===========================================================================
+
+TEST(TestReadLine, WaitsForCompleteLines)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    auto bb = std::make_shared<bt::Blackboard>();
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    bt::Tree tree;
+    tree.setBlackboard(bb);
+    tree.setReactor(reactor);
+    auto& reader = tree.createRoot<bt::ReadLine>(reactor, fds[0]);
+    reader.setBlackboard(bb);
+
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    ASSERT_EQ(::write(fds[1], "hel", 3), 3);
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    ASSERT_EQ(::write(fds[1], "lo\nworld\n", 9), 9);
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(reader.line(), "hello");
+    EXPECT_EQ(bb->get<std::string>("line").value(), "hello");
+    EXPECT_FALSE(reactor->contains(fds[0]));
+
+    // The second line has already been read
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(reader.line(), "world");
+
+    // End of file without pending bytes
+    EXPECT_EQ(tree.tick(), bt::Status::RUNNING);
+    ::close(fds[1]);
+    EXPECT_EQ(tree.tick(), bt::Status::FAILURE);
+    ::close(fds[0]);
+}
+
+TEST(TestReadLine, HaltUnregisters)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    auto reader = bt::Node::create<bt::ReadLine>(reactor, fds[0]);
+    EXPECT_EQ(reader->tick(), bt::Status::RUNNING);
+    EXPECT_TRUE(reactor->contains(fds[0]));
+    reader->halt();
+    EXPECT_FALSE(reactor->contains(fds[0]));
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+// ===========================================================================
+// SpawnProcess Tests
+// ===========================================================================
+
+TEST(TestSpawnProcess, CapturesOutputAndExitCode)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    auto bb = std::make_shared<bt::Blackboard>();
+
+    auto ok = bt::Node::create<bt::SpawnProcess>(reactor, "echo hello");
+    ok->setBlackboard(bb);
+    EXPECT_EQ(tickUntilDone(*ok, *reactor), bt::Status::SUCCESS);
+    EXPECT_EQ(ok->output(), "hello\n");
+    EXPECT_EQ(bb->get<int>("exit_code").value(), 0);
+    EXPECT_EQ(bb->get<std::string>("output").value(), "hello\n");
+
+    auto ko = bt::Node::create<bt::SpawnProcess>(reactor, "printf oops; exit 3");
+    EXPECT_EQ(tickUntilDone(*ko, *reactor), bt::Status::FAILURE);
+    EXPECT_EQ(ko->output(), "oops");
+    EXPECT_EQ(ko->exitCode(), 3);
+    EXPECT_EQ(reactor->size(), 0u);
+}
+
+TEST(TestSpawnProcess, HaltKillsProcess)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    auto node = bt::Node::create<bt::SpawnProcess>(reactor, "sleep 10");
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(node->tick(), bt::Status::RUNNING);
+    EXPECT_EQ(node->tick(), bt::Status::RUNNING);
+    node->halt();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(node->exitCode(), -1);
+    EXPECT_EQ(reactor->size(), 0u);
+}
+
+// ===========================================================================
+// ConnectSocket Tests
+// ===========================================================================
+
+TEST(TestConnectSocket, ConnectsToLocalServer)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    LocalServer server;
+    ASSERT_GE(server.fd, 0);
+
+    auto node =
+        bt::Node::create<bt::ConnectSocket>(reactor, "127.0.0.1", server.port);
+    EXPECT_EQ(tickUntilDone(*node, *reactor), bt::Status::SUCCESS);
+    ASSERT_GE(node->socket(), 0);
+
+    int accepted = ::accept(server.fd, nullptr, nullptr);
+    EXPECT_GE(accepted, 0);
+    ::close(accepted);
+    ::close(node->socket());
+}
+
+TEST(TestConnectSocket, ConnectionRefused)
+{
+    auto reactor = std::make_shared<bt::Reactor>();
+    LocalServer server;
+    uint16_t port = server.port;
+    server.close();
+
+    auto node = bt::Node::create<bt::ConnectSocket>(reactor, "127.0.0.1", port);
+    EXPECT_EQ(tickUntilDone(*node, *reactor), bt::Status::FAILURE);
+    EXPECT_LT(node->socket(), 0);
+    EXPECT_EQ(reactor->size(), 0u);
+}
@@ -1,6 +1,6 @@
 /**
  * @file TestLeaves.cpp
- * @brief Unit tests for Leaf nodes: Action, Basic, Condition.
+ * @brief Unit tests for Leaf nodes: Action, Basic, Condition, SetBlackboard.
  *
  * Corresponds to src/BlackThorn/Nodes/Leaves/
  *
@@ -105,3 +105,93 @@ TEST(TestLeafNodes, ConditionWithBlackboard)
     bb->set("enabled", false);
     EXPECT_EQ(node->tick(), bt::Status::FAILURE);
 }
+
+// ===========================================================================
+// SetBlackboard Tests (SetBlackboard.hpp)
+// ===========================================================================
+
+TEST(TestSetBlackboard, InfersLiteralType)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+
+    auto integer = bt::Node::create<bt::SetBlackboard>("i", "42", bb);
+    auto real = bt::Node::create<bt::SetBlackboard>("d", "3.5", bb);
+    auto boolean = bt::Node::create<bt::SetBlackboard>("b", "true", bb);
+    auto text = bt::Node::create<bt::SetBlackboard>("s", "hello", bb);
+
+    EXPECT_EQ(integer->getKind(), bt::SetBlackboard::Kind::Literal);
+    EXPECT_EQ(integer->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(real->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(boolean->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(text->tick(), bt::Status::SUCCESS);
+
+    EXPECT_EQ(bb->get<int>("i").value(), 42);
+    EXPECT_DOUBLE_EQ(bb->get<double>("d").value(), 3.5);
+    EXPECT_TRUE(bb->get<bool>("b").value());
+    EXPECT_EQ(bb->get<std::string>("s").value(), "hello");
+}
+
+TEST(TestSetBlackboard, ExplicitType)
+{
+    using Type = bt::SetBlackboard::Type;
+    auto bb = std::make_shared<bt::Blackboard>();
+
+    auto text =
+        bt::Node::create<bt::SetBlackboard>("s", "42", Type::String, bb);
+    auto real =
+        bt::Node::create<bt::SetBlackboard>("d", "2", Type::Double, bb);
+    EXPECT_EQ(text->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(real->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(bb->get<std::string>("s").value(), "42");
+    EXPECT_DOUBLE_EQ(bb->get<double>("d").value(), 2.0);
+
+    // Strings are written verbatim, even when looking like an expression
+    auto verbatim =
+        bt::Node::create<bt::SetBlackboard>("v", "1 + 2", Type::String, bb);
+    EXPECT_EQ(verbatim->getKind(), bt::SetBlackboard::Kind::Literal);
+
+    auto invalid = bt::Node::create<bt::SetBlackboard>("i", "abc", Type::Int);
+    EXPECT_FALSE(invalid->isValid());
+}
+
+TEST(TestSetBlackboard, CopyKeepsType)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("speed", 2.5);
+
+    auto node = bt::Node::create<bt::SetBlackboard>("target", "${speed}", bb);
+    EXPECT_EQ(node->getKind(), bt::SetBlackboard::Kind::Copy);
+    EXPECT_EQ(node->tick(), bt::Status::SUCCESS);
+    EXPECT_DOUBLE_EQ(bb->get<double>("target").value(), 2.5);
+
+    auto missing = bt::Node::create<bt::SetBlackboard>("x", "${unknown}", bb);
+    EXPECT_EQ(missing->tick(), bt::Status::FAILURE);
+}
+
+TEST(TestSetBlackboard, Expression)
+{
+    auto bb = std::make_shared<bt::Blackboard>();
+    bb->set("counter", 4);
+    bb->set("gain", 0.5);
+
+    auto increment =
+        bt::Node::create<bt::SetBlackboard>("counter", "${counter} + 1", bb);
+    EXPECT_EQ(increment->getKind(), bt::SetBlackboard::Kind::Expression);
+    EXPECT_EQ(increment->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(increment->tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(bb->get<int>("counter").value(), 6);
+
+    // Precedence and promotion to double
+    auto mixed = bt::Node::create<bt::SetBlackboard>(
+        "result", "1 + ${counter} * ${gain} - 2 / 4", bb);
+    EXPECT_EQ(mixed->tick(), bt::Status::SUCCESS);
+    EXPECT_DOUBLE_EQ(bb->get<double>("result").value(), 4.0);
+
+    // Integer division by zero
+    auto zero = bt::Node::create<bt::SetBlackboard>("z", "${counter} / 0", bb);
+    EXPECT_EQ(zero->tick(), bt::Status::FAILURE);
+
+    // Operators shall be separated by spaces: this is a string
+    auto date = bt::Node::create<bt::SetBlackboard>("date", "2025-01-01", bb);
+    EXPECT_EQ(date->getKind(), bt::SetBlackboard::Kind::Literal);
+}
@@ -0,0 +1,167 @@
+/**
+ * @file TestSamplingProfiler.cpp
+ * @brief Unit tests for the sampling profiler of behavior trees.
+ *
+ * Corresponds to src/BlackThorn/Profiler/SamplingProfiler.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+#include <thread>
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Action taking p_samples samples of the profiler while it runs, so
+//! that the tests do not depend on the timing of the sampling thread.
+// ----------------------------------------------------------------------------
+bt::Node::Ptr sampling(bt::SamplingProfiler& p_profiler,
+                       std::string const& p_name,
+                       size_t p_samples)
+{
+    auto action = bt::Node::create<bt::SugarAction>([&p_profiler, p_samples]() {
+        for (size_t i = 0u; i < p_samples; ++i)
+        {
+            p_profiler.sample();
+        }
+        return bt::Status::SUCCESS;
+    });
+    action->name = p_name;
+    return action;
+}
+
+// ----------------------------------------------------------------------------
+//! \brief Tree "root" -> { "fast" (1 sample), "branch" -> { "slow" (3
+//! samples) } }.
+// ----------------------------------------------------------------------------
+void buildTree(bt::Tree& p_tree, bt::SamplingProfiler& p_profiler)
+{
+    auto& root = p_tree.createRoot<bt::Sequence>();
+    root.name = "root";
+    root.addChild(sampling(p_profiler, "fast", 1u));
+    auto branch = bt::Node::create<bt::Sequence>();
+    branch->name = "branch";
+    branch->addChild(sampling(p_profiler, "slow", 3u));
+    root.addChild(std::move(branch));
+}
+
+} // anonymous namespace
+
+// ===========================================================================
+// Sampling Profiler Tests (the trees must outlive the profiler)
+// ===========================================================================
+
+TEST(TestSamplingProfiler, HotNodesAndCollapsedStacks)
+{
+    bt::Tree tree;
+    bt::SamplingProfiler profiler;
+    buildTree(tree, profiler);
+    profiler.attach(tree, "npc");
+    ASSERT_NE(tree.tickMarker(), nullptr);
+
+    EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(tree.tickMarker()->load(), nullptr);
+    profiler.sample(); // Between two ticks
+
+    auto stats = profiler.statistics(tree);
+    EXPECT_EQ(stats.samples, 5u);
+    EXPECT_EQ(stats.idle, 1u);
+    EXPECT_EQ(stats.untracked, 0u);
+    EXPECT_EQ(stats.busy(), 4u);
+
+    auto hot = profiler.hotNodes(tree);
+    ASSERT_EQ(hot.size(), 4u);
+    EXPECT_EQ(hot[0].node->name, "slow");
+    EXPECT_EQ(hot[0].path, "npc;root;branch;slow");
+    EXPECT_EQ(hot[0].self, 3u);
+    EXPECT_EQ(hot[1].node->name, "fast");
+    EXPECT_EQ(hot[1].self, 1u);
+    EXPECT_EQ(hot[2].node->name, "root");
+    EXPECT_EQ(hot[2].self, 0u);
+    EXPECT_EQ(hot[2].total, 4u);
+    EXPECT_EQ(hot[3].node->name, "branch");
+    EXPECT_EQ(hot[3].total, 3u);
+
+    EXPECT_EQ(profiler.collapsedStacks(),
+              "npc;root;branch;slow 3\n"
+              "npc;root;fast 1\n");
+
+    profiler.reset();
+    EXPECT_EQ(profiler.statistics(tree).samples, 0u);
+    EXPECT_TRUE(profiler.hotNodes(tree).empty());
+}
+
+TEST(TestSamplingProfiler, TreesWithSameLabelAreMerged)
+{
+    bt::Tree first;
+    bt::Tree second;
+    bt::SamplingProfiler profiler;
+    buildTree(first, profiler);
+    buildTree(second, profiler);
+    profiler.attach(first, "npc");
+    profiler.attach(second, "npc");
+
+    EXPECT_EQ(first.tick(), bt::Status::SUCCESS);
+    EXPECT_EQ(second.tick(), bt::Status::SUCCESS);
+
+    // Each sample reads the markers of both trees
+    EXPECT_EQ(profiler.statistics(first).samples, 8u);
+    EXPECT_EQ(profiler.statistics(first).busy(), 4u);
+    EXPECT_EQ(profiler.collapsedStacks(),
+              "npc;root;branch;slow 6\n"
+              "npc;root;fast 2\n");
+
+    profiler.detach(first);
+    EXPECT_EQ(first.tickMarker(), nullptr);
+    EXPECT_TRUE(profiler.hotNodes(first).empty());
+    EXPECT_EQ(profiler.collapsedStacks(),
+              "npc;root;branch;slow 3\n"
+              "npc;root;fast 1\n");
+}
+
+TEST(TestSamplingProfiler, ForkIsNotTracked)
+{
+    bt::Tree tree;
+    bt::SamplingProfiler profiler;
+    tree.createRoot<bt::Sequence>().addChild(bt::Node::create<bt::Success>());
+    profiler.attach(tree);
+
+    auto fork = tree.fork();
+    ASSERT_NE(fork, nullptr);
+    EXPECT_EQ(fork->tickMarker(), nullptr);
+    EXPECT_NE(tree.tickMarker(), nullptr);
+}
+
+TEST(TestSamplingProfiler, BackgroundThread)
+{
+    bt::Tree tree;
+    bt::SamplingProfiler profiler(std::chrono::microseconds(100));
+    auto& root = tree.createRoot<bt::Sequence>();
+    root.addChild(bt::Node::create<bt::SugarAction>([]() {
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return bt::Status::SUCCESS;
+    }));
+    profiler.attach(tree);
+
+    profiler.start();
+    EXPECT_TRUE(profiler.isRunning());
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(50);
+    while (std::chrono::steady_clock::now() < end)
+    {
+        EXPECT_EQ(tree.tick(), bt::Status::SUCCESS);
+    }
+    profiler.stop();
+    EXPECT_FALSE(profiler.isRunning());
+
+    auto stats = profiler.statistics(tree);
+    EXPECT_GT(stats.samples, 0u);
+    EXPECT_EQ(stats.untracked, 0u);
+    size_t const samples = stats.samples;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    EXPECT_EQ(profiler.statistics(tree).samples, samples);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file TestStatusAggregator.cpp
+ * @brief Unit tests for the distribution of the statuses across instances.
+ *
+ * Corresponds to src/BlackThorn/Profiler/StatusAggregator.hpp
+ *
+ * Copyright (c) 2025 Quentin Quadrat <lecrapouille@gmail.com>
+ * distributed under MIT License
+ */
+
+#include "main.hpp"
+
+#include "BlackThorn/BlackThorn.hpp"
+
+namespace {
+
+// ----------------------------------------------------------------------------
+//! \brief Instance of the tree definition "root" (ID 1) -> { "task" (ID 2)
+//! returning the status chosen by the test }.
+// ----------------------------------------------------------------------------
+struct Agent
+{
+    Agent()
+    {
+        auto& root = tree.createRoot<bt::Sequence>();
+        root.setId(1u);
+        auto task =
+            bt::Node::create<bt::SugarAction>([this]() { return status; });
+        task->setId(2u);
+        root.addChild(std::move(task));
+    }
+
+    bt::Tree tree;
+    bt::Status status = bt::Status::RUNNING;
+};
+
+// ----------------------------------------------------------------------------
+//! \brief Counts of a node, or zeros if absent.
+// ----------------------------------------------------------------------------
+bt::StatusAggregator::Counts countsOf(bt::StatusAggregator const& p_aggregator,
+                                      uint32_t p_id)
+{
+    for (auto const& node : p_aggregator.distribution())
+    {
+        if (node.id == p_id)
+        {
+            return node.counts;
+        }
+    }
+    return {};
+}
+
+} // anonymous namespace
+
+// ------------------------------------------------------------------------
+//! \brief Test the distribution of the statuses across instances.
+//! \details GIVEN ten agents, three of them succeeding, WHEN reporting them
+//!          after a tick, THEN EXPECT each node counts the agents per status.
+// ------------------------------------------------------------------------
+TEST(TestStatusAggregator, DistributionAcrossInstances)
+{
+    // GIVEN: Ten agents, three of them succeeding
+    std::vector<Agent> agents(10u);
+    for (size_t i = 0u; i < 3u; ++i)
+    {
+        agents[i].status = bt::Status::SUCCESS;
+    }
+
+    // WHEN: Reporting them after a tick
+    bt::StatusAggregator aggregator;
+    for (size_t i = 0u; i < agents.size(); ++i)
+    {
+        (void)agents[i].tree.tick();
+        aggregator.report(uint32_t(i), agents[i].tree);
+    }
+
+    // THEN: EXPECT each node counts the agents per status
+    EXPECT_EQ(aggregator.instances(), 10u);
+    ASSERT_EQ(aggregator.distribution().size(), 2u);
+    EXPECT_EQ(countsOf(aggregator, 1u),
+              bt::StatusAggregator::Counts({0u, 7u, 3u, 0u}));
+    EXPECT_EQ(countsOf(aggregator, 2u),
+              bt::StatusAggregator::Counts({0u, 7u, 3u, 0u}));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the incremental update of the distribution.
+//! \details GIVEN reported agents, WHEN reporting them again unchanged, then
+//!          with one failing, then removing it, THEN EXPECT the revision only
+//!          changes with the counts.
+// ------------------------------------------------------------------------
+TEST(TestStatusAggregator, OnlyChangesUpdateTheCounts)
+{
+    // GIVEN: Reported agents
+    std::vector<Agent> agents(4u);
+    bt::StatusAggregator aggregator;
+    for (size_t i = 0u; i < agents.size(); ++i)
+    {
+        (void)agents[i].tree.tick();
+        aggregator.report(uint32_t(i), agents[i].tree);
+    }
+    size_t revision = aggregator.revision();
+
+    // WHEN: Reporting them again unchanged
+    for (size_t i = 0u; i < agents.size(); ++i)
+    {
+        (void)agents[i].tree.tick();
+        aggregator.report(uint32_t(i), agents[i].tree);
+    }
+
+    // THEN: EXPECT the revision is unchanged
+    EXPECT_EQ(aggregator.revision(), revision);
+
+    // WHEN: One agent fails
+    agents[2].status = bt::Status::FAILURE;
+    (void)agents[2].tree.tick();
+    aggregator.report(2u, agents[2].tree);
+
+    // THEN: EXPECT its statuses moved to FAILURE
+    EXPECT_GT(aggregator.revision(), revision);
+    EXPECT_EQ(countsOf(aggregator, 2u),
+              bt::StatusAggregator::Counts({0u, 3u, 0u, 1u}));
+
+    // WHEN: Removing it
+    revision = aggregator.revision();
+    aggregator.remove(2u);
+
+    // THEN: EXPECT it is no longer counted
+    EXPECT_GT(aggregator.revision(), revision);
+    EXPECT_EQ(aggregator.instances(), 3u);
+    EXPECT_EQ(countsOf(aggregator, 2u),
+              bt::StatusAggregator::Counts({0u, 3u, 0u, 0u}));
+}
+
+// ------------------------------------------------------------------------
+//! \brief Test the change of structure of an instance.
+//! \details GIVEN two reported agents, WHEN the tree of one of them gets a
+//!          new root, THEN EXPECT its old nodes are uncounted and the new
+//!          ones counted.
+// ------------------------------------------------------------------------
+TEST(TestStatusAggregator, StructureChange)
+{
+    // GIVEN: Two reported agents
+    std::vector<Agent> agents(2u);
+    bt::StatusAggregator aggregator;
+    for (size_t i = 0u; i < agents.size(); ++i)
+    {
+        (void)agents[i].tree.tick();
+        aggregator.report(uint32_t(i), agents[i].tree);
+    }
+
+    // WHEN: The tree of one of them gets a new root
+    auto& root = agents[1].tree.createRoot<bt::Success>();
+    root.setId(3u);
+    (void)agents[1].tree.tick();
+    aggregator.report(1u, agents[1].tree);
+
+    // THEN: EXPECT its old nodes are uncounted and the new ones counted
+    EXPECT_EQ(countsOf(aggregator, 1u),
+              bt::StatusAggregator::Counts({0u, 1u, 0u, 0u}));
+    EXPECT_EQ(countsOf(aggregator, 2u),
+              bt::StatusAggregator::Counts({0u, 1u, 0u, 0u}));
+    EXPECT_EQ(countsOf(aggregator, 3u),
+              bt::StatusAggregator::Counts({0u, 0u, 1u, 0u}));
+
+    // WHEN: Removing the first agent
+    aggregator.remove(0u);
+
+    // THEN: EXPECT the nodes it was alone to use are gone
+    EXPECT_EQ(aggregator.distribution().size(), 1u);
+}